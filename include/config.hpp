@@ -29,6 +29,50 @@ constexpr int INITIAL_WINDOW_HEIGHT = 720; ///< Initial window height
 constexpr int TICK_RATE = 60;                                             ///< Fixed update rate (ticks per second)
 constexpr double FIXED_DELTA_TIME = 1.0 / static_cast<double>(TICK_RATE); ///< Time per tick
 
+constexpr int ATLAS_PAGE_SIZE = 2048; ///< Max edge (pixels) of one sprite atlas page
+constexpr int ATLAS_PADDING = 2;      ///< Transparent border around each atlased sprite (pixels)
+// Car level of detail, by on-screen car length in logical pixels
+constexpr float LOD_MARKER_MAX_PIXELS = 16.0f; ///< Below this, cars are drawn as colored markers
+constexpr float LOD_DETAIL_MIN_PIXELS = 48.0f; ///< From this up, cars get full rotation and path waypoints
+constexpr float LOD_MARKER_MIN_PIXELS = 3.0f;  ///< Markers never shrink below this on screen
+
+constexpr float GRID_MIN_CELL_PIXELS = 8.0f; ///< Grid overlay cells never get smaller than this on screen
+
+constexpr int STATIC_LAYER_CHUNK_SIZE = 2048; ///< Max edge (texture pixels) of one baked static-layer chunk
+
+constexpr double OPENMETRICS_INTERVAL = 5.0;      ///< Wall-clock seconds between OpenMetrics telemetry writes
+constexpr unsigned SHM_TELEMETRY_SLOTS = 256;     ///< Frames kept in the shared-memory telemetry ring
+constexpr unsigned SHM_TELEMETRY_MAX_CARS = 1024; ///< Cars per shared-memory telemetry frame
+constexpr unsigned TRAJECTORY_SAMPLE_TICKS = 6;   ///< Ticks between trajectory samples (10 Hz)
+
+constexpr float HEATMAP_CELL_SIZE = 2.0f;        ///< Congestion heatmap cell edge (meters)
+constexpr float HEATMAP_SLOW_SPEED = 1.5f;       ///< Cars slower than this (m/s) count as queuing
+constexpr double HEATMAP_HALF_LIFE = 300.0;      ///< Default decay half-life (simulated seconds, 0 = none)
+constexpr double HEATMAP_PUBLISH_INTERVAL = 0.5; ///< Min simulated seconds between heatmap snapshots
+constexpr float HEATMAP_MIN_SCALE = 10.0f;       ///< Lower bound of the heatmap color scale (queued seconds per cell)
+
+constexpr int GRID_BLOCK_UNITS = 6; ///< Entrance units between two cross streets in the city-grid layout
+
+constexpr float ROUTE_FREE_FLOW_SPEED = 15.0f;      ///< Lane speed (m/s) assumed where no car has been measured
+constexpr float ROUTE_MIN_SPEED = 1.0f;             ///< Floor of measured lane speeds; caps a jammed lane's cost
+constexpr double ROUTE_SPEED_TIME_CONSTANT = 10.0;  ///< Smoothing of measured lane speeds (simulated seconds)
+constexpr double REROUTE_FIRST_CHECK = 2.0;         ///< Simulated seconds after spawning until the first reroute check
+constexpr double REROUTE_INTERVAL = 5.0;            ///< Simulated seconds between reroute checks of one car
+constexpr float REROUTE_MIN_SAVING = 5.0f;          ///< Seconds a new route must be predicted to save...
+constexpr float REROUTE_MIN_SAVING_FRACTION = 0.1f; ///< ...and this fraction of the remaining route's cost
+constexpr int REROUTE_SEARCHES_PER_TICK = 4;        ///< Reroute searches per tick; further checks wait a tick
+
+constexpr int ASSIGNMENT_MAX_RELAXATIONS = 200000; ///< Matching work per tick before spot assignment turns greedy
+
+constexpr double PRICING_INTERVAL = 5.0;         ///< Simulated seconds between dynamic price updates
+constexpr double PRICING_TIME_CONSTANT = 60.0;   ///< Smoothing of price factors and arrival rates (simulated seconds)
+constexpr float PRICING_TARGET_OCCUPANCY = 0.8f; ///< Share of taken spots at which a facility keeps its base prices
+constexpr float PRICING_OCCUPANCY_GAIN = 1.5f;   ///< Price factor change per unit of occupancy off the target
+constexpr float PRICING_ARRIVAL_GAIN = 2.0f;     ///< Price factor added per arrival per minute per spot
+constexpr float PRICING_CHARGING_GAIN = 0.5f;    ///< Price factor added per unit of charging load (charging stations)
+constexpr float PRICING_MIN_FACTOR = 0.5f;       ///< Lowest price factor (share of the base price)
+constexpr float PRICING_MAX_FACTOR = 3.0f;       ///< Highest price factor
+
 constexpr int TARGET_FPS = 60;       ///< Target frames per second
 constexpr bool VSYNC_ENABLED = true; ///< Vertical sync flag
 
@@ -72,6 +116,7 @@ constexpr float BATTERY_HIGH_THRESHOLD = 70.0f;
 constexpr float BATTERY_EXIT_THRESHOLD = 80.0f;       // Chance to leave
 constexpr float BATTERY_FORCE_EXIT_THRESHOLD = 95.0f; // Must leave
 constexpr float CHARGING_RATE = 0.25f;                // % per second
+constexpr float BATTERY_CAPACITY_KWH = 60.0f;         // Pack size, for per-kWh statistics
 
 // Parking Timers (Seconds)
 constexpr float PARKING_MIN_TIME = 120.0f;
@@ -1,7 +1,35 @@
 #pragma once
 #include "raylib.h"
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
+
+/**
+ * @struct TextureHandle
+ * @brief Interned texture id handed out by AssetManager.
+ *
+ * Resolve a handle once (at construction/load time) and pass it to AssetManager::GetTexture
+ * at draw time for an O(1) array lookup instead of a string-keyed map search.
+ */
+struct TextureHandle {
+  uint16_t index = 0; ///< Slot in the texture table. 0 = invalid.
+
+  bool isValid() const { return index != 0; }
+  bool operator==(const TextureHandle &) const = default;
+};
+
+/**
+ * @struct SpriteRegion
+ * @brief The texture and source rectangle to draw a sprite with.
+ *
+ * For atlased sprites this is the shared atlas page and the sprite's sub-rectangle,
+ * so consecutive draws of different sprites don't force a texture switch.
+ */
+struct SpriteRegion {
+  Texture2D texture;
+  Rectangle source; ///< In texture pixels.
+};
 
 /**
  * @file AssetManager.hpp
@@ -9,6 +37,10 @@
  *
  * Currently handles Textures and Sounds (placeholder).
  * Implements the Singleton pattern for global access.
+ *
+ * Textures are stored in a flat table indexed by TextureHandle. Handles stay valid for the
+ * lifetime of the manager (unloading empties the slot but never reuses it), and resolving a
+ * handle is a read-only lookup, so any thread may resolve handles once loading is done.
  */
 class AssetManager {
 public:
@@ -39,12 +71,61 @@ public:
    */
   Texture2D GetTexture(const std::string &name);
 
+  /**
+   * @brief Resolves a texture name to its handle.
+   * @param name The unique identifier.
+   * @return The handle, or an invalid handle if the texture was never loaded.
+   */
+  TextureHandle GetTextureHandle(const std::string &name) const;
+
+  /**
+   * @brief Like GetTextureHandle(), but without the warning.
+   *
+   * For the simulation side (e.g. spawning cars), which also runs headless with no textures loaded.
+   * @return The handle, or an invalid handle if the texture was never loaded.
+   */
+  TextureHandle FindTextureHandle(const std::string &name) const;
+
+  /**
+   * @brief Retrieves a texture by handle (O(1), no logging).
+   * @param handle Handle from GetTextureHandle().
+   * @return The texture, or an empty texture (id 0) for invalid/unloaded handles.
+   */
+  Texture2D GetTexture(TextureHandle handle) const {
+    return handle.index < textureSlots.size() ? textureSlots[handle.index] : textureSlots[0];
+  }
+
   /**
    * @brief Unloads a specific texture from GPU memory.
    * @param name The unique identifier.
    */
   void UnloadTexture(const std::string &name);
 
+  /**
+   * @brief Resolves a handle to the region to draw it with (O(1)).
+   * @return The atlas page and sub-rectangle if the sprite was packed by BuildAtlas(),
+   * otherwise the texture itself with its full rectangle.
+   */
+  SpriteRegion GetSpriteRegion(TextureHandle handle) const {
+    if (handle.index < atlasRegions.size() && atlasRegions[handle.index].page.isValid()) {
+      const AtlasRegion &region = atlasRegions[handle.index];
+      return {GetTexture(region.page), region.source};
+    }
+    Texture2D tex = GetTexture(handle);
+    return {tex, {0, 0, (float)tex.width, (float)tex.height}};
+  }
+
+  /**
+   * @brief Packs already loaded textures into shared atlas pages.
+   *
+   * Re-reads the source images from disk, packs them with AtlasPacker and uploads one
+   * texture per page. The original textures stay loaded (and their handles valid);
+   * GetSpriteRegion() simply starts returning atlas regions for them.
+   *
+   * @param names Textures to pack.
+   */
+  void BuildAtlas(const std::vector<std::string> &names);
+
   // --- Sound ---
   /**
    * @brief Loads a sound from disk and caches it.
@@ -102,7 +183,16 @@ private:
   AssetManager() = default;
   ~AssetManager();
 
-  std::map<std::string, Texture2D> textures;
+  std::map<std::string, TextureHandle> textureHandles;
+  std::vector<Texture2D> textureSlots = {Texture2D{0, 0, 0, 0, 0}}; ///< Slot 0 is the invalid/empty texture.
+  std::vector<std::string> texturePaths = {""};                      ///< Source file per slot (for BuildAtlas).
+
+  struct AtlasRegion {
+    TextureHandle page; ///< Atlas page texture, invalid if the slot is not atlased.
+    Rectangle source;
+  };
+  std::vector<AtlasRegion> atlasRegions; ///< Indexed like textureSlots.
+  int atlasPageCount = 0;
   std::map<std::string, Sound> sounds;
   std::map<std::string, Music> musicStreams;
 };
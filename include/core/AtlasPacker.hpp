@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+
+/**
+ * @file AtlasPacker.hpp
+ * @brief Rectangle packing for texture atlases.
+ */
+
+/**
+ * @struct AtlasPlacement
+ * @brief Where one input rectangle ended up.
+ */
+struct AtlasPlacement {
+  int page = -1; ///< Atlas page index, or -1 if the rectangle does not fit on any page.
+  int x = 0;     ///< Left edge in pixels (padding excluded).
+  int y = 0;     ///< Top edge in pixels (padding excluded).
+};
+
+/**
+ * @class AtlasPacker
+ * @brief Shelf packer: sorts rectangles by height and fills rows left to right, opening
+ * new shelves and pages as needed.
+ *
+ * Pure logic (no raylib calls) so that it can be unit tested; AssetManager::BuildAtlas
+ * uses the placements to compose the atlas images.
+ */
+class AtlasPacker {
+public:
+  /**
+   * @param pageSize Edge length of a (square) page in pixels.
+   * @param padding Empty pixels kept around every rectangle to avoid sampling bleed.
+   */
+  AtlasPacker(int pageSize, int padding);
+
+  /**
+   * @brief Packs rectangles.
+   * @param sizes Width/height of each rectangle in pixels.
+   * @return One placement per input, in input order.
+   */
+  std::vector<AtlasPlacement> pack(const std::vector<std::pair<int, int>> &sizes);
+
+  /**
+   * @brief Number of pages used by the last pack() call.
+   */
+  int getPageCount() const { return (int)pageExtents.size(); }
+
+  /**
+   * @brief Used width/height of a page (pages can be allocated smaller than pageSize).
+   */
+  std::pair<int, int> getPageExtent(int page) const { return pageExtents[page]; }
+
+private:
+  int pageSize;
+  int padding;
+  std::vector<std::pair<int, int>> pageExtents;
+};
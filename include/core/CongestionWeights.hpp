@@ -0,0 +1,89 @@
+#pragma once
+#include "core/SpatialGrid.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file CongestionWeights.hpp
+ * @brief Live travel time of every road-graph edge, measured from the cars driving on it.
+ */
+
+/**
+ * @class CongestionWeights
+ * @brief Per-edge travel-time estimates for congestion-aware routing.
+ *
+ * An edge's cost is its length divided by a smoothed speed: Config::ROUTE_FREE_FLOW_SPEED while the
+ * edge is empty, moving towards the mean speed of the cars on it while it is occupied (never below
+ * Config::ROUTE_MIN_SPEED), and back towards free flow once it empties. Queues therefore make an
+ * edge expensive for a while after they form.
+ *
+ * Updates are incremental. Each car remembers its edge and is only matched against the spatial
+ * index of edge footprints when it leaves it. Only occupied edges and edges still recovering
+ * towards free flow are touched per tick, so an update costs O(cars + recently used edges).
+ */
+class CongestionWeights {
+public:
+  /**
+   * @brief Sizes the weights for @p graph and resets them to free flow. The graph must outlive this object.
+   */
+  void reset(const RoadGraph &graph);
+
+  /**
+   * @brief Measures one tick of traffic.
+   * @param dt Tick length in simulated seconds.
+   */
+  void update(double dt, const std::vector<std::unique_ptr<Car>> &cars);
+
+  /**
+   * @brief Forgets a car that left the simulation.
+   */
+  void removeCar(uint32_t carId);
+
+  /**
+   * @brief Current cost (seconds) of every edge, indexed like the graph's edges.
+   */
+  std::span<const float> getCosts() const { return costs; }
+  float getCost(uint32_t edge) const { return costs[edge]; }
+
+  /**
+   * @brief Lower bound of cost per meter over all edges, for RoadGraph::findRouteWeighted().
+   */
+  static float GetMinCostPerMeter();
+
+  /**
+   * @brief Edge the car was last matched to, or RoadGraph::NO_EDGE.
+   */
+  uint32_t getCarEdge(uint32_t carId) const;
+
+  /**
+   * @brief Edges currently slower than free flow or occupied.
+   */
+  size_t getActiveEdgeCount() const { return active.size(); }
+
+private:
+  /**
+   * @brief Lateral distance of @p position from @p edge, or a negative value if the car is not on it.
+   */
+  float fit(uint32_t edge, Vector2 position, Vector2 velocity) const;
+  uint32_t locate(Vector2 position, Vector2 velocity);
+  void activate(uint32_t edge);
+
+  const RoadGraph *graph = nullptr;
+  std::unique_ptr<SpatialGrid> edgeIndex; ///< Footprints of all edges, widened by the lane snap distance.
+  std::vector<int> candidates;            ///< Reused query buffer for edgeIndex.
+  std::vector<uint32_t> edgeSources;      ///< Source node of each edge (the CSR arrays only store targets).
+
+  std::vector<float> costs;        ///< Seconds per edge.
+  std::vector<float> speeds;       ///< Smoothed speed per edge (m/s).
+  std::vector<float> speedSums;    ///< Speeds of the cars on each edge this tick.
+  std::vector<uint16_t> carCounts; ///< Cars on each edge this tick.
+  std::vector<uint8_t> isActive;
+  std::vector<uint32_t> active; ///< Edges that need work in update().
+
+  std::unordered_map<uint32_t, uint32_t> carEdges; ///< Car id -> last matched edge.
+};
@@ -1,7 +1,10 @@
 #pragma once
 #include "core/EventBus.hpp"
+#include "core/LaneIndex.hpp"
 #include "entities/Car.hpp"
 #include "entities/map/Modules.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include "entities/map/SpotRegistry.hpp"
 #include "entities/map/World.hpp"
 #include <memory>
 #include <vector>
@@ -12,6 +15,9 @@
  *
  * Stores the World, Modules, and Cars.
  * Subscribes to events to trigger spawning, generation, and updates.
+ *
+ * Lives on the simulation thread. Rendering is done by RenderSystem from snapshots;
+ * only the World and Modules (immutable after generation) are shared with the render thread.
  */
 class EntityManager {
 public:
@@ -28,20 +34,31 @@ public:
    */
   void update(double dt);
 
-  /**
-   * @brief Draws all managed entities in the correct order (World -> Modules -> Cars -> Overlay).
-   */
-  void draw();
-
   // Entity Management
   void setWorld(std::unique_ptr<World> world);
   void addModule(std::unique_ptr<Module> module);
+  /**
+   * @brief Takes ownership of a car and assigns it a unique id.
+   */
   void addCar(std::unique_ptr<Car> car);
 
   // Accessors
   World *getWorld() const { return world.get(); }
   const std::vector<std::unique_ptr<Module>> &getModules() const { return modules; }
   const std::vector<std::unique_ptr<Car>> &getCars() const { return cars; }
+  /**
+   * @brief Lane graph of the current modules, rebuilt whenever a world is generated.
+   */
+  const RoadGraph &getRoadGraph() const { return roadGraph; }
+  /**
+   * @brief Cars of each road lane in driving order, as of the last update().
+   */
+  const LaneIndex &getLaneIndex() const { return laneIndex; }
+  /**
+   * @brief Table of all facility spots, rebuilt whenever a world is generated.
+   */
+  SpotRegistry &getSpotRegistry() { return spotRegistry; }
+  const SpotRegistry &getSpotRegistry() const { return spotRegistry; }
 
   /**
    * @brief Clears all entities and resets the world.
@@ -60,7 +77,11 @@ private:
 
   std::unique_ptr<World> world;
   std::vector<std::unique_ptr<Module>> modules;
+  RoadGraph roadGraph;
+  SpotRegistry spotRegistry; ///< Declared after modules: it unbinds them when destroyed.
   std::vector<std::unique_ptr<Car>> cars;
-  
-  bool dashboardVisible = false;
+  LaneIndex laneIndex;
+  std::vector<const Car *> neighbors; ///< Scratch: neighbors of the car being updated.
+
+  uint32_t nextCarId = 1; ///< Next id handed out by addCar().
 };
@@ -2,6 +2,8 @@
 
 #include "events/EventTypes.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -146,6 +148,7 @@ public:
    * @param event The event data instance.
    */
   template <EventType T> void publish(const T &event) {
+    publishCount_.fetch_add(1, std::memory_order_relaxed);
     std::vector<std::shared_ptr<IEventWrapper>> listenersSnapshot;
 
     {
@@ -173,6 +176,13 @@ public:
     }
   }
 
+  /**
+   * @brief Total number of publish() calls so far (including events nobody listens to).
+   *
+   * Relaxed counter for telemetry; safe to read from any thread.
+   */
+  uint64_t getPublishCount() const { return publishCount_.load(std::memory_order_relaxed); }
+
   /**
    * @brief Internal method called by Subscription destructor.
    * Removes a specific handler ID from the subscriber list.
@@ -223,6 +233,8 @@ private:
 
   // shared_mutex allows multiple readers (publish) but only one writer (subscribe/unsubscribe)
   mutable std::shared_mutex mutex_;
+
+  std::atomic<uint64_t> publishCount_{0};
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,132 @@
+#pragma once
+#include "core/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @file EventJournal.hpp
+ * @brief Append-only binary log of car and spot state changes (.plevj).
+ *
+ * File = [JournalHeader][JournalFacility x facilityCount][JournalRecord]...
+ *
+ * Records have a fixed size and are written in tick order, so a reader can split the record
+ * array into equal ranges for parallel processing without any index. Like TelemetryRing, this
+ * header only depends on the standard library so offline tools can use it without raylib.
+ */
+
+/**
+ * @enum JournalEventKind
+ * @brief What a JournalRecord describes.
+ */
+enum class JournalEventKind : uint8_t {
+  CAR_SPAWNED, ///< state = initial Car::CarState.
+  CAR_STATE,   ///< state = new Car::CarState; facility is set when the car parked.
+  CAR_REMOVED, ///< The car left the map.
+  SPOT_STATE,  ///< state/previous = SpotState of spot @c spot in facility @c facility.
+};
+
+/**
+ * @struct JournalRecord
+ * @brief One event. Plain data; the file stores these back to back.
+ */
+struct JournalRecord {
+  static constexpr uint32_t NO_FACILITY = UINT32_MAX;
+
+  uint64_t tick;
+  uint32_t carId;    ///< 0 for spot events.
+  uint32_t facility; ///< Index into the facility table, NO_FACILITY = none.
+  uint16_t spot;
+  JournalEventKind kind;
+  uint8_t state;
+  uint8_t previous;
+  uint8_t carType;  ///< Car::CarType (car events).
+  uint8_t priority; ///< Car::Priority (car events).
+  uint8_t reserved;
+};
+static_assert(sizeof(JournalRecord) == 24, "JournalRecord is part of the file format");
+
+/**
+ * @struct JournalFacility
+ * @brief A facility (module with spots) in generation order, same as SimulationSnapshot::facilities.
+ */
+struct JournalFacility {
+  uint32_t type; ///< ModuleType.
+  uint32_t spotCount;
+};
+
+namespace EventJournalFormat {
+constexpr uint64_t MAGIC = 0x31304A5645544C50ULL; ///< "PLTEVJ01"
+constexpr uint32_t VERSION = 2;                   ///< 2: 32-bit facility indices.
+
+struct JournalHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t recordSize;    ///< sizeof(JournalRecord), checked by readers.
+  double tickRate;        ///< Ticks per simulated second.
+  uint32_t facilityCount; ///< Entries in the facility table that follows the header.
+  uint32_t reserved[9];
+};
+static_assert(sizeof(JournalHeader) == 64);
+} // namespace EventJournalFormat
+
+/**
+ * @class EventJournalWriter
+ * @brief Buffered appender for .plevj files.
+ *
+ * State changes happen a few times per car trip, orders of magnitude less often than trajectory
+ * samples, so records go straight into a large stdio buffer on the calling thread.
+ */
+class EventJournalWriter {
+public:
+  /**
+   * @return nullptr if the file cannot be created.
+   */
+  static std::unique_ptr<EventJournalWriter> Open(const std::string &path, double tickRate,
+                                                  const std::vector<JournalFacility> &facilities);
+  ~EventJournalWriter();
+
+  EventJournalWriter(const EventJournalWriter &) = delete;
+  EventJournalWriter &operator=(const EventJournalWriter &) = delete;
+
+  void append(const JournalRecord &record);
+
+  uint64_t getRecordsWritten() const { return recordsWritten; }
+
+private:
+  explicit EventJournalWriter(std::FILE *file);
+
+  std::FILE *file;
+  std::vector<char> buffer;
+  uint64_t recordsWritten = 0;
+};
+
+/**
+ * @class EventJournalReader
+ * @brief Memory-mapped view of a .plevj file. Immutable after Open(), safe to share between threads.
+ */
+class EventJournalReader {
+public:
+  /**
+   * @return nullptr if the file is missing or not a journal. A trailing partial record
+   *         (interrupted run) is ignored.
+   */
+  static std::unique_ptr<EventJournalReader> Open(const std::string &path);
+
+  double getTickRate() const { return header->tickRate; }
+  std::span<const JournalFacility> getFacilities() const { return facilities; }
+  std::span<const JournalRecord> getRecords() const { return records; }
+  const MappedFile &getFile() const { return *file; }
+
+private:
+  explicit EventJournalReader(std::unique_ptr<MappedFile> file) : file(std::move(file)) {}
+
+  std::unique_ptr<MappedFile> file;
+  const EventJournalFormat::JournalHeader *header = nullptr;
+  std::span<const JournalFacility> facilities;
+  std::span<const JournalRecord> records;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include "config.hpp"
+#include "core/MetricsStore.hpp"
+#include "events/GameEvents.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/**
+ * @struct HeadlessOptions
+ * @brief Parameters of a windowless simulation run.
+ */
+struct HeadlessOptions {
+  MapConfig map;
+  MetricsConfig metrics;
+  double duration = 3600.0; ///< Simulated seconds to run.
+  int spawnLevel = 3;       ///< Auto-spawn level (0-5).
+  unsigned int seed = 0;    ///< Random seed; 0 keeps raylib's default seeding.
+  std::string outputPrefix = "parklogic_metrics";
+  std::string openMetricsPath;                                     ///< Live OpenMetrics file; empty = disabled.
+  double openMetricsInterval = Config::OPENMETRICS_INTERVAL;       ///< Wall-clock seconds between OpenMetrics writes.
+  std::string shmName;                                             ///< Shared-memory telemetry ring; empty = disabled.
+  uint32_t shmSlots = Config::SHM_TELEMETRY_SLOTS;                 ///< Frames kept in the ring.
+  uint32_t shmMaxCars = Config::SHM_TELEMETRY_MAX_CARS;            ///< Cars per frame.
+  uint32_t shmEveryTicks = 1;                                      ///< Ticks between frames.
+  std::string trajectoryPath;                                      ///< Columnar trajectory file; empty = disabled.
+  uint32_t trajectoryEveryTicks = Config::TRAJECTORY_SAMPLE_TICKS; ///< Ticks between trajectory samples.
+  uint32_t trajectoryCarModulo = 1;                                ///< Record cars whose id is a multiple of this.
+  std::string journalPath;                                         ///< Binary event journal; empty = disabled.
+};
+
+/**
+ * @class HeadlessRunner
+ * @brief Runs a Simulation without a window as fast as possible and exports its metrics.
+ *
+ * Started with `parklogic --headless [options]`; useful for long unattended runs and batch experiments.
+ * No textures are loaded, so the simulation's texture handles stay invalid; nothing is drawn.
+ */
+class HeadlessRunner {
+public:
+  /**
+   * @brief Parses the command line.
+   * @return Options if `--headless` was given, std::nullopt for a normal GUI start.
+   * @throws std::invalid_argument On an unknown option or a malformed value.
+   */
+  static std::optional<HeadlessOptions> ParseArgs(int argc, char **argv);
+
+  /**
+   * @brief Runs the simulation to completion and writes the CSV exports.
+   * @return Process exit code.
+   */
+  static int Run(const HeadlessOptions &options);
+
+  /**
+   * @brief Text printed for `--help`.
+   */
+  static const char *Usage();
+};
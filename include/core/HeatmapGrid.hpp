@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct HeatmapGrid
+ * @brief Immutable copy of the congestion heatmap, shared between snapshots until it changes.
+ *
+ * Cell (x, y) covers [x * cellSize, (x + 1) * cellSize) x [y * cellSize, (y + 1) * cellSize) meters.
+ */
+struct HeatmapGrid {
+  int width = 0;         ///< Cells.
+  int height = 0;        ///< Cells.
+  float cellSize = 1.0f; ///< Meters.
+  uint64_t version = 0;  ///< Increases with every published grid; the render side re-uploads on change.
+  float maxValue = 0.0f;
+  std::vector<float> values; ///< Queued car-seconds per cell (after decay), row-major.
+
+  float at(int x, int y) const { return values[(size_t)y * width + x]; }
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file JobPool.hpp
+ * @brief Persistent worker threads for batches of independent jobs.
+ */
+
+/**
+ * @class JobPool
+ * @brief Runs one indexed batch of jobs at a time on a fixed set of worker threads.
+ *
+ * dispatch() hands the indices [0, count) to the workers and returns at once; wait() blocks until
+ * the whole batch has finished. Workers claim indices through an atomic counter, so the order jobs
+ * run in varies between runs, but every index runs exactly once: a job that only writes its own
+ * result slot produces the same results whatever the thread count or timing.
+ *
+ * Jobs receive the index of the worker running them (0 to getThreadCount() - 1) so callers can
+ * keep scratch memory per worker instead of per job.
+ */
+class JobPool {
+public:
+  using Job = std::function<void(size_t index, unsigned worker)>;
+
+  /**
+   * @param threads Worker threads; at least one is started.
+   */
+  explicit JobPool(unsigned threads);
+
+  /**
+   * @brief Finishes the current batch, then stops and joins the workers.
+   */
+  ~JobPool();
+
+  JobPool(const JobPool &) = delete;
+  JobPool &operator=(const JobPool &) = delete;
+
+  /**
+   * @brief Starts job(i, worker) for every i in [0, count). Waits for the previous batch first.
+   *
+   * @p job and everything it reads must stay valid until wait() returns.
+   */
+  void dispatch(size_t count, Job job);
+
+  /**
+   * @brief Blocks until the dispatched batch has finished (returns at once if there is none).
+   */
+  void wait();
+
+  unsigned getThreadCount() const { return (unsigned)workers.size(); }
+
+  /**
+   * @brief A worker count that leaves cores for the simulation and render threads.
+   */
+  static unsigned DefaultThreadCount();
+
+private:
+  void run(unsigned worker);
+
+  std::mutex mutex;
+  std::condition_variable wake;     ///< Workers wait here for the next batch.
+  std::condition_variable finished; ///< wait() waits here for the batch to drain.
+  Job job;
+  size_t jobCount = 0;
+  size_t jobsDone = 0;          ///< Guarded by mutex.
+  std::atomic<size_t> nextJob;  ///< Next index to claim.
+  unsigned busyWorkers = 0;     ///< Workers that picked up the batch and have not left it yet.
+  unsigned long long batch = 0; ///< Bumped per dispatch so each worker joins every batch once.
+  bool stopping = false;
+  std::vector<std::thread> workers;
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include "core/SpatialGrid.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file LaneIndex.hpp
+ * @brief Cars of every road lane in driving order, for O(1) leader and follower lookups.
+ */
+
+/**
+ * @class LaneIndex
+ * @brief Per-lane lists of the cars driving on each RoadGraph lane, sorted by progress along it.
+ *
+ * On a lane, the only car another car has to follow is the next one ahead, so car-following does
+ * not need a 2D neighbor search there: the leader is the next entry of the lane's list and the
+ * follower the previous one. Cars that are on no lane (inside facilities, on their connectors or
+ * mid-turn) are collected in getOffLaneCars() instead; their motion is free-form.
+ *
+ * A lane ends where it turns onto others, as a cross street does at the road it joins; there a car
+ * also has to watch the cars coming up on the lanes it is about to enter. appendNeighbors() adds
+ * them for cars close to the end of their lane.
+ *
+ * The remaining interactions are local, so every moving car is also bucketed in a SpatialGrid once
+ * per update(): a car on a lane picks up the off-lane cars in the corridor it is driving into, and
+ * an off-lane car every car within its look-ahead distance.
+ *
+ * Each car remembers its lane and is only matched against the lanes near it when it leaves it. The lists
+ * are kept from tick to tick and re-sorted with an insertion sort, which is O(cars) when, as on a
+ * road, the order rarely changes.
+ *
+ * Car pointers are valid from one update() until a car is removed; call update() every tick
+ * before querying.
+ */
+class LaneIndex {
+public:
+  /**
+   * @brief Sizes the index for @p graph and forgets all cars. The graph must outlive this object.
+   */
+  void reset(const RoadGraph &graph);
+
+  /**
+   * @brief Places every moving car on its lane (or off lanes) and re-sorts the lanes.
+   */
+  void update(const std::vector<std::unique_ptr<Car>> &cars);
+
+  /**
+   * @brief Lane @p car was placed on by the last update(), or RoadGraph::NO_LANE.
+   */
+  uint32_t getLane(const Car &car) const;
+  /**
+   * @brief Next car ahead of @p car on its lane, or nullptr.
+   */
+  const Car *getLeader(const Car &car) const;
+  /**
+   * @brief Next car behind @p car on its lane, or nullptr.
+   */
+  const Car *getFollower(const Car &car) const;
+  /**
+   * @brief Appends the cars @p car has to watch to @p cars.
+   *
+   * On a lane: its leader, the off-lane cars in the corridor ahead of it and, near the end of its
+   * lane, the cars close to the junction on the lanes it turns onto. Off lanes: every moving car
+   * within its look-ahead distance. Nothing for parked cars.
+   */
+  void appendNeighbors(const Car &car, std::vector<const Car *> &cars) const;
+
+  /**
+   * @brief Cars of @p lane, rearmost first.
+   */
+  std::vector<const Car *> getLaneCars(uint32_t lane) const;
+  /**
+   * @brief Cars that are neither parked nor on a lane.
+   */
+  const std::vector<const Car *> &getOffLaneCars() const { return offLane; }
+
+private:
+  /**
+   * @struct Entry
+   * @brief One car in a lane list.
+   */
+  struct Entry {
+    const Car *car;
+    uint32_t carId;
+    float progress;    ///< Position along the lane direction (meters).
+    uint32_t lastSeen; ///< Update in which the car was last on this lane.
+  };
+
+  /**
+   * @struct Slot
+   * @brief Where a car sits in the lane lists.
+   */
+  struct Slot {
+    uint32_t lane = RoadGraph::NO_LANE;
+    uint32_t index = 0; ///< Into lanes[lane].
+    uint32_t mover = 0; ///< Into movers.
+    uint32_t lastSeen = 0;
+  };
+
+  /**
+   * @struct Mover
+   * @brief A car that is not parked, by its id in carGrid.
+   */
+  struct Mover {
+    const Car *car;
+    bool onLane;
+  };
+
+  /**
+   * @struct Turn
+   * @brief A lane that another lane's end node leads onto.
+   */
+  struct Turn {
+    uint32_t lane;
+    float progress; ///< Progress of the junction along that lane.
+  };
+
+  const Entry *neighbor(const Car &car, int offset) const;
+
+  const RoadGraph *graph = nullptr;
+  std::vector<std::vector<Entry>> lanes;    ///< Per lane, sorted by progress.
+  std::vector<float> laneEnds;              ///< Per lane, progress of its last node.
+  std::vector<std::vector<Turn>> turns;     ///< Per lane, the lanes its last node leads onto.
+  std::unordered_map<uint32_t, Slot> slots; ///< Car id -> lane slot.
+  std::vector<const Car *> offLane;         ///< Movers that are on no lane.
+  std::vector<Mover> movers;                ///< This update's moving cars, indexed by grid id.
+  std::unique_ptr<SpatialGrid> carGrid;     ///< Positions of the movers, refilled every update().
+  mutable std::vector<int> found;           ///< Scratch for carGrid queries.
+  uint32_t generation = 0;
+};
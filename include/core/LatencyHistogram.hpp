@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file LatencyHistogram.hpp
+ * @brief Fixed-size log-linear histogram for durations (HDR-histogram style).
+ */
+
+/**
+ * @class LatencyHistogram
+ * @brief Records non-negative durations in O(1) with bounded relative error.
+ *
+ * Values are bucketed by power-of-two octave, and each octave is split into SUB_BUCKETS
+ * linear sub-buckets, so a reported quantile is within 1/SUB_BUCKETS (~3%) of the true value.
+ * The bucket layout is a compile-time constant, which makes histograms from different runs
+ * mergeable by simply adding their counts.
+ *
+ * Range: MIN_VALUE (1 ms) up to MIN_VALUE * 2^OCTAVES (~12 days); values outside are clamped
+ * into the first/last bucket. Exact count, sum, min and max are kept alongside.
+ */
+class LatencyHistogram {
+public:
+  static constexpr double MIN_VALUE = 0.001;
+  static constexpr int OCTAVES = 30;
+  static constexpr int SUB_BUCKETS = 32;
+  static constexpr size_t BUCKET_COUNT = 1 + OCTAVES * SUB_BUCKETS; ///< Bucket 0 holds everything below MIN_VALUE.
+
+  /**
+   * @brief Adds one observation.
+   */
+  void record(double value);
+
+  /**
+   * @brief Adds all observations of @p other.
+   */
+  void merge(const LatencyHistogram &other);
+
+  /**
+   * @brief Value at quantile @p q (0-1), as the midpoint of the containing bucket clamped to [min, max].
+   * @return 0 if the histogram is empty.
+   */
+  double quantile(double q) const;
+
+  uint64_t count() const { return total; }
+  double mean() const { return total > 0 ? sum / (double)total : 0.0; }
+  double min() const { return total > 0 ? minValue : 0.0; }
+  double max() const { return total > 0 ? maxValue : 0.0; }
+
+  /**
+   * @brief Raw bucket access, used to export and re-import histograms for merging across runs.
+   */
+  uint64_t bucketAt(size_t index) const { return buckets[index]; }
+  void addToBucket(size_t index, uint64_t n);
+
+  /**
+   * @brief Bucket that @p value falls into.
+   */
+  static size_t BucketIndex(double value);
+
+  /**
+   * @brief Smallest value that maps to bucket @p index.
+   */
+  static double BucketLowerBound(size_t index);
+
+private:
+  std::array<uint64_t, BUCKET_COUNT> buckets{};
+  uint64_t total = 0;
+  double sum = 0.0;
+  double minValue = 0.0;
+  double maxValue = 0.0;
+};
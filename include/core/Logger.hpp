@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <format>
 #include <iostream>
 #include <mutex>
@@ -25,6 +26,8 @@ public:
    * @param message The message string.
    */
   static void Log(Level level, const std::string &message) {
+    if (!IsEnabled(level))
+      return;
     std::scoped_lock lock(mutex);
     switch (level) {
     case Level::Info:
@@ -40,6 +43,16 @@ public:
     std::cout << message << "\n";
   }
 
+  /**
+   * @brief Drops all messages below @p level (e.g. to silence per-car logging in headless runs).
+   */
+  static void SetMinLevel(Level level) { minLevel.store(level, std::memory_order_relaxed); }
+
+  /**
+   * @brief Whether messages of @p level are currently written.
+   */
+  static bool IsEnabled(Level level) { return level >= minLevel.load(std::memory_order_relaxed); }
+
   /**
    * @brief Logs an informational message with formatting.
    *
@@ -48,7 +61,8 @@ public:
    * @param args The arguments to format.
    */
   template <typename... Args> static void Info(std::format_string<Args...> fmt, Args &&...args) {
-    Log(Level::Info, std::format(fmt, std::forward<Args>(args)...));
+    if (IsEnabled(Level::Info))
+      Log(Level::Info, std::format(fmt, std::forward<Args>(args)...));
   }
 
   /**
@@ -70,9 +84,11 @@ public:
    * @param args The arguments to format.
    */
   template <typename... Args> static void Warn(std::format_string<Args...> fmt, Args &&...args) {
-    Log(Level::Warning, std::format(fmt, std::forward<Args>(args)...));
+    if (IsEnabled(Level::Warning))
+      Log(Level::Warning, std::format(fmt, std::forward<Args>(args)...));
   }
 
 private:
-  static inline std::mutex mutex; ///< Mutex for thread safety.
+  static inline std::mutex mutex;                         ///< Mutex for thread safety.
+  static inline std::atomic<Level> minLevel{Level::Info}; ///< Messages below this level are dropped.
 };
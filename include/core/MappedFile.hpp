@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Shared by the trajectory and event journal readers. Pages are loaded lazily by the OS, so
+ * mapping a file much larger than RAM costs only address space.
+ */
+class MappedFile {
+public:
+  /**
+   * @return nullptr if the file cannot be opened or mapped (or the platform has no mmap).
+   */
+  static std::unique_ptr<MappedFile> Open(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const unsigned char *data() const { return bytes; }
+  size_t size() const { return length; }
+
+  /**
+   * @brief Hints that [offset, offset + bytes) will be read front to back (read-ahead). Optional.
+   */
+  void adviseSequential(size_t offset, size_t bytes) const;
+
+private:
+  MappedFile(const unsigned char *bytes, size_t length) : bytes(bytes), length(length) {}
+
+  const unsigned char *bytes;
+  size_t length;
+};
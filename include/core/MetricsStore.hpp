@@ -0,0 +1,116 @@
+#pragma once
+#include "core/RingBuffer.hpp"
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file MetricsStore.hpp
+ * @brief Fixed-memory time series of simulation metrics with downsampled tiers.
+ */
+
+/**
+ * @enum Metric
+ * @brief Columns of a MetricsSample. Order matches MetricsStore::ColumnName().
+ */
+enum class Metric : size_t {
+  OCCUPANCY_SMALL_PARKING,  ///< Occupied / total spots, 0-1.
+  OCCUPANCY_LARGE_PARKING,  ///< Occupied / total spots, 0-1.
+  OCCUPANCY_SMALL_CHARGING, ///< Occupied / total spots, 0-1.
+  OCCUPANCY_LARGE_CHARGING, ///< Occupied / total spots, 0-1.
+  CARS_DRIVING,
+  CARS_ALIGNING,
+  CARS_PARKED,
+  CARS_EXITING,
+  SPAWN_RATE,        ///< Cars spawned per simulated minute.
+  EXIT_RATE,         ///< Cars leaving the map after a visit, per simulated minute.
+  PASS_THROUGH_RATE, ///< Cars leaving the map without parking, per simulated minute.
+  AVG_BATTERY,       ///< Mean battery level of electric cars on the map, 0-100.
+  COUNT
+};
+
+constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+
+/**
+ * @struct MetricsSample
+ * @brief One row of the time series.
+ */
+struct MetricsSample {
+  double simTime = 0.0; ///< End of the sampled interval, in simulated seconds.
+  std::array<float, METRIC_COUNT> values{};
+
+  float &operator[](Metric m) { return values[static_cast<size_t>(m)]; }
+  float operator[](Metric m) const { return values[static_cast<size_t>(m)]; }
+};
+
+/**
+ * @struct MetricsConfig
+ * @brief Sampling cadence and retention of a MetricsStore.
+ */
+struct MetricsConfig {
+  double sampleInterval = 1.0;  ///< Simulated seconds between samples.
+  bool downsample = true;       ///< Keep the 1 min / 1 h tiers in addition to the 1 s tier.
+  size_t secondCapacity = 3600; ///< Rows kept in the 1 s tier (1 hour).
+  size_t minuteCapacity = 1440; ///< Rows kept in the 1 min tier (1 day).
+  size_t hourCapacity = 720;    ///< Rows kept in the 1 h tier (30 days).
+};
+
+/**
+ * @class MetricsStore
+ * @brief Averages incoming samples into fixed-period buckets, one ring buffer per tier.
+ *
+ * Each tier (1 s, 1 min, 1 h) owns a RingBuffer sized up front, so recording is O(1) and the
+ * store's memory never grows however long the simulation runs. A bucket is closed when the first
+ * sample of the next period arrives; the still-open bucket is included in exports as a partial row.
+ */
+class MetricsStore {
+public:
+  /**
+   * @brief Retention tier.
+   */
+  struct Tier {
+    std::string name; ///< "1s", "1m" or "1h"; used in export file names.
+    double period;    ///< Bucket length in simulated seconds.
+    RingBuffer<MetricsSample> rows;
+    MetricsSample pending; ///< Running sum of the open bucket.
+    int pendingCount = 0;
+    long long pendingBucket = -1;
+
+    Tier(std::string name, double period, size_t capacity) : name(std::move(name)), period(period), rows(capacity) {}
+  };
+
+  explicit MetricsStore(const MetricsConfig &config = {});
+
+  /**
+   * @brief Folds one sample into every tier.
+   */
+  void record(const MetricsSample &sample);
+
+  const std::vector<Tier> &getTiers() const { return tiers; }
+  const MetricsConfig &getConfig() const { return config; }
+
+  /**
+   * @brief Writes a tier as CSV (header + one row per bucket, oldest first).
+   */
+  void writeCsv(std::ostream &out, size_t tier) const;
+
+  /**
+   * @brief Writes every tier to "<prefix>_<tier>.csv".
+   * @return False if any file could not be written.
+   */
+  bool exportCsv(const std::string &prefix) const;
+
+  /**
+   * @brief CSV column name of a metric.
+   */
+  static const char *ColumnName(Metric metric);
+
+private:
+  static MetricsSample Average(const Tier &tier);
+
+  MetricsConfig config;
+  std::vector<Tier> tiers;
+};
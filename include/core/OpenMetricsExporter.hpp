@@ -0,0 +1,101 @@
+#pragma once
+#include "core/SimulationStats.hpp"
+#include "core/SpscQueue.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @file OpenMetricsExporter.hpp
+ * @brief Periodic OpenMetrics (Prometheus text format) file writer for live telemetry.
+ */
+
+/**
+ * @struct TelemetrySample
+ * @brief Simulation counters and engine health, handed from the simulation to the exporter.
+ */
+struct TelemetrySample {
+  uint64_t ticks = 0;             ///< Fixed steps simulated so far.
+  double simTime = 0.0;           ///< Simulated seconds.
+  uint64_t eventsPublished = 0;   ///< EventBus::getPublishCount() of the simulation bus.
+  uint64_t windowTicks = 0;       ///< Ticks timed since the previous sample.
+  double windowTickSeconds = 0.0; ///< Wall time spent in those ticks.
+  double windowTickMax = 0.0;     ///< Slowest of those ticks, in seconds.
+  SimulationStats stats;
+};
+
+/**
+ * @class OpenMetricsExporter
+ * @brief Writes a TelemetrySample as an OpenMetrics text file on a background thread.
+ *
+ * submit() only pushes into a lock-free SPSC queue (dropping the sample if the queue is full),
+ * so the simulation tick never waits on file I/O. Every interval the worker drains the queue,
+ * derives rates (ticks/s, events/s) against the previous write, and replaces the file atomically
+ * by writing "<path>.tmp" and renaming it over @p path, so scrapers never see a partial file.
+ */
+class OpenMetricsExporter {
+public:
+  /**
+   * @param path Output file, e.g. for node_exporter's textfile collector.
+   * @param intervalSeconds Wall-clock seconds between writes.
+   */
+  OpenMetricsExporter(std::string path, double intervalSeconds);
+
+  /**
+   * @brief Stops the worker after a final write.
+   */
+  ~OpenMetricsExporter();
+
+  OpenMetricsExporter(const OpenMetricsExporter &) = delete;
+  OpenMetricsExporter &operator=(const OpenMetricsExporter &) = delete;
+
+  /**
+   * @brief Hands over the latest sample (simulation thread only). Never blocks.
+   */
+  void submit(const TelemetrySample &sample) { samples.push(sample); }
+
+  std::chrono::duration<double> getInterval() const { return interval; }
+
+  /**
+   * @brief Rates derived by the worker between two writes.
+   */
+  struct Rates {
+    double ticksPerSecond = 0.0;
+    double eventsPerSecond = 0.0;
+    double tickSecondsMean = 0.0;
+    double tickSecondsMax = 0.0;
+    uint64_t residentBytes = 0; ///< 0 if unknown on this platform.
+  };
+
+  /**
+   * @brief Formats one exposition (ending in "# EOF").
+   */
+  static void Format(std::ostream &out, const TelemetrySample &sample, const Rates &rates);
+
+private:
+  void run();
+  void writeFile();
+
+  std::string path;
+  std::chrono::duration<double> interval;
+  SpscQueue<TelemetrySample, 16> samples;
+
+  // Worker-thread state
+  TelemetrySample latest;
+  bool hasSample = false;
+  uint64_t windowTicks = 0;
+  double windowTickSeconds = 0.0;
+  double windowTickMax = 0.0;
+  uint64_t lastWrittenTicks = 0;
+  uint64_t lastWrittenEvents = 0;
+  std::chrono::steady_clock::time_point lastWrite;
+
+  std::thread worker;
+  std::mutex stopMutex;
+  std::condition_variable stopSignal;
+  bool stopping = false;
+};
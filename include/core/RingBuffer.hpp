@@ -0,0 +1,62 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file RingBuffer.hpp
+ * @brief Fixed-capacity circular buffer that overwrites its oldest element when full.
+ */
+
+/**
+ * @class RingBuffer
+ * @brief Keeps the most recent N values in storage allocated once at construction.
+ *
+ * Unlike SpscQueue this is single-threaded and never rejects a push: once full, each push
+ * replaces the oldest value, so memory stays constant for arbitrarily long runs.
+ * Elements are indexed from oldest (0) to newest (size() - 1).
+ *
+ * @tparam T Element type (must be default-constructible and copy-assignable).
+ */
+template <typename T> class RingBuffer {
+public:
+  explicit RingBuffer(size_t capacity) : buffer(capacity) {}
+
+  /**
+   * @brief Appends a value, discarding the oldest one if the buffer is full.
+   */
+  void push(const T &value) {
+    if (buffer.empty())
+      return;
+    buffer[(start + count) % buffer.size()] = value;
+    if (count < buffer.size())
+      count++;
+    else
+      start = (start + 1) % buffer.size();
+  }
+
+  /**
+   * @brief Element @p i counted from the oldest retained value.
+   */
+  const T &operator[](size_t i) const {
+    assert(i < count);
+    return buffer[(start + i) % buffer.size()];
+  }
+
+  const T &newest() const { return (*this)[count - 1]; }
+
+  size_t size() const { return count; }
+  size_t capacity() const { return buffer.size(); }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == buffer.size(); }
+
+  void clear() {
+    start = 0;
+    count = 0;
+  }
+
+private:
+  std::vector<T> buffer;
+  size_t start = 0; ///< Index of the oldest element.
+  size_t count = 0;
+};
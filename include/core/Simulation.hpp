@@ -0,0 +1,152 @@
+#pragma once
+#include "core/EntityManager.hpp"
+#include "core/EventJournal.hpp"
+#include "core/EventBus.hpp"
+#include "core/MetricsStore.hpp"
+#include "core/TelemetryRing.hpp"
+#include "core/TrajectoryWriter.hpp"
+#include "core/TripLatencies.hpp"
+#include "events/GameEvents.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class HeatmapSystem;
+class MetricsSystem;
+class OpenMetricsExporter;
+class StatsSystem;
+class TrafficSystem;
+class TripLatencySystem;
+struct HeatmapGrid;
+struct SimulationStats;
+
+/**
+ * @class Simulation
+ * @brief The complete parking simulation (entities, traffic, statistics, metrics, trip latencies, heatmap)
+ * on one private EventBus.
+ *
+ * Simulation is not thread-aware: SimulationThread hosts one on a worker thread for the GUI,
+ * and HeadlessRunner drives one synchronously from the command line.
+ */
+class Simulation {
+public:
+  /**
+   * @brief Creates the systems and generates the world.
+   * @param config Map generation parameters.
+   * @param metricsConfig Sampling cadence and retention of the metrics time series.
+   */
+  explicit Simulation(const MapConfig &config, const MetricsConfig &metricsConfig = {});
+  ~Simulation();
+
+  Simulation(const Simulation &) = delete;
+  Simulation &operator=(const Simulation &) = delete;
+
+  /**
+   * @brief Advances the simulation by one fixed step and takes a metrics sample when one is due.
+   */
+  void step(double dt);
+
+  /**
+   * @brief Publishes an event on the simulation's private bus (e.g. a spawn request).
+   */
+  template <typename EventType> void publish(const EventType &event) { bus->publish(event); }
+
+  /**
+   * @brief Subscribes to an event of the simulation's private bus; the handler runs on the simulation thread.
+   */
+  template <EventType T> [[nodiscard]] Subscription subscribe(std::function<void(const T &)> callback) {
+    return bus->subscribe<T>(std::move(callback));
+  }
+
+  /**
+   * @brief Starts writing live telemetry to an OpenMetrics text file from a background thread.
+   * @param path Output file, replaced atomically on every write.
+   * @param intervalSeconds Wall-clock seconds between writes.
+   */
+  void enableOpenMetrics(const std::string &path, double intervalSeconds);
+
+  /**
+   * @brief Starts publishing frames into a POSIX shared-memory ring for external viewers.
+   * @param name Shared-memory object name, e.g. "/parklogic".
+   * @param slotCount Frames kept in the ring.
+   * @param maxCars Cars per frame; extra cars are dropped and the frame is flagged as truncated.
+   * @param everyTicks Write one frame every this many ticks.
+   * @return False if the segment could not be created.
+   */
+  bool enableSharedMemoryTelemetry(const std::string &name, uint32_t slotCount, uint32_t maxCars,
+                                   uint32_t everyTicks = 1);
+
+  /**
+   * @brief Starts recording car trajectories into a columnar .pltraj file (see TrajectoryFormat).
+   * @param path Output file.
+   * @param everyTicks Sample every this many ticks.
+   * @param carModulo Only record cars whose id is a multiple of this (1 = all cars).
+   * @return False if the file could not be created.
+   */
+  bool enableTrajectoryLog(const std::string &path, uint32_t everyTicks, uint32_t carModulo = 1);
+
+  /**
+   * @brief Starts logging car and spot state changes into a binary event journal (see EventJournal.hpp).
+   * @return False if the file could not be created.
+   */
+  bool enableEventJournal(const std::string &path);
+
+  const EntityManager &getEntityManager() const { return *entityManager; }
+  const SimulationStats &getStats() const;
+  const MetricsStore &getMetrics() const;
+  const TripLatencies &getTripLatencies() const;
+  HeatmapSystem &getHeatmap() { return *heatmapSystem; }
+  /**
+   * @brief Latest congestion heatmap, republished at most every Config::HEATMAP_PUBLISH_INTERVAL.
+   */
+  std::shared_ptr<const HeatmapGrid> getHeatmapGrid();
+  /**
+   * @brief Trip latency quantiles, refreshed at most once per simulated second.
+   */
+  const TripLatencySummary &getTripSummary();
+
+  uint64_t getTick() const { return tick; }
+  double getSimTime() const { return simTime; }
+  int getSpawnLevel() const { return spawnLevel; }
+  uint32_t getLastSpawnedCarId() const { return lastSpawnedCarId; }
+
+private:
+  std::shared_ptr<EventBus> bus;
+  std::unique_ptr<EntityManager> entityManager;
+  std::unique_ptr<TrafficSystem> trafficSystem;
+  std::unique_ptr<StatsSystem> statsSystem;
+  std::unique_ptr<MetricsSystem> metricsSystem;
+  std::unique_ptr<TripLatencySystem> tripLatencySystem;
+  std::unique_ptr<HeatmapSystem> heatmapSystem;
+  std::unique_ptr<OpenMetricsExporter> openMetrics;
+  std::unique_ptr<TelemetryRingWriter> sharedTelemetry;
+  TelemetryFrame telemetryFrame; ///< Reused between writes to avoid per-tick allocations.
+  uint32_t sharedTelemetryStride = 1;
+  std::unique_ptr<TrajectoryWriter> trajectory;
+  uint32_t trajectoryStride = 1;
+  uint32_t trajectoryCarModulo = 1;
+  std::unique_ptr<EventJournalWriter> journal;
+  std::unordered_map<const Module *, uint32_t> journalFacilities; ///< Module -> facility table index.
+  std::vector<Subscription> eventTokens;
+
+  void advance(double dt);
+
+  // Tick timing, only measured while telemetry is enabled
+  void submitTelemetry();
+  void writeSharedTelemetry();
+  void writeTrajectorySample();
+  void journalCar(JournalEventKind kind, const Car &car);
+  std::chrono::steady_clock::time_point lastTelemetrySubmit;
+  std::chrono::duration<double> telemetrySubmitPeriod{0.0};
+  uint64_t windowTicks = 0;
+  double windowTickSeconds = 0.0;
+  double windowTickMax = 0.0;
+
+  uint64_t tick = 0;
+  double simTime = 0.0;
+  int spawnLevel = 0;
+  uint32_t lastSpawnedCarId = 0;
+};
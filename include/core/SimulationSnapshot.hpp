@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file SimulationSnapshot.hpp
+ * @brief Immutable copy of the simulation state handed from the simulation thread to the render thread.
+ */
+#include "core/AssetManager.hpp"
+#include "core/HeatmapGrid.hpp"
+#include "core/SimulationStats.hpp"
+#include "core/TripLatencies.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct CarSnapshot
+ * @brief Everything the render thread needs to draw, pick and describe one car.
+ */
+struct CarSnapshot {
+  uint32_t id = 0; ///< Car::getId().
+  Vector2 position = {0, 0};
+  Vector2 velocity = {0, 0};
+  float rotation = 0.0f; ///< Sprite rotation in degrees.
+  Car::CarType type = Car::CarType::COMBUSTION;
+  Car::CarState state = Car::CarState::DRIVING;
+  Car::Priority priority = Car::Priority::PRIORITY_DISTANCE;
+  float batteryLevel = 0.0f;
+  TextureHandle texture;
+  std::vector<Vector2> path; ///< Remaining waypoints. Only filled for the selected car.
+};
+
+/**
+ * @struct FacilityLayout
+ * @brief Fixed geometry of one facility (a module that owns spots).
+ */
+struct FacilityLayout {
+  ModuleType type = ModuleType::GENERIC;
+  Rectangle bounds = {0, 0, 0, 0}; ///< World-space footprint in meters.
+  float priceMultiplier = 1.0f;
+  uint32_t firstSpot = 0; ///< Its spots are [firstSpot, firstSpot + spotCount) of the per-spot arrays.
+  uint32_t spotCount = 0;
+};
+
+/**
+ * @struct SnapshotLayout
+ * @brief Geometry of all facilities and spots; built once per world and shared by its snapshots.
+ */
+struct SnapshotLayout {
+  std::vector<FacilityLayout> facilities;
+  std::vector<Vector2> spotPositions; ///< Per spot, world coordinates in meters.
+};
+
+/**
+ * @struct SimulationSnapshot
+ * @brief One consistent view of the world, published after each batch of simulation ticks.
+ *
+ * Snapshots are never modified after publication, so any number of render-thread readers
+ * (DashboardOverlay, click picking, RenderSystem, TrackingSystem) can share one instance.
+ * Facility and spot geometry lives in the shared layout; a snapshot only copies the spot states.
+ */
+struct SimulationSnapshot {
+  uint64_t tick = 0;             ///< Number of fixed steps simulated so far.
+  double simTime = 0.0;          ///< Simulated seconds.
+  int spawnLevel = 0;            ///< Current auto-spawn level (0-5).
+  uint32_t lastSpawnedCarId = 0; ///< Id of the most recently spawned car (0 = none yet).
+
+  std::vector<CarSnapshot> cars;
+  std::shared_ptr<const SnapshotLayout> layout;         ///< The same instance for the lifetime of a world.
+  std::vector<Module::SpotCounts> facilityCounts;       ///< Per layout facility.
+  std::vector<SpotState> spotStates;                    ///< Per spot, indexed like layout->spotPositions.
+  std::shared_ptr<const std::vector<float>> spotPrices; ///< Per spot; the same instance until prices change.
+  SimulationStats stats;                                ///< Aggregates maintained by StatsSystem.
+  TripLatencySummary trips;                             ///< Trip duration quantiles from TripLatencySystem.
+  std::shared_ptr<const HeatmapGrid> heatmap;           ///< Congestion grid; the same instance until it changes.
+
+  /**
+   * @brief Finds a car by id.
+   * @return Pointer into this snapshot, or nullptr if the car no longer exists.
+   */
+  const CarSnapshot *findCar(uint32_t id) const {
+    for (const auto &car : cars) {
+      if (car.id == id)
+        return &car;
+    }
+    return nullptr;
+  }
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include <array>
+#include <cstdint>
+
+/**
+ * @file SimulationStats.hpp
+ * @brief Aggregate counters shown on the dashboard and copied into every SimulationSnapshot.
+ */
+
+/**
+ * @struct FacilityStats
+ * @brief Spot totals for a group of facilities.
+ */
+struct FacilityStats {
+  int facilities = 0;
+  int totalSpots = 0;
+  int free = 0;
+  int reserved = 0;
+  int occupied = 0;
+
+  float occupancy() const { return totalSpots > 0 ? (float)occupied / totalSpots : 0.0f; }
+
+  FacilityStats &operator+=(const FacilityStats &o) {
+    facilities += o.facilities;
+    totalSpots += o.totalSpots;
+    free += o.free;
+    reserved += o.reserved;
+    occupied += o.occupied;
+    return *this;
+  }
+};
+
+/**
+ * @struct SimulationStats
+ * @brief Aggregates maintained by StatsSystem; all accessors are O(1).
+ */
+struct SimulationStats {
+  static constexpr size_t MODULE_TYPE_COUNT = 6; ///< Number of ModuleType values.
+  static constexpr size_t CAR_STATE_COUNT = 4;   ///< Number of Car::CarState values.
+
+  std::array<FacilityStats, MODULE_TYPE_COUNT> byType{}; ///< Indexed by ModuleType.
+  std::array<int, CAR_STATE_COUNT> carsByState{};        ///< Indexed by Car::CarState.
+  int activeCars = 0;
+  uint64_t totalSpawned = 0;
+  uint64_t totalRemoved = 0;       ///< totalExited + totalPassedThrough.
+  uint64_t totalExited = 0;        ///< Cars that left the map after parking or charging.
+  uint64_t totalPassedThrough = 0; ///< Cars that left the map without ever parking.
+
+  const FacilityStats &of(ModuleType type) const { return byType[(size_t)type]; }
+  int cars(Car::CarState state) const { return carsByState[(size_t)state]; }
+
+  FacilityStats parking() const {
+    FacilityStats s = of(ModuleType::SMALL_PARKING);
+    s += of(ModuleType::LARGE_PARKING);
+    return s;
+  }
+  FacilityStats charging() const {
+    FacilityStats s = of(ModuleType::SMALL_CHARGING);
+    s += of(ModuleType::LARGE_CHARGING);
+    return s;
+  }
+  FacilityStats allFacilities() const {
+    FacilityStats s = parking();
+    s += charging();
+    return s;
+  }
+};
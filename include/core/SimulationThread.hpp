@@ -0,0 +1,105 @@
+#pragma once
+#include "core/Simulation.hpp"
+#include "core/SimulationSnapshot.hpp"
+#include "core/SpscQueue.hpp"
+#include "events/GameEvents.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <variant>
+#include <vector>
+
+/**
+ * @struct SimulationTickCommand
+ * @brief Advances the simulation by one fixed step.
+ */
+struct SimulationTickCommand {
+  double dt = 0.0;
+};
+
+/**
+ * @brief Everything the render thread may ask of the simulation.
+ *
+ * Each alternative other than SimulationTickCommand is an event that is re-published
+ * on the simulation's private EventBus, so simulation systems keep their usual subscriptions.
+ */
+using SimulationCommand = std::variant<SimulationTickCommand, SpawnCarRequestEvent, CycleAutoSpawnLevelEvent,
+                                       EntitySelectedEvent, ExportMetricsEvent, ResetHeatmapEvent,
+                                       CycleHeatmapDecayEvent>;
+
+/**
+ * @class SimulationThread
+ * @brief Runs a Simulation on a dedicated thread.
+ *
+ * Communication with the render thread is lock-free in both directions:
+ * - Commands (ticks, spawn requests, selection) arrive through an SPSC queue.
+ * - After each batch of commands an immutable SimulationSnapshot is published through a second SPSC queue.
+ *
+ * The simulation owns a private EventBus so that no handler ever runs on the wrong thread.
+ * The World and Modules are generated synchronously in the constructor and never change
+ * afterwards, which makes getEntityManager().getWorld()/getModules() safe to read from the render thread.
+ */
+class SimulationThread {
+public:
+  /**
+   * @brief Creates the simulation and generates its world (synchronously, on the calling thread).
+   * @param config Map generation parameters.
+   */
+  explicit SimulationThread(const MapConfig &config, const MetricsConfig &metricsConfig = {});
+  ~SimulationThread();
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  /**
+   * @brief Starts the worker thread. Idempotent.
+   */
+  void start();
+
+  /**
+   * @brief Stops and joins the worker thread. Idempotent.
+   */
+  void stop();
+
+  /**
+   * @brief Queues a command for the simulation (render thread only).
+   * @return False if the command queue is full and the command was dropped.
+   */
+  bool post(SimulationCommand command);
+
+  /**
+   * @brief Drains the snapshot queue (render thread only).
+   * @return The newest snapshot published since the last call, or nullptr if there is none.
+   */
+  std::shared_ptr<const SimulationSnapshot> pollSnapshot();
+
+  /**
+   * @brief Access to the static world layout (World + Modules).
+   *
+   * Only the generation-time geometry may be read from the render thread; spot states and cars
+   * must be read from snapshots.
+   */
+  const EntityManager &getEntityManager() const { return simulation->getEntityManager(); }
+
+private:
+  void run();
+  void execute(const SimulationCommand &command);
+  void publishSnapshot();
+  /**
+   * @brief Captures the facility and spot geometry of the current world for the snapshots to share.
+   */
+  void rebuildLayout();
+
+  std::unique_ptr<Simulation> simulation; ///< Only touched by the worker once started.
+  Subscription worldBoundsToken;          ///< Rebuilds the layout when a world is generated.
+  std::shared_ptr<const SnapshotLayout> layout;
+  std::shared_ptr<const std::vector<float>> spotPrices; ///< Last published prices, reused while unchanged.
+  uint64_t spotPricesVersion = 0;                       ///< SpotRegistry::getPriceVersion() of spotPrices.
+
+  SpscQueue<SimulationCommand, 1024> commands;
+  SpscQueue<std::shared_ptr<const SimulationSnapshot>, 8> snapshots;
+
+  std::thread worker;
+  std::atomic<bool> running{false};
+  std::atomic<uint32_t> wakeSignal{0}; ///< Bumped on every post() so the worker can sleep with atomic::wait.
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file SpatialGrid.hpp
+ * @brief Uniform-grid index for axis-aligned rectangles.
+ */
+
+/**
+ * @class SpatialGrid
+ * @brief Buckets rectangles into fixed-size cells so area queries only touch nearby items.
+ *
+ * Items are identified by dense integer ids (e.g. indices into an owner's vector).
+ * An item spanning several cells is stored in each of them; query() de-duplicates.
+ * clear() only touches occupied cells, so the grid can be refilled every tick for moving items.
+ */
+class SpatialGrid {
+public:
+  /**
+   * @brief Creates an empty grid covering [0, width] x [0, height].
+   * @param width Covered width in meters.
+   * @param height Covered height in meters.
+   * @param cellSize Cell edge length in meters.
+   */
+  SpatialGrid(float width, float height, float cellSize);
+
+  /**
+   * @brief Adds an item. Parts of @p bounds outside the grid are clamped to the border cells.
+   * @param id Dense, non-negative id.
+   * @param bounds Item footprint in meters.
+   */
+  void insert(int id, Rectangle bounds);
+
+  /**
+   * @brief Collects the ids of all items whose cells intersect @p area.
+   *
+   * The result is a conservative superset (cell granularity) in ascending id order,
+   * so callers that draw in insertion order keep their layering.
+   *
+   * @param area Query rectangle in meters.
+   * @param out Receives the ids (cleared first).
+   */
+  void query(Rectangle area, std::vector<int> &out) const;
+
+  /**
+   * @brief Removes all items but keeps the grid dimensions.
+   */
+  void clear();
+
+  int getCols() const { return cols; }
+  int getRows() const { return rows; }
+
+private:
+  struct CellRange {
+    int x0, y0, x1, y1;
+  };
+  CellRange cellRange(Rectangle area) const;
+
+  float cellSize;
+  int cols;
+  int rows;
+  std::vector<std::vector<int>> cells;
+  std::vector<size_t> usedCells; ///< Cells that received items since the last clear().
+
+  // Per-id visit stamps used to de-duplicate query results without a set
+  mutable std::vector<uint32_t> stamps;
+  mutable uint32_t queryStamp = 0;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file SpscQueue.hpp
+ * @brief Bounded lock-free single-producer / single-consumer ring buffer.
+ */
+
+/**
+ * @class SpscQueue
+ * @brief Wait-free FIFO for handing values from exactly one thread to exactly one other thread.
+ *
+ * Used to pass input commands from the render thread to the simulation thread and
+ * immutable snapshots back the other way.
+ *
+ * Thread Safety Model:
+ * - push() may only be called from the producer thread.
+ * - pop() may only be called from the consumer thread.
+ * - Head and tail live on separate cache lines; each side keeps a cached copy of the
+ *   other side's index so the shared atomics are only touched when the cache looks full/empty.
+ *
+ * @tparam T Element type (must be default-constructible and movable).
+ * @tparam Capacity Number of slots. Must be a power of two.
+ */
+template <typename T, size_t Capacity> class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+  SpscQueue() = default;
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  /**
+   * @brief Enqueues a value (producer thread only).
+   * @return False if the queue is full; the value is left untouched in that case.
+   */
+  bool push(T &&value) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tailCache_ == Capacity) {
+      tailCache_ = tail_.load(std::memory_order_acquire);
+      if (head - tailCache_ == Capacity)
+        return false;
+    }
+    buffer_[head & Mask] = std::move(value);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool push(const T &value) {
+    T copy = value;
+    return push(std::move(copy));
+  }
+
+  /**
+   * @brief Dequeues the oldest value (consumer thread only).
+   * @param out Receives the value.
+   * @return False if the queue is empty.
+   */
+  bool pop(T &out) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == headCache_) {
+      headCache_ = head_.load(std::memory_order_acquire);
+      if (tail == headCache_)
+        return false;
+    }
+    out = std::move(buffer_[tail & Mask]);
+    buffer_[tail & Mask] = T{}; // Release resources (e.g. shared_ptr) held by the slot
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Approximate number of queued elements. Exact only when both threads are idle.
+   */
+  size_t sizeApprox() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  static constexpr size_t Mask = Capacity - 1;
+  static constexpr size_t CacheLine = 64;
+
+  alignas(CacheLine) std::atomic<size_t> head_{0}; ///< Next slot to write (owned by producer).
+  size_t tailCache_ = 0;                           ///< Producer's view of tail_.
+
+  alignas(CacheLine) std::atomic<size_t> tail_{0}; ///< Next slot to read (owned by consumer).
+  size_t headCache_ = 0;                           ///< Consumer's view of head_.
+
+  alignas(CacheLine) std::array<T, Capacity> buffer_{};
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file TelemetryRing.hpp
+ * @brief Shared-memory ring of simulation frames for external viewer processes.
+ *
+ * This header and TelemetryRing.cpp have no dependencies beyond the standard library and POSIX,
+ * so viewers can link the small `parklogic_telemetry` library instead of the whole simulation.
+ */
+
+/**
+ * @struct TelemetryCar
+ * @brief One car in a telemetry frame. Plain data, identical in memory for writer and reader.
+ */
+struct TelemetryCar {
+  uint32_t id;
+  float x;        ///< World position in meters.
+  float y;
+  float rotation; ///< Degrees.
+  float battery;  ///< 0-100.
+  uint8_t state;  ///< Car::CarState.
+  uint8_t type;   ///< Car::CarType.
+  uint16_t reserved;
+};
+static_assert(sizeof(TelemetryCar) == 24, "TelemetryCar is part of the shared-memory layout");
+
+/**
+ * @struct TelemetryFrame
+ * @brief Decoded contents of one ring slot.
+ */
+struct TelemetryFrame {
+  uint64_t frame = 0; ///< Sequence number, 1 for the first frame written.
+  uint64_t tick = 0;
+  double simTime = 0.0;
+  uint64_t totalSpawned = 0;
+  uint64_t totalExited = 0;
+  uint64_t totalPassedThrough = 0;
+  bool truncated = false;     ///< More cars existed than the segment has room for.
+  std::vector<TelemetryCar> cars;
+  std::vector<uint8_t> spots; ///< SpotState per spot, facilities in generation order.
+};
+
+/**
+ * @namespace TelemetryLayout
+ * @brief Versioned layout of the shared-memory segment.
+ *
+ * [Header][Slot 0][Slot 1]...[Slot N-1], each slot = [SlotHeader][TelemetryCar x maxCars][uint8_t x maxSpots],
+ * padded to 64 bytes. Every slot is guarded by its own seqlock: the writer makes `sequence` odd, writes, then
+ * makes it even again; a reader retries if it saw an odd value or the value changed while it copied.
+ */
+namespace TelemetryLayout {
+constexpr uint32_t MAGIC = 0x52544C50; ///< "PLTR"
+constexpr uint32_t VERSION = 1;        ///< Bump on any layout change.
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t slotCount;
+  uint32_t slotSize; ///< Bytes per slot, including padding.
+  uint32_t maxCars;
+  uint32_t maxSpots;
+  alignas(64) std::atomic<uint64_t> framesWritten; ///< Frame number of the newest complete frame.
+};
+
+struct SlotHeader {
+  std::atomic<uint64_t> sequence; ///< Seqlock; odd while the slot is being written.
+  uint64_t frame;
+  uint64_t tick;
+  double simTime;
+  uint64_t totalSpawned;
+  uint64_t totalExited;
+  uint64_t totalPassedThrough;
+  uint32_t carCount;
+  uint32_t spotCount;
+  uint32_t flags; ///< Bit 0: car list truncated.
+  uint32_t reserved;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlock counters must be lock-free in shared memory");
+
+constexpr size_t HeaderSize() { return (sizeof(Header) + 63) & ~size_t(63); }
+constexpr size_t SlotSize(uint32_t maxCars, uint32_t maxSpots) {
+  return (sizeof(SlotHeader) + maxCars * sizeof(TelemetryCar) + maxSpots + 63) & ~size_t(63);
+}
+} // namespace TelemetryLayout
+
+/**
+ * @class TelemetryRingWriter
+ * @brief Creates the segment and appends frames (single writer, wait-free).
+ */
+class TelemetryRingWriter {
+public:
+  /**
+   * @brief Creates (or replaces) the POSIX shared-memory object @p name, e.g. "/parklogic".
+   * @return nullptr if shared memory is unavailable or the segment cannot be created.
+   */
+  static std::unique_ptr<TelemetryRingWriter> Create(const std::string &name, uint32_t slotCount, uint32_t maxCars,
+                                                     uint32_t maxSpots);
+  ~TelemetryRingWriter(); ///< Unmaps and unlinks the segment.
+
+  TelemetryRingWriter(const TelemetryRingWriter &) = delete;
+  TelemetryRingWriter &operator=(const TelemetryRingWriter &) = delete;
+
+  /**
+   * @brief Writes @p frame into the next slot. frame.frame is ignored and assigned here.
+   */
+  void write(const TelemetryFrame &frame);
+
+  const std::string &getName() const { return name; }
+
+private:
+  TelemetryRingWriter(std::string name, void *base, size_t size);
+
+  std::string name;
+  void *base;
+  size_t size;
+  uint64_t nextFrame = 1;
+};
+
+/**
+ * @class TelemetryRingReader
+ * @brief Read-only view of a segment created by TelemetryRingWriter. Never blocks the writer.
+ */
+class TelemetryRingReader {
+public:
+  /**
+   * @return nullptr if the segment does not exist or has an incompatible version.
+   */
+  static std::unique_ptr<TelemetryRingReader> Open(const std::string &name);
+  ~TelemetryRingReader();
+
+  TelemetryRingReader(const TelemetryRingReader &) = delete;
+  TelemetryRingReader &operator=(const TelemetryRingReader &) = delete;
+
+  /**
+   * @brief Frame number of the newest complete frame (0 = none yet).
+   */
+  uint64_t latestFrame() const;
+
+  /**
+   * @brief Copies the newest frame.
+   * @return False if nothing has been written yet or the writer kept overtaking the copy.
+   */
+  bool readLatest(TelemetryFrame &out) const;
+
+  /**
+   * @brief Copies frame number @p frame.
+   * @return False if it is not written yet or has already been overwritten.
+   */
+  bool read(uint64_t frame, TelemetryFrame &out) const;
+
+  uint32_t getSlotCount() const;
+
+private:
+  TelemetryRingReader(void *base, size_t size);
+
+  void *base;
+  size_t size;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file TrajectoryFormat.hpp
+ * @brief On-disk layout and column codec of ParkLogic trajectory files (.pltraj).
+ *
+ * File = [FileHeader][Chunk]...[Chunk][ChunkIndexEntry x N][Trailer]
+ * Chunk = [ChunkHeader][column 0 data][column 1 data]... (each column 8-byte aligned)
+ *
+ * The writer sorts the rows of a chunk by (car, tick), so consecutive rows mostly follow one car
+ * and their deltas stay small. Every column of a chunk is encoded independently: the first value is
+ * stored in the column header, the rest as zig-zag deltas bit-packed at the width that packs the
+ * chunk tightest. Deltas too wide for it (typically where the rows switch to the next car) are
+ * written as an escape code, all ones at that width, followed by the full 64-bit delta.
+ * Column offsets are absolute, so a reader that memory-maps the file can decode one column of
+ * the chunks overlapping a tick range without touching any other bytes. If the trailer is missing
+ * (the writer did not shut down cleanly), chunks can still be found by walking the chunk headers.
+ */
+
+/**
+ * @enum TrajectoryColumn
+ * @brief Columns of a trajectory file. All values are stored as integers; see TrajectoryFormat::SCALE.
+ */
+enum class TrajectoryColumn : uint32_t {
+  TICK,           ///< Simulation tick of the sample.
+  CAR_ID,         ///< Car::getId().
+  X,              ///< Millimeters.
+  Y,              ///< Millimeters.
+  VX,             ///< Millimeters per second.
+  VY,             ///< Millimeters per second.
+  STATE,          ///< Car::CarState.
+  WAYPOINT_INDEX, ///< Car::getWaypointIndex().
+  BATTERY,        ///< Hundredths of a percent.
+  COUNT
+};
+
+namespace TrajectoryFormat {
+constexpr size_t COLUMN_COUNT = static_cast<size_t>(TrajectoryColumn::COUNT);
+constexpr uint64_t FILE_MAGIC = 0x31304A4152544C50ULL; ///< "PLTRAJ01"
+constexpr uint32_t CHUNK_MAGIC = 0x4B4E4843;           ///< "CHNK"
+constexpr uint32_t TRAILER_MAGIC = 0x45525450;         ///< "PTRE"
+constexpr uint32_t VERSION = 2; ///< 2: rows sorted by car, escaped wide deltas.
+
+/**
+ * @brief Multiply a stored integer by this to get the value in natural units (seconds are not stored).
+ */
+constexpr std::array<double, COLUMN_COUNT> SCALE = {1.0, 1.0, 0.001, 0.001, 0.001, 0.001, 1.0, 1.0, 0.01};
+
+struct FileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t columnCount;
+  double tickRate;      ///< Ticks per simulated second.
+  uint32_t sampleEvery; ///< Ticks between samples.
+  uint32_t reserved[9];
+};
+static_assert(sizeof(FileHeader) == 64);
+
+struct ColumnHeader {
+  uint64_t offset;   ///< Absolute file offset of the packed deltas.
+  uint32_t byteSize; ///< Size of the packed deltas.
+  uint8_t bitWidth;  ///< Bits per delta (0 = all deltas are zero), not counting escaped deltas.
+  uint8_t reserved[3];
+  int64_t first; ///< Value of the first row.
+};
+static_assert(sizeof(ColumnHeader) == 24);
+
+struct ChunkHeader {
+  uint32_t magic;
+  uint32_t rowCount;
+  uint64_t firstTick;
+  uint64_t lastTick;
+  ColumnHeader columns[COLUMN_COUNT];
+};
+
+struct ChunkIndexEntry {
+  uint64_t offset; ///< Absolute offset of the ChunkHeader.
+  uint64_t firstTick;
+  uint64_t lastTick;
+  uint32_t rowCount;
+  uint32_t reserved;
+};
+
+struct Trailer {
+  uint64_t indexOffset;
+  uint32_t chunkCount;
+  uint32_t magic;
+};
+
+/**
+ * @brief Delta + zig-zag + bit-pack @p values (all but the first, which goes in the header).
+ *
+ * The width minimizes the packed size, counting 64 extra bits for every delta that needs an escape.
+ * @param header Receives first, bitWidth and byteSize (offset is left to the caller).
+ * @param out Packed 64-bit words are appended here.
+ */
+void EncodeColumn(const std::vector<int64_t> &values, ColumnHeader &header, std::vector<uint64_t> &out);
+
+/**
+ * @brief Inverse of EncodeColumn.
+ * @param data Start of the packed words (header.offset into the file).
+ * @param rowCount Rows in the chunk.
+ * @param out Decoded values are appended here. Never reads past header.byteSize; if the data ends
+ *            early, the last decoded value is repeated for the remaining rows.
+ */
+void DecodeColumn(const ColumnHeader &header, const uint64_t *data, uint32_t rowCount, std::vector<int64_t> &out);
+} // namespace TrajectoryFormat
@@ -0,0 +1,69 @@
+#pragma once
+#include "core/MappedFile.hpp"
+#include "core/TrajectoryFormat.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class TrajectoryReader
+ * @brief Memory-mapped, read-only access to a .pltraj file.
+ *
+ * Opening only parses the header and the chunk index; column data is decoded on demand, one
+ * chunk and one column at a time, so the cost of a query is proportional to what it touches.
+ * The reader is immutable after Open() and can be shared by several threads. Every chunk is checked
+ * against the file bounds when it is listed, so a damaged file loses chunks instead of being read
+ * out of bounds.
+ */
+class TrajectoryReader {
+public:
+  /**
+   * @return nullptr if the file cannot be mapped or is not a trajectory file.
+   */
+  static std::unique_ptr<TrajectoryReader> Open(const std::string &path);
+  TrajectoryReader(const TrajectoryReader &) = delete;
+  TrajectoryReader &operator=(const TrajectoryReader &) = delete;
+
+  const TrajectoryFormat::FileHeader &getHeader() const { return *header; }
+  const std::vector<TrajectoryFormat::ChunkIndexEntry> &getChunks() const { return chunks; }
+  const MappedFile &getFile() const { return *file; }
+
+  /**
+   * @brief Whether the index was rebuilt by scanning because the file has no trailer.
+   */
+  bool wasRecovered() const { return recovered; }
+
+  /**
+   * @brief Decodes one column of one chunk (raw integers; multiply by TrajectoryFormat::SCALE).
+   * @param out Values are appended.
+   */
+  void decodeColumn(size_t chunk, TrajectoryColumn column, std::vector<int64_t> &out) const;
+
+  /**
+   * @brief Decodes @p column for all rows with firstTick <= tick <= lastTick.
+   *
+   * Values come chunk by chunk, in (car, tick) order within each chunk.
+   * @param ticks If not null, receives the matching tick of every value.
+   */
+  void readColumn(TrajectoryColumn column, uint64_t firstTick, uint64_t lastTick, std::vector<int64_t> &out,
+                  std::vector<int64_t> *ticks = nullptr) const;
+
+private:
+  explicit TrajectoryReader(std::unique_ptr<MappedFile> file);
+  bool loadIndex();
+  void scanChunks();
+  /**
+   * @brief Validates the chunk at @p offset against the file bounds, so decoding it cannot read outside the file.
+   * @return One past its last column byte, or 0 if it is damaged or truncated.
+   */
+  size_t checkChunk(uint64_t offset) const;
+
+  std::unique_ptr<MappedFile> file;
+  const unsigned char *data;
+  size_t size;
+  const TrajectoryFormat::FileHeader *header = nullptr;
+  std::vector<TrajectoryFormat::ChunkIndexEntry> chunks;
+  bool recovered = false;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include "core/TrajectoryFormat.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct TrajectoryRow
+ * @brief One car at one sampled tick, in natural units (quantized on encode).
+ */
+struct TrajectoryRow {
+  uint64_t tick;
+  uint32_t carId;
+  float x, y;   ///< Meters.
+  float vx, vy; ///< Meters per second.
+  uint8_t state;
+  uint32_t waypointIndex;
+  float battery; ///< 0-100.
+};
+
+/**
+ * @class TrajectoryWriter
+ * @brief Appends TrajectoryRows to a .pltraj file, encoding and writing chunks on a background thread.
+ *
+ * The simulation thread only copies rows into the current chunk buffer; full chunks are handed
+ * to the worker, which quantizes, delta/bit-packs each column and writes it. At most
+ * MAX_PENDING_CHUNKS wait for the worker, so memory stays bounded if the disk falls behind
+ * (the simulation then waits instead of dropping data).
+ */
+class TrajectoryWriter {
+public:
+  static constexpr size_t MAX_PENDING_CHUNKS = 4;
+
+  /**
+   * @param path Output file (truncated).
+   * @param tickRate Ticks per simulated second, stored in the header.
+   * @param sampleEvery Ticks between samples, stored in the header.
+   * @param rowsPerChunk Rows per chunk; larger chunks compress better, smaller ones seek finer.
+   * @return nullptr if the file cannot be created.
+   */
+  static std::unique_ptr<TrajectoryWriter> Open(const std::string &path, double tickRate, uint32_t sampleEvery,
+                                                uint32_t rowsPerChunk = 65536);
+
+  /**
+   * @brief Writes the pending rows and the chunk index, then closes the file.
+   */
+  ~TrajectoryWriter();
+
+  TrajectoryWriter(const TrajectoryWriter &) = delete;
+  TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+  /**
+   * @brief Adds a row (simulation thread only). Rows must be appended in non-decreasing tick order.
+   */
+  void append(const TrajectoryRow &row);
+
+  /**
+   * @brief Hands the partially filled chunk to the worker.
+   */
+  void flush();
+
+  uint64_t getRowsWritten() const { return rowsAppended; }
+
+private:
+  TrajectoryWriter(std::FILE *file, uint32_t rowsPerChunk);
+  void run();
+  void writeChunk(std::vector<TrajectoryRow> &rows); ///< Sorts @p rows by (car, tick) first.
+
+  std::FILE *file;
+  uint32_t rowsPerChunk;
+  std::vector<TrajectoryRow> current;
+  uint64_t rowsAppended = 0;
+
+  // Handoff to the worker
+  std::mutex queueMutex;
+  std::condition_variable queueSignal;
+  std::deque<std::vector<TrajectoryRow>> pending;
+  bool stopping = false;
+  std::thread worker;
+
+  // Worker-thread state
+  uint64_t fileOffset = sizeof(TrajectoryFormat::FileHeader);
+  std::vector<TrajectoryFormat::ChunkIndexEntry> index;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include "core/LatencyHistogram.hpp"
+#include "entities/Car.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+/**
+ * @file TripLatencies.hpp
+ * @brief Per-trip duration distributions split by car type and priority.
+ */
+
+/**
+ * @enum TripMetric
+ * @brief Durations recorded once per trip.
+ */
+enum class TripMetric : size_t {
+  TIME_TO_PARK,   ///< Spawn until PARKED.
+  SEARCH,         ///< Spawn until ALIGNING (driving to the chosen spot).
+  ALIGNING,       ///< ALIGNING until PARKED.
+  DWELL,          ///< PARKED until EXITING.
+  CHARGE_PER_KWH, ///< Seconds parked at a charger per kWh delivered (electric cars only).
+  EXIT,           ///< EXITING until the car leaves the map (cars that parked only).
+  COUNT
+};
+
+constexpr size_t TRIP_METRIC_COUNT = static_cast<size_t>(TripMetric::COUNT);
+
+/**
+ * @struct TripLatencySummary
+ * @brief p50/p95/p99 per metric over all car types and priorities; cheap to copy into snapshots.
+ */
+struct TripLatencySummary {
+  struct Quantiles {
+    uint64_t count = 0;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+  };
+  std::array<Quantiles, TRIP_METRIC_COUNT> metrics{};
+
+  const Quantiles &operator[](TripMetric m) const { return metrics[static_cast<size_t>(m)]; }
+};
+
+/**
+ * @class TripLatencies
+ * @brief One LatencyHistogram per TripMetric x CarType x Priority.
+ *
+ * Memory is fixed (24 histograms) regardless of run length. Instances from parallel or
+ * consecutive runs combine with merge(), including ones re-read from a bucket export.
+ */
+class TripLatencies {
+public:
+  static constexpr size_t CAR_TYPE_COUNT = 2; ///< Number of Car::CarType values.
+  static constexpr size_t PRIORITY_COUNT = 2; ///< Number of Car::Priority values.
+
+  void record(TripMetric metric, Car::CarType type, Car::Priority priority, double seconds) {
+    at(metric, type, priority).record(seconds);
+  }
+
+  LatencyHistogram &at(TripMetric metric, Car::CarType type, Car::Priority priority) {
+    return histograms[Index(metric, (size_t)type, (size_t)priority)];
+  }
+  const LatencyHistogram &at(TripMetric metric, Car::CarType type, Car::Priority priority) const {
+    return histograms[Index(metric, (size_t)type, (size_t)priority)];
+  }
+
+  /**
+   * @brief All car types and priorities of @p metric combined.
+   */
+  LatencyHistogram combined(TripMetric metric) const;
+
+  void merge(const TripLatencies &other);
+
+  TripLatencySummary summarize() const;
+
+  /**
+   * @brief CSV with count, mean, p50, p95, p99 and max per metric, car type and priority.
+   */
+  void writeSummaryCsv(std::ostream &out) const;
+
+  /**
+   * @brief CSV of all non-empty buckets; readBucketsCsv() on the output reproduces the distributions.
+   */
+  void writeBucketsCsv(std::ostream &out) const;
+
+  /**
+   * @brief Adds the buckets of a writeBucketsCsv() export to this instance.
+   * @return False if the input is not a bucket export.
+   */
+  bool readBucketsCsv(std::istream &in);
+
+  /**
+   * @brief Writes "<prefix>_latency.csv" (summary) and "<prefix>_latency_buckets.csv" (mergeable).
+   * @return False if a file could not be written.
+   */
+  bool exportCsv(const std::string &prefix) const;
+
+  static const char *MetricName(TripMetric metric);
+
+private:
+  static size_t Index(TripMetric metric, size_t type, size_t priority) {
+    return ((size_t)metric * CAR_TYPE_COUNT + type) * PRIORITY_COUNT + priority;
+  }
+
+  std::array<LatencyHistogram, TRIP_METRIC_COUNT * CAR_TYPE_COUNT * PRIORITY_COUNT> histograms{};
+};
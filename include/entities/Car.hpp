@@ -1,9 +1,14 @@
 #pragma once
+#include "config.hpp"
+#include "core/AssetManager.hpp"
 #include "entities/Entity.hpp"
 #include "raylib.h"
+#include <cstdint>
 #include <deque>
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 class World;
@@ -42,9 +47,9 @@ public:
    * @brief Updates the car's state with awareness of other cars.
    *
    * @param dt Delta time in seconds.
-   * @param cars Pointer to the list of other cars for collision avoidance.
+   * @param neighbors Cars to avoid (may include this one), as chosen by LaneIndex::appendNeighbors().
    */
-  void updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>> *cars = nullptr);
+  void updateWithNeighbors(double dt, std::span<const Car *const> neighbors = {});
 
   /**
    * @brief Draws the car and its debug info (waypoints, velocity).
@@ -53,14 +58,52 @@ public:
   void draw(bool showPath);
   void draw() override { draw(false); }
 
+  /**
+   * @brief Draws a car sprite centered at a position.
+   *
+   * Shared by Car::draw and the render thread, which only has snapshot data.
+   * @param position Center of the car in meters.
+   * @param rotation Sprite rotation in degrees.
+   * @param texture Handle of the car variant's texture.
+   */
+  static void drawSprite(Vector2 position, float rotation, TextureHandle texture);
+
+  /**
+   * @brief Size of the car sprite in meters (17x31 art pixels).
+   */
+  static Vector2 getSpriteSize() {
+    return {17.0f / static_cast<float>(Config::ART_PIXELS_PER_METER),
+            31.0f / static_cast<float>(Config::ART_PIXELS_PER_METER)};
+  }
+
   // --- State Management ---
   enum class CarState { DRIVING, ALIGNING, PARKED, EXITING };
 
+  /**
+   * @brief Stable identifier assigned by the EntityManager (0 = unassigned).
+   *
+   * Used instead of raw pointers whenever a car is referenced across threads.
+   */
+  uint32_t getId() const { return id; }
+  void setId(uint32_t newId) { id = newId; }
+
   bool isSelected() const { return selected; }
   void setSelected(bool s) { selected = s; }
 
   CarState getState() const { return state; }
-  void setState(CarState newState) { state = newState; }
+  void setState(CarState newState) {
+    if (newState != state) {
+      state = newState;
+      stateChanged = true;
+    }
+  }
+
+  /**
+   * @brief Returns true once after any state change, then resets.
+   *
+   * Lets EntityManager publish CarStateChangedEvent without Car knowing about the EventBus.
+   */
+  bool consumeStateChange() { return std::exchange(stateChanged, false); }
 
   /**
    * @brief Adds a waypoint to the car's path.
@@ -84,6 +127,21 @@ public:
   Vector2 getPosition() const { return position; }
   Vector2 getVelocity() const { return velocity; }
   void setVelocity(Vector2 v) { velocity = v; }
+  float getRotation() const { return currentRotation; }
+  /**
+   * @brief Unit vector the car is driving along: its velocity, or its sprite heading while (nearly) stopped.
+   */
+  Vector2 getHeading() const;
+  /**
+   * @brief How far ahead (meters) the car reacts to other cars; grows with speed.
+   */
+  float getLookAheadDistance() const;
+  TextureHandle getTexture() const { return texture; }
+  const std::deque<Waypoint> &getWaypoints() const { return waypoints; }
+  /**
+   * @brief Number of waypoints of the current path already reached.
+   */
+  uint32_t getWaypointIndex() const { return waypointIndex; }
 
   bool isReadyToLeave() const { return state == CarState::PARKED && parkingTimer <= 0.0f; }
 
@@ -102,6 +160,7 @@ private:
   Vector2 acceleration;
 
   CarState state = CarState::DRIVING;
+  bool stateChanged = false;
   float parkingTimer = 0.0f;
   float targetRotation = 0.0f;
   float currentRotation = 0.0f; // degrees, for smooth rendering
@@ -114,6 +173,7 @@ private:
   float maxForce;
 
   std::deque<Waypoint> waypoints;
+  uint32_t waypointIndex = 0; ///< Waypoints reached since the last setPath()/clearWaypoints().
 
   /**
    * @brief Applies a force to the car's acceleration.
@@ -133,7 +193,7 @@ private:
    * @param wp The target waypoint.
    */
   void seek(const Waypoint &wp);
-  std::string textureName;
+  TextureHandle texture; ///< Resolved once in the constructor.
 
   // New Members for Traffic Overhaul
 public:
@@ -162,4 +222,5 @@ private:
   float batteryLevel = 100.0f;                     // 0-100%
   float parkingDuration = 0.0f;                    // Assigned when parking starts
   bool selected = false;
+  uint32_t id = 0;
 };
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file ContractionHierarchy.hpp
+ * @brief Shortest-path index over a RoadGraph for fast route queries on large maps.
+ */
+#include "entities/map/RoadGraph.hpp"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @class ContractionHierarchy
+ * @brief Contraction hierarchy over the lane graph.
+ *
+ * Preprocessing contracts the nodes one at a time in order of importance, adding a shortcut arc
+ * wherever removing a node would lengthen a shortest path between its neighbours. A query is a
+ * bidirectional Dijkstra that only ever climbs to more important nodes, so it settles a few
+ * hundred nodes where A* on a large city settles tens of thousands. Shortcuts remember the two
+ * arcs they replace and are expanded back into lane nodes before the route is returned.
+ *
+ * Immutable after Build()/Load(); queries keep their state in the caller's RoadGraph::SearchScratch.
+ */
+class ContractionHierarchy {
+public:
+  /**
+   * @brief Contracts every node of @p graph.
+   */
+  static std::shared_ptr<const ContractionHierarchy> Build(const RoadGraph &graph);
+
+  /**
+   * @brief Reads a hierarchy written by save().
+   * @return nullptr if the file is missing, malformed or was built for a different graph.
+   */
+  static std::shared_ptr<const ContractionHierarchy> Load(const std::string &path, const RoadGraph &graph);
+
+  /**
+   * @brief Writes the hierarchy to a .plch file.
+   * @return False on I/O failure.
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * @brief Same contract as RoadGraph::findRoute().
+   */
+  bool findRoute(uint32_t start, std::span<const uint32_t> goals, RoadGraph::SearchScratch &scratch,
+                 std::vector<uint32_t> &route) const;
+
+  size_t getNodeCount() const { return rank.size(); }
+  size_t getArcCount() const { return arcs.size(); }
+  uint64_t getFingerprint() const { return fingerprint; }
+
+  static constexpr uint32_t NO_ARC = UINT32_MAX;
+
+private:
+  /**
+   * @struct Arc
+   * @brief Original lane edge, or a shortcut standing for the arcs @c first then @c second.
+   */
+  struct Arc {
+    uint32_t from;
+    uint32_t to;
+    float length;
+    uint32_t first;  ///< NO_ARC for an original edge.
+    uint32_t second; ///< NO_ARC for an original edge.
+  };
+
+  /**
+   * @brief Arc in a search graph, with its far end and length copied out for locality.
+   */
+  struct SearchArc {
+    uint32_t node;
+    float length;
+    uint32_t arc;
+  };
+
+  /**
+   * @brief Rebuilds the upward/downward search graphs from @c rank and @c arcs.
+   */
+  void buildSearchGraphs();
+
+  std::vector<uint32_t> rank; ///< Contraction order; queries only move to higher ranks.
+  std::vector<Arc> arcs;
+  uint64_t fingerprint = 0; ///< RoadGraph::getFingerprint() of the source graph.
+
+  std::vector<uint32_t> upFirst;   ///< CSR offsets into upArcs.
+  std::vector<SearchArc> upArcs;   ///< Forward search: arcs to higher-ranked nodes.
+  std::vector<uint32_t> downFirst; ///< CSR offsets into downArcs.
+  std::vector<SearchArc> downArcs; ///< Backward search: arcs from higher-ranked nodes, reversed.
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file DistanceMatrix.hpp
+ * @brief Road distances from route sources to every facility, filled in one row at a time.
+ */
+#include "entities/map/Modules.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class DistanceMatrix
+ * @brief Table of shortest road distances from source nodes (map entries, facility exits) to facilities.
+ *
+ * Columns are the facilities that hang off an entrance road, in module order. A facility's distance
+ * is the shorter one to the two lane nodes where its road's facilities join (the facility "gates").
+ * Rows are keyed by graph node and computed on first use with one early-exit Dijkstra search over
+ * all gates. The graph and the facilities never change while the simulation runs, so a row stays
+ * valid once computed; addRows() can fill the known sources (the map entries) up front.
+ *
+ * Storage is one row-major float array, so choosing a facility is a scan over a contiguous row
+ * (or a single lookup when the column is known) instead of a route search per candidate.
+ */
+class DistanceMatrix {
+public:
+  static constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+  /**
+   * @brief Sets the columns for @p modules and drops all rows. @p graph must outlive this object.
+   */
+  void reset(const RoadGraph &graph, const std::vector<std::unique_ptr<Module>> &modules);
+
+  /**
+   * @brief Distances from @p source to every column, computed now if this is the first request.
+   * @return Empty span if @p source is not a node of the graph. Valid until the next new row.
+   */
+  std::span<const float> getRow(uint32_t source);
+
+  /**
+   * @brief Computes the rows of all @p sources that do not have one yet.
+   */
+  void addRows(std::span<const uint32_t> sources);
+
+  /**
+   * @brief Column of @p facility, or -1 if it has none (no entrance road).
+   */
+  int getColumn(const Module *facility) const;
+
+  const std::vector<const Module *> &getFacilities() const { return facilities; }
+  size_t getRowCount() const { return rows.size(); }
+  size_t getColumnCount() const { return facilities.size(); }
+
+private:
+  const RoadGraph *graph = nullptr;
+  std::vector<const Module *> facilities;                 ///< Column order.
+  std::unordered_map<const Module *, uint32_t> columns;   ///< Facility -> column.
+  std::vector<uint32_t> gates;                            ///< Distinct gate nodes of all facility roads.
+  std::vector<std::pair<uint32_t, uint32_t>> columnGates; ///< Per column: its two indices into gates.
+  std::unordered_map<uint32_t, uint32_t> rows;            ///< Source node -> row.
+  std::vector<float> distances;                           ///< Row-major, rows x columns.
+  std::vector<float> gateDistances;                       ///< Reused per row: distance to each gate.
+  RoadGraph::SearchScratch scratch;
+};
@@ -4,10 +4,15 @@
  * @file Modules.hpp
  * @brief Defines the building blocks of the game map (Roads, Parking, Charging).
  */
+#include "core/AssetManager.hpp"
 #include "entities/map/Waypoint.hpp"
 #include "raylib.h"
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
+class SpotRegistry;
+
 /**
  * @struct AttachmentPoint
  * @brief Defines a connection point on a module.
@@ -107,14 +112,49 @@ public:
   // --- Spot Management ---
   int getRandomSpotIndex() const;
   Spot getSpot(int index) const;
-  void setSpotState(int index, SpotState state);
+  /**
+   * @brief Changes a spot's state and keeps the per-facility counters in sync.
+   * @return The previous state (FREE for an invalid index).
+   */
+  SpotState setSpotState(int index, SpotState state);
+  /**
+   * @brief Reserves a spot only if it is free; atomic while bound to a SpotRegistry.
+   * @return True if this call reserved it.
+   */
+  bool tryReserveSpot(int index);
+  /**
+   * @brief Index of the cheapest free spot (the first one on ties), or -1 if none is free.
+   */
+  int getCheapestFreeSpotIndex() const;
+
+  /**
+   * @brief Moves spot state and prices into @p registry, starting at global spot id @p firstSpot.
+   * Called by SpotRegistry::rebuild().
+   */
+  void bindSpots(SpotRegistry *registry, uint32_t firstSpot);
+  /**
+   * @brief Copies spot state and prices back from the registry. Called by SpotRegistry::clear().
+   */
+  void unbindSpots();
+  const SpotRegistry *getSpotRegistry() const { return registry; }
+  /**
+   * @brief Global spot id of @p index in the bound registry.
+   */
+  uint32_t getRegistrySpot(int index) const { return registryFirstSpot + (uint32_t)index; }
 
   struct SpotCounts {
     int free;
     int reserved;
     int occupied;
   };
-  SpotCounts getSpotCounts() const;
+  /**
+   * @brief Spot counts by state, maintained incrementally by setSpotState() (O(1)).
+   */
+  SpotCounts getSpotCounts() const {
+    int reserved = reservedCount.load(std::memory_order_relaxed);
+    int occupied = occupiedCount.load(std::memory_order_relaxed);
+    return {(int)spots.size() - reserved - occupied, reserved, occupied};
+  }
   float getOccupancyPercentage() const;
   size_t getSpotCount() const { return spots.size(); }
 
@@ -124,13 +164,29 @@ public:
   virtual ModuleType getType() const { return ModuleType::GENERIC; }
 
 protected:
+  /**
+   * @brief Draws @ref texture stretched over the module's footprint.
+   */
+  void drawTexture() const;
+
   float width;
   float height;
   float priceMultiplier = 1.0f;
+  TextureHandle texture; ///< Sprite, resolved once by the subclass constructor.
   std::vector<AttachmentPoint> attachmentPoints;
   std::vector<Waypoint> localWaypoints;
-  std::vector<Spot> spots;
+  std::vector<Spot> spots; ///< Spots are always added FREE; state changes go through setSpotState().
+  std::atomic<int> reservedCount = 0;
+  std::atomic<int> occupiedCount = 0;
   Module *parent = nullptr;
+  SpotRegistry *registry = nullptr; ///< While set, spot states and prices live there, not in spots.
+  uint32_t registryFirstSpot = 0;
+
+private:
+  friend class SpotRegistry; // Keeps the counters in sync with its atomic state changes
+
+  SpotState getSpotState(int index) const;
+  void countStateChange(SpotState previous, SpotState state);
 };
 
 // --- Roads ---
@@ -159,6 +215,22 @@ public:
   void draw() const override;
 };
 
+/**
+ * @class CrossStreet
+ * @brief Vertical street linking two road rows of a city grid.
+ *
+ * Drawn with the horizontal road sprite turned by 90 degrees, tiled along its length.
+ * Attaches with its top edge to the row above and its bottom edge to the row below.
+ */
+class CrossStreet : public Module {
+public:
+  /**
+   * @param length Distance between the two rows it connects (meters).
+   */
+  explicit CrossStreet(float length);
+  void draw() const override;
+};
+
 // --- Facilities ---
 
 class SmallParking : public Module {
@@ -0,0 +1,214 @@
+#pragma once
+
+/**
+ * @file RoadGraph.hpp
+ * @brief Directed lane graph of the road network, built once from the generated modules.
+ */
+#include "entities/map/Modules.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ContractionHierarchy;
+
+/**
+ * @class RoadGraph
+ * @brief Lane-level road network with A* routing.
+ *
+ * Nodes sit on lane center lines wherever something joins a road: facility entrances, cross-street
+ * junctions and the open ends of each road. Every road contributes one lane per driving direction
+ * (horizontal roads: east on the DOWN lane, west on the UP lane; cross streets: south and north).
+ * Edges run along lanes between consecutive nodes and turn between lanes at junctions; their
+ * weight is the straight-line length in meters.
+ *
+ * Storage is contiguous: node positions in one array, edges in compressed sparse row form, and the
+ * nodes of each lane numbered consecutively in driving order so a position can be snapped to its
+ * lane with a binary search.
+ *
+ * The graph is immutable after Build(). Searches keep all mutable state in a caller-owned
+ * SearchScratch, so one graph can serve any number of threads. An optional ContractionHierarchy
+ * can be attached once after Build(); findRoute() then answers from it instead of running A*.
+ */
+class RoadGraph {
+public:
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+  static constexpr uint32_t NO_EDGE = UINT32_MAX;
+
+  /**
+   * @struct Endpoint
+   * @brief Open end of a lane where cars enter or leave the map.
+   */
+  struct Endpoint {
+    uint32_t node = NO_NODE;
+    Vector2 direction = {0, 0}; ///< Driving direction at the node (unit vector).
+  };
+
+  /**
+   * @struct SearchScratch
+   * @brief Reusable working memory for findRoute().
+   *
+   * Sized to the graph on first use and never shrunk. Per-node entries are invalidated by bumping
+   * a generation counter, so a search costs O(nodes visited), not O(graph).
+   */
+  struct SearchScratch {
+    std::vector<float> cost;                      ///< Best known distance from the start.
+    std::vector<uint32_t> parent;                 ///< Predecessor on the best known route.
+    std::vector<uint32_t> visited;                ///< Generation in which cost/parent were last written.
+    std::vector<uint32_t> closed;                 ///< Generation in which the node was settled.
+    std::vector<uint32_t> goal;                   ///< Generation in which the node was marked as a goal.
+    std::vector<std::pair<float, uint32_t>> heap; ///< Open set as a binary min-heap on (f, node).
+    uint32_t generation = 0;
+    size_t lastSettled = 0; ///< Nodes settled by the most recent search (for diagnostics/benchmarks).
+
+    // Backward half of a bidirectional hierarchy query (the forward half reuses the fields above)
+    std::vector<float> costBack;
+    std::vector<uint32_t> parentBack;
+    std::vector<uint32_t> visitedBack;
+    std::vector<std::pair<float, uint32_t>> heapBack;
+    std::vector<uint32_t> unpack; ///< Shortcut expansion stack.
+  };
+
+  /**
+   * @brief Builds the graph from the world's modules.
+   *
+   * Horizontal roads (left + right attachments) that touch end to end form one road; cross streets
+   * (up + down attachments only) join the roads whose edges their ends touch.
+   */
+  static RoadGraph Build(const std::vector<std::unique_ptr<Module>> &modules);
+
+  size_t getNodeCount() const { return positions.size(); }
+  size_t getEdgeCount() const { return edgeTargets.size(); }
+  Vector2 getNodePosition(uint32_t node) const { return positions[node]; }
+
+  /**
+   * @brief Outgoing edges of @p node as indices into getEdgeTarget()/getEdgeLength().
+   */
+  std::pair<uint32_t, uint32_t> getEdgeRange(uint32_t node) const { return {firstEdge[node], firstEdge[node + 1]}; }
+  uint32_t getEdgeTarget(uint32_t edge) const { return edgeTargets[edge]; }
+  float getEdgeLength(uint32_t edge) const { return edgeLengths[edge]; }
+  std::span<const float> getEdgeLengths() const { return edgeLengths; }
+
+  /**
+   * @brief Edge from @p from to @p to, or NO_EDGE.
+   */
+  uint32_t findEdge(uint32_t from, uint32_t to) const;
+
+  const std::vector<Endpoint> &getEntries() const { return entries; }
+  const std::vector<Endpoint> &getExits() const { return exits; }
+
+  /**
+   * @brief First node at or ahead of @p position on the lane the car is driving on.
+   * @param heading Driving direction; only lanes pointing the same way are considered.
+   * @return NO_NODE if the position is not on any lane.
+   */
+  uint32_t findNodeAhead(Vector2 position, Vector2 heading) const;
+
+  // --- Lanes (one per road and driving direction, indexed 0 .. getLaneCount()) ---
+  static constexpr uint32_t NO_LANE = UINT32_MAX;
+  size_t getLaneCount() const { return lanes.size(); }
+  /**
+   * @brief Unit vector along @p lane; a position's progress along the lane is its dot product with it.
+   */
+  Vector2 getLaneDirection(uint32_t lane) const { return lanes[lane].direction; }
+  /**
+   * @brief Nodes of @p lane as [first, end), in driving order.
+   */
+  std::pair<uint32_t, uint32_t> getLaneNodes(uint32_t lane) const {
+    return {lanes[lane].firstNode, lanes[lane].firstNode + lanes[lane].nodeCount};
+  }
+  /**
+   * @brief Lane @p node lies on, or NO_LANE.
+   */
+  uint32_t getNodeLane(uint32_t node) const;
+  /**
+   * @brief Whether a car at @p position driving along @p heading (a unit vector) is on @p lane.
+   */
+  bool isOnLane(uint32_t lane, Vector2 position, Vector2 heading) const;
+  /**
+   * @brief Lane a car at @p position driving along @p heading is on, or NO_LANE (e.g. inside a facility).
+   */
+  uint32_t findLane(Vector2 position, Vector2 heading) const;
+
+  /**
+   * @brief Nodes where the facilities of an entrance road join it.
+   * @return {eastbound node, westbound node}, or {NO_NODE, NO_NODE} if @p road is not an entrance.
+   */
+  std::pair<uint32_t, uint32_t> getEntranceNodes(const Module *road) const;
+
+  /**
+   * @brief Shortest route from @p start to the nearest of @p goals.
+   *
+   * Uses the attached contraction hierarchy if there is one, otherwise findRouteAStar().
+   * @param route Receives the node sequence, start and goal included (cleared first).
+   * @return False if no goal is reachable.
+   */
+  bool findRoute(uint32_t start, std::span<const uint32_t> goals, SearchScratch &scratch,
+                 std::vector<uint32_t> &route) const;
+
+  /**
+   * @brief A* search over the plain graph; same contract as findRoute().
+   */
+  bool findRouteAStar(uint32_t start, std::span<const uint32_t> goals, SearchScratch &scratch,
+                      std::vector<uint32_t> &route) const;
+
+  /**
+   * @brief A* search with caller-supplied edge costs, e.g. live travel times.
+   * @param edgeCosts One non-negative cost per edge.
+   * @param minCostPerMeter Lower bound of cost / edge length over all edges; scales the heuristic.
+   */
+  bool findRouteWeighted(uint32_t start, std::span<const uint32_t> goals, std::span<const float> edgeCosts,
+                         float minCostPerMeter, SearchScratch &scratch, std::vector<uint32_t> &route) const;
+
+  /**
+   * @brief Shortest distances (meters) from @p start to each of @p targets, by one Dijkstra search.
+   *
+   * The search stops once every target is settled, so nearby targets are cheap.
+   * @param distances Receives one distance per target (infinity if unreachable); same size as @p targets.
+   */
+  void findDistances(uint32_t start, std::span<const uint32_t> targets, SearchScratch &scratch,
+                     std::span<float> distances) const;
+
+  /**
+   * @brief Length (meters) of @p route, a node sequence as returned by findRoute().
+   */
+  float getRouteLength(std::span<const uint32_t> route) const;
+
+  /**
+   * @brief Attaches a hierarchy built from (or loaded for) this graph. nullptr detaches.
+   */
+  void setHierarchy(std::shared_ptr<const ContractionHierarchy> ch) { hierarchy = std::move(ch); }
+  const ContractionHierarchy *getHierarchy() const { return hierarchy.get(); }
+
+  /**
+   * @brief Hash of the node positions and edges; identifies a graph across runs.
+   */
+  uint64_t getFingerprint() const;
+
+private:
+  /**
+   * @brief One driving direction of a road: nodes [firstNode, firstNode + nodeCount) in driving order.
+   */
+  struct LaneRun {
+    Vector2 direction; ///< Unit vector along the lane.
+    float offset;      ///< Fixed coordinate: y for horizontal lanes, x for vertical ones.
+    uint32_t firstNode;
+    uint32_t nodeCount;
+  };
+
+  std::vector<Vector2> positions;
+  std::vector<uint32_t> firstEdge; ///< CSR row offsets, size nodes + 1.
+  std::vector<uint32_t> edgeTargets;
+  std::vector<float> edgeLengths;
+
+  std::vector<LaneRun> lanes;
+  std::vector<std::pair<float, uint32_t>> rowLanes;    ///< (offset, lane) of horizontal lanes, by offset.
+  std::vector<std::pair<float, uint32_t>> columnLanes; ///< (offset, lane) of vertical lanes, by offset.
+  std::vector<Endpoint> entries;
+  std::vector<Endpoint> exits;
+  std::unordered_map<const Module *, std::pair<uint32_t, uint32_t>> entranceNodes;
+  std::shared_ptr<const ContractionHierarchy> hierarchy;
+};
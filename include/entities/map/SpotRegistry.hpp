@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file SpotRegistry.hpp
+ * @brief City-wide table of all spots in structure-of-arrays form, with lock-free reservation.
+ */
+#include "entities/map/Modules.hpp"
+#include "raylib.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SpotRegistry
+ * @brief Every spot of every facility in flat arrays, one per field, indexed by a global spot id.
+ *
+ * Facilities are laid out parking first, then charging, each facility's spots contiguous, so
+ * "all parking spots" or "the spots of this facility" is a plain index range and finding the
+ * cheapest free spot is a linear scan over two dense arrays.
+ *
+ * Positions, orientations and facility ids are fixed once the table is built. Spot states are
+ * atomics: tryReserve() claims a free spot with a compare-and-swap, so planners on several threads
+ * can reserve spots without a lock and without two of them getting the same one. Prices (a fixed
+ * base price and the current, dynamically priced one) are only written on the simulation thread.
+ *
+ * Modules bound by rebuild() read and write their spot states and prices here; unbound modules
+ * (e.g. in tests) keep using their own Spot vector.
+ */
+class SpotRegistry {
+public:
+  static constexpr uint32_t NO_SPOT = std::numeric_limits<uint32_t>::max();
+
+  SpotRegistry() = default;
+  SpotRegistry(const SpotRegistry &) = delete;
+  SpotRegistry &operator=(const SpotRegistry &) = delete;
+  ~SpotRegistry();
+
+  /**
+   * @brief Rebuilds the table from the facilities in @p modules and binds them to it.
+   *
+   * Spot states and prices are taken over from the modules. Modules must outlive the binding
+   * (until the next rebuild() or clear()).
+   */
+  void rebuild(const std::vector<std::unique_ptr<Module>> &modules);
+
+  /**
+   * @brief Unbinds all facilities (their current states and prices are written back) and empties the table.
+   */
+  void clear();
+
+  uint32_t size() const { return (uint32_t)facility.size(); }
+
+  // --- Fields (spot id -> value) ---
+  Module *getFacility(uint32_t spot) const { return facilities[facility[spot]]; }
+  Vector2 getPosition(uint32_t spot) const { return {positionX[spot], positionY[spot]}; }
+  float getOrientation(uint32_t spot) const { return orientation[spot]; }
+  float getPrice(uint32_t spot) const { return price[spot]; }
+  float getBasePrice(uint32_t spot) const { return basePrice[spot]; }
+  /**
+   * @brief Sets a spot's base (list) price; its current price starts over from it.
+   */
+  void setPrice(uint32_t spot, float value) {
+    basePrice[spot] = price[spot] = value;
+    ++priceVersion;
+  }
+  /**
+   * @brief Sets the current prices of facility @p index to its base prices times @p factor.
+   */
+  void applyPriceFactor(uint32_t index, float factor);
+  /**
+   * @brief Current prices of all spots, indexed by spot id.
+   */
+  std::span<const float> getPrices() const { return price; }
+  /**
+   * @brief Changes whenever any price (or the table) changes, so copies can be reused until then.
+   */
+  uint64_t getPriceVersion() const { return priceVersion; }
+  SpotState getState(uint32_t spot) const { return (SpotState)states[spot].load(std::memory_order_acquire); }
+
+  // --- State changes (safe from any thread) ---
+  /**
+   * @brief Claims @p spot if it is free. The facility's spot counts follow.
+   * @return True if this call moved it from FREE to RESERVED.
+   */
+  bool tryReserve(uint32_t spot);
+  /**
+   * @brief Sets the state unconditionally.
+   * @return The previous state.
+   */
+  SpotState exchange(uint32_t spot, SpotState state);
+
+  // --- Facilities (index -> module, in layout order) ---
+  static constexpr uint32_t NO_FACILITY = std::numeric_limits<uint32_t>::max();
+  const std::vector<Module *> &getFacilities() const { return facilities; }
+  /**
+   * @brief Index of @p module among getFacilities(), or NO_FACILITY if it is not bound here.
+   */
+  uint32_t getFacilityIndex(const Module *module) const;
+  std::pair<uint32_t, uint32_t> getFacilityRange(uint32_t index) const {
+    return {firstSpot[index], firstSpot[index + 1]};
+  }
+
+  // --- Ranges ---
+  /**
+   * @brief Spot ids [first, last) of all parking or all charging spots.
+   */
+  std::pair<uint32_t, uint32_t> getRange(bool charging) const;
+  /**
+   * @brief Spot ids [first, last) of @p module's spots; empty if it is not bound here.
+   */
+  std::pair<uint32_t, uint32_t> getRange(const Module *module) const;
+  /**
+   * @brief The cheapest spot in [first, last) that is free right now, or NO_SPOT.
+   *
+   * The result is a snapshot: reserve it with tryReserve(), which fails if another thread was faster.
+   */
+  uint32_t findCheapestFree(uint32_t first, uint32_t last) const;
+
+private:
+  std::vector<Module *> facilities;
+  std::vector<uint32_t> firstSpot; ///< Per facility, plus one past the end: its first spot id.
+  uint32_t chargingBegin = 0;      ///< First spot id of the charging facilities.
+
+  std::vector<uint32_t> facility; ///< Index into facilities.
+  std::vector<float> positionX;   ///< World position (meters).
+  std::vector<float> positionY;
+  std::vector<float> orientation;
+  std::vector<float> price;                       ///< Current price.
+  std::vector<float> basePrice;                   ///< List price set at creation; dynamic pricing scales it.
+  std::unique_ptr<std::atomic<uint8_t>[]> states; ///< SpotState values.
+  uint64_t priceVersion = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
+#include "core/AssetManager.hpp"
 #include "entities/Entity.hpp"
-#include <string>
+#include "raylib.h"
 #include <vector>
 
 /**
@@ -17,7 +18,16 @@ public:
 
   void update(double dt) override;
   void draw() override;
-  void drawOverlay(); // Draws grid and borders on top of entities
+  /**
+   * @brief Draws the world border on top of entities.
+   */
+  void drawOverlay();
+
+  /**
+   * @brief Draws only the background tiles that intersect a region.
+   * @param region Area in meters.
+   */
+  void drawTiles(Rectangle region) const;
 
   void setGridEnabled(bool enabled) { showGrid = enabled; }
   bool isGridEnabled() const { return showGrid; }
@@ -35,7 +45,7 @@ private:
 
   // Background
   std::vector<std::vector<int>> backgroundTiles; // Stores index of texture to use
-  std::vector<std::string> tileTextures;         // Texture names
+  std::vector<TextureHandle> tileTextures;       // Grass variants, resolved once
   float tileWidthMeter;
   float tileHeightMeter;
 };
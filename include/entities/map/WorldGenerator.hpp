@@ -23,6 +23,10 @@ struct GeneratedMap {
  * 2. Placement: Aligning them linearly with collision avoidance.
  * 3. Padding: Adding extra roads to fill the view.
  * 4. Normalization: Centering coordinates.
+ *
+ * With MapConfig::rows > 1 the facilities are laid out as a city grid instead: several road rows,
+ * joined by cross streets every Config::GRID_BLOCK_UNITS entrance units. Grid positions are
+ * computed in closed form from the unit index, so placement runs in parallel per row.
  */
 class WorldGenerator {
 public:
@@ -32,4 +36,10 @@ public:
    * @return A struct containing the World and Modules.
    */
   static GeneratedMap generate(const struct MapConfig &config);
+
+private:
+  /**
+   * @brief Multi-row city-grid layout (MapConfig::rows > 1).
+   */
+  static GeneratedMap generateGrid(const struct MapConfig &config);
 };
@@ -1,6 +1,9 @@
 #pragma once
 #include "entities/map/Waypoint.hpp"
 #include "raylib.h"
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 struct MapConfig {
@@ -8,6 +11,9 @@ struct MapConfig {
   int largeParkingCount = 1;
   int smallChargingCount = 1;
   int largeChargingCount = 0;
+  int rows = 1;               ///< Road rows. More than one selects the city-grid layout with cross streets.
+  bool routeIndex = false;    ///< Preprocess the road graph into a contraction hierarchy for faster routing.
+  std::string routeIndexPath; ///< Hierarchy cache file, loaded if it matches the map; empty = no cache.
 };
 
 struct AdaptiveSignalsConfig {
@@ -36,14 +42,32 @@ struct GameUpdateEvent {
 };
 
 struct BeginCameraEvent {};
+/**
+ * @brief Published by CameraSystem at the start of every camera pass.
+ */
+struct CameraViewEvent {
+  Rectangle visibleArea; ///< World area on screen, in meters.
+  float pixelsPerMeter;  ///< Logical screen pixels per meter at the current zoom.
+};
 struct EndCameraEvent {};
 struct DrawWorldEvent {};
+/**
+ * @brief Published once per frame before the window's render target is bound.
+ *
+ * Off-screen rendering (BeginTextureMode) is only safe here, since raylib texture modes cannot nest.
+ */
+struct PreRenderEvent {};
 
 struct GamePausedEvent {};
 struct GameResumedEvent {};
 
 struct ToggleDashboardEvent {};
 
+// Congestion heatmap controls: visibility is render-side, reset/decay go to the simulation
+struct ToggleHeatmapEvent {};
+struct ResetHeatmapEvent {};
+struct CycleHeatmapDecayEvent {};
+
 struct CameraZoomEvent {
   float zoomDelta;
 };
@@ -59,6 +83,13 @@ struct AutoSpawnLevelChangedEvent {
   int newLevel;
 };
 
+/**
+ * @brief Asks the simulation to write its metrics time series, trip latencies and heatmap grid to "<prefix>_*.csv".
+ */
+struct ExportMetricsEvent {
+  std::string prefix = "parklogic_metrics";
+};
+
 struct SpawnCarRequestEvent {};
 
 struct CreateCarEvent {
@@ -90,6 +121,21 @@ struct CarDeletedEvent {
   class Car *car;
 };
 
+// Published by EntityManager after a car's CarState changed (at most once per car per tick).
+struct CarStateChangedEvent {
+  class Car *car;
+};
+
+enum class SpotState; // Defined in entities/map/Modules.hpp
+
+// Published whenever a spot changes state (reservation, arrival, departure).
+struct SpotStateChangedEvent {
+  const class Module *facility;
+  int spotIndex;
+  SpotState previous;
+  SpotState current;
+};
+
 struct SimulationSpeedChangedEvent {
   double speedMultiplier;
 };
@@ -98,7 +144,12 @@ enum class SelectionType { NONE, CAR, FACILITY, SPOT, GENERAL };
 
 struct EntitySelectedEvent {
   SelectionType type = SelectionType::GENERAL;
-  class Car *car = nullptr;
-  class Module *module = nullptr;
+  uint32_t carId = 0;     // Car::getId(), 0 = none
+  int facilityIndex = -1; // Index into SnapshotLayout::facilities
   int spotIndex = -1;
 };
+
+// Published on the render-side bus whenever a newer simulation snapshot arrives.
+struct SnapshotUpdatedEvent {
+  std::shared_ptr<const struct SimulationSnapshot> snapshot;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "core/EventBus.hpp"
+#include "core/SimulationSnapshot.hpp"
 #include "events/GameEvents.hpp"
 #include "scenes/IScene.hpp"
 #include <memory>
@@ -7,6 +8,15 @@
 #include <vector>
 
 class TrackingSystem;
+
+/**
+ * @class GameScene
+ * @brief The parking simulation scene.
+ *
+ * The simulation itself runs on a SimulationThread; this scene lives on the render thread,
+ * forwards ticks and simulation-bound input events as commands, and republishes incoming
+ * snapshots on the render-side EventBus for the HUD, camera tracking and renderer.
+ */
 class GameScene : public IScene {
 public:
   explicit GameScene(std::shared_ptr<EventBus> bus, MapConfig config, AdaptiveSignalsConfig adaptiveConfig);
@@ -19,12 +29,14 @@ public:
 
 private:
   void handleInput();
-  std::unique_ptr<TrackingSystem> trackingSystem;
+  void pollSnapshot();
+
   std::shared_ptr<EventBus> eventBus;
+  std::unique_ptr<class SimulationThread> simulation; ///< Declared first so it is destroyed last.
   std::vector<Subscription> eventTokens;
 
-  std::unique_ptr<class EntityManager> entityManager;
-  std::unique_ptr<class TrafficSystem> trafficSystem;
+  std::unique_ptr<TrackingSystem> trackingSystem;
+  std::unique_ptr<class RenderSystem> renderSystem;
   std::unique_ptr<class GameHUD> gameHUD;
 
   std::unique_ptr<class CameraSystem> cameraSystem;
@@ -32,4 +44,6 @@ private:
   MapConfig config;
   AdaptiveSignalsConfig adaptiveConfig;
   std::set<int> keysDown;
+
+  std::shared_ptr<const SimulationSnapshot> snapshot; ///< Latest state received from the simulation.
 };
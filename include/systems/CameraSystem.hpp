@@ -43,6 +43,12 @@ public:
    */
   Camera2D getCamera() const { return camera; }
 
+  /**
+   * @brief Computes the world area currently on screen.
+   * @return Visible rectangle in Meters (logical resolution, no rotation).
+   */
+  Rectangle getVisibleWorldRect() const;
+
   // Setters for initial setup
   void setTarget(Vector2 target) { camera.target = target; }
   void setOffset(Vector2 offset) { camera.offset = offset; }
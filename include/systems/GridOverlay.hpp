@@ -0,0 +1,45 @@
+#pragma once
+#include "raylib.h"
+
+/**
+ * @class GridOverlay
+ * @brief Procedural meter grid drawn by a fragment shader over a single quad.
+ *
+ * Line spacing steps by powers of ten so cells never get smaller than
+ * Config::GRID_MIN_CELL_PIXELS on screen; the finer level fades out as it approaches that
+ * limit while the next coarser level stays visible. The cost is one quad at any map size or zoom.
+ *
+ * If the shader cannot be compiled, falls back to drawing clipped lines at the adaptive spacing.
+ */
+class GridOverlay {
+public:
+  GridOverlay() = default;
+  ~GridOverlay();
+
+  GridOverlay(const GridOverlay &) = delete;
+  GridOverlay &operator=(const GridOverlay &) = delete;
+
+  /**
+   * @brief Draws the grid. Must be called inside the world camera (meters).
+   * @param area Region to cover in meters (typically visible area clipped to the world).
+   * @param pixelsPerMeter Current on-screen scale.
+   */
+  void draw(Rectangle area, float pixelsPerMeter);
+
+  /**
+   * @brief Finest grid spacing (meters, a power of ten >= 1) whose cells are at least
+   * Config::GRID_MIN_CELL_PIXELS wide at @p pixelsPerMeter.
+   */
+  static float selectSpacing(float pixelsPerMeter);
+
+private:
+  bool ensureShader();
+  void drawLines(Rectangle area, float spacing, Color color) const;
+
+  Shader shader = {0, nullptr};
+  bool loadAttempted = false;
+  bool shaderReady = false;
+  int spacingLoc = -1;
+  int pixelsPerMeterLoc = -1;
+  int lineColorLoc = -1;
+};
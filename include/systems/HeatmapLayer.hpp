@@ -0,0 +1,39 @@
+#pragma once
+#include "core/HeatmapGrid.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class HeatmapLayer
+ * @brief Draws a HeatmapGrid as one bilinear-filtered texture stretched over the world.
+ *
+ * The texture has one texel per grid cell and is only re-uploaded when a grid with a new version
+ * arrives (at most a few times per simulated second), so drawing costs a single quad per frame.
+ */
+class HeatmapLayer {
+public:
+  HeatmapLayer() = default;
+  ~HeatmapLayer();
+
+  HeatmapLayer(const HeatmapLayer &) = delete;
+  HeatmapLayer &operator=(const HeatmapLayer &) = delete;
+
+  /**
+   * @brief Draws the grid, uploading it first if it changed. Must be called inside the world camera (meters).
+   */
+  void draw(const HeatmapGrid &grid);
+
+  /**
+   * @brief Color of a cell holding @p value when the scale saturates at @p scale (fully transparent for 0).
+   */
+  static Color ColorFor(float value, float scale);
+
+private:
+  void upload(const HeatmapGrid &grid);
+  void unload();
+
+  Texture2D texture = {0, 0, 0, 0, 0};
+  uint64_t uploadedVersion = 0;
+  std::vector<Color> pixels; ///< Staging buffer, reused between uploads.
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include "config.hpp"
+#include "core/EventBus.hpp"
+#include "core/HeatmapGrid.hpp"
+#include "entities/Car.hpp"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class HeatmapSystem
+ * @brief Accumulates where cars queue into a coarse world grid.
+ *
+ * Every tick, each car that is not parked and slower than Config::HEATMAP_SLOW_SPEED adds its dwell
+ * time to the cell under it, so the cost is O(active cars). Exponential decay is applied lazily: new
+ * time is added with a weight that grows at the decay rate, and the stored values are rescaled only
+ * when that weight gets large (or the half-life changes). Nothing is touched per cell per tick.
+ *
+ * Lives on the simulation thread; getGrid() hands an immutable copy to the render thread, rebuilt
+ * at most every Config::HEATMAP_PUBLISH_INTERVAL simulated seconds and only if something changed.
+ */
+class HeatmapSystem {
+public:
+  /**
+   * @param bus Simulation bus (WorldBoundsEvent, ResetHeatmapEvent, CycleHeatmapDecayEvent).
+   */
+  explicit HeatmapSystem(std::shared_ptr<EventBus> bus, float cellSize = Config::HEATMAP_CELL_SIZE);
+  ~HeatmapSystem();
+
+  /**
+   * @brief Accumulates one tick of queuing cars.
+   * @param simTime Simulated time at the end of the tick.
+   */
+  void update(double simTime, double dt, const std::vector<std::unique_ptr<Car>> &cars);
+
+  /**
+   * @brief Adds @p seconds of queuing at a world position (outside the world it is ignored).
+   */
+  void addDwell(Vector2 position, double seconds);
+
+  /**
+   * @brief Clears the grid and sizes it for a world of the given size in meters.
+   */
+  void resize(float worldWidth, float worldHeight);
+  void reset();
+
+  /**
+   * @brief Sets the decay half-life in simulated seconds (0 = keep everything).
+   */
+  void setHalfLife(double seconds);
+  double getHalfLife() const { return halfLife; }
+
+  /**
+   * @brief Current (decayed) value of a cell.
+   */
+  float valueAt(int cellX, int cellY) const;
+
+  /**
+   * @brief Latest published grid (never null).
+   */
+  std::shared_ptr<const HeatmapGrid> getGrid();
+
+  /**
+   * @brief Writes the raw grid as "x,y,slow_seconds" (cell corner in meters), non-empty cells only.
+   *
+   * The columns match `parklogic_analyze`'s heatmap output, so live and offline grids can be compared.
+   */
+  void writeCsv(std::ostream &out) const;
+
+  /**
+   * @brief Writes `<prefix>_heatmap_grid.csv`.
+   */
+  bool exportCsv(const std::string &prefix) const;
+
+private:
+  void setTime(double simTime);
+  void renormalize();
+
+  std::shared_ptr<EventBus> eventBus;
+  std::vector<Subscription> eventTokens;
+
+  float cellSize;
+  int width = 0;
+  int height = 0;
+  std::vector<float> cells; ///< Values scaled by `gain`.
+
+  double halfLife = Config::HEATMAP_HALF_LIFE;
+  double now = 0.0;
+  double epoch = 0.0; ///< Time at which gain was 1.
+  double gain = 1.0;  ///< Weight of newly added time, 2^((now - epoch) / halfLife).
+
+  bool dirty = true;
+  double lastPublish = -1.0;
+  uint64_t version = 0;
+  std::shared_ptr<const HeatmapGrid> published;
+};
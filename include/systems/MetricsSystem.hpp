@@ -0,0 +1,40 @@
+#pragma once
+#include "core/EntityManager.hpp"
+#include "core/MetricsStore.hpp"
+#include <cstdint>
+
+class StatsSystem;
+
+/**
+ * @class MetricsSystem
+ * @brief Samples the simulation into a MetricsStore at a fixed simulated-time cadence.
+ *
+ * Occupancy and car counts come from StatsSystem in O(1); rates are derived from the change
+ * of its cumulative counters since the previous sample. Only the average battery level needs
+ * a pass over the cars, once per sample rather than once per tick.
+ */
+class MetricsSystem {
+public:
+  MetricsSystem(const EntityManager &entityManager, const StatsSystem &statsSystem, const MetricsConfig &config);
+
+  /**
+   * @brief Records a sample if at least one sample interval has passed since the last one.
+   * @param simTime Current simulated time in seconds.
+   */
+  void update(double simTime);
+
+  const MetricsStore &getStore() const { return store; }
+
+private:
+  void sample(double simTime);
+
+  const EntityManager &entityManager;
+  const StatsSystem &statsSystem;
+  MetricsStore store;
+
+  double nextSampleTime;
+  double lastSampleTime = 0.0;
+  uint64_t lastSpawned = 0;
+  uint64_t lastExited = 0;
+  uint64_t lastPassedThrough = 0;
+};
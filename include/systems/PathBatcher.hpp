@@ -0,0 +1,104 @@
+#pragma once
+#include "core/JobPool.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include "entities/map/Waypoint.hpp"
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file PathBatcher.hpp
+ * @brief Plans car paths in batches on worker threads.
+ */
+
+/**
+ * @struct PathRequest
+ * @brief Everything needed to plan one car's path, copied so it can be solved off the simulation thread.
+ */
+struct PathRequest {
+  enum class Kind { PARK, EXIT };
+
+  Kind kind = Kind::PARK;
+  Car *car = nullptr; ///< Receives the path when it is applied; the workers never touch it.
+  uint32_t carId = 0;
+  Vector2 position = {0, 0};        ///< Car position when the request was made.
+  Vector2 velocity = {0, 0};        ///< Car velocity when the request was made.
+  const Module *facility = nullptr; ///< Facility to park in (PARK) or to leave (EXIT).
+  Spot spot;                        ///< Spot to park in or to leave.
+  int spotIndex = -1;
+  bool exitRight = false; ///< EXIT: leave towards the east.
+  float finalX = 0.0f;    ///< EXIT: map edge to drive to when there is no graph route.
+};
+
+/**
+ * @struct PlannedPath
+ * @brief A solved PathRequest.
+ */
+struct PlannedPath {
+  PathRequest request;
+  std::vector<Waypoint> path;
+  std::vector<uint32_t> route; ///< Graph route of a PARK path (empty for exits or without one).
+};
+
+/**
+ * @class PathBatcher
+ * @brief Queues path requests and solves each tick's requests as one batch on a JobPool.
+ *
+ * The simulation thread enqueue()s requests while a tick runs and dispatch()es them at its end.
+ * The workers then plan while the rest of the frame (and the next tick's car movement) runs;
+ * collect() at the start of the next tick waits for the batch and hands back the paths in
+ * request order. Paths therefore always take effect exactly one tick after they were requested,
+ * however many threads solved them or how long they took, so seeded runs stay reproducible.
+ *
+ * The road graph and the modules are immutable while the simulation runs, and each worker has its
+ * own search scratch, so the only per-request state the workers read is the request itself.
+ */
+class PathBatcher {
+public:
+  explicit PathBatcher(unsigned threads = JobPool::DefaultThreadCount());
+
+  /**
+   * @brief Queues a request for the next dispatch(). A car has at most one request pending.
+   */
+  void enqueue(const PathRequest &request);
+
+  /**
+   * @brief Starts solving everything queued since the last dispatch. Call collect() first.
+   * @param graph Road network to route through; must stay valid until collect() returns.
+   */
+  void dispatch(const RoadGraph &graph);
+
+  /**
+   * @brief Waits for the dispatched batch.
+   * @return Its paths in request order, without cancelled ones. Valid until the next collect().
+   */
+  std::vector<PlannedPath> &collect();
+
+  /**
+   * @brief Drops any pending request of a car (e.g. because it was deleted).
+   */
+  void cancel(uint32_t carId);
+
+  /**
+   * @brief Waits for the running batch and drops everything pending.
+   */
+  void clear();
+
+  bool isPending(uint32_t carId) const { return pendingCars.contains(carId); }
+  size_t getQueuedCount() const { return queued.size(); }
+  uint64_t getBatchCount() const { return batchCount; }
+  unsigned getThreadCount() const { return pool.getThreadCount(); }
+
+private:
+  JobPool pool;
+  std::vector<RoadGraph::SearchScratch> scratches; ///< One per worker.
+  std::vector<PathRequest> queued;                 ///< Requested since the last dispatch().
+  std::vector<PlannedPath> inFlight;               ///< Being solved; each job fills its own entry.
+  std::vector<PlannedPath> ready;                  ///< Returned by collect().
+  std::unordered_set<uint32_t> pendingCars;        ///< Cars with a queued or in-flight request.
+  std::unordered_set<uint32_t> cancelled;          ///< In-flight requests to drop on collect().
+  bool running = false;
+  uint64_t batchCount = 0;
+};
@@ -7,6 +7,7 @@
 #include "config.hpp"
 #include "entities/Car.hpp"
 #include "entities/map/Modules.hpp"
+#include "entities/map/RoadGraph.hpp"
 #include "entities/map/Waypoint.hpp"
 #include <vector>
 
@@ -18,18 +19,76 @@ public:
    * @param car The car entity (used for velocity/state).
    * @param targetFac The target facility module.
    * @param targetSpot The specific spot within the facility.
+   * @param graph Road network to route through. Without one (or if no route exists) the car is
+   *              assumed to already drive on the facility's road.
+   * @param scratch Search buffers for @p graph; required whenever @p graph is given.
+   * @param route If given, receives the graph route the path follows (empty if there is none).
    * @return std::vector<Waypoint> The ordered list of waypoints.
    */
-  static std::vector<Waypoint> GeneratePath(const Car *car, const Module *targetFac, const Spot &targetSpot);
+  static std::vector<Waypoint> GeneratePath(const Car *car, const Module *targetFac, const Spot &targetSpot,
+                                            const RoadGraph *graph = nullptr,
+                                            RoadGraph::SearchScratch *scratch = nullptr,
+                                            std::vector<uint32_t> *route = nullptr);
+
+  /**
+   * @brief GeneratePath() from a copy of the car's kinematics.
+   *
+   * Reads nothing but its arguments, the modules' geometry and the graph, so worker threads can
+   * call it (each with its own @p scratch) while the simulation moves the car.
+   */
+  static std::vector<Waypoint> GeneratePath(Vector2 position, Vector2 velocity, const Module *targetFac,
+                                            const Spot &targetSpot, const RoadGraph *graph,
+                                            RoadGraph::SearchScratch *scratch, std::vector<uint32_t> *route);
+
+  /**
+   * @brief Like GeneratePath(), but follows a route the caller already found.
+   * @param startPos Where the car is now.
+   * @param route Graph nodes from ahead of the car to one of the facility road's entrance nodes.
+   */
+  static std::vector<Waypoint> GeneratePathAlong(Vector2 startPos, const Module *targetFac, const Spot &targetSpot,
+                                                 const RoadGraph &graph, const std::vector<uint32_t> &route);
 
   /**
    * @brief Constructs a path for a car to leave the facility and map.
-   * @param finalX The X coordinate (in Meters) where the car should exit the map.
+   * @param exitRight Leave through the nearest eastbound exit (otherwise westbound).
+   * @param finalX The X coordinate (in Meters) where the car should exit the map when there is no graph route.
    */
   static std::vector<Waypoint> GenerateExitPath(const Car *car, const Module *currentFac, const Spot &currentSpot,
-                                                bool exitRight, float finalX);
+                                                bool exitRight, float finalX, const RoadGraph *graph = nullptr,
+                                                RoadGraph::SearchScratch *scratch = nullptr);
+
+  /**
+   * @brief GenerateExitPath() from a copy of the car's position; safe on worker threads like GeneratePath().
+   */
+  static std::vector<Waypoint> GenerateExitPath(Vector2 position, const Module *currentFac, const Spot &currentSpot,
+                                                bool exitRight, float finalX, const RoadGraph *graph,
+                                                RoadGraph::SearchScratch *scratch);
 
 private:
+  /**
+   * @brief Turns a graph route into the points where the car has to change direction.
+   *
+   * Runs of collinear nodes collapse into their end points; the route's last node is left out
+   * because the caller replaces it with its own final approach.
+   *
+   * @param from Where the car starts (it drives straight to the first node).
+   * @return Corner positions, each with the heading the car leaves it in.
+   */
+  static std::vector<Waypoint> RouteCorners(const RoadGraph &graph, const std::vector<uint32_t> &route, Vector2 from);
+
+  /**
+   * @brief Adds a straight drive to @p target at cruising speed, switching to APPROACH only for the
+   * last stretch so the car slows for the turn at its end and not before.
+   */
+  static void AddDrive(std::vector<Waypoint> &path, Vector2 startPos, Waypoint target);
+
+  /**
+   * @brief Appends the drive from the car's lane into the facility and onto the spot.
+   * @param mainRoadLane Lane of the facility's road the car arrives on.
+   */
+  static void AddFacilityApproach(std::vector<Waypoint> &path, Vector2 currentPos, const Module *targetFac,
+                                  const Spot &targetSpot, Lane mainRoadLane);
+
   /**
    * @brief Calculates the entry waypoint on the road leading to the facility.
    *
@@ -0,0 +1,90 @@
+#pragma once
+#include "config.hpp"
+#include "entities/map/SpotRegistry.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file PricingEngine.hpp
+ * @brief Demand-based spot prices, updated only where demand changed.
+ */
+
+/**
+ * @struct PricingRules
+ * @brief Tunables of the price rule; defaults come from Config.
+ */
+struct PricingRules {
+  double interval = Config::PRICING_INTERVAL;
+  double timeConstant = Config::PRICING_TIME_CONSTANT;
+  float targetOccupancy = Config::PRICING_TARGET_OCCUPANCY;
+  float occupancyGain = Config::PRICING_OCCUPANCY_GAIN;
+  float arrivalGain = Config::PRICING_ARRIVAL_GAIN;
+  float chargingGain = Config::PRICING_CHARGING_GAIN;
+  float minFactor = Config::PRICING_MIN_FACTOR;
+  float maxFactor = Config::PRICING_MAX_FACTOR;
+};
+
+/**
+ * @class PricingEngine
+ * @brief Scales each facility's spot prices by a factor that follows its demand.
+ *
+ * Every interval, a facility's target factor is
+ * `1 + occupancyGain * (occupancy - targetOccupancy) + arrivalGain * arrivals per minute per spot`,
+ * plus `chargingGain * share of spots charging a car` for charging stations, clamped to
+ * [minFactor, maxFactor]. The factor, like the arrival rate, moves toward its target by exponential
+ * smoothing, so prices drift instead of jumping. Full lots get dearer and idle ones cheaper, which
+ * spreads price-priority cars over the city.
+ *
+ * Updates are incremental: only facilities whose spots changed state since the last update, or whose
+ * factor has not settled yet, are visited. Each price change rewrites that facility's contiguous
+ * range of the SpotRegistry price array in one loop.
+ */
+class PricingEngine {
+public:
+  /**
+   * @brief Starts over for the facilities of @p registry, all at their base prices.
+   */
+  void reset(SpotRegistry &registry);
+
+  void setRules(const PricingRules &r) { rules = r; }
+  const PricingRules &getRules() const { return rules; }
+
+  /**
+   * @brief Records a spot state change; a FREE -> RESERVED change counts as an arrival.
+   */
+  void onSpotStateChanged(const Module *facility, SpotState previous, SpotState current);
+
+  /**
+   * @brief Re-prices the facilities that need it, at most once per rules.interval.
+   * @return Facilities whose prices changed. Valid until the next call.
+   */
+  const std::vector<Module *> &update(double simTime);
+
+  /**
+   * @brief Current price factor of @p facility (1 if it is not priced here).
+   */
+  float getFactor(const Module *facility) const;
+  size_t getActiveCount() const { return active.size(); }
+
+private:
+  /**
+   * @struct FacilityDemand
+   * @brief Pricing state of one facility, indexed like SpotRegistry::getFacilities().
+   */
+  struct FacilityDemand {
+    float factor = 1.0f;
+    float arrivalRate = 0.0f; ///< Smoothed arrivals per minute.
+    int arrivals = 0;         ///< Since lastUpdate.
+    double lastUpdate = 0.0;
+    bool active = false; ///< Listed in active.
+  };
+
+  void activate(uint32_t index);
+
+  SpotRegistry *registry = nullptr;
+  PricingRules rules;
+  std::vector<FacilityDemand> demand;
+  std::vector<uint32_t> active; ///< Facilities to visit at the next update.
+  std::vector<Module *> changed;
+  double lastRun = 0.0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "config.hpp"
+#include "core/EntityManager.hpp"
+#include "core/EventBus.hpp"
+#include "core/SimulationSnapshot.hpp"
+#include "core/SpatialGrid.hpp"
+#include "systems/GridOverlay.hpp"
+#include "systems/HeatmapLayer.hpp"
+#include "systems/SpriteBatch.hpp"
+#include "systems/StaticRenderLayer.hpp"
+#include <memory>
+#include <vector>
+
+/**
+ * @class RenderSystem
+ * @brief Draws the game world on the render thread.
+ *
+ * Static layout (World tiles, Modules) is read directly from the EntityManager since it
+ * never changes after generation, and is baked into a StaticRenderLayer whenever a new world
+ * is announced (WorldBoundsEvent). Everything dynamic (cars, paths) comes from the latest
+ * SimulationSnapshot, so drawing never races with the simulation thread.
+ *
+ * Everything is culled against the camera's visible area (CameraViewEvent).
+ */
+class RenderSystem {
+public:
+  /**
+   * @brief Constructs the RenderSystem.
+   * @param bus Render-side EventBus (DrawWorldEvent, SnapshotUpdatedEvent, UI events).
+   * @param entityManager Source of the static world layout.
+   */
+  RenderSystem(std::shared_ptr<EventBus> bus, const EntityManager &entityManager);
+  ~RenderSystem();
+
+  /**
+   * @brief Draws the world in order: World -> Modules -> Heatmap -> Cars -> Overlay -> Mask.
+   */
+  void draw();
+
+private:
+  /**
+   * @brief Car detail tiers, chosen per frame from the on-screen car size.
+   */
+  enum class CarLod {
+    MARKER,  ///< Colored quad, no texture.
+    SPRITE,  ///< Sprite snapped to quarter turns, path drawn as plain lines.
+    DETAILED ///< Fully rotated sprite, path with waypoint markers.
+  };
+  static CarLod selectCarLod(float pixelsPerMeter);
+
+  void drawCar(const CarSnapshot &car, bool showPath, CarLod lod);
+  void drawPath(const CarSnapshot &car, CarLod lod) const;
+  void rebuildModuleIndex(float worldWidth, float worldHeight);
+
+  std::shared_ptr<EventBus> eventBus;
+  std::vector<Subscription> eventTokens;
+
+  const EntityManager &entityManager;
+  std::shared_ptr<const SimulationSnapshot> snapshot;
+
+  Rectangle visibleArea = {-1e6f, -1e6f, 2e6f, 2e6f}; ///< Updated every frame by CameraViewEvent.
+  float pixelsPerMeter = Config::PPM;                 ///< Updated every frame by CameraViewEvent.
+  std::unique_ptr<SpatialGrid> moduleIndex;           ///< Module footprints, for culling the unbaked path.
+  std::vector<int> visibleModules;                    ///< Scratch buffer for moduleIndex queries.
+
+  SpriteBatch spriteBatch; ///< Car sprites, flushed once per frame.
+  StaticRenderLayer staticLayer;
+  GridOverlay gridOverlay;
+  HeatmapLayer heatmapLayer;
+  bool heatmapVisible = false;   ///< Toggled by ToggleHeatmapEvent.
+  bool staticLayerDirty = false; ///< Set when a new world is announced; baked on the next PreRenderEvent.
+
+  uint32_t selectedCarId = 0;
+  bool dashboardVisible = false;
+};
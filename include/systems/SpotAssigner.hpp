@@ -0,0 +1,177 @@
+#pragma once
+#include "config.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/DistanceMatrix.hpp"
+#include "entities/map/Modules.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file SpotAssigner.hpp
+ * @brief Assigns the cars that asked for a spot during a tick to free spots, all at once.
+ */
+
+/**
+ * @struct SpotRequest
+ * @brief A car looking for a spot, with what it cares about.
+ */
+struct SpotRequest {
+  Car *car = nullptr;
+  uint32_t carId = 0;
+  bool charging = false; ///< Wants a charging spot (otherwise a parking spot).
+  Car::Priority priority = Car::Priority::PRIORITY_PRICE;
+  Vector2 position = {0, 0};
+  Vector2 velocity = {0, 0};
+};
+
+/**
+ * @struct SpotAssignment
+ * @brief Outcome of one SpotRequest.
+ */
+struct SpotAssignment {
+  SpotRequest request;
+  Module *facility = nullptr; ///< nullptr: no spot worth taking; the car passes through.
+  int spotIndex = -1;
+};
+
+/**
+ * @class SpotAssigner
+ * @brief Min-cost matching of requesting cars to free spots, solved once per tick.
+ *
+ * A car's cost for a spot is its price for price-priority cars and the road distance to the
+ * facility (scaled to dollars) for distance-priority cars; passing through costs far more than
+ * any spot. To keep the problem small, each car only considers the cheapest free spots of its
+ * few best facilities. For price-priority cars those come from an index of facilities ordered by
+ * their cheapest free spot, kept current through refresh(), so finding them is O(log n).
+ *
+ * The matching is solved exactly with successive shortest paths: cars are added in request order,
+ * and each addition runs one Dijkstra search over reduced costs (Hungarian potentials) that may
+ * move earlier cars to other spots if that lowers the total cost. Passing through is a private
+ * option of every car, so each search ends. If the searches need more than
+ * Config::ASSIGNMENT_MAX_RELAXATIONS arc relaxations, the tick falls back to greedy assignment in
+ * request order. The budget counts work rather than time so seeded runs stay reproducible.
+ */
+class SpotAssigner {
+public:
+  /**
+   * @struct SolveStats
+   * @brief What the most recent solve() did.
+   */
+  struct SolveStats {
+    size_t cars = 0;
+    size_t spots = 0; ///< Distinct candidate spots.
+    size_t relaxations = 0;
+    size_t assigned = 0;
+    bool greedy = false; ///< The relaxation budget ran out.
+  };
+
+  /**
+   * @brief Collects the parking and charging facilities of a new world and forgets all requests.
+   */
+  void reset(const std::vector<std::unique_ptr<Module>> &modules);
+
+  void enqueue(const SpotRequest &request);
+  void cancel(uint32_t carId);
+
+  /**
+   * @brief Re-ranks @p facility in the price index; call after its spot states or prices changed.
+   */
+  void refresh(const Module *facility);
+
+  /**
+   * @brief Whether the world has any facility that could serve such a request.
+   */
+  bool hasFacilities(bool charging) const { return !(charging ? chargers : parkings).empty(); }
+
+  /**
+   * @brief Assigns every queued request and clears the queue.
+   * @param distances Road distances for distance-priority cars (rows are added as needed).
+   * @return One assignment per request, in request order. Valid until the next solve().
+   */
+  const std::vector<SpotAssignment> &solve(const RoadGraph &graph, DistanceMatrix &distances);
+
+  size_t getQueuedCount() const { return queued.size(); }
+  const SolveStats &getLastStats() const { return lastStats; }
+  uint64_t getGreedyFallbackCount() const { return greedyFallbacks; }
+
+  /**
+   * @brief Overrides the relaxation budget (Config::ASSIGNMENT_MAX_RELAXATIONS by default).
+   */
+  void setMaxRelaxations(size_t relaxations) { maxRelaxations = relaxations; }
+
+private:
+  /**
+   * @struct Candidate
+   * @brief A spot that is a candidate for at least one car this solve.
+   */
+  struct Candidate {
+    Module *facility;
+    int spotIndex;
+  };
+
+  /**
+   * @struct Arc
+   * @brief A car's option: a candidate spot or, past the candidates, its own pass-through column.
+   */
+  struct Arc {
+    uint32_t column;
+    float cost;
+  };
+
+  using PriceKey = std::pair<float, uint32_t>; ///< (cheapest free price, index into parkings/chargers).
+
+  /**
+   * @struct IndexEntry
+   * @brief Where a facility sits in the price index.
+   */
+  struct IndexEntry {
+    bool charging;
+    uint32_t position; ///< Index into parkings or chargers.
+    bool listed = false;
+    float price = 0.0f; ///< Key it is listed under.
+  };
+
+  void buildCandidates(const RoadGraph &graph, DistanceMatrix &distances);
+  const std::vector<int> &freeSpotsByPrice(Module *facility);
+  /**
+   * @brief Adds @p car to the matching along a shortest augmenting path.
+   * @return False if the relaxation budget ran out.
+   */
+  bool augment(uint32_t car);
+  void greedy();
+
+  std::vector<Module *> parkings;
+  std::vector<Module *> chargers;
+  std::vector<SpotRequest> queued;
+  std::array<std::set<PriceKey>, 2> priceIndex; ///< Per kind (parking, charging): facilities with a free spot.
+  std::unordered_map<const Module *, IndexEntry> indexEntries;
+
+  // Per-solve working memory, kept for its capacity
+  std::vector<Candidate> candidates;
+  std::unordered_map<uint64_t, uint32_t> candidateIndex;          ///< (facility, spot) -> candidate.
+  std::unordered_map<const Module *, std::vector<int>> freeSpots; ///< Free spot indices, cheapest first.
+  std::vector<std::pair<float, Module *>> facilityCosts;
+  std::vector<uint32_t> firstArc; ///< Per car: its arcs start here.
+  std::vector<Arc> arcs;
+  std::vector<int> carColumn;                          ///< Per car: matched column, or -1.
+  std::vector<int> columnCar;                          ///< Per column: matched car, or -1.
+  std::vector<double> carPotential;                    ///< Hungarian row potentials.
+  std::vector<double> columnPotential;                 ///< Hungarian column potentials.
+  std::vector<double> pathCost;                        ///< Per column: reduced cost from the searching car.
+  std::vector<uint8_t> columnSettled;                  ///< Per column: settled by the current search.
+  std::vector<uint32_t> reachedFrom;                   ///< Per column: car it was reached from.
+  std::vector<uint32_t> reached;                       ///< Columns touched by the current search.
+  std::vector<uint32_t> settled;                       ///< Columns settled by the current search.
+  std::vector<std::pair<double, uint32_t>> searchHeap; ///< (path cost, column).
+  std::vector<SpotAssignment> results;
+
+  size_t maxRelaxations = Config::ASSIGNMENT_MAX_RELAXATIONS;
+  SolveStats lastStats;
+  uint64_t greedyFallbacks = 0;
+};
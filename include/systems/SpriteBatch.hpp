@@ -0,0 +1,61 @@
+#pragma once
+#include "core/AssetManager.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SpriteBatch
+ * @brief Collects sprite draws for a frame and emits them grouped by layer and texture.
+ *
+ * raylib's internal batch flushes whenever the bound texture changes. Submissions are
+ * therefore sorted by (layer, texture) and written straight into rlgl as quads, which,
+ * combined with the sprite atlas, turns thousands of cars into a handful of draw calls.
+ *
+ * Within one (layer, texture) group the submission order is preserved.
+ */
+class SpriteBatch {
+public:
+  /**
+   * @brief Queues a sprite. Parameters mirror DrawTexturePro.
+   * @param sprite Texture handle; resolved through AssetManager::GetSpriteRegion (atlas aware).
+   * @param dest Destination rectangle; x/y is the pivot position.
+   * @param origin Pivot relative to the destination's top-left corner.
+   * @param rotation Degrees, clockwise.
+   * @param tint Color multiplier.
+   * @param layer Lower layers are drawn first.
+   */
+  void submit(TextureHandle sprite, Rectangle dest, Vector2 origin, float rotation, Color tint = WHITE,
+              int layer = 0);
+
+  /**
+   * @brief Queues an untextured, axis-aligned quad (drawn with rlgl's default white texture).
+   * @param dest Destination rectangle (top-left based).
+   * @param color Fill color.
+   * @param layer Lower layers are drawn first.
+   */
+  void submitRect(Rectangle dest, Color color, int layer = 0);
+
+  /**
+   * @brief Sorts and draws everything submitted since the last flush, then clears the queue.
+   * Must be called inside the same camera/texture mode the sprites were meant for.
+   */
+  void flush();
+
+  size_t size() const { return submissions.size(); }
+
+private:
+  struct Submission {
+    uint64_t sortKey; ///< (layer << 32) | texture id.
+    unsigned int textureId;
+    int textureWidth;
+    int textureHeight;
+    Rectangle source;
+    Rectangle dest;
+    Vector2 origin;
+    float rotation;
+    Color tint;
+  };
+
+  std::vector<Submission> submissions;
+};
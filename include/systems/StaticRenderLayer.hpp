@@ -0,0 +1,52 @@
+#pragma once
+#include "entities/map/Modules.hpp"
+#include "entities/map/World.hpp"
+#include "raylib.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @class StaticRenderLayer
+ * @brief Pre-rendered copy of everything that never moves (background tiles and module sprites).
+ *
+ * The world is split into chunks of at most Config::STATIC_LAYER_CHUNK_SIZE texture pixels.
+ * Each chunk is baked once at art resolution (Config::ART_PIXELS_PER_METER), so drawing the
+ * static world costs one textured quad per chunk regardless of how many tiles and modules it holds.
+ *
+ * bake() uses BeginTextureMode and must therefore be called outside of any other texture mode
+ * (see PreRenderEvent).
+ */
+class StaticRenderLayer {
+public:
+  StaticRenderLayer() = default;
+  ~StaticRenderLayer();
+
+  StaticRenderLayer(const StaticRenderLayer &) = delete;
+  StaticRenderLayer &operator=(const StaticRenderLayer &) = delete;
+
+  /**
+   * @brief Renders the world and modules into the chunk textures, replacing any previous bake.
+   * @return False if a render texture could not be created (the layer is left empty).
+   */
+  bool bake(const World &world, const std::vector<std::unique_ptr<Module>> &modules);
+
+  /**
+   * @brief Draws the baked chunks that intersect @p visibleArea. Must be called inside the world camera (meters).
+   */
+  void draw(Rectangle visibleArea) const;
+
+  /**
+   * @brief Releases all chunk textures.
+   */
+  void unload();
+
+  bool isBaked() const { return !chunks.empty(); }
+
+private:
+  struct Chunk {
+    RenderTexture2D target;
+    Rectangle bounds; ///< Area covered, in meters.
+  };
+
+  std::vector<Chunk> chunks;
+};
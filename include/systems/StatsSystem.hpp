@@ -0,0 +1,44 @@
+#pragma once
+#include "core/EntityManager.hpp"
+#include "core/EventBus.hpp"
+#include "core/SimulationStats.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class StatsSystem
+ * @brief Maintains SimulationStats incrementally from simulation events.
+ *
+ * Facility totals are built once per generated world (WorldBoundsEvent); after that every
+ * update is O(1) per event:
+ * - SpotStateChangedEvent moves one spot between free/reserved/occupied.
+ * - CarSpawnedEvent / CarStateChangedEvent / CarDeletedEvent keep per-state car counts.
+ *
+ * Lives on the simulation thread next to TrafficSystem; its stats are copied into every snapshot.
+ */
+class StatsSystem {
+public:
+  StatsSystem(std::shared_ptr<EventBus> bus, const EntityManager &entityManager);
+  ~StatsSystem();
+
+  const SimulationStats &getStats() const { return stats; }
+
+private:
+  void rebuildFacilities();
+  void moveCar(const Car *car, Car::CarState newState);
+
+  std::shared_ptr<EventBus> eventBus;
+  const EntityManager &entityManager;
+  std::vector<Subscription> eventTokens;
+
+  SimulationStats stats;
+  /**
+   * @brief How a live car is currently counted.
+   */
+  struct TrackedCar {
+    Car::CarState state;
+    bool visitedFacility = false; ///< Reached ALIGNING or PARKED at some point.
+  };
+  std::unordered_map<const Car *, TrackedCar> trackedCars;
+};
@@ -1,9 +1,16 @@
 #pragma once
 #include "core/EventBus.hpp"
-#include "entities/Car.hpp"
+#include "core/SimulationSnapshot.hpp"
 #include <memory>
 #include <vector>
 
+/**
+ * @class TrackingSystem
+ * @brief Follows a freshly spawned car with the camera.
+ *
+ * Runs on the render thread and only reads SimulationSnapshots; the target car
+ * is identified by id so it can never dangle when the simulation removes it.
+ */
 class TrackingSystem {
 public:
     explicit TrackingSystem(std::shared_ptr<EventBus> bus);
@@ -14,11 +21,13 @@ public:
 private:
     std::shared_ptr<EventBus> eventBus;
     std::vector<Subscription> eventTokens;
-    
-    Car* targetCar = nullptr;
+    std::shared_ptr<const SimulationSnapshot> snapshot;
+
+    uint32_t targetCarId = 0;
+    uint32_t spawnBaselineId = 0; ///< lastSpawnedCarId when tracking started.
     bool isTrackingActive = false;
     bool waitingForSpawn = false;
 
     void startTracking();
     void stopTracking();
-};
\ No newline at end of file
+};
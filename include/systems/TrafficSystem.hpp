@@ -1,7 +1,17 @@
 #pragma once
+#include "core/CongestionWeights.hpp"
 #include "core/EntityManager.hpp"
 #include "core/EventBus.hpp"
+#include "entities/map/DistanceMatrix.hpp"
+#include "systems/PathBatcher.hpp"
+#include "systems/PricingEngine.hpp"
+#include "systems/SpotAssigner.hpp"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 /**
@@ -10,8 +20,11 @@
  *
  * The TrafficSystem acts as the "Director" for the simulation. It handles:
  * - Spawning cars at intervals.
- * - Assigning parking spots and paths to cars.
+ * - Assigning parking spots to cars, all requests of a tick at once (see SpotAssigner).
+ * - Pricing spots by demand (see PricingEngine).
+ * - Planning the cars' paths in batches on worker threads (see PathBatcher).
  * - Monitoring car states (Parking, Exiting).
+ * - Rerouting cars around congestion on their way to a facility.
  * - Cleaning up cars that have exited the map.
  */
 class TrafficSystem {
@@ -24,14 +37,70 @@ public:
   TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager &entityManager);
   ~TrafficSystem();
 
+  const CongestionWeights &getCongestion() const { return congestion; }
+  uint64_t getRerouteCount() const { return rerouteCount; }
+  const PathBatcher &getPathBatcher() const { return pathBatcher; }
+  const DistanceMatrix &getDistanceMatrix() const { return distanceMatrix; }
+  const SpotAssigner &getSpotAssigner() const { return spotAssigner; }
+  const PricingEngine &getPricing() const { return pricing; }
+
 private:
+  /**
+   * @struct PlannedTrip
+   * @brief Street route of a car driving to its facility, kept so it can be re-evaluated.
+   */
+  struct PlannedTrip {
+    Car *car;
+    const Module *facility;
+    Spot spot;
+    std::vector<uint32_t> route; ///< Graph nodes from the car's first node to the facility road's entrance.
+  };
+  using RerouteCheck = std::pair<double, uint32_t>; ///< (due time, car id); ties break on the id.
+
   std::shared_ptr<EventBus> eventBus;
   const EntityManager &entityManager;
   std::vector<Subscription> eventTokens;
 
   int currentSpawnLevel = 0;
   float spawnTimer = 0.0f;
+  RoadGraph::SearchScratch routeScratch; ///< Reused by every route search on the simulation thread.
+
+  double simTime = 0.0;
+  CongestionWeights congestion;
+  std::unordered_map<uint32_t, PlannedTrip> trips; ///< Cars that may still be rerouted, by id.
+  std::vector<uint32_t> candidateRoute;            ///< Reused result buffer of reroute().
+  std::priority_queue<RerouteCheck, std::vector<RerouteCheck>, std::greater<>> rerouteQueue; // Earliest first
+  uint64_t rerouteCount = 0;
+  PathBatcher pathBatcher;
+  DistanceMatrix distanceMatrix; ///< Road distances from map entries (and facility exits) to facilities.
+  SpotAssigner spotAssigner;
+  PricingEngine pricing;
 
   void spawnCar();
+  /**
+   * @brief Sizes the distance matrix for the new world and fills the rows of the map entries.
+   */
+  void buildDistanceMatrix();
+  /**
+   * @brief Assigns this tick's spot requests, reserves the spots and requests the parking paths.
+   */
+  void assignSpots();
+  /**
+   * @brief Hands the paths planned since the last tick to their cars, in request order.
+   */
+  void applyPlannedPaths();
+  /**
+   * @brief Re-checks the trips that are due, at most Config::REROUTE_SEARCHES_PER_TICK of them.
+   */
+  void rerouteCars();
+  /**
+   * @brief Switches the car to a faster route if one saves enough predicted travel time.
+   * @return False once the car has left its street route and can no longer be rerouted.
+   */
+  bool reroute(uint32_t carId, PlannedTrip &trip);
+  /**
+   * @brief Sets a spot's state and publishes SpotStateChangedEvent.
+   */
+  void setSpotState(Module *facility, int spotIndex, SpotState state);
   void assignThroughTrafficPath(class Car *car);
 };
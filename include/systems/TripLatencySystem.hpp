@@ -0,0 +1,58 @@
+#pragma once
+#include "core/EventBus.hpp"
+#include "core/TripLatencies.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TripLatencySystem
+ * @brief Times each car's trip phases and records them into TripLatencies.
+ *
+ * Listens to CarSpawnedEvent, CarStateChangedEvent and CarDeletedEvent; each transition
+ * costs one hash lookup and at most one histogram record. Per-car bookkeeping is dropped
+ * when the car leaves the map, so memory is bounded by the number of live cars.
+ *
+ * Simulation::step() sets the clock before each tick so timestamps refer to the end of the
+ * tick in which a transition happened.
+ */
+class TripLatencySystem {
+public:
+  explicit TripLatencySystem(std::shared_ptr<EventBus> bus);
+  ~TripLatencySystem();
+
+  void setTime(double simTime) { now = simTime; }
+
+  const TripLatencies &getLatencies() const { return latencies; }
+
+  /**
+   * @brief Quantile summary, recomputed at most once per simulated second.
+   */
+  const TripLatencySummary &getSummary();
+
+private:
+  /**
+   * @brief Timestamps of one car's trip (negative = not reached yet).
+   */
+  struct Trip {
+    Car::CarState state;
+    double spawned = 0.0;
+    double aligning = -1.0;
+    double parked = -1.0;
+    double exiting = -1.0;
+    float batteryAtPark = 0.0f;
+    bool atCharger = false;
+  };
+
+  void onStateChanged(const Car &car);
+
+  std::shared_ptr<EventBus> eventBus;
+  std::vector<Subscription> eventTokens;
+
+  std::unordered_map<const Car *, Trip> trips;
+  TripLatencies latencies;
+  TripLatencySummary summary;
+  double now = 0.0;
+  double summaryTime = -1.0;
+  bool summaryDirty = false;
+};
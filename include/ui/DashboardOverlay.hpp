@@ -4,8 +4,8 @@
  * @file DashboardOverlay.hpp
  * @brief HUD Debug/Info panel.
  */
-#include "core/EntityManager.hpp"
 #include "core/EventBus.hpp"
+#include "core/SimulationSnapshot.hpp"
 #include "events/GameEvents.hpp"
 #include "ui/UIElement.hpp"
 #include <memory>
@@ -19,18 +19,20 @@
  * - General Simulator stats (FPS, Entity count).
  * - Selected Car details.
  * - Facility occupancy and economics.
+ *
+ * Reads only SimulationSnapshot data, never live simulation objects.
  */
 class DashboardOverlay : public UIElement {
 public:
-  DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager *entityManager);
+  explicit DashboardOverlay(std::shared_ptr<EventBus> bus);
   ~DashboardOverlay();
 
   void update(double dt) override;
   void draw() override;
 
 private:
-  EntityManager *entityManager;
   std::vector<Subscription> eventTokens;
+  std::shared_ptr<const SimulationSnapshot> snapshot;
 
   EntitySelectedEvent currentSelection;
 
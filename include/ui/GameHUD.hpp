@@ -10,8 +10,6 @@
 #include <memory>
 #include <vector>
 
-class EntityManager;
-
 /**
  * @class GameHUD
  * @brief Manages top-level UI elements (Buttons, Overlay).
@@ -20,7 +18,7 @@ class EntityManager;
  */
 class GameHUD {
 public:
-  GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager, const AdaptiveSignalsConfig& config);
+  GameHUD(std::shared_ptr<EventBus> bus, const AdaptiveSignalsConfig& config);
   ~GameHUD();
 
   void update(double dt);
@@ -80,6 +80,8 @@ void Application::render() {
   }
   inputSystem->update();
 
+  eventBus->publish(PreRenderEvent{});
+
   window->beginDrawing();
   sceneManager->render();
 
@@ -1,5 +1,8 @@
 #include "core/AssetManager.hpp"
+#include "config.hpp"
+#include "core/AtlasPacker.hpp"
 #include "core/Logger.hpp"
+#include <format>
 
 /**
  * @file AssetManager.cpp
@@ -9,7 +12,8 @@
 AssetManager::~AssetManager() { UnloadAll(); }
 
 void AssetManager::LoadTexture(const std::string &name, const std::string &path) {
-  if (textures.find(name) != textures.end()) {
+  auto it = textureHandles.find(name);
+  if (it != textureHandles.end() && textureSlots[it->second.index].id != 0) {
     Logger::Warn("Texture already loaded: {}", name);
     return;
   }
@@ -20,26 +24,111 @@ void AssetManager::LoadTexture(const std::string &name, const std::string &path)
     return;
   }
 
-  textures[name] = tex;
+  if (it != textureHandles.end()) {
+    // Reloading a previously unloaded texture keeps its handle
+    textureSlots[it->second.index] = tex;
+  } else {
+    TextureHandle handle{static_cast<uint16_t>(textureSlots.size())};
+    textureSlots.push_back(tex);
+    texturePaths.push_back(path);
+    textureHandles[name] = handle;
+  }
   Logger::Info("Loaded texture: {}", name);
 }
 
 Texture2D AssetManager::GetTexture(const std::string &name) {
-  if (textures.find(name) == textures.end()) {
+  TextureHandle handle = GetTextureHandle(name);
+  return GetTexture(handle);
+}
+
+TextureHandle AssetManager::GetTextureHandle(const std::string &name) const {
+  TextureHandle handle = FindTextureHandle(name);
+  if (!handle.isValid())
     Logger::Warn("Texture not found: {}", name);
-    return {0, 0, 0, 0, 0};
-  }
-  return textures[name];
+  return handle;
+}
+
+TextureHandle AssetManager::FindTextureHandle(const std::string &name) const {
+  auto it = textureHandles.find(name);
+  return it == textureHandles.end() ? TextureHandle{} : it->second;
 }
 
 void AssetManager::UnloadTexture(const std::string &name) {
-  if (textures.find(name) != textures.end()) {
-    ::UnloadTexture(textures[name]);
-    textures.erase(name);
+  auto it = textureHandles.find(name);
+  if (it != textureHandles.end() && textureSlots[it->second.index].id != 0) {
+    ::UnloadTexture(textureSlots[it->second.index]);
+    textureSlots[it->second.index] = textureSlots[0];
     Logger::Info("Unloaded texture: {}", name);
   }
 }
 
+void AssetManager::BuildAtlas(const std::vector<std::string> &names) {
+  std::vector<TextureHandle> handles;
+  std::vector<Image> images;
+  std::vector<std::pair<int, int>> sizes;
+
+  for (const auto &name : names) {
+    auto it = textureHandles.find(name);
+    if (it == textureHandles.end())
+      continue;
+    Image img = ::LoadImage(texturePaths[it->second.index].c_str());
+    if (img.data == nullptr) {
+      Logger::Warn("Atlas: could not read image for {}", name);
+      continue;
+    }
+    ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    handles.push_back(it->second);
+    images.push_back(img);
+    sizes.push_back({img.width, img.height});
+  }
+
+  AtlasPacker packer(Config::ATLAS_PAGE_SIZE, Config::ATLAS_PADDING);
+  auto placements = packer.pack(sizes);
+
+  // Compose each page on the CPU, then upload it once
+  std::vector<TextureHandle> pages;
+  for (int p = 0; p < packer.getPageCount(); ++p) {
+    auto [pageWidth, pageHeight] = packer.getPageExtent(p);
+    Image pageImage = GenImageColor(pageWidth, pageHeight, BLANK);
+    for (size_t i = 0; i < images.size(); ++i) {
+      if (placements[i].page != p)
+        continue;
+      Rectangle src = {0, 0, (float)images[i].width, (float)images[i].height};
+      Rectangle dst = {(float)placements[i].x, (float)placements[i].y, src.width, src.height};
+      ImageDraw(&pageImage, images[i], src, dst, WHITE);
+    }
+
+    Texture2D pageTex = LoadTextureFromImage(pageImage);
+    UnloadImage(pageImage);
+    if (pageTex.id == 0) {
+      Logger::Error("Atlas: failed to upload page {}", p);
+      pages.push_back({});
+      continue;
+    }
+
+    std::string pageName = std::format("atlas{}", atlasPageCount++);
+    TextureHandle pageHandle{static_cast<uint16_t>(textureSlots.size())};
+    textureSlots.push_back(pageTex);
+    texturePaths.push_back("");
+    textureHandles[pageName] = pageHandle;
+    pages.push_back(pageHandle);
+  }
+
+  atlasRegions.resize(textureSlots.size());
+  int packed = 0;
+  for (size_t i = 0; i < images.size(); ++i) {
+    const AtlasPlacement &pl = placements[i];
+    if (pl.page >= 0 && pages[pl.page].isValid()) {
+      atlasRegions[handles[i].index] = {pages[pl.page],
+                                        {(float)pl.x, (float)pl.y, (float)images[i].width, (float)images[i].height}};
+      packed++;
+    }
+    UnloadImage(images[i]);
+  }
+
+  Logger::Info("Atlas: packed {} of {} textures into {} page(s).", packed, names.size(), packer.getPageCount());
+}
+
 void AssetManager::LoadSound(const std::string &name, const std::string &path) {
   if (sounds.find(name) != sounds.end()) {
     Logger::Warn("Sound already loaded: {}", name);
@@ -143,6 +232,12 @@ void AssetManager::LoadAllAssets() {
   LoadTexture("car22", "assets/car22.png");
   LoadTexture("car23", "assets/car23.png");
 
+  // Everything drawn in the world shares atlas pages so the sprite batch rarely switches textures
+  BuildAtlas({"grass1", "grass2", "grass3", "grass4", "road", "entrance_up", "entrance_down", "entrance_double",
+              "parking_small_up", "parking_small_down", "parking_large_up", "parking_large_down", "charging_small_up",
+              "charging_small_down", "charging_large_up", "charging_large_down", "car11", "car12", "car13", "car21",
+              "car22", "car23"});
+
   // --- Sounds ---
   LoadSound("click", "assets/click_sound.mp3");
 
@@ -153,10 +248,14 @@ void AssetManager::LoadAllAssets() {
 }
 
 void AssetManager::UnloadAll() {
-  for (auto &pair : textures) {
-    ::UnloadTexture(pair.second);
+  // Slots (and therefore handles) are kept; they just resolve to the empty texture now
+  for (size_t i = 1; i < textureSlots.size(); ++i) {
+    if (textureSlots[i].id != 0) {
+      ::UnloadTexture(textureSlots[i]);
+      textureSlots[i] = textureSlots[0];
+    }
   }
-  textures.clear();
+  atlasRegions.clear();
 
   for (auto &pair : sounds) {
     ::UnloadSound(pair.second);
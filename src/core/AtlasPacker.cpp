@@ -0,0 +1,64 @@
+#include "core/AtlasPacker.hpp"
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @file AtlasPacker.cpp
+ * @brief Implementation of the shelf packer.
+ */
+
+AtlasPacker::AtlasPacker(int pageSize, int padding) : pageSize(pageSize), padding(padding) {}
+
+std::vector<AtlasPlacement> AtlasPacker::pack(const std::vector<std::pair<int, int>> &sizes) {
+  std::vector<AtlasPlacement> placements(sizes.size());
+  pageExtents.clear();
+
+  // Tallest first keeps shelves tight
+  std::vector<size_t> order(sizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return sizes[a].second > sizes[b].second; });
+
+  int page = -1;
+  int cursorX = 0;
+  int shelfY = 0;
+  int shelfHeight = 0;
+
+  auto openPage = [&]() {
+    page++;
+    pageExtents.push_back({0, 0});
+    cursorX = 0;
+    shelfY = 0;
+    shelfHeight = 0;
+  };
+
+  for (size_t i : order) {
+    int w = sizes[i].first + 2 * padding;
+    int h = sizes[i].second + 2 * padding;
+    if (w > pageSize || h > pageSize)
+      continue; // Can never fit; left at page -1
+
+    if (page < 0)
+      openPage();
+
+    // New shelf when the row is full
+    if (cursorX + w > pageSize) {
+      shelfY += shelfHeight;
+      cursorX = 0;
+      shelfHeight = 0;
+    }
+    // New page when the shelf doesn't fit vertically
+    if (shelfY + h > pageSize)
+      openPage();
+
+    placements[i] = {page, cursorX + padding, shelfY + padding};
+    cursorX += w;
+    shelfHeight = std::max(shelfHeight, h);
+
+    auto &extent = pageExtents[page];
+    extent.first = std::max(extent.first, cursorX);
+    extent.second = std::max(extent.second, shelfY + shelfHeight);
+  }
+
+  return placements;
+}
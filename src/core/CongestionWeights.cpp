@@ -0,0 +1,166 @@
+#include "core/CongestionWeights.hpp"
+#include "config.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file CongestionWeights.cpp
+ * @brief Implementation of the live edge travel times.
+ */
+
+namespace {
+// TUNING: Cell edge of the edge-footprint index (meters); lane edges between junctions are tens of meters long
+constexpr float EDGE_GRID_CELL = 20.0f;
+// TUNING: A car further than this from an edge's center line (or beyond its ends) is not on that edge
+constexpr float EDGE_SNAP_DISTANCE = 2.0f;
+// TUNING: Below this speed (m/s) a car's heading is unreliable, so only its position is matched
+constexpr float MOVING_SPEED = 0.5f;
+// TUNING: An empty edge within this fraction of free flow is treated as recovered and left alone
+constexpr float RECOVERED_FRACTION = 0.99f;
+} // namespace
+
+void CongestionWeights::reset(const RoadGraph &g) {
+  graph = &g;
+  const size_t edgeCount = g.getEdgeCount();
+  costs.resize(edgeCount);
+  speeds.assign(edgeCount, Config::ROUTE_FREE_FLOW_SPEED);
+  speedSums.assign(edgeCount, 0.0f);
+  carCounts.assign(edgeCount, 0);
+  isActive.assign(edgeCount, 0);
+  edgeSources.resize(edgeCount);
+  active.clear();
+  carEdges.clear();
+  for (size_t e = 0; e < edgeCount; ++e)
+    costs[e] = g.getEdgeLength((uint32_t)e) / Config::ROUTE_FREE_FLOW_SPEED;
+
+  float width = 0.0f;
+  float height = 0.0f;
+  for (size_t n = 0; n < g.getNodeCount(); ++n) {
+    Vector2 p = g.getNodePosition((uint32_t)n);
+    width = std::max(width, p.x + EDGE_SNAP_DISTANCE);
+    height = std::max(height, p.y + EDGE_SNAP_DISTANCE);
+  }
+  edgeIndex = std::make_unique<SpatialGrid>(std::max(width, 1.0f), std::max(height, 1.0f), EDGE_GRID_CELL);
+  for (uint32_t n = 0; n < (uint32_t)g.getNodeCount(); ++n) {
+    auto [begin, end] = g.getEdgeRange(n);
+    for (uint32_t e = begin; e < end; ++e) {
+      edgeSources[e] = n;
+      Vector2 a = g.getNodePosition(n);
+      Vector2 b = g.getNodePosition(g.getEdgeTarget(e));
+      Rectangle bounds = {std::min(a.x, b.x) - EDGE_SNAP_DISTANCE, std::min(a.y, b.y) - EDGE_SNAP_DISTANCE,
+                          std::fabs(a.x - b.x) + 2 * EDGE_SNAP_DISTANCE, std::fabs(a.y - b.y) + 2 * EDGE_SNAP_DISTANCE};
+      edgeIndex->insert((int)e, bounds);
+    }
+  }
+}
+
+float CongestionWeights::GetMinCostPerMeter() { return 1.0f / Config::ROUTE_FREE_FLOW_SPEED; }
+
+uint32_t CongestionWeights::getCarEdge(uint32_t carId) const {
+  auto it = carEdges.find(carId);
+  return it == carEdges.end() ? RoadGraph::NO_EDGE : it->second;
+}
+
+void CongestionWeights::removeCar(uint32_t carId) { carEdges.erase(carId); }
+
+float CongestionWeights::fit(uint32_t edge, Vector2 position, Vector2 velocity) const {
+  Vector2 from = graph->getNodePosition(edgeSources[edge]);
+  Vector2 to = graph->getNodePosition(graph->getEdgeTarget(edge));
+  Vector2 d = Vector2Subtract(to, from);
+  float length = Vector2Length(d);
+  if (length < 1e-4f)
+    return -1.0f;
+  Vector2 u = Vector2Scale(d, 1.0f / length);
+  Vector2 rel = Vector2Subtract(position, from);
+  float along = Vector2DotProduct(rel, u);
+  if (along < -EDGE_SNAP_DISTANCE || along > length + EDGE_SNAP_DISTANCE)
+    return -1.0f;
+  float lateral = std::fabs(u.x * rel.y - u.y * rel.x);
+  if (lateral > EDGE_SNAP_DISTANCE)
+    return -1.0f;
+  float speed = Vector2Length(velocity);
+  if (speed > MOVING_SPEED && Vector2DotProduct(u, velocity) < 0.5f * speed)
+    return -1.0f;
+  return lateral;
+}
+
+uint32_t CongestionWeights::locate(Vector2 position, Vector2 velocity) {
+  edgeIndex->query({position.x - EDGE_SNAP_DISTANCE, position.y - EDGE_SNAP_DISTANCE, 2 * EDGE_SNAP_DISTANCE,
+                    2 * EDGE_SNAP_DISTANCE},
+                   candidates);
+  uint32_t best = RoadGraph::NO_EDGE;
+  float bestLateral = EDGE_SNAP_DISTANCE;
+  for (int candidate : candidates) {
+    float lateral = fit((uint32_t)candidate, position, velocity);
+    if (lateral >= 0.0f && lateral <= bestLateral) {
+      best = (uint32_t)candidate;
+      bestLateral = lateral;
+    }
+  }
+  return best;
+}
+
+void CongestionWeights::activate(uint32_t edge) {
+  if (!isActive[edge]) {
+    isActive[edge] = 1;
+    active.push_back(edge);
+  }
+}
+
+void CongestionWeights::update(double dt, const std::vector<std::unique_ptr<Car>> &cars) {
+  if (!graph || costs.empty())
+    return;
+
+  // 1. Match cars to edges, reusing last tick's match while the car is still on it
+  for (const auto &car : cars) {
+    Car::CarState state = car->getState();
+    if (state != Car::CarState::DRIVING && state != Car::CarState::EXITING)
+      continue;
+    Vector2 position = car->getPosition();
+    Vector2 velocity = car->getVelocity();
+
+    auto it = carEdges.find(car->getId());
+    uint32_t edge = it == carEdges.end() ? RoadGraph::NO_EDGE : it->second;
+    if (edge == RoadGraph::NO_EDGE || fit(edge, position, velocity) < 0.0f)
+      edge = locate(position, velocity);
+
+    if (edge == RoadGraph::NO_EDGE) {
+      if (it != carEdges.end())
+        carEdges.erase(it); // Inside a facility or mid-turn
+      continue;
+    }
+    if (it != carEdges.end())
+      it->second = edge;
+    else
+      carEdges.emplace(car->getId(), edge);
+
+    speedSums[edge] += Vector2Length(velocity);
+    if (carCounts[edge] < UINT16_MAX)
+      carCounts[edge]++;
+    activate(edge);
+  }
+
+  // 2. Smooth the measured speeds of the edges in use and let the others recover
+  const float alpha = (float)(1.0 - std::exp(-dt / Config::ROUTE_SPEED_TIME_CONSTANT));
+  for (size_t i = 0; i < active.size();) {
+    uint32_t edge = active[i];
+    float target = carCounts[edge] > 0 ? speedSums[edge] / carCounts[edge] : Config::ROUTE_FREE_FLOW_SPEED;
+    speeds[edge] += alpha * (target - speeds[edge]);
+    float length = graph->getEdgeLength(edge);
+
+    if (carCounts[edge] == 0 && speeds[edge] >= Config::ROUTE_FREE_FLOW_SPEED * RECOVERED_FRACTION) {
+      speeds[edge] = Config::ROUTE_FREE_FLOW_SPEED;
+      costs[edge] = length / Config::ROUTE_FREE_FLOW_SPEED;
+      isActive[edge] = 0;
+      active[i] = active.back();
+      active.pop_back();
+      continue;
+    }
+    // Cars cruise at free-flow speed at most, so a measured edge is never cheaper than an empty one
+    costs[edge] = length / std::clamp(speeds[edge], Config::ROUTE_MIN_SPEED, Config::ROUTE_FREE_FLOW_SPEED);
+    speedSums[edge] = 0.0f;
+    carCounts[edge] = 0;
+    ++i;
+  }
+}
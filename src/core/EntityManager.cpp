@@ -5,12 +5,13 @@
  * @file EntityManager.cpp
  * @brief Implementation of EntityManager.
  *
- * Handles entity updates, drawing order, and event-driven entity creation/destruction.
+ * Handles entity updates and event-driven entity creation/destruction.
  */
 
 #include "core/EntityManager.hpp"
 #include "core/Logger.hpp"
 #include "entities/Car.hpp"
+#include "entities/map/ContractionHierarchy.hpp"
 #include "entities/map/WorldGenerator.hpp"
 #include "events/GameEvents.hpp"
 
@@ -24,6 +25,20 @@ EntityManager::EntityManager(std::shared_ptr<EventBus> bus) : eventBus(bus) {
     for (auto &mod : generated.modules) {
       this->addModule(std::move(mod));
     }
+    roadGraph = RoadGraph::Build(modules);
+    laneIndex.reset(roadGraph);
+    spotRegistry.rebuild(modules);
+    if (e.config.routeIndex || !e.config.routeIndexPath.empty()) {
+      std::shared_ptr<const ContractionHierarchy> index;
+      if (!e.config.routeIndexPath.empty())
+        index = ContractionHierarchy::Load(e.config.routeIndexPath, roadGraph);
+      if (!index) {
+        index = ContractionHierarchy::Build(roadGraph);
+        if (!e.config.routeIndexPath.empty())
+          index->save(e.config.routeIndexPath);
+      }
+      roadGraph.setHierarchy(std::move(index));
+    }
 
     // Publish WorldBounds
     if (world) {
@@ -34,9 +49,6 @@ EntityManager::EntityManager(std::shared_ptr<EventBus> bus) : eventBus(bus) {
   // Subscribe to GameUpdateEvent
   eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) { this->update(e.dt); }));
 
-  // Subscribe to DrawWorldEvent
-  eventTokens.push_back(eventBus->subscribe<DrawWorldEvent>([this](const DrawWorldEvent &) { this->draw(); }));
-
   // Subscribe to CreateCarEvent
   eventTokens.push_back(eventBus->subscribe<CreateCarEvent>([this](const CreateCarEvent &e) {
     if (!world)
@@ -60,20 +72,10 @@ EntityManager::EntityManager(std::shared_ptr<EventBus> bus) : eventBus(bus) {
     }
   }));
 
-  // Track Dashboard State
-  eventTokens.push_back(eventBus->subscribe<ToggleDashboardEvent>([this](const ToggleDashboardEvent&) {
-      this->dashboardVisible = !this->dashboardVisible;
-  }));
-
-  // Track Selection
+  // Track Selection (the selected car exports its path in snapshots)
   eventTokens.push_back(eventBus->subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent& e) {
-      // Logic matching DashboardOverlay: specific selection forces visibility
-      if (e.type != SelectionType::GENERAL) {
-          this->dashboardVisible = true;
-      }
-      
       for(auto& car : cars) {
-          car->setSelected(car.get() == e.car);
+          car->setSelected(e.carId != 0 && car->getId() == e.carId);
       }
   }));
 }
@@ -86,32 +88,20 @@ void EntityManager::update(double dt) {
   }
 
   // Update Cars
-  // Note: Cars need access to other cars for collision avoidance/logic
-  // Currently Car::updateWithNeighbors takes a vector of unique_ptr<Car>
-  // We might need to refactor Car::updateWithNeighbors to take a raw pointer list or reference to the vector
+  // On a lane a car follows its leader and watches the lanes it turns onto and the off-lane cars in its way;
+  // off lanes, inside facilities, it checks the cars around it
+  laneIndex.update(cars);
   for (auto &car : cars) {
-    car->updateWithNeighbors(dt, &cars);
-  }
-}
-
-void EntityManager::draw() {
-  if (world) {
-    world->draw();
-  }
-
-  for (const auto &mod : modules) {
-    mod->draw();
-  }
-
-  for (const auto &car : cars) {
-    bool showPath = car->isSelected() && this->dashboardVisible;
-    car->draw(showPath);
+    neighbors.clear();
+    laneIndex.appendNeighbors(*car, neighbors);
+    car->updateWithNeighbors(dt, neighbors);
   }
 
-  // Draw Mask last (Foreground)
-  if (world) {
-    world->drawOverlay();
-    world->drawMask();
+  // Report state changes made by the cars themselves and by systems since the last tick
+  for (auto &car : cars) {
+    if (car->consumeStateChange()) {
+      eventBus->publish(CarStateChangedEvent{car.get()});
+    }
   }
 }
 
@@ -119,14 +109,20 @@ void EntityManager::setWorld(std::unique_ptr<World> w) { world = std::move(w); }
 
 void EntityManager::addModule(std::unique_ptr<Module> module) { modules.push_back(std::move(module)); }
 
-void EntityManager::addCar(std::unique_ptr<Car> car) { cars.push_back(std::move(car)); }
+void EntityManager::addCar(std::unique_ptr<Car> car) {
+  car->setId(nextCarId++);
+  cars.push_back(std::move(car));
+}
 
 void EntityManager::clear() {
   for (auto &car : cars) {
     eventBus->publish(CarDeletedEvent{car.get()});
   }
   cars.clear();
+  spotRegistry.clear();
   modules.clear();
+  roadGraph = RoadGraph();
+  laneIndex.reset(roadGraph);
   world.reset();
 }
 
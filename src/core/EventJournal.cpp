@@ -0,0 +1,64 @@
+#include "core/EventJournal.hpp"
+
+/**
+ * @file EventJournal.cpp
+ * @brief Implementation of the event journal writer and reader.
+ */
+
+using namespace EventJournalFormat;
+
+namespace {
+constexpr size_t WRITE_BUFFER_BYTES = 1 << 20;
+}
+
+std::unique_ptr<EventJournalWriter> EventJournalWriter::Open(const std::string &path, double tickRate,
+                                                             const std::vector<JournalFacility> &facilities) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return nullptr;
+
+  std::unique_ptr<EventJournalWriter> writer(new EventJournalWriter(file));
+  JournalHeader header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.recordSize = sizeof(JournalRecord);
+  header.tickRate = tickRate;
+  header.facilityCount = (uint32_t)facilities.size();
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            std::fwrite(facilities.data(), sizeof(JournalFacility), facilities.size(), file) == facilities.size();
+  return ok ? std::move(writer) : nullptr;
+}
+
+EventJournalWriter::EventJournalWriter(std::FILE *file) : file(file), buffer(WRITE_BUFFER_BYTES) {
+  std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+}
+
+EventJournalWriter::~EventJournalWriter() { std::fclose(file); }
+
+void EventJournalWriter::append(const JournalRecord &record) {
+  if (std::fwrite(&record, sizeof(record), 1, file) == 1)
+    recordsWritten++;
+}
+
+std::unique_ptr<EventJournalReader> EventJournalReader::Open(const std::string &path) {
+  auto file = MappedFile::Open(path);
+  if (!file || file->size() < sizeof(JournalHeader))
+    return nullptr;
+
+  const unsigned char *data = file->data();
+  const auto *header = reinterpret_cast<const JournalHeader *>(data);
+  if (header->magic != MAGIC || header->version != VERSION || header->recordSize != sizeof(JournalRecord))
+    return nullptr;
+
+  size_t recordsOffset = sizeof(JournalHeader) + (size_t)header->facilityCount * sizeof(JournalFacility);
+  if (recordsOffset > file->size())
+    return nullptr;
+
+  std::unique_ptr<EventJournalReader> reader(new EventJournalReader(std::move(file)));
+  reader->header = header;
+  reader->facilities = {reinterpret_cast<const JournalFacility *>(data + sizeof(JournalHeader)),
+                        header->facilityCount};
+  reader->records = {reinterpret_cast<const JournalRecord *>(data + recordsOffset),
+                     (reader->file->size() - recordsOffset) / sizeof(JournalRecord)};
+  return reader;
+}
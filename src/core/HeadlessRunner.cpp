@@ -0,0 +1,200 @@
+#include "core/HeadlessRunner.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include "core/Simulation.hpp"
+#include "core/SimulationStats.hpp"
+#include "systems/HeatmapSystem.hpp"
+#include "raylib.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @file HeadlessRunner.cpp
+ * @brief Implementation of the windowless simulation driver.
+ */
+
+namespace {
+double ParseNumber(std::string_view option, const char *value) {
+  try {
+    size_t used = 0;
+    double result = std::stod(value, &used);
+    if (used == std::string_view(value).size())
+      return result;
+  } catch (const std::exception &) {
+  }
+  throw std::invalid_argument(std::format("Invalid value '{}' for {}", value, option));
+}
+
+int ParseCount(std::string_view option, const char *value) {
+  double v = ParseNumber(option, value);
+  if (v < 0 || v != (double)(int)v)
+    throw std::invalid_argument(std::format("{} expects a non-negative integer, got '{}'", option, value));
+  return (int)v;
+}
+} // namespace
+
+const char *HeadlessRunner::Usage() {
+  return "Usage: parklogic --headless [options]\n"
+         "  --duration <s>          Simulated seconds to run (default 3600)\n"
+         "  --spawn-level <0-5>     Auto-spawn level (default 3)\n"
+         "  --small-parking <n>     Number of small parking lots (default 1)\n"
+         "  --large-parking <n>     Number of large parking lots (default 1)\n"
+         "  --small-charging <n>    Number of small charging stations (default 1)\n"
+         "  --large-charging <n>    Number of large charging stations (default 0)\n"
+         "  --rows <n>              Road rows; more than 1 builds a city grid with cross streets (default 1)\n"
+         "  --route-index           Preprocess the roads into a contraction hierarchy for faster routing\n"
+         "  --route-index-cache <path>  Load the hierarchy from <path> if it matches the map, else build and save it\n"
+         "  --sample-interval <s>   Simulated seconds between metric samples (default 1)\n"
+         "  --no-downsample         Only keep the 1 s tier\n"
+         "  --seed <n>              Random seed\n"
+         "  --out <prefix>          CSV prefix; writes <prefix>_1s.csv etc. (default parklogic_metrics)\n"
+         "  --openmetrics <path>    Write live telemetry in OpenMetrics text format to <path>\n"
+         "  --openmetrics-interval <s>  Wall-clock seconds between telemetry writes (default 5)\n"
+         "  --shm <name>            Publish frames to POSIX shared memory <name> (e.g. /parklogic)\n"
+         "  --shm-slots <n>         Frames kept in the shared-memory ring (default 256)\n"
+         "  --shm-max-cars <n>      Cars per shared-memory frame (default 1024)\n"
+         "  --shm-every <ticks>     Ticks between shared-memory frames (default 1)\n"
+         "  --trajectory <path>     Record car trajectories to a columnar .pltraj file\n"
+         "  --trajectory-every <ticks>  Ticks between trajectory samples (default 6)\n"
+         "  --trajectory-cars <n>   Only record every n-th car id (default 1 = all cars)\n"
+         "  --journal <path>        Log car and spot state changes to a binary .plevj journal\n";
+}
+
+std::optional<HeadlessOptions> HeadlessRunner::ParseArgs(int argc, char **argv) {
+  bool headless = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string_view(argv[i]) == "--headless")
+      headless = true;
+  }
+  if (!headless)
+    return std::nullopt;
+
+  HeadlessOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--headless")
+      continue;
+    if (arg == "--route-index") {
+      options.map.routeIndex = true;
+      continue;
+    }
+    if (arg == "--no-downsample") {
+      options.metrics.downsample = false;
+      continue;
+    }
+    if (arg == "--help") {
+      std::cout << Usage();
+      continue;
+    }
+
+    if (i + 1 >= argc)
+      throw std::invalid_argument(std::format("Missing value for {}", arg));
+    const char *value = argv[++i];
+
+    if (arg == "--duration")
+      options.duration = ParseNumber(arg, value);
+    else if (arg == "--spawn-level")
+      options.spawnLevel = ParseCount(arg, value);
+    else if (arg == "--small-parking")
+      options.map.smallParkingCount = ParseCount(arg, value);
+    else if (arg == "--large-parking")
+      options.map.largeParkingCount = ParseCount(arg, value);
+    else if (arg == "--small-charging")
+      options.map.smallChargingCount = ParseCount(arg, value);
+    else if (arg == "--large-charging")
+      options.map.largeChargingCount = ParseCount(arg, value);
+    else if (arg == "--rows")
+      options.map.rows = ParseCount(arg, value);
+    else if (arg == "--route-index-cache")
+      options.map.routeIndexPath = value;
+    else if (arg == "--sample-interval")
+      options.metrics.sampleInterval = ParseNumber(arg, value);
+    else if (arg == "--seed")
+      options.seed = (unsigned int)ParseCount(arg, value);
+    else if (arg == "--out")
+      options.outputPrefix = value;
+    else if (arg == "--openmetrics")
+      options.openMetricsPath = value;
+    else if (arg == "--openmetrics-interval")
+      options.openMetricsInterval = ParseNumber(arg, value);
+    else if (arg == "--shm")
+      options.shmName = value;
+    else if (arg == "--shm-slots")
+      options.shmSlots = (uint32_t)ParseCount(arg, value);
+    else if (arg == "--shm-max-cars")
+      options.shmMaxCars = (uint32_t)ParseCount(arg, value);
+    else if (arg == "--shm-every")
+      options.shmEveryTicks = (uint32_t)ParseCount(arg, value);
+    else if (arg == "--trajectory")
+      options.trajectoryPath = value;
+    else if (arg == "--trajectory-every")
+      options.trajectoryEveryTicks = (uint32_t)ParseCount(arg, value);
+    else if (arg == "--trajectory-cars")
+      options.trajectoryCarModulo = (uint32_t)ParseCount(arg, value);
+    else if (arg == "--journal")
+      options.journalPath = value;
+    else
+      throw std::invalid_argument(std::format("Unknown option {}", arg));
+  }
+
+  if (options.spawnLevel > 5)
+    throw std::invalid_argument("--spawn-level must be between 0 and 5");
+  if (options.metrics.sampleInterval <= 0.0)
+    throw std::invalid_argument("--sample-interval must be positive");
+  return options;
+}
+
+int HeadlessRunner::Run(const HeadlessOptions &options) {
+  if (options.seed != 0)
+    SetRandomSeed(options.seed);
+
+  Logger::Info("Headless: {:.0f} s simulated, spawn level {}, output '{}'", options.duration, options.spawnLevel,
+               options.outputPrefix);
+
+  // Per-car logging and missing-texture warnings would dominate the run time
+  Logger::SetMinLevel(Logger::Level::Error);
+  auto wallStart = std::chrono::steady_clock::now();
+
+  Simulation simulation(options.map, options.metrics);
+  if (!options.openMetricsPath.empty())
+    simulation.enableOpenMetrics(options.openMetricsPath, options.openMetricsInterval);
+  if (!options.shmName.empty() &&
+      !simulation.enableSharedMemoryTelemetry(options.shmName, options.shmSlots, options.shmMaxCars,
+                                              options.shmEveryTicks))
+    return 1;
+  if (!options.trajectoryPath.empty() &&
+      !simulation.enableTrajectoryLog(options.trajectoryPath, options.trajectoryEveryTicks,
+                                      options.trajectoryCarModulo))
+    return 1;
+  if (!options.journalPath.empty() && !simulation.enableEventJournal(options.journalPath))
+    return 1;
+  simulation.getHeatmap().setHalfLife(0.0); // The exported grid covers the whole run
+  for (int i = 0; i < options.spawnLevel; ++i)
+    simulation.publish(CycleAutoSpawnLevelEvent{});
+
+  while (simulation.getSimTime() < options.duration)
+    simulation.step(Config::FIXED_DELTA_TIME);
+
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  Logger::SetMinLevel(Logger::Level::Info);
+
+  const SimulationStats &stats = simulation.getStats();
+  Logger::Info("Headless: {} ticks in {:.2f} s wall time ({:.0f}x real time)", simulation.getTick(), wallSeconds,
+               wallSeconds > 0.0 ? simulation.getSimTime() / wallSeconds : 0.0);
+  Logger::Info("Headless: {} spawned, {} exited, {} passed through, {} still on the map", stats.totalSpawned,
+               stats.totalExited, stats.totalPassedThrough, stats.activeCars);
+
+  TripLatencySummary trips = simulation.getTripLatencies().summarize();
+  for (size_t m = 0; m < TRIP_METRIC_COUNT; ++m) {
+    const auto &q = trips.metrics[m];
+    Logger::Info("Headless: {:<16} n={:<6} p50={:.1f}s p95={:.1f}s p99={:.1f}s",
+                 TripLatencies::MetricName((TripMetric)m), q.count, q.p50, q.p95, q.p99);
+  }
+
+  bool ok = simulation.getMetrics().exportCsv(options.outputPrefix);
+  ok = simulation.getTripLatencies().exportCsv(options.outputPrefix) && ok;
+  ok = simulation.getHeatmap().exportCsv(options.outputPrefix) && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#include "core/JobPool.hpp"
+#include <algorithm>
+
+/**
+ * @file JobPool.cpp
+ * @brief Implementation of the batch worker pool.
+ */
+
+namespace {
+// TUNING: Upper bound on pool threads; path batches are small and the rest of the frame needs cores too
+constexpr unsigned MAX_DEFAULT_THREADS = 4;
+} // namespace
+
+JobPool::JobPool(unsigned threads) : nextJob(0) {
+  threads = std::max(threads, 1u);
+  workers.reserve(threads);
+  for (unsigned w = 0; w < threads; ++w)
+    workers.emplace_back([this, w]() { run(w); });
+}
+
+JobPool::~JobPool() {
+  wait();
+  {
+    std::scoped_lock lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+unsigned JobPool::DefaultThreadCount() {
+  // Half the cores: the simulation thread and (with a window) the render thread keep theirs
+  return std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_DEFAULT_THREADS);
+}
+
+void JobPool::dispatch(size_t count, Job newJob) {
+  if (count == 0) {
+    wait();
+    return;
+  }
+  {
+    // Waiting and publishing under one lock, so no worker can join the old batch in between
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [this]() { return jobsDone == jobCount && busyWorkers == 0; });
+    job = std::move(newJob);
+    jobCount = count;
+    jobsDone = 0;
+    nextJob.store(0, std::memory_order_relaxed);
+    batch++;
+  }
+  wake.notify_all();
+}
+
+void JobPool::wait() {
+  std::unique_lock lock(mutex);
+  // A worker that joined late may still be leaving the batch; the next dispatch must not race it
+  finished.wait(lock, [this]() { return jobsDone == jobCount && busyWorkers == 0; });
+}
+
+void JobPool::run(unsigned worker) {
+  unsigned long long seen = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      wake.wait(lock, [this, seen]() { return stopping || batch != seen; });
+      if (stopping)
+        return;
+      seen = batch;
+      busyWorkers++;
+    }
+
+    size_t done = 0;
+    for (size_t i = nextJob.fetch_add(1); i < jobCount; i = nextJob.fetch_add(1)) {
+      job(i, worker);
+      done++;
+    }
+
+    bool last;
+    {
+      std::scoped_lock lock(mutex);
+      jobsDone += done;
+      busyWorkers--;
+      last = jobsDone == jobCount && busyWorkers == 0;
+    }
+    if (last)
+      finished.notify_all();
+  }
+}
@@ -0,0 +1,213 @@
+#include "core/LaneIndex.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <initializer_list>
+
+/**
+ * @file LaneIndex.cpp
+ * @brief Implementation of the per-lane car lists.
+ */
+
+namespace {
+// TUNING: Cars this close (meters) to the end of their lane watch the lanes it turns onto, and the cars
+// that close to the junction on them; about the look-ahead of a car at cruising speed
+constexpr float JUNCTION_WATCH_DISTANCE = 20.0f;
+// TUNING: Cell size (meters) of the moving-car grid; about the look-ahead of a slow car
+constexpr float CAR_GRID_CELL = 16.0f;
+// TUNING: Reach (meters) beside and behind a car; covers the lateral corridor and separation radius of
+// Car::updateWithNeighbors
+constexpr float CAR_CLEARANCE = 2.0f;
+
+/**
+ * @brief Bounding box of @p points.
+ */
+Rectangle Bounds(std::initializer_list<Vector2> points) {
+  Vector2 lo = *points.begin(), hi = *points.begin();
+  for (Vector2 p : points) {
+    lo = Vector2Min(lo, p);
+    hi = Vector2Max(hi, p);
+  }
+  return {lo.x, lo.y, hi.x - lo.x, hi.y - lo.y};
+}
+} // namespace
+
+void LaneIndex::reset(const RoadGraph &g) {
+  graph = &g;
+  // Cars beyond the road network (facilities below the last road, map ends) land in the border cells
+  Vector2 extent = {1.0f, 1.0f};
+  for (uint32_t n = 0; n < (uint32_t)g.getNodeCount(); ++n)
+    extent = Vector2Max(extent, g.getNodePosition(n));
+  carGrid = std::make_unique<SpatialGrid>(extent.x, extent.y, CAR_GRID_CELL);
+  movers.clear();
+  lanes.assign(g.getLaneCount(), {});
+  laneEnds.assign(g.getLaneCount(), 0.0f);
+  turns.assign(g.getLaneCount(), {});
+  for (uint32_t lane = 0; lane < (uint32_t)g.getLaneCount(); ++lane) {
+    Vector2 direction = g.getLaneDirection(lane);
+    uint32_t last = g.getLaneNodes(lane).second - 1;
+    laneEnds[lane] = Vector2DotProduct(g.getNodePosition(last), direction);
+    auto [begin, end] = g.getEdgeRange(last);
+    for (uint32_t e = begin; e < end; ++e) {
+      uint32_t target = g.getEdgeTarget(e);
+      uint32_t other = g.getNodeLane(target);
+      if (other != RoadGraph::NO_LANE && other != lane)
+        turns[lane].push_back({other, Vector2DotProduct(g.getNodePosition(target), g.getLaneDirection(other))});
+    }
+  }
+  slots.clear();
+  offLane.clear();
+  generation = 0;
+}
+
+void LaneIndex::update(const std::vector<std::unique_ptr<Car>> &cars) {
+  offLane.clear();
+  movers.clear();
+  if (!graph)
+    return;
+  ++generation;
+
+  // 1. Match cars to lanes, reusing last tick's lane while the car is still on it
+  for (const auto &car : cars) {
+    Car::CarState state = car->getState();
+    if (state == Car::CarState::PARKED)
+      continue;
+    Slot &slot = slots[car->getId()];
+    slot.lastSeen = generation;
+    slot.mover = (uint32_t)movers.size();
+    uint32_t lane = RoadGraph::NO_LANE;
+    if (state == Car::CarState::DRIVING || state == Car::CarState::EXITING) {
+      Vector2 position = car->getPosition();
+      Vector2 heading = car->getHeading();
+      lane = slot.lane != RoadGraph::NO_LANE && graph->isOnLane(slot.lane, position, heading)
+                 ? slot.lane
+                 : graph->findLane(position, heading);
+    }
+    movers.push_back({car.get(), lane != RoadGraph::NO_LANE});
+    if (lane == RoadGraph::NO_LANE) {
+      slot.lane = RoadGraph::NO_LANE;
+      offLane.push_back(car.get());
+      continue;
+    }
+
+    float progress = Vector2DotProduct(car->getPosition(), graph->getLaneDirection(lane));
+    if (lane == slot.lane) {
+      Entry &entry = lanes[lane][slot.index];
+      entry.progress = progress;
+      entry.lastSeen = generation;
+    } else {
+      // The entry on the old lane goes stale and is dropped below
+      slot.lane = lane;
+      slot.index = (uint32_t)lanes[lane].size();
+      lanes[lane].push_back({car.get(), car->getId(), progress, generation});
+    }
+  }
+
+  // 2. Drop cars that left each lane (or the simulation), then restore the driving order
+  for (std::vector<Entry> &entries : lanes) {
+    if (entries.empty())
+      continue;
+    std::erase_if(entries, [this](const Entry &e) { return e.lastSeen != generation; });
+    // Insertion sort: cars rarely overtake, so this is one pass in the common case
+    for (size_t i = 1; i < entries.size(); ++i) {
+      Entry moving = entries[i];
+      size_t j = i;
+      for (; j > 0 && entries[j - 1].progress > moving.progress; --j)
+        entries[j] = entries[j - 1];
+      entries[j] = moving;
+    }
+    for (uint32_t i = 0; i < (uint32_t)entries.size(); ++i)
+      slots[entries[i].carId].index = i;
+  }
+  std::erase_if(slots, [this](const auto &item) { return item.second.lastSeen != generation; });
+
+  // 3. Bucket the moving cars for the area queries of appendNeighbors()
+  carGrid->clear();
+  for (uint32_t i = 0; i < (uint32_t)movers.size(); ++i) {
+    Vector2 position = movers[i].car->getPosition();
+    carGrid->insert((int)i, {position.x, position.y, 0.0f, 0.0f});
+  }
+}
+
+const LaneIndex::Entry *LaneIndex::neighbor(const Car &car, int offset) const {
+  auto it = slots.find(car.getId());
+  if (it == slots.end() || it->second.lane == RoadGraph::NO_LANE)
+    return nullptr;
+  const std::vector<Entry> &entries = lanes[it->second.lane];
+  int64_t index = (int64_t)it->second.index + offset;
+  return index >= 0 && index < (int64_t)entries.size() ? &entries[index] : nullptr;
+}
+
+uint32_t LaneIndex::getLane(const Car &car) const {
+  auto it = slots.find(car.getId());
+  return it == slots.end() ? RoadGraph::NO_LANE : it->second.lane;
+}
+
+const Car *LaneIndex::getLeader(const Car &car) const {
+  const Entry *entry = neighbor(car, 1);
+  return entry ? entry->car : nullptr;
+}
+
+const Car *LaneIndex::getFollower(const Car &car) const {
+  const Entry *entry = neighbor(car, -1);
+  return entry ? entry->car : nullptr;
+}
+
+void LaneIndex::appendNeighbors(const Car &car, std::vector<const Car *> &cars) const {
+  auto it = slots.find(car.getId());
+  if (it == slots.end() || !carGrid)
+    return;
+  const Slot &slot = it->second;
+  const Vector2 position = car.getPosition();
+  const float reach = car.getLookAheadDistance();
+
+  // The grid only spans the road network; cars outside it sit in the border cells
+  const float gridWidth = (float)carGrid->getCols() * CAR_GRID_CELL;
+  const float gridHeight = (float)carGrid->getRows() * CAR_GRID_CELL;
+  auto query = [&](Rectangle area) {
+    float x0 = std::clamp(area.x, 0.0f, gridWidth), y0 = std::clamp(area.y, 0.0f, gridHeight);
+    float x1 = std::clamp(area.x + area.width, 0.0f, gridWidth);
+    float y1 = std::clamp(area.y + area.height, 0.0f, gridHeight);
+    carGrid->query({x0, y0, x1 - x0, y1 - y0}, found);
+  };
+
+  if (slot.lane == RoadGraph::NO_LANE) {
+    // Off lanes, in a facility or turning: everything around the car
+    query({position.x - reach, position.y - reach, 2.0f * reach, 2.0f * reach});
+    for (int id : found)
+      cars.push_back(movers[id].car);
+    return;
+  }
+
+  const std::vector<Entry> &own = lanes[slot.lane];
+  if (slot.index + 1 < own.size())
+    cars.push_back(own[slot.index + 1].car);
+
+  // Off-lane cars that may merge into the corridor the car is driving into
+  Vector2 heading = car.getHeading();
+  Vector2 side = Vector2Scale({-heading.y, heading.x}, CAR_CLEARANCE);
+  Vector2 back = Vector2Subtract(position, Vector2Scale(heading, CAR_CLEARANCE));
+  Vector2 front = Vector2Add(position, Vector2Scale(heading, reach));
+  query(Bounds({Vector2Add(back, side), Vector2Subtract(back, side), Vector2Add(front, side),
+                Vector2Subtract(front, side)}));
+  for (int id : found) {
+    if (!movers[id].onLane)
+      cars.push_back(movers[id].car);
+  }
+
+  if (laneEnds[slot.lane] - own[slot.index].progress > JUNCTION_WATCH_DISTANCE)
+    return;
+  for (const Turn &turn : turns[slot.lane]) {
+    const std::vector<Entry> &entries = lanes[turn.lane];
+    auto entry = std::lower_bound(entries.begin(), entries.end(), turn.progress - JUNCTION_WATCH_DISTANCE,
+                                  [](const Entry &e, float progress) { return e.progress < progress; });
+    for (; entry != entries.end() && entry->progress <= turn.progress + JUNCTION_WATCH_DISTANCE; ++entry)
+      cars.push_back(entry->car);
+  }
+}
+
+std::vector<const Car *> LaneIndex::getLaneCars(uint32_t lane) const {
+  std::vector<const Car *> cars;
+  for (const Entry &entry : lanes[lane])
+    cars.push_back(entry.car);
+  return cars;
+}
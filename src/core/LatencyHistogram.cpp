@@ -0,0 +1,84 @@
+#include "core/LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Implementation of the log-linear duration histogram.
+ */
+
+size_t LatencyHistogram::BucketIndex(double value) {
+  if (!(value >= MIN_VALUE))
+    return 0;
+
+  // value / MIN_VALUE = mantissa * 2^exponent with mantissa in [0.5, 1)
+  int exponent = 0;
+  double mantissa = std::frexp(value / MIN_VALUE, &exponent);
+  int octave = exponent - 1;
+  if (octave >= OCTAVES)
+    return BUCKET_COUNT - 1;
+
+  int sub = std::min((int)((mantissa * 2.0 - 1.0) * SUB_BUCKETS), SUB_BUCKETS - 1);
+  return 1 + (size_t)octave * SUB_BUCKETS + (size_t)sub;
+}
+
+double LatencyHistogram::BucketLowerBound(size_t index) {
+  if (index == 0)
+    return 0.0;
+  size_t octave = (index - 1) / SUB_BUCKETS;
+  size_t sub = (index - 1) % SUB_BUCKETS;
+  return MIN_VALUE * std::ldexp(1.0 + (double)sub / SUB_BUCKETS, (int)octave);
+}
+
+void LatencyHistogram::record(double value) {
+  if (value < 0.0 || std::isnan(value))
+    return;
+  buckets[BucketIndex(value)]++;
+  minValue = total == 0 ? value : std::min(minValue, value);
+  maxValue = total == 0 ? value : std::max(maxValue, value);
+  sum += value;
+  total++;
+}
+
+void LatencyHistogram::addToBucket(size_t index, uint64_t n) {
+  if (index >= BUCKET_COUNT || n == 0)
+    return;
+  // Bucket-only data: bound min/max and estimate the sum with the bucket's lower edge
+  double lower = BucketLowerBound(index);
+  double upper = index + 1 < BUCKET_COUNT ? BucketLowerBound(index + 1) : lower;
+  minValue = total == 0 ? lower : std::min(minValue, lower);
+  maxValue = total == 0 ? upper : std::max(maxValue, upper);
+  buckets[index] += n;
+  sum += lower * (double)n;
+  total += n;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  if (other.total == 0)
+    return;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    buckets[i] += other.buckets[i];
+  minValue = total == 0 ? other.minValue : std::min(minValue, other.minValue);
+  maxValue = total == 0 ? other.maxValue : std::max(maxValue, other.maxValue);
+  sum += other.sum;
+  total += other.total;
+}
+
+double LatencyHistogram::quantile(double q) const {
+  if (total == 0)
+    return 0.0;
+  q = std::clamp(q, 0.0, 1.0);
+  // Rank of the requested observation, 1-based
+  uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(q * (double)total));
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      double lower = BucketLowerBound(i);
+      double upper = i + 1 < BUCKET_COUNT ? BucketLowerBound(i + 1) : lower;
+      return std::clamp((lower + upper) * 0.5, minValue, maxValue);
+    }
+  }
+  return maxValue;
+}
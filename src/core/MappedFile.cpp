@@ -0,0 +1,60 @@
+#include "core/MappedFile.hpp"
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PARKLOGIC_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PARKLOGIC_HAS_MMAP 0
+#endif
+
+/**
+ * @file MappedFile.cpp
+ * @brief POSIX implementation of MappedFile.
+ */
+
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string &path) {
+#if PARKLOGIC_HAS_MMAP
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+  struct stat info {};
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  size_t length = (size_t)info.st_size;
+  void *mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+    return nullptr;
+  return std::unique_ptr<MappedFile>(new MappedFile(static_cast<const unsigned char *>(mapped), length));
+#else
+  (void)path;
+  return nullptr;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if PARKLOGIC_HAS_MMAP
+  munmap(const_cast<unsigned char *>(bytes), length);
+#endif
+}
+
+void MappedFile::adviseSequential(size_t offset, size_t bytes) const {
+#if PARKLOGIC_HAS_MMAP
+  // madvise needs a page-aligned start
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t start = offset / page * page;
+  if (start >= length)
+    return;
+  size_t end = std::min(offset + bytes, length);
+  madvise(const_cast<unsigned char *>(this->bytes) + start, end - start, MADV_SEQUENTIAL);
+#else
+  (void)offset;
+  (void)bytes;
+#endif
+}
@@ -0,0 +1,105 @@
+#include "core/MetricsStore.hpp"
+#include "core/Logger.hpp"
+#include <cmath>
+#include <fstream>
+
+/**
+ * @file MetricsStore.cpp
+ * @brief Implementation of the tiered metrics time series.
+ */
+
+namespace {
+constexpr std::array<const char *, METRIC_COUNT> COLUMN_NAMES = {
+    "occupancy_small_parking",
+    "occupancy_large_parking",
+    "occupancy_small_charging",
+    "occupancy_large_charging",
+    "cars_driving",
+    "cars_aligning",
+    "cars_parked",
+    "cars_exiting",
+    "spawns_per_min",
+    "exits_per_min",
+    "pass_throughs_per_min",
+    "avg_battery",
+};
+} // namespace
+
+MetricsStore::MetricsStore(const MetricsConfig &config) : config(config) {
+  if (this->config.sampleInterval <= 0.0)
+    this->config.sampleInterval = 1.0;
+  tiers.emplace_back("1s", 1.0, config.secondCapacity);
+  if (config.downsample) {
+    tiers.emplace_back("1m", 60.0, config.minuteCapacity);
+    tiers.emplace_back("1h", 3600.0, config.hourCapacity);
+  }
+}
+
+const char *MetricsStore::ColumnName(Metric metric) { return COLUMN_NAMES[static_cast<size_t>(metric)]; }
+
+MetricsSample MetricsStore::Average(const Tier &tier) {
+  MetricsSample avg = tier.pending;
+  if (tier.pendingCount > 0) {
+    for (float &v : avg.values)
+      v /= (float)tier.pendingCount;
+  }
+  return avg;
+}
+
+void MetricsStore::record(const MetricsSample &sample) {
+  for (Tier &tier : tiers) {
+    // Samples stamp the end of their interval, so one landing exactly on a boundary closes that bucket
+    long long bucket = (long long)std::ceil(sample.simTime / tier.period - 1e-9);
+
+    if (bucket != tier.pendingBucket && tier.pendingCount > 0) {
+      tier.rows.push(Average(tier));
+      tier.pending = {};
+      tier.pendingCount = 0;
+    }
+
+    tier.pendingBucket = bucket;
+    tier.pending.simTime = sample.simTime;
+    for (size_t i = 0; i < METRIC_COUNT; ++i)
+      tier.pending.values[i] += sample.values[i];
+    tier.pendingCount++;
+  }
+}
+
+void MetricsStore::writeCsv(std::ostream &out, size_t tierIndex) const {
+  if (tierIndex >= tiers.size())
+    return;
+  const Tier &tier = tiers[tierIndex];
+
+  out << "sim_time";
+  for (const char *name : COLUMN_NAMES)
+    out << ',' << name;
+  out << '\n';
+
+  auto writeRow = [&out](const MetricsSample &row) {
+    out << row.simTime;
+    for (float v : row.values)
+      out << ',' << v;
+    out << '\n';
+  };
+
+  for (size_t i = 0; i < tier.rows.size(); ++i)
+    writeRow(tier.rows[i]);
+  if (tier.pendingCount > 0)
+    writeRow(Average(tier));
+}
+
+bool MetricsStore::exportCsv(const std::string &prefix) const {
+  bool ok = true;
+  for (size_t i = 0; i < tiers.size(); ++i) {
+    std::string path = prefix + "_" + tiers[i].name + ".csv";
+    std::ofstream file(path);
+    if (!file) {
+      Logger::Error("MetricsStore: Cannot write {}", path);
+      ok = false;
+      continue;
+    }
+    writeCsv(file, i);
+    Logger::Info("MetricsStore: Exported {} rows to {}", tiers[i].rows.size(), path);
+  }
+  return ok;
+}
@@ -0,0 +1,162 @@
+#include "core/OpenMetricsExporter.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+/**
+ * @file OpenMetricsExporter.cpp
+ * @brief Implementation of the OpenMetrics telemetry file writer.
+ */
+
+namespace {
+uint64_t ResidentBytes() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  uint64_t sizePages = 0;
+  uint64_t residentPages = 0;
+  if (statm >> sizePages >> residentPages)
+    return residentPages * (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+  return 0;
+}
+
+constexpr std::array<const char *, SimulationStats::CAR_STATE_COUNT> CAR_STATE_LABELS = {"driving", "aligning",
+                                                                                         "parked", "exiting"};
+constexpr std::array<const char *, SimulationStats::MODULE_TYPE_COUNT> MODULE_TYPE_LABELS = {
+    "generic", "road", "small_parking", "large_parking", "small_charging", "large_charging"};
+
+void Family(std::ostream &out, const char *name, const char *type, const char *help) {
+  out << "# TYPE " << name << ' ' << type << '\n' << "# HELP " << name << ' ' << help << '\n';
+}
+} // namespace
+
+OpenMetricsExporter::OpenMetricsExporter(std::string path, double intervalSeconds)
+    : path(std::move(path)), interval(intervalSeconds > 0.0 ? intervalSeconds : 5.0),
+      lastWrite(std::chrono::steady_clock::now()) {
+  worker = std::thread([this]() { run(); });
+  Logger::Info("OpenMetricsExporter: Writing {} every {:.1f} s", this->path, interval.count());
+}
+
+OpenMetricsExporter::~OpenMetricsExporter() {
+  {
+    std::scoped_lock lock(stopMutex);
+    stopping = true;
+  }
+  stopSignal.notify_one();
+  if (worker.joinable())
+    worker.join();
+}
+
+void OpenMetricsExporter::run() {
+  std::unique_lock lock(stopMutex);
+  while (true) {
+    bool stop = stopSignal.wait_for(lock, interval, [this]() { return stopping; });
+    lock.unlock();
+    writeFile(); // A final write on shutdown keeps the file's counters current
+    lock.lock();
+    if (stop)
+      return;
+  }
+}
+
+void OpenMetricsExporter::writeFile() {
+  TelemetrySample sample;
+  while (samples.pop(sample)) {
+    windowTicks += sample.windowTicks;
+    windowTickSeconds += sample.windowTickSeconds;
+    windowTickMax = std::max(windowTickMax, sample.windowTickMax);
+    latest = sample;
+    hasSample = true;
+  }
+  if (!hasSample)
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+  double elapsed = std::chrono::duration<double>(now - lastWrite).count();
+
+  Rates rates;
+  if (elapsed > 0.0) {
+    rates.ticksPerSecond = (double)(latest.ticks - lastWrittenTicks) / elapsed;
+    rates.eventsPerSecond = (double)(latest.eventsPublished - lastWrittenEvents) / elapsed;
+  }
+  rates.tickSecondsMean = windowTicks > 0 ? windowTickSeconds / (double)windowTicks : 0.0;
+  rates.tickSecondsMax = windowTickMax;
+  rates.residentBytes = ResidentBytes();
+
+  std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::trunc);
+    if (!out) {
+      Logger::Error("OpenMetricsExporter: Cannot write {}", tmpPath);
+      return;
+    }
+    Format(out, latest, rates);
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    Logger::Error("OpenMetricsExporter: Cannot replace {}: {}", path, ec.message());
+    return;
+  }
+
+  lastWrite = now;
+  lastWrittenTicks = latest.ticks;
+  lastWrittenEvents = latest.eventsPublished;
+  windowTicks = 0;
+  windowTickSeconds = 0.0;
+  windowTickMax = 0.0;
+}
+
+void OpenMetricsExporter::Format(std::ostream &out, const TelemetrySample &sample, const Rates &rates) {
+  const SimulationStats &stats = sample.stats;
+
+  Family(out, "parklogic_ticks", "counter", "Fixed simulation steps executed.");
+  out << "parklogic_ticks_total " << sample.ticks << '\n';
+  Family(out, "parklogic_sim_time_seconds", "gauge", "Simulated time.");
+  out << "parklogic_sim_time_seconds " << sample.simTime << '\n';
+  Family(out, "parklogic_ticks_per_second", "gauge", "Ticks executed per wall-clock second since the last write.");
+  out << "parklogic_ticks_per_second " << rates.ticksPerSecond << '\n';
+  Family(out, "parklogic_tick_duration_seconds", "gauge", "Wall time per tick since the last write.");
+  out << "parklogic_tick_duration_seconds{stat=\"mean\"} " << rates.tickSecondsMean << '\n';
+  out << "parklogic_tick_duration_seconds{stat=\"max\"} " << rates.tickSecondsMax << '\n';
+
+  Family(out, "parklogic_events_published", "counter", "Events published on the simulation bus.");
+  out << "parklogic_events_published_total " << sample.eventsPublished << '\n';
+  Family(out, "parklogic_event_publish_rate", "gauge", "Events published per wall-clock second since the last write.");
+  out << "parklogic_event_publish_rate " << rates.eventsPerSecond << '\n';
+
+  Family(out, "parklogic_cars", "gauge", "Cars currently on the map.");
+  for (size_t s = 0; s < SimulationStats::CAR_STATE_COUNT; ++s)
+    out << "parklogic_cars{state=\"" << CAR_STATE_LABELS[s] << "\"} " << stats.carsByState[s] << '\n';
+
+  Family(out, "parklogic_cars_spawned", "counter", "Cars spawned.");
+  out << "parklogic_cars_spawned_total " << stats.totalSpawned << '\n';
+  Family(out, "parklogic_cars_exited", "counter", "Cars that left the map after parking.");
+  out << "parklogic_cars_exited_total " << stats.totalExited << '\n';
+  Family(out, "parklogic_cars_passed_through", "counter", "Cars that left the map without parking.");
+  out << "parklogic_cars_passed_through_total " << stats.totalPassedThrough << '\n';
+
+  Family(out, "parklogic_spots", "gauge", "Parking and charging spots by facility type and state.");
+  for (size_t t = 0; t < SimulationStats::MODULE_TYPE_COUNT; ++t) {
+    const FacilityStats &f = stats.byType[t];
+    if (f.totalSpots == 0)
+      continue;
+    out << "parklogic_spots{type=\"" << MODULE_TYPE_LABELS[t] << "\",state=\"free\"} " << f.free << '\n';
+    out << "parklogic_spots{type=\"" << MODULE_TYPE_LABELS[t] << "\",state=\"reserved\"} " << f.reserved << '\n';
+    out << "parklogic_spots{type=\"" << MODULE_TYPE_LABELS[t] << "\",state=\"occupied\"} " << f.occupied << '\n';
+  }
+
+  if (rates.residentBytes > 0) {
+    Family(out, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes.");
+    out << "process_resident_memory_bytes " << rates.residentBytes << '\n';
+  }
+
+  out << "# EOF\n";
+}
@@ -0,0 +1,265 @@
+#include "core/Simulation.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include "core/OpenMetricsExporter.hpp"
+#include "systems/HeatmapSystem.hpp"
+#include "systems/MetricsSystem.hpp"
+#include "systems/StatsSystem.hpp"
+#include "systems/TrafficSystem.hpp"
+#include "systems/TripLatencySystem.hpp"
+#include <algorithm>
+
+/**
+ * @file Simulation.cpp
+ * @brief Implementation of the thread-agnostic simulation core.
+ */
+
+Simulation::Simulation(const MapConfig &config, const MetricsConfig &metricsConfig)
+    : bus(std::make_shared<EventBus>()) {
+  entityManager = std::make_unique<EntityManager>(bus);
+  trafficSystem = std::make_unique<TrafficSystem>(bus, *entityManager);
+  // Must exist before world generation so it sees WorldBoundsEvent
+  statsSystem = std::make_unique<StatsSystem>(bus, *entityManager);
+  metricsSystem = std::make_unique<MetricsSystem>(*entityManager, *statsSystem, metricsConfig);
+  tripLatencySystem = std::make_unique<TripLatencySystem>(bus);
+  heatmapSystem = std::make_unique<HeatmapSystem>(bus); // Sized by WorldBoundsEvent, like StatsSystem
+
+  // Mirror state that otherwise only exists as events
+  eventTokens.push_back(bus->subscribe<AutoSpawnLevelChangedEvent>(
+      [this](const AutoSpawnLevelChangedEvent &e) { spawnLevel = e.newLevel; }));
+
+  eventTokens.push_back(bus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
+    if (e.car)
+      lastSpawnedCarId = e.car->getId();
+  }));
+
+  eventTokens.push_back(bus->subscribe<ExportMetricsEvent>(
+      [this](const ExportMetricsEvent &e) {
+        metricsSystem->getStore().exportCsv(e.prefix);
+        tripLatencySystem->getLatencies().exportCsv(e.prefix);
+        heatmapSystem->exportCsv(e.prefix);
+      }));
+
+  bus->publish(GenerateWorldEvent{config});
+}
+
+Simulation::~Simulation() {
+  openMetrics.reset(); // Joins the writer after a final write
+  sharedTelemetry.reset();
+  trajectory.reset(); // Writes the remaining rows and the chunk index
+  eventTokens.clear();
+  journal.reset();
+  heatmapSystem.reset();
+  tripLatencySystem.reset();
+  metricsSystem.reset();
+  statsSystem.reset();
+  trafficSystem.reset();
+  entityManager.reset();
+}
+
+void Simulation::step(double dt) {
+  tick++;
+  simTime += dt;
+  // Transitions during this tick are timestamped with its end time
+  tripLatencySystem->setTime(simTime);
+
+  if (!openMetrics) {
+    advance(dt);
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  advance(dt);
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  windowTicks++;
+  windowTickSeconds += seconds;
+  windowTickMax = std::max(windowTickMax, seconds);
+
+  // A few samples per export interval, however fast the simulation runs, so the exporter's queue never fills
+  if (end - lastTelemetrySubmit >= telemetrySubmitPeriod) {
+    lastTelemetrySubmit = end;
+    submitTelemetry();
+  }
+}
+
+void Simulation::advance(double dt) {
+  bus->publish(GameUpdateEvent{dt});
+  heatmapSystem->update(simTime, dt, entityManager->getCars());
+  metricsSystem->update(simTime);
+  if (sharedTelemetry && tick % sharedTelemetryStride == 0)
+    writeSharedTelemetry();
+  if (trajectory && tick % trajectoryStride == 0)
+    writeTrajectorySample();
+}
+
+void Simulation::enableOpenMetrics(const std::string &path, double intervalSeconds) {
+  openMetrics = std::make_unique<OpenMetricsExporter>(path, intervalSeconds);
+  telemetrySubmitPeriod = openMetrics->getInterval() / 4.0;
+  lastTelemetrySubmit = std::chrono::steady_clock::now();
+  submitTelemetry();
+}
+
+bool Simulation::enableSharedMemoryTelemetry(const std::string &name, uint32_t slotCount, uint32_t maxCars,
+                                             uint32_t everyTicks) {
+  uint32_t spotCount = 0;
+  for (const auto &mod : entityManager->getModules())
+    spotCount += (uint32_t)mod->getSpotCount();
+
+  sharedTelemetry = TelemetryRingWriter::Create(name, slotCount, maxCars, spotCount);
+  if (!sharedTelemetry) {
+    Logger::Error("Simulation: Cannot create shared-memory telemetry segment {}", name);
+    return false;
+  }
+  sharedTelemetryStride = std::max(1u, everyTicks);
+  telemetryFrame.cars.reserve(maxCars);
+  telemetryFrame.spots.reserve(spotCount);
+  Logger::Info("Simulation: Shared-memory telemetry at {} ({} slots, {} cars, {} spots)", name, slotCount, maxCars,
+               spotCount);
+  return true;
+}
+
+bool Simulation::enableTrajectoryLog(const std::string &path, uint32_t everyTicks, uint32_t carModulo) {
+  trajectoryStride = std::max(1u, everyTicks);
+  trajectoryCarModulo = std::max(1u, carModulo);
+  trajectory = TrajectoryWriter::Open(path, (double)Config::TICK_RATE, trajectoryStride);
+  if (!trajectory) {
+    Logger::Error("Simulation: Cannot create trajectory file {}", path);
+    return false;
+  }
+  Logger::Info("Simulation: Recording trajectories to {} (every {} ticks, 1 in {} cars)", path, trajectoryStride,
+               trajectoryCarModulo);
+  return true;
+}
+
+bool Simulation::enableEventJournal(const std::string &path) {
+  std::vector<JournalFacility> facilities;
+  for (const auto &mod : entityManager->getModules()) {
+    if (mod->getSpotCount() == 0)
+      continue;
+    // Records store 32-bit facility and 16-bit spot indices; refuse rather than log wrapped ones
+    if (facilities.size() >= JournalRecord::NO_FACILITY || mod->getSpotCount() > UINT16_MAX) {
+      Logger::Error("Simulation: Map too large for an event journal ({}+ facilities, {} spots in one)",
+                    facilities.size(), mod->getSpotCount());
+      journalFacilities.clear();
+      return false;
+    }
+    journalFacilities[mod.get()] = (uint32_t)facilities.size();
+    facilities.push_back({(uint32_t)mod->getType(), (uint32_t)mod->getSpotCount()});
+  }
+
+  journal = EventJournalWriter::Open(path, (double)Config::TICK_RATE, facilities);
+  if (!journal) {
+    Logger::Error("Simulation: Cannot create event journal {}", path);
+    return false;
+  }
+
+  eventTokens.push_back(bus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
+    if (e.car)
+      journalCar(JournalEventKind::CAR_SPAWNED, *e.car);
+  }));
+  eventTokens.push_back(bus->subscribe<CarStateChangedEvent>([this](const CarStateChangedEvent &e) {
+    if (e.car)
+      journalCar(JournalEventKind::CAR_STATE, *e.car);
+  }));
+  eventTokens.push_back(bus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
+    if (e.car)
+      journalCar(JournalEventKind::CAR_REMOVED, *e.car);
+  }));
+  eventTokens.push_back(bus->subscribe<SpotStateChangedEvent>([this](const SpotStateChangedEvent &e) {
+    auto it = journalFacilities.find(e.facility);
+    if (it == journalFacilities.end())
+      return;
+    JournalRecord record{};
+    record.tick = tick;
+    record.facility = it->second;
+    record.spot = (uint16_t)e.spotIndex;
+    record.kind = JournalEventKind::SPOT_STATE;
+    record.state = (uint8_t)e.current;
+    record.previous = (uint8_t)e.previous;
+    journal->append(record);
+  }));
+
+  Logger::Info("Simulation: Journaling events to {} ({} facilities)", path, facilities.size());
+  return true;
+}
+
+void Simulation::journalCar(JournalEventKind kind, const Car &car) {
+  JournalRecord record{};
+  record.tick = tick;
+  record.carId = car.getId();
+  record.facility = JournalRecord::NO_FACILITY;
+  record.kind = kind;
+  record.state = (uint8_t)car.getState();
+  record.carType = (uint8_t)car.getType();
+  record.priority = (uint8_t)car.getPriority();
+  if (kind == JournalEventKind::CAR_STATE && car.getState() == Car::CarState::PARKED) {
+    auto it = journalFacilities.find(car.getParkedFacility());
+    if (it != journalFacilities.end())
+      record.facility = it->second;
+  }
+  journal->append(record);
+}
+
+void Simulation::writeTrajectorySample() {
+  for (const auto &car : entityManager->getCars()) {
+    if (car->getId() % trajectoryCarModulo != 0)
+      continue;
+    Vector2 pos = car->getPosition();
+    Vector2 vel = car->getVelocity();
+    trajectory->append({tick, car->getId(), pos.x, pos.y, vel.x, vel.y, (uint8_t)car->getState(),
+                        car->getWaypointIndex(), car->getBatteryLevel()});
+  }
+}
+
+void Simulation::writeSharedTelemetry() {
+  const SimulationStats &stats = statsSystem->getStats();
+  TelemetryFrame &frame = telemetryFrame;
+  frame.tick = tick;
+  frame.simTime = simTime;
+  frame.totalSpawned = stats.totalSpawned;
+  frame.totalExited = stats.totalExited;
+  frame.totalPassedThrough = stats.totalPassedThrough;
+
+  frame.cars.clear();
+  for (const auto &car : entityManager->getCars()) {
+    Vector2 pos = car->getPosition();
+    frame.cars.push_back({car->getId(), pos.x, pos.y, car->getRotation(), car->getBatteryLevel(),
+                          (uint8_t)car->getState(), (uint8_t)car->getType(), 0});
+  }
+
+  frame.spots.clear();
+  for (const auto &mod : entityManager->getModules()) {
+    for (size_t i = 0; i < mod->getSpotCount(); ++i)
+      frame.spots.push_back((uint8_t)mod->getSpot((int)i).state);
+  }
+
+  sharedTelemetry->write(frame);
+}
+
+void Simulation::submitTelemetry() {
+  TelemetrySample sample;
+  sample.ticks = tick;
+  sample.simTime = simTime;
+  sample.eventsPublished = bus->getPublishCount();
+  sample.windowTicks = windowTicks;
+  sample.windowTickSeconds = windowTickSeconds;
+  sample.windowTickMax = windowTickMax;
+  sample.stats = statsSystem->getStats();
+  openMetrics->submit(sample);
+
+  windowTicks = 0;
+  windowTickSeconds = 0.0;
+  windowTickMax = 0.0;
+}
+
+const SimulationStats &Simulation::getStats() const { return statsSystem->getStats(); }
+
+const MetricsStore &Simulation::getMetrics() const { return metricsSystem->getStore(); }
+
+const TripLatencies &Simulation::getTripLatencies() const { return tripLatencySystem->getLatencies(); }
+
+std::shared_ptr<const HeatmapGrid> Simulation::getHeatmapGrid() { return heatmapSystem->getGrid(); }
+
+const TripLatencySummary &Simulation::getTripSummary() { return tripLatencySystem->getSummary(); }
@@ -0,0 +1,183 @@
+#include "core/SimulationThread.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include <cstdlib>
+
+/**
+ * @file SimulationThread.cpp
+ * @brief Implementation of the threaded simulation host.
+ */
+
+SimulationThread::SimulationThread(const MapConfig &config, const MetricsConfig &metricsConfig) {
+  // World generation happens here, before the worker exists, so the layout is immutable once shared.
+  simulation = std::make_unique<Simulation>(config, metricsConfig);
+
+  // Opt-in live telemetry for monitoring long GUI sessions
+  if (const char *openMetricsPath = std::getenv("PARKLOGIC_OPENMETRICS_FILE")) {
+    simulation->enableOpenMetrics(openMetricsPath, Config::OPENMETRICS_INTERVAL);
+  }
+  if (const char *shmName = std::getenv("PARKLOGIC_SHM_NAME")) {
+    simulation->enableSharedMemoryTelemetry(shmName, Config::SHM_TELEMETRY_SLOTS, Config::SHM_TELEMETRY_MAX_CARS);
+  }
+  if (const char *trajectoryPath = std::getenv("PARKLOGIC_TRAJECTORY_FILE")) {
+    simulation->enableTrajectoryLog(trajectoryPath, Config::TRAJECTORY_SAMPLE_TICKS);
+  }
+  if (const char *journalPath = std::getenv("PARKLOGIC_JOURNAL_FILE")) {
+    simulation->enableEventJournal(journalPath);
+  }
+
+  // The first world was generated above; later ones announce themselves
+  rebuildLayout();
+  worldBoundsToken = simulation->subscribe<WorldBoundsEvent>([this](const WorldBoundsEvent &) { rebuildLayout(); });
+
+  // Make an initial snapshot available immediately
+  publishSnapshot();
+}
+
+SimulationThread::~SimulationThread() {
+  stop();
+  simulation.reset();
+}
+
+void SimulationThread::start() {
+  if (running.exchange(true))
+    return;
+  worker = std::thread([this]() { run(); });
+  Logger::Info("SimulationThread: Started.");
+}
+
+void SimulationThread::stop() {
+  if (!running.exchange(false))
+    return;
+  wakeSignal.fetch_add(1, std::memory_order_release);
+  wakeSignal.notify_one();
+  if (worker.joinable())
+    worker.join();
+  Logger::Info("SimulationThread: Stopped after {} ticks.", simulation->getTick());
+}
+
+bool SimulationThread::post(SimulationCommand command) {
+  if (!commands.push(std::move(command)))
+    return false;
+  wakeSignal.fetch_add(1, std::memory_order_release);
+  wakeSignal.notify_one();
+  return true;
+}
+
+std::shared_ptr<const SimulationSnapshot> SimulationThread::pollSnapshot() {
+  std::shared_ptr<const SimulationSnapshot> latest;
+  std::shared_ptr<const SimulationSnapshot> next;
+  while (snapshots.pop(next)) {
+    latest = std::move(next);
+  }
+  return latest;
+}
+
+/**
+ * @brief Worker loop.
+ *
+ * Drains all pending commands, publishes one snapshot for the batch, then sleeps until
+ * the next post(). The wake counter is read before draining so a post that races with
+ * the drain always wakes the following wait().
+ */
+void SimulationThread::run() {
+  while (running.load(std::memory_order_acquire)) {
+    uint32_t seen = wakeSignal.load(std::memory_order_acquire);
+
+    bool didWork = false;
+    SimulationCommand command;
+    while (commands.pop(command)) {
+      execute(command);
+      didWork = true;
+    }
+
+    if (didWork)
+      publishSnapshot();
+
+    wakeSignal.wait(seen, std::memory_order_acquire);
+  }
+}
+
+void SimulationThread::execute(const SimulationCommand &command) {
+  std::visit(
+      [this](const auto &cmd) {
+        using T = std::decay_t<decltype(cmd)>;
+        if constexpr (std::is_same_v<T, SimulationTickCommand>) {
+          simulation->step(cmd.dt);
+        } else {
+          simulation->publish(cmd);
+        }
+      },
+      command);
+}
+
+void SimulationThread::publishSnapshot() {
+  auto snapshot = std::make_shared<SimulationSnapshot>();
+  snapshot->tick = simulation->getTick();
+  snapshot->simTime = simulation->getSimTime();
+  snapshot->spawnLevel = simulation->getSpawnLevel();
+  snapshot->lastSpawnedCarId = simulation->getLastSpawnedCarId();
+  snapshot->stats = simulation->getStats();
+  snapshot->trips = simulation->getTripSummary();
+  snapshot->heatmap = simulation->getHeatmapGrid();
+
+  const EntityManager &entityManager = simulation->getEntityManager();
+  const auto &cars = entityManager.getCars();
+  snapshot->cars.reserve(cars.size());
+  for (const auto &car : cars) {
+    CarSnapshot cs;
+    cs.id = car->getId();
+    cs.position = car->getPosition();
+    cs.velocity = car->getVelocity();
+    cs.rotation = car->getRotation();
+    cs.type = car->getType();
+    cs.state = car->getState();
+    cs.priority = car->getPriority();
+    cs.batteryLevel = car->getBatteryLevel();
+    cs.texture = car->getTexture();
+    if (car->isSelected()) {
+      for (const auto &wp : car->getWaypoints())
+        cs.path.push_back(wp.position);
+    }
+    snapshot->cars.push_back(std::move(cs));
+  }
+
+  // Geometry is shared through the layout; only the dynamic spot state is copied
+  const SpotRegistry &registry = entityManager.getSpotRegistry();
+  snapshot->layout = layout;
+  snapshot->facilityCounts.reserve(registry.getFacilities().size());
+  for (const Module *mod : registry.getFacilities())
+    snapshot->facilityCounts.push_back(mod->getSpotCounts());
+  snapshot->spotStates.resize(registry.size());
+  for (uint32_t spot = 0; spot < registry.size(); ++spot)
+    snapshot->spotStates[spot] = registry.getState(spot);
+  if (!spotPrices || spotPricesVersion != registry.getPriceVersion()) {
+    std::span<const float> prices = registry.getPrices();
+    spotPrices = std::make_shared<const std::vector<float>>(prices.begin(), prices.end());
+    spotPricesVersion = registry.getPriceVersion();
+  }
+  snapshot->spotPrices = spotPrices;
+
+  // If the render thread has fallen behind the queue is full and this snapshot is dropped;
+  // a newer one follows the next batch.
+  snapshots.push(std::move(snapshot));
+}
+
+void SimulationThread::rebuildLayout() {
+  auto next = std::make_shared<SnapshotLayout>();
+  const SpotRegistry &registry = simulation->getEntityManager().getSpotRegistry();
+  for (uint32_t f = 0; f < (uint32_t)registry.getFacilities().size(); ++f) {
+    const Module *mod = registry.getFacilities()[f];
+    auto [first, last] = registry.getFacilityRange(f);
+    next->facilities.push_back({mod->getType(),
+                                {mod->worldPosition.x, mod->worldPosition.y, mod->getWidth(), mod->getHeight()},
+                                mod->getPriceMultiplier(),
+                                first,
+                                last - first});
+  }
+  next->spotPositions.reserve(registry.size());
+  for (uint32_t spot = 0; spot < registry.size(); ++spot)
+    next->spotPositions.push_back(registry.getPosition(spot));
+  layout = std::move(next);
+  spotPrices.reset();
+}
@@ -0,0 +1,76 @@
+#include "core/SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file SpatialGrid.cpp
+ * @brief Implementation of SpatialGrid.
+ */
+
+SpatialGrid::SpatialGrid(float width, float height, float cellSize) : cellSize(cellSize > 0.0f ? cellSize : 1.0f) {
+  cols = std::max(1, (int)std::ceil(width / this->cellSize));
+  rows = std::max(1, (int)std::ceil(height / this->cellSize));
+  cells.resize((size_t)cols * rows);
+}
+
+SpatialGrid::CellRange SpatialGrid::cellRange(Rectangle area) const {
+  CellRange r;
+  r.x0 = std::clamp((int)std::floor(area.x / cellSize), 0, cols - 1);
+  r.y0 = std::clamp((int)std::floor(area.y / cellSize), 0, rows - 1);
+  r.x1 = std::clamp((int)std::floor((area.x + area.width) / cellSize), 0, cols - 1);
+  r.y1 = std::clamp((int)std::floor((area.y + area.height) / cellSize), 0, rows - 1);
+  return r;
+}
+
+void SpatialGrid::insert(int id, Rectangle bounds) {
+  if (id < 0)
+    return;
+  if ((size_t)id >= stamps.size())
+    stamps.resize((size_t)id + 1, 0);
+
+  CellRange r = cellRange(bounds);
+  for (int y = r.y0; y <= r.y1; ++y) {
+    for (int x = r.x0; x <= r.x1; ++x) {
+      std::vector<int> &cell = cells[(size_t)y * cols + x];
+      if (cell.empty())
+        usedCells.push_back((size_t)y * cols + x);
+      cell.push_back(id);
+    }
+  }
+}
+
+void SpatialGrid::query(Rectangle area, std::vector<int> &out) const {
+  out.clear();
+  if (area.width < 0 || area.height < 0)
+    return;
+  if (area.x > cols * cellSize || area.y > rows * cellSize || area.x + area.width < 0 || area.y + area.height < 0)
+    return; // Entirely outside the grid
+
+  // Stamp wrap-around: reset so stale stamps can't collide with the new one
+  if (++queryStamp == 0) {
+    std::fill(stamps.begin(), stamps.end(), 0);
+    queryStamp = 1;
+  }
+
+  CellRange r = cellRange(area);
+  for (int y = r.y0; y <= r.y1; ++y) {
+    for (int x = r.x0; x <= r.x1; ++x) {
+      for (int id : cells[(size_t)y * cols + x]) {
+        if (stamps[id] != queryStamp) {
+          stamps[id] = queryStamp;
+          out.push_back(id);
+        }
+      }
+    }
+  }
+  std::sort(out.begin(), out.end());
+}
+
+void SpatialGrid::clear() {
+  for (size_t cell : usedCells) {
+    cells[cell].clear();
+  }
+  usedCells.clear();
+  stamps.clear();
+  queryStamp = 0;
+}
@@ -0,0 +1,214 @@
+#include "core/TelemetryRing.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PARKLOGIC_HAS_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PARKLOGIC_HAS_SHM 0
+#endif
+
+/**
+ * @file TelemetryRing.cpp
+ * @brief Implementation of the shared-memory telemetry ring (writer and reader).
+ */
+
+using namespace TelemetryLayout;
+
+namespace {
+Header *HeaderOf(void *base) { return static_cast<Header *>(base); }
+
+unsigned char *SlotOf(void *base, uint64_t frame) {
+  const Header *header = HeaderOf(base);
+  size_t index = (size_t)((frame - 1) % header->slotCount);
+  return static_cast<unsigned char *>(base) + HeaderSize() + index * header->slotSize;
+}
+} // namespace
+
+// --- Writer ---
+
+std::unique_ptr<TelemetryRingWriter> TelemetryRingWriter::Create(const std::string &name, uint32_t slotCount,
+                                                                 uint32_t maxCars, uint32_t maxSpots) {
+#if PARKLOGIC_HAS_SHM
+  if (slotCount == 0)
+    return nullptr;
+  size_t size = HeaderSize() + (size_t)slotCount * SlotSize(maxCars, maxSpots);
+
+  shm_unlink(name.c_str()); // Replace a segment left behind by a crashed run
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0)
+    return nullptr;
+  if (ftruncate(fd, (off_t)size) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+
+  // ftruncate zero-fills, so every slot starts with sequence 0 (even, empty)
+  Header *header = new (base) Header{};
+  header->slotCount = slotCount;
+  header->slotSize = (uint32_t)SlotSize(maxCars, maxSpots);
+  header->maxCars = maxCars;
+  header->maxSpots = maxSpots;
+  header->version = VERSION;
+  header->framesWritten.store(0, std::memory_order_relaxed);
+  // Readers check the magic last, so they never see a half-initialised header
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = MAGIC;
+
+  return std::unique_ptr<TelemetryRingWriter>(new TelemetryRingWriter(name, base, size));
+#else
+  (void)name;
+  (void)slotCount;
+  (void)maxCars;
+  (void)maxSpots;
+  return nullptr;
+#endif
+}
+
+TelemetryRingWriter::TelemetryRingWriter(std::string name, void *base, size_t size)
+    : name(std::move(name)), base(base), size(size) {}
+
+TelemetryRingWriter::~TelemetryRingWriter() {
+#if PARKLOGIC_HAS_SHM
+  munmap(base, size);
+  shm_unlink(name.c_str());
+#endif
+}
+
+void TelemetryRingWriter::write(const TelemetryFrame &frame) {
+  Header *header = HeaderOf(base);
+  uint64_t number = nextFrame++;
+  unsigned char *slot = SlotOf(base, number);
+  auto *slotHeader = reinterpret_cast<SlotHeader *>(slot);
+
+  // Seqlock: odd = write in progress
+  uint64_t sequence = slotHeader->sequence.load(std::memory_order_relaxed);
+  slotHeader->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  uint32_t carCount = (uint32_t)std::min<size_t>(frame.cars.size(), header->maxCars);
+  uint32_t spotCount = (uint32_t)std::min<size_t>(frame.spots.size(), header->maxSpots);
+
+  slotHeader->frame = number;
+  slotHeader->tick = frame.tick;
+  slotHeader->simTime = frame.simTime;
+  slotHeader->totalSpawned = frame.totalSpawned;
+  slotHeader->totalExited = frame.totalExited;
+  slotHeader->totalPassedThrough = frame.totalPassedThrough;
+  slotHeader->carCount = carCount;
+  slotHeader->spotCount = spotCount;
+  slotHeader->flags = (frame.truncated || carCount < frame.cars.size()) ? 1u : 0u;
+
+  unsigned char *cars = slot + sizeof(SlotHeader);
+  std::memcpy(cars, frame.cars.data(), carCount * sizeof(TelemetryCar));
+  std::memcpy(cars + header->maxCars * sizeof(TelemetryCar), frame.spots.data(), spotCount);
+
+  slotHeader->sequence.store(sequence + 2, std::memory_order_release);
+  header->framesWritten.store(number, std::memory_order_release);
+}
+
+// --- Reader ---
+
+std::unique_ptr<TelemetryRingReader> TelemetryRingReader::Open(const std::string &name) {
+#if PARKLOGIC_HAS_SHM
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return nullptr;
+  struct stat info {};
+  if (fstat(fd, &info) != 0 || (size_t)info.st_size < HeaderSize()) {
+    close(fd);
+    return nullptr;
+  }
+  size_t size = (size_t)info.st_size;
+  void *base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return nullptr;
+
+  const Header *header = HeaderOf(base);
+  bool compatible = header->magic == MAGIC;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  compatible = compatible && header->version == VERSION && header->slotCount > 0 &&
+               header->slotSize == SlotSize(header->maxCars, header->maxSpots) &&
+               HeaderSize() + (size_t)header->slotCount * header->slotSize <= size;
+  if (!compatible) {
+    munmap(base, size);
+    return nullptr;
+  }
+  return std::unique_ptr<TelemetryRingReader>(new TelemetryRingReader(base, size));
+#else
+  (void)name;
+  return nullptr;
+#endif
+}
+
+TelemetryRingReader::TelemetryRingReader(void *base, size_t size) : base(base), size(size) {}
+
+TelemetryRingReader::~TelemetryRingReader() {
+#if PARKLOGIC_HAS_SHM
+  munmap(base, size);
+#endif
+}
+
+uint32_t TelemetryRingReader::getSlotCount() const { return HeaderOf(base)->slotCount; }
+
+uint64_t TelemetryRingReader::latestFrame() const {
+  return HeaderOf(base)->framesWritten.load(std::memory_order_acquire);
+}
+
+bool TelemetryRingReader::readLatest(TelemetryFrame &out) const {
+  // If the writer laps us mid-copy, the newest frame has moved on; try the new one
+  for (int attempt = 0; attempt < 8; ++attempt) {
+    uint64_t latest = latestFrame();
+    if (latest == 0)
+      return false;
+    if (read(latest, out))
+      return true;
+  }
+  return false;
+}
+
+bool TelemetryRingReader::read(uint64_t frame, TelemetryFrame &out) const {
+  const Header *header = HeaderOf(base);
+  uint64_t latest = latestFrame();
+  if (frame == 0 || frame > latest || latest - frame >= header->slotCount)
+    return false;
+
+  const unsigned char *slot = SlotOf(base, frame);
+  const auto *slotHeader = reinterpret_cast<const SlotHeader *>(slot);
+
+  uint64_t before = slotHeader->sequence.load(std::memory_order_acquire);
+  if (before & 1)
+    return false; // Being overwritten right now
+
+  uint32_t carCount = std::min(slotHeader->carCount, header->maxCars);
+  uint32_t spotCount = std::min(slotHeader->spotCount, header->maxSpots);
+  out.frame = slotHeader->frame;
+  out.tick = slotHeader->tick;
+  out.simTime = slotHeader->simTime;
+  out.totalSpawned = slotHeader->totalSpawned;
+  out.totalExited = slotHeader->totalExited;
+  out.totalPassedThrough = slotHeader->totalPassedThrough;
+  out.truncated = (slotHeader->flags & 1u) != 0;
+  out.cars.resize(carCount);
+  out.spots.resize(spotCount);
+  const unsigned char *cars = slot + sizeof(SlotHeader);
+  std::memcpy(out.cars.data(), cars, carCount * sizeof(TelemetryCar));
+  std::memcpy(out.spots.data(), cars + header->maxCars * sizeof(TelemetryCar), spotCount);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t after = slotHeader->sequence.load(std::memory_order_relaxed);
+  return before == after && out.frame == frame;
+}
@@ -0,0 +1,120 @@
+#include "core/TrajectoryFormat.hpp"
+#include <array>
+#include <bit>
+
+/**
+ * @file TrajectoryFormat.cpp
+ * @brief Column codec of the trajectory file format.
+ */
+
+namespace TrajectoryFormat {
+
+namespace {
+uint64_t ZigZag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+int64_t UnZigZag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+// Wrapping difference, so arbitrary int64 columns round-trip without signed overflow
+int64_t Delta(int64_t to, int64_t from) { return (int64_t)((uint64_t)to - (uint64_t)from); }
+} // namespace
+
+void EncodeColumn(const std::vector<int64_t> &values, ColumnHeader &header, std::vector<uint64_t> &out) {
+  header.first = values.empty() ? 0 : values[0];
+  header.bitWidth = 0;
+  header.byteSize = 0;
+  if (values.size() < 2)
+    return;
+
+  // Deltas by significant bits. At width w < 64 a delta escapes if it has more than w bits, or if
+  // it has exactly w bits and they are all ones (the escape code itself)
+  std::vector<uint64_t> deltas(values.size() - 1);
+  std::array<size_t, 65> bitCounts{};
+  std::array<size_t, 65> allOnes{};
+  for (size_t i = 1; i < values.size(); ++i) {
+    uint64_t z = ZigZag(Delta(values[i], values[i - 1]));
+    int bits = 64 - std::countl_zero(z);
+    deltas[i - 1] = z;
+    bitCounts[bits]++;
+    allOnes[bits] += bits > 0 && std::countr_one(z) == bits;
+  }
+  if (bitCounts[0] == deltas.size())
+    return; // All zero
+
+  int width = 64;
+  size_t bestBits = deltas.size() * 64;
+  size_t wider = 0;
+  for (int w = 63; w >= 1; --w) {
+    wider += bitCounts[w + 1];
+    size_t bits = deltas.size() * (size_t)w + (wider + allOnes[w]) * 64;
+    if (bits <= bestBits) {
+      bestBits = bits;
+      width = w;
+    }
+  }
+  header.bitWidth = (uint8_t)width;
+
+  size_t words = (bestBits + 63) / 64;
+  size_t base = out.size();
+  out.resize(base + words, 0);
+  uint64_t *packed = out.data() + base;
+  const uint64_t escape = width == 64 ? 0 : (1ULL << width) - 1;
+
+  size_t bit = 0;
+  auto put = [&](uint64_t z, size_t bits) {
+    size_t word = bit / 64;
+    size_t shift = bit % 64;
+    packed[word] |= z << shift;
+    if (shift + bits > 64)
+      packed[word + 1] |= z >> (64 - shift);
+    bit += bits;
+  };
+  for (uint64_t z : deltas) {
+    if (width < 64 && z >= escape) {
+      put(escape, (size_t)width);
+      put(z, 64);
+    } else {
+      put(z, (size_t)width);
+    }
+  }
+  header.byteSize = (uint32_t)(words * sizeof(uint64_t));
+}
+
+void DecodeColumn(const ColumnHeader &header, const uint64_t *data, uint32_t rowCount, std::vector<int64_t> &out) {
+  if (rowCount == 0)
+    return;
+  out.reserve(out.size() + rowCount);
+  int64_t value = header.first;
+  out.push_back(value);
+
+  size_t width = header.bitWidth;
+  if (width == 0 || width > 64) {
+    out.insert(out.end(), rowCount - 1, value);
+    return;
+  }
+  const uint64_t mask = width == 64 ? ~0ULL : ((1ULL << width) - 1);
+  const size_t totalBits = (size_t)header.byteSize * 8;
+
+  size_t bit = 0;
+  auto get = [&](size_t bits, uint64_t &z) {
+    if (totalBits - bit < bits)
+      return false;
+    size_t word = bit / 64;
+    size_t shift = bit % 64;
+    z = data[word] >> shift;
+    if (shift + bits > 64)
+      z |= data[word + 1] << (64 - shift);
+    bit += bits;
+    return true;
+  };
+  uint32_t i = 1;
+  for (uint64_t z = 0; i < rowCount; ++i) {
+    if (!get(width, z))
+      break;
+    z &= mask;
+    if (width < 64 && z == mask && !get(64, z))
+      break;
+    value = (int64_t)((uint64_t)value + (uint64_t)UnZigZag(z));
+    out.push_back(value);
+  }
+  out.insert(out.end(), rowCount - i, value); // Damaged column: keep one value per row
+}
+
+} // namespace TrajectoryFormat
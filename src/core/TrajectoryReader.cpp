@@ -0,0 +1,113 @@
+#include "core/TrajectoryReader.hpp"
+#include <algorithm>
+
+/**
+ * @file TrajectoryReader.cpp
+ * @brief Implementation of the memory-mapped trajectory reader.
+ */
+
+using namespace TrajectoryFormat;
+
+std::unique_ptr<TrajectoryReader> TrajectoryReader::Open(const std::string &path) {
+  auto file = MappedFile::Open(path);
+  if (!file || file->size() < sizeof(FileHeader))
+    return nullptr;
+
+  std::unique_ptr<TrajectoryReader> reader(new TrajectoryReader(std::move(file)));
+  const FileHeader *header = reader->header;
+  if (header->magic != FILE_MAGIC || header->version != VERSION || header->columnCount != COLUMN_COUNT)
+    return nullptr;
+  if (!reader->loadIndex())
+    reader->scanChunks();
+  return reader;
+}
+
+TrajectoryReader::TrajectoryReader(std::unique_ptr<MappedFile> file)
+    : file(std::move(file)), data(this->file->data()), size(this->file->size()),
+      header(reinterpret_cast<const FileHeader *>(data)) {}
+
+bool TrajectoryReader::loadIndex() {
+  if (size < sizeof(FileHeader) + sizeof(Trailer))
+    return false;
+  const auto *trailer = reinterpret_cast<const Trailer *>(data + size - sizeof(Trailer));
+  if (trailer->magic != TRAILER_MAGIC)
+    return false;
+  size_t indexBytes = (size_t)trailer->chunkCount * sizeof(ChunkIndexEntry);
+  if (trailer->indexOffset > size || trailer->indexOffset + indexBytes + sizeof(Trailer) != size)
+    return false;
+
+  const auto *entries = reinterpret_cast<const ChunkIndexEntry *>(data + trailer->indexOffset);
+  for (uint32_t i = 0; i < trailer->chunkCount; ++i) {
+    // A damaged index falls back to scanning, which keeps every chunk before the damage
+    if (checkChunk(entries[i].offset) == 0 ||
+        reinterpret_cast<const ChunkHeader *>(data + entries[i].offset)->rowCount != entries[i].rowCount) {
+      chunks.clear();
+      return false;
+    }
+    chunks.push_back(entries[i]);
+  }
+  return true;
+}
+
+size_t TrajectoryReader::checkChunk(uint64_t offset) const {
+  if (offset < sizeof(FileHeader) || offset > size || size - offset < sizeof(ChunkHeader))
+    return 0;
+  const auto *chunk = reinterpret_cast<const ChunkHeader *>(data + offset);
+  if (chunk->magic != CHUNK_MAGIC)
+    return 0;
+
+  // Every column must lie inside the file, after its chunk header, and hold all the bits DecodeColumn reads
+  const uint64_t dataStart = offset + sizeof(ChunkHeader);
+  const uint64_t deltaBits = chunk->rowCount > 0 ? (uint64_t)(chunk->rowCount - 1) : 0;
+  uint64_t end = dataStart;
+  for (const ColumnHeader &column : chunk->columns) {
+    if (column.offset < dataStart || column.offset % sizeof(uint64_t) != 0 || column.offset > size ||
+        size - column.offset < column.byteSize || column.bitWidth > 64)
+      return 0;
+    uint64_t words = (deltaBits * column.bitWidth + 63) / 64;
+    if ((uint64_t)column.byteSize < words * sizeof(uint64_t))
+      return 0;
+    end = std::max(end, column.offset + column.byteSize);
+  }
+  return (size_t)end;
+}
+
+void TrajectoryReader::scanChunks() {
+  recovered = true;
+  size_t offset = sizeof(FileHeader);
+  while (size_t end = checkChunk(offset)) {
+    // A chunk that fails the check is the truncated end of a crashed run
+    const auto *chunk = reinterpret_cast<const ChunkHeader *>(data + offset);
+    chunks.push_back({offset, chunk->firstTick, chunk->lastTick, chunk->rowCount, 0});
+    offset = end;
+  }
+}
+
+void TrajectoryReader::decodeColumn(size_t chunk, TrajectoryColumn column, std::vector<int64_t> &out) const {
+  const auto *chunkHeader = reinterpret_cast<const ChunkHeader *>(data + chunks[chunk].offset);
+  const ColumnHeader &columnHeader = chunkHeader->columns[static_cast<size_t>(column)];
+  DecodeColumn(columnHeader, reinterpret_cast<const uint64_t *>(data + columnHeader.offset), chunkHeader->rowCount,
+               out);
+}
+
+void TrajectoryReader::readColumn(TrajectoryColumn column, uint64_t firstTick, uint64_t lastTick,
+                                  std::vector<int64_t> &out, std::vector<int64_t> *ticks) const {
+  std::vector<int64_t> chunkTicks;
+  std::vector<int64_t> chunkValues;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    if (chunks[i].lastTick < firstTick || chunks[i].firstTick > lastTick)
+      continue;
+
+    chunkTicks.clear();
+    chunkValues.clear();
+    decodeColumn(i, TrajectoryColumn::TICK, chunkTicks);
+    decodeColumn(i, column, chunkValues);
+    for (size_t r = 0; r < chunkTicks.size(); ++r) {
+      if ((uint64_t)chunkTicks[r] < firstTick || (uint64_t)chunkTicks[r] > lastTick)
+        continue;
+      out.push_back(chunkValues[r]);
+      if (ticks)
+        ticks->push_back(chunkTicks[r]);
+    }
+  }
+}
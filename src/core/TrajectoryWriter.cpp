@@ -0,0 +1,166 @@
+#include "core/TrajectoryWriter.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file TrajectoryWriter.cpp
+ * @brief Implementation of the background trajectory chunk writer.
+ */
+
+using namespace TrajectoryFormat;
+
+std::unique_ptr<TrajectoryWriter> TrajectoryWriter::Open(const std::string &path, double tickRate,
+                                                         uint32_t sampleEvery, uint32_t rowsPerChunk) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return nullptr;
+
+  FileHeader header{};
+  header.magic = FILE_MAGIC;
+  header.version = VERSION;
+  header.columnCount = (uint32_t)COLUMN_COUNT;
+  header.tickRate = tickRate;
+  header.sampleEvery = sampleEvery;
+  if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+    std::fclose(file);
+    return nullptr;
+  }
+  return std::unique_ptr<TrajectoryWriter>(new TrajectoryWriter(file, rowsPerChunk > 0 ? rowsPerChunk : 65536));
+}
+
+TrajectoryWriter::TrajectoryWriter(std::FILE *file, uint32_t rowsPerChunk) : file(file), rowsPerChunk(rowsPerChunk) {
+  current.reserve(rowsPerChunk);
+  worker = std::thread([this]() { run(); });
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+  flush();
+  {
+    std::scoped_lock lock(queueMutex);
+    stopping = true;
+  }
+  queueSignal.notify_all();
+  if (worker.joinable())
+    worker.join();
+
+  // The worker has drained everything; append the index so readers can seek
+  Trailer trailer{fileOffset, (uint32_t)index.size(), TRAILER_MAGIC};
+  std::fwrite(index.data(), sizeof(ChunkIndexEntry), index.size(), file);
+  std::fwrite(&trailer, sizeof(trailer), 1, file);
+  std::fclose(file);
+}
+
+void TrajectoryWriter::append(const TrajectoryRow &row) {
+  current.push_back(row);
+  rowsAppended++;
+  if (current.size() >= rowsPerChunk)
+    flush();
+}
+
+void TrajectoryWriter::flush() {
+  if (current.empty())
+    return;
+  {
+    std::unique_lock lock(queueMutex);
+    queueSignal.wait(lock, [this]() { return pending.size() < MAX_PENDING_CHUNKS; });
+    pending.push_back(std::move(current));
+  }
+  queueSignal.notify_all();
+  current = {};
+  current.reserve(rowsPerChunk);
+}
+
+void TrajectoryWriter::run() {
+  while (true) {
+    std::vector<TrajectoryRow> rows;
+    {
+      std::unique_lock lock(queueMutex);
+      queueSignal.wait(lock, [this]() { return stopping || !pending.empty(); });
+      if (pending.empty())
+        return; // Stopping and drained
+      rows = std::move(pending.front());
+      pending.pop_front();
+    }
+    queueSignal.notify_all(); // Room for the producer again
+    writeChunk(rows);
+  }
+}
+
+void TrajectoryWriter::writeChunk(std::vector<TrajectoryRow> &rows) {
+  // Rows arrive car after car within each tick; grouped by car, the deltas follow one trajectory
+  std::sort(rows.begin(), rows.end(), [](const TrajectoryRow &a, const TrajectoryRow &b) {
+    return a.carId != b.carId ? a.carId < b.carId : a.tick < b.tick;
+  });
+
+  const uint32_t rowCount = (uint32_t)rows.size();
+  ChunkHeader header{};
+  header.magic = CHUNK_MAGIC;
+  header.rowCount = rowCount;
+  header.firstTick = rows.front().tick;
+  header.lastTick = rows.front().tick;
+  for (const TrajectoryRow &row : rows) {
+    header.firstTick = std::min(header.firstTick, row.tick);
+    header.lastTick = std::max(header.lastTick, row.tick);
+  }
+
+  auto quantize = [](float value, double scale) { return (int64_t)std::llround(value / scale); };
+
+  std::vector<uint64_t> data;
+  std::vector<int64_t> values(rowCount);
+  uint64_t offset = fileOffset + sizeof(ChunkHeader);
+
+  for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+    double scale = SCALE[c];
+    for (uint32_t r = 0; r < rowCount; ++r) {
+      const TrajectoryRow &row = rows[r];
+      switch ((TrajectoryColumn)c) {
+      case TrajectoryColumn::TICK:
+        values[r] = (int64_t)row.tick;
+        break;
+      case TrajectoryColumn::CAR_ID:
+        values[r] = row.carId;
+        break;
+      case TrajectoryColumn::X:
+        values[r] = quantize(row.x, scale);
+        break;
+      case TrajectoryColumn::Y:
+        values[r] = quantize(row.y, scale);
+        break;
+      case TrajectoryColumn::VX:
+        values[r] = quantize(row.vx, scale);
+        break;
+      case TrajectoryColumn::VY:
+        values[r] = quantize(row.vy, scale);
+        break;
+      case TrajectoryColumn::STATE:
+        values[r] = row.state;
+        break;
+      case TrajectoryColumn::WAYPOINT_INDEX:
+        values[r] = row.waypointIndex;
+        break;
+      case TrajectoryColumn::BATTERY:
+        values[r] = quantize(row.battery, scale);
+        break;
+      case TrajectoryColumn::COUNT:
+        break;
+      }
+    }
+
+    ColumnHeader &column = header.columns[c];
+    EncodeColumn(values, column, data);
+    column.offset = offset;
+    offset += column.byteSize;
+  }
+
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            (data.empty() || std::fwrite(data.data(), sizeof(uint64_t), data.size(), file) == data.size());
+  if (!ok) {
+    Logger::Error("TrajectoryWriter: Write failed, dropping chunk of {} rows", rowCount);
+    std::fseek(file, (long)fileOffset, SEEK_SET); // Overwrite the partial chunk with the next one
+    return;
+  }
+
+  index.push_back({fileOffset, header.firstTick, header.lastTick, rowCount, 0});
+  fileOffset = offset;
+}
@@ -0,0 +1,123 @@
+#include "core/TripLatencies.hpp"
+#include "core/Logger.hpp"
+#include <fstream>
+#include <sstream>
+
+/**
+ * @file TripLatencies.cpp
+ * @brief Implementation of the per-trip latency histograms and their CSV formats.
+ */
+
+namespace {
+constexpr std::array<const char *, TRIP_METRIC_COUNT> METRIC_NAMES = {
+    "time_to_park", "search", "aligning", "dwell", "charge_s_per_kwh", "exit",
+};
+constexpr std::array<const char *, TripLatencies::CAR_TYPE_COUNT> TYPE_NAMES = {"combustion", "electric"};
+constexpr std::array<const char *, TripLatencies::PRIORITY_COUNT> PRIORITY_NAMES = {"price", "distance"};
+constexpr const char *BUCKETS_HEADER = "metric,car_type,priority,bucket,count";
+
+template <size_t N> int FindName(const std::array<const char *, N> &names, const std::string &name) {
+  for (size_t i = 0; i < N; ++i) {
+    if (name == names[i])
+      return (int)i;
+  }
+  return -1;
+}
+} // namespace
+
+const char *TripLatencies::MetricName(TripMetric metric) { return METRIC_NAMES[static_cast<size_t>(metric)]; }
+
+LatencyHistogram TripLatencies::combined(TripMetric metric) const {
+  LatencyHistogram result;
+  for (size_t t = 0; t < CAR_TYPE_COUNT; ++t) {
+    for (size_t p = 0; p < PRIORITY_COUNT; ++p)
+      result.merge(histograms[Index(metric, t, p)]);
+  }
+  return result;
+}
+
+void TripLatencies::merge(const TripLatencies &other) {
+  for (size_t i = 0; i < histograms.size(); ++i)
+    histograms[i].merge(other.histograms[i]);
+}
+
+TripLatencySummary TripLatencies::summarize() const {
+  TripLatencySummary summary;
+  for (size_t m = 0; m < TRIP_METRIC_COUNT; ++m) {
+    LatencyHistogram all = combined((TripMetric)m);
+    summary.metrics[m] = {all.count(), (float)all.quantile(0.50), (float)all.quantile(0.95),
+                          (float)all.quantile(0.99)};
+  }
+  return summary;
+}
+
+void TripLatencies::writeSummaryCsv(std::ostream &out) const {
+  out << "metric,car_type,priority,count,mean,p50,p95,p99,max\n";
+  for (size_t m = 0; m < TRIP_METRIC_COUNT; ++m) {
+    for (size_t t = 0; t < CAR_TYPE_COUNT; ++t) {
+      for (size_t p = 0; p < PRIORITY_COUNT; ++p) {
+        const LatencyHistogram &h = histograms[Index((TripMetric)m, t, p)];
+        out << METRIC_NAMES[m] << ',' << TYPE_NAMES[t] << ',' << PRIORITY_NAMES[p] << ',' << h.count() << ','
+            << h.mean() << ',' << h.quantile(0.50) << ',' << h.quantile(0.95) << ',' << h.quantile(0.99) << ','
+            << h.max() << '\n';
+      }
+    }
+  }
+}
+
+void TripLatencies::writeBucketsCsv(std::ostream &out) const {
+  out << BUCKETS_HEADER << '\n';
+  for (size_t m = 0; m < TRIP_METRIC_COUNT; ++m) {
+    for (size_t t = 0; t < CAR_TYPE_COUNT; ++t) {
+      for (size_t p = 0; p < PRIORITY_COUNT; ++p) {
+        const LatencyHistogram &h = histograms[Index((TripMetric)m, t, p)];
+        for (size_t b = 0; b < LatencyHistogram::BUCKET_COUNT; ++b) {
+          if (h.bucketAt(b) > 0)
+            out << METRIC_NAMES[m] << ',' << TYPE_NAMES[t] << ',' << PRIORITY_NAMES[p] << ',' << b << ','
+                << h.bucketAt(b) << '\n';
+        }
+      }
+    }
+  }
+}
+
+bool TripLatencies::readBucketsCsv(std::istream &in) {
+  std::string line;
+  if (!std::getline(in, line) || line != BUCKETS_HEADER)
+    return false;
+
+  while (std::getline(in, line)) {
+    std::stringstream row(line);
+    std::string metric, type, priority, bucket, count;
+    if (!std::getline(row, metric, ',') || !std::getline(row, type, ',') || !std::getline(row, priority, ',') ||
+        !std::getline(row, bucket, ',') || !std::getline(row, count))
+      continue;
+
+    int m = FindName(METRIC_NAMES, metric);
+    int t = FindName(TYPE_NAMES, type);
+    int p = FindName(PRIORITY_NAMES, priority);
+    if (m < 0 || t < 0 || p < 0)
+      continue;
+    try {
+      histograms[Index((TripMetric)m, (size_t)t, (size_t)p)].addToBucket(std::stoul(bucket), std::stoull(count));
+    } catch (const std::exception &) {
+      continue; // Malformed row
+    }
+  }
+  return true;
+}
+
+bool TripLatencies::exportCsv(const std::string &prefix) const {
+  std::string summaryPath = prefix + "_latency.csv";
+  std::string bucketsPath = prefix + "_latency_buckets.csv";
+  std::ofstream summary(summaryPath);
+  std::ofstream buckets(bucketsPath);
+  if (!summary || !buckets) {
+    Logger::Error("TripLatencies: Cannot write {} / {}", summaryPath, bucketsPath);
+    return false;
+  }
+  writeSummaryCsv(summary);
+  writeBucketsCsv(buckets);
+  Logger::Info("TripLatencies: Exported {} and {}", summaryPath, bucketsPath);
+  return true;
+}
@@ -27,12 +27,13 @@ Car::Car(Vector2 startPos, const World * /*world*/, Vector2 initialVelocity, Car
     : position(startPos), velocity(initialVelocity), acceleration{0, 0}, maxSpeed(15.0f), maxForce(60.0f), type(type) {
 
   // Select a random visual variant (1-3) based on vehicle type
+  // Handles are resolved once here so drawing never touches the name map; headless runs get the invalid handle
   int variant = GetRandomValue(1, 3);
   if (type == CarType::COMBUSTION) {
-    textureName = "car1" + std::to_string(variant);
+    texture = AssetManager::Get().FindTextureHandle("car1" + std::to_string(variant));
     batteryLevel = 0.0f;
   } else {
-    textureName = "car2" + std::to_string(variant);
+    texture = AssetManager::Get().FindTextureHandle("car2" + std::to_string(variant));
     batteryLevel = (float)GetRandomValue(10, 90); // Initialize with random charge
   }
 
@@ -65,9 +66,17 @@ void Car::setParkingContext(const Module *fac, const Spot &spot, int spotIndex)
 
 /**
  * @brief Standard update override.
- * Calls updateWithNeighbors with no neighbor context.
+ * Calls updateWithNeighbors with no neighbors.
  */
-void Car::update(double dt) { updateWithNeighbors(dt, nullptr); }
+void Car::update(double dt) { updateWithNeighbors(dt); }
+
+Vector2 Car::getHeading() const {
+  if (Vector2Length(velocity) > 0.1f)
+    return Vector2Normalize(velocity);
+  return {cosf((currentRotation - 90.0f) * DEG2RAD), sinf((currentRotation - 90.0f) * DEG2RAD)};
+}
+
+float Car::getLookAheadDistance() const { return 7.0f + (Vector2Length(velocity) * 2.0f); }
 
 /**
  * @brief Core AI and Physics update loop.
@@ -80,9 +89,9 @@ void Car::update(double dt) { updateWithNeighbors(dt, nullptr); }
  * 5. Visual Rotation (Smoothly lerp sprite rotation toward heading).
  *
  * @param dt Delta time in seconds.
- * @param cars Pointer to a vector of other cars for spatial awareness.
+ * @param neighbors Cars to avoid, chosen by the caller.
  */
-void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>> *cars) {
+void Car::updateWithNeighbors(double dt, std::span<const Car *const> neighbors) {
 
   // 1. Handle Static States
   if (state == CarState::PARKED) {
@@ -102,11 +111,12 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
         if (currentWp.stopAtEnd && state == CarState::DRIVING) {
           velocity = {0, 0};
           acceleration = {0, 0};
-          state = CarState::ALIGNING;
+          setState(CarState::ALIGNING);
           targetRotation = currentWp.entryAngle;
         }
       }
       waypoints.pop_front();
+      waypointIndex++;
     }
   } else {
     // Logic for cars currently parking (Aligning to the spot angle)
@@ -123,7 +133,7 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
 
       if (fabs(diff) < 1.0f) {
         currentRotation = targetDeg;
-        state = CarState::PARKED;
+        setState(CarState::PARKED);
         parkingTimer =
             (float)GetRandomValue((int)(Config::PARKING_MIN_TIME * 10), (int)(Config::PARKING_MAX_TIME * 10)) / 10.0f;
       } else {
@@ -140,20 +150,18 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
   }
 
   // 3. Collision Avoidance and "Creep" Logic
-  if (cars && (state == CarState::DRIVING || state == CarState::EXITING)) {
+  if (!neighbors.empty() && (state == CarState::DRIVING || state == CarState::EXITING)) {
     // Determine current heading vector
-    Vector2 heading = (Vector2Length(velocity) > 0.1f) ? Vector2Normalize(velocity)
-                                                       : Vector2{cosf((currentRotation - 90.0f) * DEG2RAD),
-                                                                 sinf((currentRotation - 90.0f) * DEG2RAD)};
+    Vector2 heading = getHeading();
     Vector2 sideVec = {-heading.y, heading.x};
 
     float currentSpeed = Vector2Length(velocity);
-    float lookAheadDist = 7.0f + (currentSpeed * 2.0f);
+    float lookAheadDist = getLookAheadDistance();
     float laneWidth = 1.8f;
     float criticalStopDist = 3.2f;
 
-    for (const auto &other : *cars) {
-      if (other.get() == this || other->state == CarState::PARKED)
+    for (const Car *other : neighbors) {
+      if (other == this || other->state == CarState::PARKED)
         continue;
 
       Vector2 toOther = Vector2Subtract(other->getPosition(), position);
@@ -262,17 +270,20 @@ void Car::draw(bool showPath) {
     }
   }
 
-  Texture2D tex = AssetManager::Get().GetTexture(textureName);
+  drawSprite(position, currentRotation, texture);
+}
 
-  // Convert pixel dimensions to meters using config scaling
-  float width = 17.0f / static_cast<float>(Config::ART_PIXELS_PER_METER);
-  float height = 31.0f / static_cast<float>(Config::ART_PIXELS_PER_METER);
+/**
+ * @brief Draws the car texture scaled from art pixels to meters and rotated around its center.
+ */
+void Car::drawSprite(Vector2 position, float rotation, TextureHandle texture) {
+  SpriteRegion sprite = AssetManager::Get().GetSpriteRegion(texture);
 
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {position.x, position.y, width, height};
-  Vector2 origin = {width / 2.0f, height / 2.0f};
+  Vector2 size = getSpriteSize();
+  Rectangle dest = {position.x, position.y, size.x, size.y};
+  Vector2 origin = {size.x / 2.0f, size.y / 2.0f};
 
-  DrawTexturePro(tex, source, dest, origin, currentRotation, WHITE);
+  DrawTexturePro(sprite.texture, sprite.source, dest, origin, rotation, WHITE);
 }
 
 /**
@@ -285,6 +296,7 @@ void Car::addWaypoint(Waypoint wp) { waypoints.push_back(wp); }
  */
 void Car::setPath(const std::vector<Waypoint> &path) {
   waypoints.clear();
+  waypointIndex = 0;
   for (const auto &wp : path) {
     waypoints.push_back(wp);
   }
@@ -293,7 +305,10 @@ void Car::setPath(const std::vector<Waypoint> &path) {
 /**
  * @brief Removes all waypoints from the path.
  */
-void Car::clearWaypoints() { waypoints.clear(); }
+void Car::clearWaypoints() {
+  waypoints.clear();
+  waypointIndex = 0;
+}
 
 /**
  * @brief Accumulates a force vector to be applied during the next physics update.
@@ -0,0 +1,428 @@
+#include "entities/map/ContractionHierarchy.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <queue>
+
+/**
+ * @file ContractionHierarchy.cpp
+ * @brief Node contraction, the bidirectional upward query and the .plch file format.
+ */
+
+namespace {
+// TUNING: Witness searches give up after settling this many nodes. A missed witness only costs a
+// redundant shortcut, never a wrong route.
+constexpr uint32_t WITNESS_SETTLE_LIMIT = 64;
+// TUNING: Slack when comparing a witness path with the path through the contracted node
+constexpr float WITNESS_EPSILON = 1e-4f;
+
+constexpr uint64_t FILE_MAGIC = 0x3130484354524C50ULL; ///< "PLRTCH01"
+constexpr uint32_t FILE_VERSION = 1;
+
+struct FileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t arcSize; ///< sizeof(Arc), checked on load.
+  uint64_t fingerprint;
+  uint32_t nodeCount;
+  uint32_t arcCount;
+  uint32_t reserved[6];
+};
+static_assert(sizeof(FileHeader) == 56);
+
+/**
+ * @brief Arc of the shrinking graph during preprocessing.
+ */
+struct WorkArc {
+  uint32_t node;
+  float length;
+  uint32_t arc;
+};
+
+using HeapEntry = std::pair<float, uint32_t>;
+bool Later(const HeapEntry &a, const HeapEntry &b) { return a.first > b.first; }
+
+/**
+ * @brief Bounded Dijkstra over the remaining graph that looks for paths avoiding one node.
+ */
+class WitnessSearch {
+public:
+  explicit WitnessSearch(size_t nodeCount) : cost(nodeCount), stamp(nodeCount, 0) {}
+
+  void run(const std::vector<std::vector<WorkArc>> &out, uint32_t source, uint32_t avoid, float limit) {
+    ++generation;
+    heap.clear();
+    cost[source] = 0.0f;
+    stamp[source] = generation;
+    heap.push_back({0.0f, source});
+
+    uint32_t settled = 0;
+    while (!heap.empty() && settled < WITNESS_SETTLE_LIMIT) {
+      std::pop_heap(heap.begin(), heap.end(), Later);
+      auto [key, node] = heap.back();
+      heap.pop_back();
+      if (key > cost[node])
+        continue;
+      if (key > limit)
+        break;
+      ++settled;
+      for (const WorkArc &a : out[node]) {
+        if (a.node == avoid)
+          continue;
+        float next = key + a.length;
+        if (stamp[a.node] == generation && next >= cost[a.node])
+          continue;
+        stamp[a.node] = generation;
+        cost[a.node] = next;
+        heap.push_back({next, a.node});
+        std::push_heap(heap.begin(), heap.end(), Later);
+      }
+    }
+  }
+
+  float distance(uint32_t node) const {
+    return stamp[node] == generation ? cost[node] : std::numeric_limits<float>::infinity();
+  }
+
+private:
+  std::vector<float> cost;
+  std::vector<uint32_t> stamp;
+  std::vector<HeapEntry> heap;
+  uint32_t generation = 0;
+};
+} // namespace
+
+std::shared_ptr<const ContractionHierarchy> ContractionHierarchy::Build(const RoadGraph &graph) {
+  auto started = std::chrono::steady_clock::now();
+  auto ch = std::make_shared<ContractionHierarchy>();
+  const uint32_t nodeCount = (uint32_t)graph.getNodeCount();
+  ch->fingerprint = graph.getFingerprint();
+  ch->rank.assign(nodeCount, 0);
+
+  std::vector<std::vector<WorkArc>> out(nodeCount);
+  std::vector<std::vector<WorkArc>> in(nodeCount);
+  for (uint32_t n = 0; n < nodeCount; ++n) {
+    auto [begin, end] = graph.getEdgeRange(n);
+    for (uint32_t e = begin; e < end; ++e) {
+      uint32_t to = graph.getEdgeTarget(e);
+      uint32_t id = (uint32_t)ch->arcs.size();
+      ch->arcs.push_back({n, to, graph.getEdgeLength(e), NO_ARC, NO_ARC});
+      out[n].push_back({to, graph.getEdgeLength(e), id});
+      in[to].push_back({n, graph.getEdgeLength(e), id});
+    }
+  }
+  const size_t originalArcs = ch->arcs.size();
+
+  auto addShortcut = [&](uint32_t from, uint32_t to, float length, uint32_t first, uint32_t second) {
+    uint32_t id = (uint32_t)ch->arcs.size();
+    auto existing = std::find_if(out[from].begin(), out[from].end(), [to](const WorkArc &a) { return a.node == to; });
+    if (existing != out[from].end()) {
+      if (existing->length <= length)
+        return;
+      ch->arcs.push_back({from, to, length, first, second});
+      *existing = {to, length, id};
+      for (WorkArc &a : in[to]) {
+        if (a.node == from)
+          a = {from, length, id};
+      }
+      return;
+    }
+    ch->arcs.push_back({from, to, length, first, second});
+    out[from].push_back({to, length, id});
+    in[to].push_back({from, length, id});
+  };
+
+  // Shortcuts needed to remove @p node; added to the graph when @p apply is set
+  WitnessSearch witness(nodeCount);
+  auto contract = [&](uint32_t node, bool apply) {
+    int shortcuts = 0;
+    for (size_t i = 0; i < in[node].size(); ++i) {
+      const WorkArc incoming = in[node][i];
+      float limit = 0.0f;
+      for (const WorkArc &outgoing : out[node]) {
+        if (outgoing.node != incoming.node)
+          limit = std::max(limit, incoming.length + outgoing.length);
+      }
+      if (limit == 0.0f)
+        continue;
+      witness.run(out, incoming.node, node, limit);
+      for (size_t k = 0; k < out[node].size(); ++k) {
+        const WorkArc outgoing = out[node][k];
+        float via = incoming.length + outgoing.length;
+        if (outgoing.node == incoming.node || witness.distance(outgoing.node) <= via + WITNESS_EPSILON)
+          continue;
+        ++shortcuts;
+        if (apply)
+          addShortcut(incoming.node, outgoing.node, via, incoming.arc, outgoing.arc);
+      }
+    }
+    return shortcuts;
+  };
+
+  // Lazy updates: a node's priority is recomputed when it reaches the top of the queue
+  std::vector<int> contractedNeighbours(nodeCount, 0);
+  auto priority = [&](uint32_t node) {
+    return contract(node, false) - (int)(in[node].size() + out[node].size()) + contractedNeighbours[node];
+  };
+  using QueueEntry = std::pair<int, uint32_t>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+  for (uint32_t n = 0; n < nodeCount; ++n)
+    queue.push({priority(n), n});
+
+  uint32_t nextRank = 0;
+  while (!queue.empty()) {
+    uint32_t node = queue.top().second;
+    queue.pop();
+    int current = priority(node);
+    if (!queue.empty() && current > queue.top().first) {
+      queue.push({current, node});
+      continue;
+    }
+
+    contract(node, true);
+    ch->rank[node] = nextRank++;
+
+    // Detach the node so later witness searches and contractions only see the remaining graph
+    for (const WorkArc &a : in[node]) {
+      std::erase_if(out[a.node], [node](const WorkArc &o) { return o.node == node; });
+      contractedNeighbours[a.node]++;
+    }
+    for (const WorkArc &a : out[node]) {
+      std::erase_if(in[a.node], [node](const WorkArc &i) { return i.node == node; });
+      contractedNeighbours[a.node]++;
+    }
+    in[node].clear();
+    in[node].shrink_to_fit();
+    out[node].clear();
+    out[node].shrink_to_fit();
+  }
+
+  ch->buildSearchGraphs();
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+  Logger::Info("ContractionHierarchy: {} nodes, {} edges + {} shortcuts in {:.1f} ms", nodeCount, originalArcs,
+               ch->arcs.size() - originalArcs, ms);
+  return ch;
+}
+
+void ContractionHierarchy::buildSearchGraphs() {
+  const size_t nodeCount = rank.size();
+  upFirst.assign(nodeCount + 1, 0);
+  downFirst.assign(nodeCount + 1, 0);
+  for (const Arc &a : arcs) {
+    if (rank[a.to] > rank[a.from])
+      upFirst[a.from + 1]++;
+    else
+      downFirst[a.to + 1]++;
+  }
+  for (size_t n = 0; n < nodeCount; ++n) {
+    upFirst[n + 1] += upFirst[n];
+    downFirst[n + 1] += downFirst[n];
+  }
+
+  upArcs.resize(upFirst[nodeCount]);
+  downArcs.resize(downFirst[nodeCount]);
+  std::vector<uint32_t> upFill(upFirst.begin(), upFirst.end() - 1);
+  std::vector<uint32_t> downFill(downFirst.begin(), downFirst.end() - 1);
+  for (uint32_t id = 0; id < (uint32_t)arcs.size(); ++id) {
+    const Arc &a = arcs[id];
+    if (rank[a.to] > rank[a.from])
+      upArcs[upFill[a.from]++] = {a.to, a.length, id};
+    else
+      downArcs[downFill[a.to]++] = {a.from, a.length, id};
+  }
+}
+
+bool ContractionHierarchy::findRoute(uint32_t start, std::span<const uint32_t> goals, RoadGraph::SearchScratch &scratch,
+                                     std::vector<uint32_t> &route) const {
+  route.clear();
+  scratch.lastSettled = 0;
+  const size_t nodeCount = rank.size();
+  if (start >= nodeCount || goals.empty())
+    return false;
+
+  if (scratch.costBack.size() < nodeCount) {
+    scratch.cost.resize(std::max(scratch.cost.size(), nodeCount));
+    scratch.parent.resize(std::max(scratch.parent.size(), nodeCount));
+    scratch.visited.resize(std::max(scratch.visited.size(), nodeCount), 0);
+    scratch.closed.resize(std::max(scratch.closed.size(), nodeCount), 0);
+    scratch.goal.resize(std::max(scratch.goal.size(), nodeCount), 0);
+    scratch.costBack.resize(nodeCount);
+    scratch.parentBack.resize(nodeCount);
+    scratch.visitedBack.resize(nodeCount, 0);
+  }
+  if (++scratch.generation == 0) {
+    std::fill(scratch.visited.begin(), scratch.visited.end(), 0);
+    std::fill(scratch.closed.begin(), scratch.closed.end(), 0);
+    std::fill(scratch.goal.begin(), scratch.goal.end(), 0);
+    std::fill(scratch.visitedBack.begin(), scratch.visitedBack.end(), 0);
+    scratch.generation = 1;
+  }
+  const uint32_t gen = scratch.generation;
+
+  auto &forward = scratch.heap;
+  auto &backward = scratch.heapBack;
+  forward.clear();
+  backward.clear();
+  scratch.cost[start] = 0.0f;
+  scratch.parent[start] = NO_ARC;
+  scratch.visited[start] = gen;
+  forward.push_back({0.0f, start});
+  for (uint32_t g : goals) {
+    if (g >= nodeCount || scratch.visitedBack[g] == gen)
+      continue;
+    scratch.costBack[g] = 0.0f;
+    scratch.parentBack[g] = NO_ARC;
+    scratch.visitedBack[g] = gen;
+    backward.push_back({0.0f, g});
+  }
+
+  // Both searches only climb, so every shortest route peaks at a node both of them settle
+  float best = std::numeric_limits<float>::infinity();
+  uint32_t meet = RoadGraph::NO_NODE;
+  auto step = [&](std::vector<HeapEntry> &heap, bool isForward) {
+    std::pop_heap(heap.begin(), heap.end(), Later);
+    auto [key, node] = heap.back();
+    heap.pop_back();
+    auto &cost = isForward ? scratch.cost : scratch.costBack;
+    auto &parent = isForward ? scratch.parent : scratch.parentBack;
+    auto &visited = isForward ? scratch.visited : scratch.visitedBack;
+    const auto &otherCost = isForward ? scratch.costBack : scratch.cost;
+    const auto &otherVisited = isForward ? scratch.visitedBack : scratch.visited;
+    if (key > cost[node])
+      return; // Stale duplicate
+    scratch.lastSettled++;
+
+    if (otherVisited[node] == gen && key + otherCost[node] < best) {
+      best = key + otherCost[node];
+      meet = node;
+    }
+
+    // Stall on demand: if a higher node already reaches this one more cheaply, its true distance
+    // is smaller than the key and nothing searched from here can be on a shortest route
+    const auto &stallFirst = isForward ? downFirst : upFirst;
+    const auto &stallArcs = isForward ? downArcs : upArcs;
+    for (uint32_t i = stallFirst[node]; i < stallFirst[node + 1]; ++i) {
+      const SearchArc &a = stallArcs[i];
+      if (visited[a.node] == gen && cost[a.node] + a.length < key)
+        return;
+    }
+
+    const auto &first = isForward ? upFirst : downFirst;
+    const auto &searchArcs = isForward ? upArcs : downArcs;
+    for (uint32_t i = first[node]; i < first[node + 1]; ++i) {
+      const SearchArc &a = searchArcs[i];
+      float next = key + a.length;
+      if (visited[a.node] == gen && next >= cost[a.node])
+        continue;
+      visited[a.node] = gen;
+      cost[a.node] = next;
+      parent[a.node] = a.arc;
+      heap.push_back({next, a.node});
+      std::push_heap(heap.begin(), heap.end(), Later);
+    }
+  };
+
+  for (;;) {
+    bool forwardOpen = !forward.empty() && forward.front().first < best;
+    bool backwardOpen = !backward.empty() && backward.front().first < best;
+    if (!forwardOpen && !backwardOpen)
+      break;
+    if (forwardOpen && (!backwardOpen || forward.front().first <= backward.front().first))
+      step(forward, true);
+    else
+      step(backward, false);
+  }
+
+  if (meet == RoadGraph::NO_NODE)
+    return false;
+
+  // Top-level arcs onto a stack so that they pop in driving order, then expand shortcuts in place
+  auto &stack = scratch.unpack;
+  stack.clear();
+  for (uint32_t n = meet; scratch.parentBack[n] != NO_ARC; n = arcs[scratch.parentBack[n]].to)
+    stack.push_back(scratch.parentBack[n]);
+  std::reverse(stack.begin(), stack.end());
+  for (uint32_t n = meet; scratch.parent[n] != NO_ARC; n = arcs[scratch.parent[n]].from)
+    stack.push_back(scratch.parent[n]);
+
+  route.push_back(start);
+  while (!stack.empty()) {
+    const Arc &a = arcs[stack.back()];
+    stack.pop_back();
+    if (a.first == NO_ARC) {
+      route.push_back(a.to);
+    } else {
+      stack.push_back(a.second);
+      stack.push_back(a.first);
+    }
+  }
+  return true;
+}
+
+bool ContractionHierarchy::save(const std::string &path) const {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    Logger::Warn("ContractionHierarchy: cannot write '{}'", path);
+    return false;
+  }
+  FileHeader header{};
+  header.magic = FILE_MAGIC;
+  header.version = FILE_VERSION;
+  header.arcSize = sizeof(Arc);
+  header.fingerprint = fingerprint;
+  header.nodeCount = (uint32_t)rank.size();
+  header.arcCount = (uint32_t)arcs.size();
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            std::fwrite(rank.data(), sizeof(uint32_t), rank.size(), file) == rank.size() &&
+            std::fwrite(arcs.data(), sizeof(Arc), arcs.size(), file) == arcs.size();
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok)
+    Logger::Warn("ContractionHierarchy: writing '{}' failed", path);
+  return ok;
+}
+
+std::shared_ptr<const ContractionHierarchy> ContractionHierarchy::Load(const std::string &path,
+                                                                       const RoadGraph &graph) {
+  std::error_code error;
+  const uintmax_t fileSize = std::filesystem::file_size(path, error);
+  std::FILE *file = error ? nullptr : std::fopen(path.c_str(), "rb");
+  if (!file)
+    return nullptr;
+
+  auto ch = std::make_shared<ContractionHierarchy>();
+  FileHeader header{};
+  bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == FILE_MAGIC &&
+            header.version == FILE_VERSION && header.arcSize == sizeof(Arc) &&
+            header.nodeCount == graph.getNodeCount() && header.fingerprint == graph.getFingerprint();
+  // The counts must match the file length before they size any allocation
+  ok = ok && fileSize == sizeof(FileHeader) + (uintmax_t)header.nodeCount * sizeof(uint32_t) +
+                             (uintmax_t)header.arcCount * sizeof(Arc);
+  if (ok) {
+    ch->fingerprint = header.fingerprint;
+    ch->rank.resize(header.nodeCount);
+    ch->arcs.resize(header.arcCount);
+    ok = std::fread(ch->rank.data(), sizeof(uint32_t), ch->rank.size(), file) == ch->rank.size() &&
+         std::fread(ch->arcs.data(), sizeof(Arc), ch->arcs.size(), file) == ch->arcs.size();
+  }
+  std::fclose(file);
+
+  // A damaged file must not send a query out of bounds
+  for (size_t n = 0; ok && n < ch->rank.size(); ++n)
+    ok = ch->rank[n] < header.nodeCount;
+  for (size_t i = 0; ok && i < ch->arcs.size(); ++i) {
+    const Arc &a = ch->arcs[i];
+    ok = a.from < header.nodeCount && a.to < header.nodeCount &&
+         (a.first == NO_ARC ? a.second == NO_ARC : a.first < i && a.second < i);
+  }
+  if (!ok) {
+    Logger::Warn("ContractionHierarchy: '{}' does not match this map, rebuilding", path);
+    return nullptr;
+  }
+
+  ch->buildSearchGraphs();
+  Logger::Info("ContractionHierarchy: loaded {} nodes, {} arcs from '{}'", header.nodeCount, header.arcCount, path);
+  return ch;
+}
@@ -0,0 +1,64 @@
+#include "entities/map/DistanceMatrix.hpp"
+#include <algorithm>
+
+/**
+ * @file DistanceMatrix.cpp
+ * @brief Implementation of the source-to-facility distance table.
+ */
+
+void DistanceMatrix::reset(const RoadGraph &g, const std::vector<std::unique_ptr<Module>> &modules) {
+  graph = &g;
+  facilities.clear();
+  columns.clear();
+  gates.clear();
+  columnGates.clear();
+  rows.clear();
+  distances.clear();
+
+  std::unordered_map<uint32_t, uint32_t> gateIndex;
+  auto addGate = [&](uint32_t node) {
+    auto [it, added] = gateIndex.try_emplace(node, (uint32_t)gates.size());
+    if (added)
+      gates.push_back(node);
+    return it->second;
+  };
+
+  for (const auto &mod : modules) {
+    if (mod->getSpotCount() == 0 || !mod->getParent())
+      continue;
+    auto [east, west] = g.getEntranceNodes(mod->getParent());
+    if (east == RoadGraph::NO_NODE)
+      continue;
+    columns.emplace(mod.get(), (uint32_t)facilities.size());
+    facilities.push_back(mod.get());
+    columnGates.push_back({addGate(east), addGate(west)});
+  }
+  gateDistances.resize(gates.size());
+}
+
+int DistanceMatrix::getColumn(const Module *facility) const {
+  auto it = columns.find(facility);
+  return it == columns.end() ? -1 : (int)it->second;
+}
+
+std::span<const float> DistanceMatrix::getRow(uint32_t source) {
+  if (!graph || source >= graph->getNodeCount())
+    return {};
+  const size_t columnCount = facilities.size();
+  auto [it, added] = rows.try_emplace(source, (uint32_t)rows.size());
+  const size_t row = it->second;
+  if (added) {
+    // Each gate serves all facilities of its road, so one search per row covers every column
+    graph->findDistances(source, gates, scratch, gateDistances);
+    distances.resize(distances.size() + columnCount);
+    float *out = distances.data() + row * columnCount;
+    for (size_t c = 0; c < columnCount; ++c)
+      out[c] = std::min(gateDistances[columnGates[c].first], gateDistances[columnGates[c].second]);
+  }
+  return {distances.data() + row * columnCount, columnCount};
+}
+
+void DistanceMatrix::addRows(std::span<const uint32_t> sources) {
+  for (uint32_t source : sources)
+    getRow(source);
+}
@@ -1,8 +1,11 @@
 #include "entities/map/Modules.hpp"
 #include "config.hpp"
 #include "core/AssetManager.hpp"
+#include "entities/map/SpotRegistry.hpp"
 #include "raylib.h"
 #include "raymath.h"
+#include <algorithm>
+#include <cmath>
 
 // --- Helper Conversion ---
 
@@ -28,6 +31,10 @@ void Module::assignRandomPricesToSpots(float baseSpotPrice, float variance) {
     if (spot.price < 0.5f)
       spot.price = 0.5f; // Min price
   }
+  if (registry) {
+    for (int i = 0; i < (int)spots.size(); ++i)
+      registry->setPrice(getRegistrySpot(i), spots[i].price);
+  }
 }
 
 void Module::draw() const {
@@ -41,6 +48,13 @@ void Module::draw() const {
   // }
 }
 
+void Module::drawTexture() const {
+  SpriteRegion sprite = AssetManager::Get().GetSpriteRegion(texture);
+  // DrawTexturePro destination uses width/height in world units
+  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
+  DrawTexturePro(sprite.texture, sprite.source, dest, {0, 0}, 0.0f, WHITE);
+}
+
 void Module::addWaypoint(Vector2 localPos, float tolerance, int id, float angle, bool stop) {
   localWaypoints.emplace_back(localPos, tolerance, id, angle, stop);
 }
@@ -85,7 +99,7 @@ const AttachmentPoint *Module::getAttachmentPointByNormal(Vector2 normal) const
 int Module::getRandomSpotIndex() const {
   std::vector<int> freeIndices;
   for (int i = 0; i < (int)spots.size(); ++i) {
-    if (spots[i].state == SpotState::FREE) {
+    if (getSpotState(i) == SpotState::FREE) {
       freeIndices.push_back(i);
     }
   }
@@ -99,40 +113,92 @@ int Module::getRandomSpotIndex() const {
 
 Spot Module::getSpot(int index) const {
   if (index >= 0 && index < (int)spots.size()) {
-    return spots[index];
+    Spot spot = spots[index];
+    if (registry) {
+      spot.state = registry->getState(getRegistrySpot(index));
+      spot.price = registry->getPrice(getRegistrySpot(index));
+    }
+    return spot;
   }
   return {{0, 0}, 0, -1, SpotState::FREE}; // Safe default
 }
 
-void Module::setSpotState(int index, SpotState state) {
-  if (index >= 0 && index < (int)spots.size()) {
-    spots[index].state = state;
+SpotState Module::getSpotState(int index) const {
+  return registry ? registry->getState(getRegistrySpot(index)) : spots[index].state;
+}
+
+void Module::countStateChange(SpotState previous, SpotState state) {
+  auto adjust = [this](SpotState s, int delta) {
+    if (s == SpotState::RESERVED)
+      reservedCount.fetch_add(delta, std::memory_order_relaxed);
+    else if (s == SpotState::OCCUPIED)
+      occupiedCount.fetch_add(delta, std::memory_order_relaxed);
+  };
+  adjust(previous, -1);
+  adjust(state, +1);
+}
+
+SpotState Module::setSpotState(int index, SpotState state) {
+  if (index < 0 || index >= (int)spots.size())
+    return SpotState::FREE;
+
+  if (registry)
+    return registry->exchange(getRegistrySpot(index), state);
+
+  SpotState previous = spots[index].state;
+  if (previous != state)
+    countStateChange(previous, state);
+  spots[index].state = state;
+  return previous;
+}
+
+bool Module::tryReserveSpot(int index) {
+  if (index < 0 || index >= (int)spots.size())
+    return false;
+
+  if (registry)
+    return registry->tryReserve(getRegistrySpot(index));
+
+  if (spots[index].state != SpotState::FREE)
+    return false;
+  spots[index].state = SpotState::RESERVED;
+  countStateChange(SpotState::FREE, SpotState::RESERVED);
+  return true;
+}
+
+int Module::getCheapestFreeSpotIndex() const {
+  if (registry) {
+    auto [first, last] = registry->getRange(this);
+    uint32_t spot = registry->findCheapestFree(first, last);
+    return spot == SpotRegistry::NO_SPOT ? -1 : (int)(spot - first);
+  }
+  int best = -1;
+  for (int i = 0; i < (int)spots.size(); ++i) {
+    if (spots[i].state == SpotState::FREE && (best < 0 || spots[i].price < spots[best].price))
+      best = i;
   }
+  return best;
 }
 
-Module::SpotCounts Module::getSpotCounts() const {
-  SpotCounts counts = {0, 0, 0};
-  for (const auto &spot : spots) {
-    if (spot.state == SpotState::FREE)
-      counts.free++;
-    else if (spot.state == SpotState::RESERVED)
-      counts.reserved++;
-    else if (spot.state == SpotState::OCCUPIED)
-      counts.occupied++;
+void Module::bindSpots(SpotRegistry *r, uint32_t firstSpot) {
+  registry = r;
+  registryFirstSpot = firstSpot;
+}
+
+void Module::unbindSpots() {
+  if (!registry)
+    return;
+  for (int i = 0; i < (int)spots.size(); ++i) {
+    spots[i].state = registry->getState(getRegistrySpot(i));
+    spots[i].price = registry->getPrice(getRegistrySpot(i));
   }
-  return counts;
+  registry = nullptr;
+  registryFirstSpot = 0;
 }
 
 float Module::getOccupancyPercentage() const {
   if (spots.empty())
     return 0.0f;
-
-  int occupiedCount = 0;
-  for (const auto &spot : spots) {
-    if (spot.state == SpotState::OCCUPIED) {
-      occupiedCount++;
-    }
-  }
   return (float)occupiedCount / (float)spots.size();
 }
 
@@ -140,6 +206,7 @@ float Module::getOccupancyPercentage() const {
 // normal road : left (0 78) right (283 78) size (283 155)
 
 NormalRoad::NormalRoad() : Module(P2M(283), P2M(155)) {
+  texture = AssetManager::Get().GetTextureHandle("road");
   // Left: 0, 78 (art pixels)
   // Right: 283, 78
   // Y in meters = 78 / 7 = 11.14
@@ -156,17 +223,13 @@ NormalRoad::NormalRoad() : Module(P2M(283), P2M(155)) {
 }
 
 void NormalRoad::draw() const {
-  Texture2D tex = AssetManager::Get().GetTexture("road");
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  // DrawTexturePro destination uses width/height in world units
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
-
+  drawTexture();
   Module::draw();
 }
 
 // up entrance road : left (0 78) right (283 78) up(142 0) size (284 155)
 UpEntranceRoad::UpEntranceRoad() : Module(P2M(284), P2M(155)) {
+  texture = AssetManager::Get().GetTextureHandle("entrance_up");
   float yCenter = P2M(78);
   float xCenter = P2M(142);
 
@@ -178,15 +241,13 @@ UpEntranceRoad::UpEntranceRoad() : Module(P2M(284), P2M(155)) {
 }
 
 void UpEntranceRoad::draw() const {
-  Texture2D tex = AssetManager::Get().GetTexture("entrance_up");
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
   Module::draw();
 }
 
 // down entrance road : left (0 78) right (283 78) down(142 155) size (284 155)
 DownEntranceRoad::DownEntranceRoad() : Module(P2M(284), P2M(155)) {
+  texture = AssetManager::Get().GetTextureHandle("entrance_down");
   float yCenter = P2M(78);
   float xCenter = P2M(142);
 
@@ -198,15 +259,13 @@ DownEntranceRoad::DownEntranceRoad() : Module(P2M(284), P2M(155)) {
 }
 
 void DownEntranceRoad::draw() const {
-  Texture2D tex = AssetManager::Get().GetTexture("entrance_down");
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
   Module::draw();
 }
 
 // double entrance road : left (0 78) right (283 78) up(142 0) down(142 155) size (284 155)
 DoubleEntranceRoad::DoubleEntranceRoad() : Module(P2M(284), P2M(155)) {
+  texture = AssetManager::Get().GetTextureHandle("entrance_double");
   float yCenter = P2M(78);
   float xCenter = P2M(142);
 
@@ -219,10 +278,33 @@ DoubleEntranceRoad::DoubleEntranceRoad() : Module(P2M(284), P2M(155)) {
 }
 
 void DoubleEntranceRoad::draw() const {
-  Texture2D tex = AssetManager::Get().GetTexture("entrance_double");
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
+  Module::draw();
+}
+
+// cross street : the normal road turned by 90 degrees, up (78 0) down (78 length) size (155 length)
+CrossStreet::CrossStreet(float length) : Module(P2M(155), length) {
+  texture = AssetManager::Get().GetTextureHandle("road");
+  float xCenter = P2M(78);
+
+  attachmentPoints.push_back({{xCenter, 0}, {0, -1}});     // Up
+  attachmentPoints.push_back({{xCenter, height}, {0, 1}}); // Down
+
+  addWaypoint({xCenter, height / 2.0f});
+}
+
+void CrossStreet::draw() const {
+  // One sprite per road length so the lane markings keep their proportions
+  SpriteRegion sprite = AssetManager::Get().GetSpriteRegion(texture);
+  float segmentLength = P2M(283);
+  int segments = std::max(1, (int)std::lround(height / segmentLength));
+  float step = height / (float)segments;
+  for (int i = 0; i < segments; ++i) {
+    // Rotating by 90 degrees about the top-left corner maps the sprite's X axis onto +Y,
+    // so the destination origin sits on the module's right edge.
+    Rectangle dest = {worldPosition.x + width, worldPosition.y + step * (float)i, step, width};
+    DrawTexturePro(sprite.texture, sprite.source, dest, {0, 0}, 90.0f, WHITE);
+  }
   Module::draw();
 }
 
@@ -236,6 +318,7 @@ small parking down : 218 0 (274*330)
 */
 
 SmallParking::SmallParking(bool isTop) : Module(P2M(274), P2M(330)), isTop(isTop) {
+  texture = AssetManager::Get().GetTextureHandle(isTop ? "parking_small_up" : "parking_small_down");
   if (isTop) {
     attachmentPoints.push_back({{P2M(218), height}, {0, 1}});
 
@@ -279,11 +362,7 @@ SmallParking::SmallParking(bool isTop) : Module(P2M(274), P2M(330)), isTop(isTop
 }
 
 void SmallParking::draw() const {
-  const char *texName = isTop ? "parking_small_up" : "parking_small_down";
-  Texture2D tex = AssetManager::Get().GetTexture(texName);
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
   Module::draw();
 }
 
@@ -292,6 +371,7 @@ large parking up : 218 363 (436*363)
 large parking down : 218 0 (436*363)
 */
 LargeParking::LargeParking(bool isTop) : Module(P2M(436), P2M(363)), isTop(isTop) {
+  texture = AssetManager::Get().GetTextureHandle(isTop ? "parking_large_up" : "parking_large_down");
   if (isTop) {
     attachmentPoints.push_back({{P2M(218), height}, {0, 1}});
 
@@ -342,11 +422,7 @@ LargeParking::LargeParking(bool isTop) : Module(P2M(436), P2M(363)), isTop(isTop
 }
 
 void LargeParking::draw() const {
-  const char *texName = isTop ? "parking_large_up" : "parking_large_down";
-  Texture2D tex = AssetManager::Get().GetTexture(texName);
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
   Module::draw();
 }
 
@@ -355,6 +431,7 @@ small charging up : 163 168 (219*168)
 small charging down : 163 0 (219*168)
 */
 SmallChargingStation::SmallChargingStation(bool isTop) : Module(P2M(219), P2M(168)), isTop(isTop) {
+  texture = AssetManager::Get().GetTextureHandle(isTop ? "charging_small_up" : "charging_small_down");
   if (isTop) {
     attachmentPoints.push_back({{P2M(163), height}, {0, 1}});
 
@@ -393,11 +470,7 @@ SmallChargingStation::SmallChargingStation(bool isTop) : Module(P2M(219), P2M(16
 }
 
 void SmallChargingStation::draw() const {
-  const char *texName = isTop ? "charging_small_up" : "charging_small_down";
-  Texture2D tex = AssetManager::Get().GetTexture(texName);
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
   Module::draw();
 }
 
@@ -406,6 +479,7 @@ large charging up : 218 330 (274*330)
 large charging down : 218 0 (274*330)
 */
 LargeChargingStation::LargeChargingStation(bool isTop) : Module(P2M(274), P2M(330)), isTop(isTop) {
+  texture = AssetManager::Get().GetTextureHandle(isTop ? "charging_large_up" : "charging_large_down");
   if (isTop) {
     attachmentPoints.push_back({{P2M(218), height}, {0, 1}});
     // Same layout as Small Parking UP
@@ -440,10 +514,6 @@ LargeChargingStation::LargeChargingStation(bool isTop) : Module(P2M(274), P2M(33
 }
 
 void LargeChargingStation::draw() const {
-  const char *texName = isTop ? "charging_large_up" : "charging_large_down";
-  Texture2D tex = AssetManager::Get().GetTexture(texName);
-  Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
-  Rectangle dest = {worldPosition.x, worldPosition.y, width, height};
-  DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  drawTexture();
   Module::draw();
 }
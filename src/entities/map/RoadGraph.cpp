@@ -0,0 +1,529 @@
+#include "entities/map/RoadGraph.hpp"
+#include "config.hpp"
+#include "entities/map/ContractionHierarchy.hpp"
+#include "core/Logger.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+/**
+ * @file RoadGraph.cpp
+ * @brief Construction of the lane graph and the A* search over it.
+ */
+
+namespace {
+// TUNING: Modules are positioned on art pixels (1/7 m), so anything closer than this touches
+constexpr float JOIN_EPSILON = 0.05f;
+// TUNING: A car further than this from a lane center line is not considered to be on that lane
+constexpr float LANE_SNAP_DISTANCE = 2.0f;
+// TUNING: Above this many goals a per-node distance heuristic costs more than it saves; use Dijkstra
+constexpr size_t MAX_HEURISTIC_GOALS = 4;
+
+float P2M(float artPixels) { return artPixels / static_cast<float>(Config::ART_PIXELS_PER_METER); }
+
+long EdgeKey(float y) { return std::lround(y / JOIN_EPSILON); }
+
+/**
+ * @brief One horizontal road: touching left/right road modules at the same height.
+ */
+struct RoadSpan {
+  float top = 0.0f;
+  float bottom = 0.0f;
+  float xMin = 0.0f;
+  float xMax = 0.0f;
+  std::vector<float> stations;                             ///< X of every node on this road.
+  std::vector<std::pair<const Module *, float>> entrances; ///< Entrance roads and their joint X.
+  std::vector<std::pair<uint32_t, float>> crossJoints;     ///< Cross streets meeting the road from below/above.
+  uint32_t eastFirst = 0;
+  uint32_t westFirst = 0;
+
+  size_t stationIndex(float x) const {
+    return (size_t)(std::lower_bound(stations.begin(), stations.end(), x - JOIN_EPSILON) - stations.begin());
+  }
+  uint32_t eastNode(size_t i) const { return eastFirst + (uint32_t)i; }
+  uint32_t westNode(size_t i) const { return westFirst + (uint32_t)(stations.size() - 1 - i); }
+};
+
+/**
+ * @brief One cross street and the roads at its two ends (-1 = open end).
+ */
+struct StreetLink {
+  const Module *street = nullptr;
+  Vector2 top = {0, 0};    ///< World position of the top joint.
+  Vector2 bottom = {0, 0}; ///< World position of the bottom joint.
+  int upper = -1;
+  int lower = -1;
+  uint32_t southFirst = 0; ///< Southbound lane: top node, bottom node.
+  uint32_t northFirst = 0; ///< Northbound lane: bottom node, top node.
+};
+
+/**
+ * @brief Sizes @p scratch for @p nodeCount nodes and starts a new generation.
+ * @return The generation that marks this search's entries.
+ */
+uint32_t BeginSearch(RoadGraph::SearchScratch &scratch, size_t nodeCount) {
+  scratch.lastSettled = 0;
+  if (scratch.cost.size() < nodeCount) {
+    scratch.cost.resize(nodeCount);
+    scratch.parent.resize(nodeCount);
+    scratch.visited.resize(nodeCount, 0);
+    scratch.closed.resize(nodeCount, 0);
+    scratch.goal.resize(nodeCount, 0);
+  }
+  if (++scratch.generation == 0) {
+    // Wrapped around: stale stamps could alias the new generation
+    std::fill(scratch.visited.begin(), scratch.visited.end(), 0);
+    std::fill(scratch.closed.begin(), scratch.closed.end(), 0);
+    std::fill(scratch.goal.begin(), scratch.goal.end(), 0);
+    scratch.generation = 1;
+  }
+  return scratch.generation;
+}
+
+bool Later(const std::pair<float, uint32_t> &a, const std::pair<float, uint32_t> &b) { return a.first > b.first; }
+} // namespace
+
+RoadGraph RoadGraph::Build(const std::vector<std::unique_ptr<Module>> &modules) {
+  RoadGraph graph;
+
+  // 1. Horizontal roads, grouped by height and merged where they touch end to end
+  std::map<long, std::vector<const Module *>> rows;
+  std::vector<StreetLink> streets;
+  for (const auto &mod : modules) {
+    if (mod->getSpotCount() > 0)
+      continue;
+    bool horizontal = mod->getAttachmentPointByNormal({-1, 0}) && mod->getAttachmentPointByNormal({1, 0});
+    const auto *up = mod->getAttachmentPointByNormal({0, -1});
+    const auto *down = mod->getAttachmentPointByNormal({0, 1});
+    if (horizontal) {
+      rows[EdgeKey(mod->worldPosition.y)].push_back(mod.get());
+    } else if (up && down) {
+      StreetLink link;
+      link.street = mod.get();
+      link.top = Vector2Add(mod->worldPosition, up->position);
+      link.bottom = Vector2Add(mod->worldPosition, down->position);
+      streets.push_back(link);
+    }
+  }
+
+  std::vector<RoadSpan> spans;
+  for (auto &[key, roads] : rows) {
+    std::sort(roads.begin(), roads.end(),
+              [](const Module *a, const Module *b) { return a->worldPosition.x < b->worldPosition.x; });
+    for (const Module *road : roads) {
+      float x = road->worldPosition.x;
+      if (spans.empty() || EdgeKey(spans.back().top) != key || x > spans.back().xMax + JOIN_EPSILON) {
+        RoadSpan span;
+        span.top = road->worldPosition.y;
+        span.bottom = road->worldPosition.y + road->getHeight();
+        span.xMin = x;
+        span.xMax = x;
+        spans.push_back(span);
+      }
+      RoadSpan &span = spans.back();
+      span.xMax = std::max(span.xMax, x + road->getWidth());
+      const auto *joint = road->getAttachmentPointByNormal({0, -1});
+      if (!joint)
+        joint = road->getAttachmentPointByNormal({0, 1});
+      if (joint)
+        span.entrances.push_back({road, x + joint->position.x});
+    }
+  }
+
+  // 2. Cross streets join the road whose bottom (top) edge their top (bottom) end touches
+  std::unordered_map<long, std::vector<int>> spansByTop;
+  std::unordered_map<long, std::vector<int>> spansByBottom;
+  for (int i = 0; i < (int)spans.size(); ++i) {
+    spansByTop[EdgeKey(spans[i].top)].push_back(i);
+    spansByBottom[EdgeKey(spans[i].bottom)].push_back(i);
+  }
+  auto findSpan = [&](const std::unordered_map<long, std::vector<int>> &index, Vector2 joint) {
+    auto it = index.find(EdgeKey(joint.y));
+    if (it == index.end())
+      return -1;
+    for (int i : it->second) {
+      if (joint.x >= spans[i].xMin - JOIN_EPSILON && joint.x <= spans[i].xMax + JOIN_EPSILON)
+        return i;
+    }
+    return -1;
+  };
+  for (uint32_t s = 0; s < (uint32_t)streets.size(); ++s) {
+    StreetLink &link = streets[s];
+    link.upper = findSpan(spansByBottom, link.top);
+    link.lower = findSpan(spansByTop, link.bottom);
+    if (link.upper >= 0)
+      spans[link.upper].crossJoints.push_back({s, link.top.x});
+    if (link.lower >= 0)
+      spans[link.lower].crossJoints.push_back({s, link.bottom.x});
+  }
+
+  // 3. Nodes, lane by lane in driving order
+  const float eastY = P2M(Config::LANE_OFFSET_DOWN);
+  const float westY = P2M(Config::LANE_OFFSET_UP);
+  auto addLane = [&](Vector2 direction, float offset, uint32_t count) {
+    graph.lanes.push_back({direction, offset, (uint32_t)graph.positions.size(), count});
+  };
+
+  for (RoadSpan &span : spans) {
+    span.stations.push_back(span.xMin);
+    span.stations.push_back(span.xMax);
+    for (const auto &[road, x] : span.entrances)
+      span.stations.push_back(x);
+    for (const auto &[street, x] : span.crossJoints)
+      span.stations.push_back(x);
+    std::sort(span.stations.begin(), span.stations.end());
+    span.stations.erase(std::unique(span.stations.begin(), span.stations.end(),
+                                    [](float a, float b) { return b - a < JOIN_EPSILON; }),
+                        span.stations.end());
+
+    const uint32_t count = (uint32_t)span.stations.size();
+    span.eastFirst = (uint32_t)graph.positions.size();
+    addLane({1, 0}, span.top + eastY, count);
+    for (float x : span.stations)
+      graph.positions.push_back({x, span.top + eastY});
+
+    span.westFirst = (uint32_t)graph.positions.size();
+    addLane({-1, 0}, span.top + westY, count);
+    for (auto it = span.stations.rbegin(); it != span.stations.rend(); ++it)
+      graph.positions.push_back({*it, span.top + westY});
+  }
+
+  for (StreetLink &link : streets) {
+    // The road sprite is turned clockwise, so the eastbound lane becomes the southbound one
+    float right = link.street->worldPosition.x + link.street->getWidth();
+    float southX = right - eastY;
+    float northX = right - westY;
+
+    link.southFirst = (uint32_t)graph.positions.size();
+    addLane({0, 1}, southX, 2);
+    graph.positions.push_back({southX, link.top.y});
+    graph.positions.push_back({southX, link.bottom.y});
+
+    link.northFirst = (uint32_t)graph.positions.size();
+    addLane({0, -1}, northX, 2);
+    graph.positions.push_back({northX, link.bottom.y});
+    graph.positions.push_back({northX, link.top.y});
+  }
+
+  // Lanes by their fixed coordinate, so findLane() only tests the few near a position
+  for (uint32_t lane = 0; lane < (uint32_t)graph.lanes.size(); ++lane) {
+    const LaneRun &run = graph.lanes[lane];
+    (run.direction.y == 0.0f ? graph.rowLanes : graph.columnLanes).push_back({run.offset, lane});
+  }
+  std::sort(graph.rowLanes.begin(), graph.rowLanes.end());
+  std::sort(graph.columnLanes.begin(), graph.columnLanes.end());
+
+  // 4. Edges: along every lane, plus turns between roads and cross streets
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (const LaneRun &lane : graph.lanes) {
+    for (uint32_t k = 1; k < lane.nodeCount; ++k)
+      edges.push_back({lane.firstNode + k - 1, lane.firstNode + k});
+  }
+
+  for (const StreetLink &link : streets) {
+    const uint32_t southTop = link.southFirst, southBottom = link.southFirst + 1;
+    const uint32_t northBottom = link.northFirst, northTop = link.northFirst + 1;
+    if (link.upper >= 0) {
+      const RoadSpan &span = spans[link.upper];
+      size_t i = span.stationIndex(link.top.x);
+      edges.push_back({span.eastNode(i), southTop});
+      edges.push_back({span.westNode(i), southTop});
+      edges.push_back({northTop, span.eastNode(i)});
+      edges.push_back({northTop, span.westNode(i)});
+    } else {
+      graph.entries.push_back({southTop, {0, 1}});
+      graph.exits.push_back({northTop, {0, -1}});
+    }
+    if (link.lower >= 0) {
+      const RoadSpan &span = spans[link.lower];
+      size_t i = span.stationIndex(link.bottom.x);
+      edges.push_back({southBottom, span.eastNode(i)});
+      edges.push_back({southBottom, span.westNode(i)});
+      edges.push_back({span.eastNode(i), northBottom});
+      edges.push_back({span.westNode(i), northBottom});
+    } else {
+      graph.entries.push_back({northBottom, {0, -1}});
+      graph.exits.push_back({southBottom, {0, 1}});
+    }
+  }
+
+  for (const RoadSpan &span : spans) {
+    const size_t last = span.stations.size() - 1;
+    graph.entries.push_back({span.eastNode(0), {1, 0}});
+    graph.entries.push_back({span.westNode(last), {-1, 0}});
+    graph.exits.push_back({span.eastNode(last), {1, 0}});
+    graph.exits.push_back({span.westNode(0), {-1, 0}});
+    for (const auto &[road, x] : span.entrances) {
+      size_t i = span.stationIndex(x);
+      graph.entranceNodes[road] = {span.eastNode(i), span.westNode(i)};
+    }
+  }
+
+  // 5. Compressed sparse rows
+  const size_t nodeCount = graph.positions.size();
+  graph.firstEdge.assign(nodeCount + 1, 0);
+  for (const auto &[from, to] : edges)
+    graph.firstEdge[from + 1]++;
+  for (size_t n = 0; n < nodeCount; ++n)
+    graph.firstEdge[n + 1] += graph.firstEdge[n];
+
+  graph.edgeTargets.resize(edges.size());
+  graph.edgeLengths.resize(edges.size());
+  std::vector<uint32_t> fill(graph.firstEdge.begin(), graph.firstEdge.end() - 1);
+  for (const auto &[from, to] : edges) {
+    uint32_t e = fill[from]++;
+    graph.edgeTargets[e] = to;
+    graph.edgeLengths[e] = Vector2Distance(graph.positions[from], graph.positions[to]);
+  }
+
+  Logger::Info("RoadGraph: {} roads, {} cross streets -> {} nodes, {} edges", spans.size(), streets.size(), nodeCount,
+               edges.size());
+  return graph;
+}
+
+uint32_t RoadGraph::findNodeAhead(Vector2 position, Vector2 heading) const {
+  if (Vector2Length(heading) < 1e-4f)
+    return NO_NODE;
+  heading = Vector2Normalize(heading);
+
+  uint32_t best = NO_NODE;
+  float bestDistance = LANE_SNAP_DISTANCE;
+  for (const LaneRun &lane : lanes) {
+    if (Vector2DotProduct(lane.direction, heading) < 0.7f)
+      continue;
+    bool horizontal = lane.direction.y == 0.0f;
+    float distance = std::fabs((horizontal ? position.y : position.x) - lane.offset);
+    if (distance > bestDistance)
+      continue;
+
+    // Lane nodes are sorted by progress along the lane
+    float along = Vector2DotProduct(position, lane.direction);
+    auto progress = [&](uint32_t k) { return Vector2DotProduct(positions[lane.firstNode + k], lane.direction); };
+    if (along < progress(0) - LANE_SNAP_DISTANCE)
+      continue;
+    uint32_t lo = 0, hi = lane.nodeCount;
+    while (lo < hi) {
+      uint32_t mid = (lo + hi) / 2;
+      if (progress(mid) < along - JOIN_EPSILON)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (lo == lane.nodeCount)
+      continue; // Already past the end of this lane
+
+    best = lane.firstNode + lo;
+    bestDistance = distance;
+  }
+  return best;
+}
+
+bool RoadGraph::isOnLane(uint32_t lane, Vector2 position, Vector2 heading) const {
+  const LaneRun &run = lanes[lane];
+  if (Vector2DotProduct(run.direction, heading) < 0.7f)
+    return false;
+  bool horizontal = run.direction.y == 0.0f;
+  if (std::fabs((horizontal ? position.y : position.x) - run.offset) > LANE_SNAP_DISTANCE)
+    return false;
+  float along = Vector2DotProduct(position, run.direction);
+  float first = Vector2DotProduct(positions[run.firstNode], run.direction);
+  float last = Vector2DotProduct(positions[run.firstNode + run.nodeCount - 1], run.direction);
+  return along >= first - LANE_SNAP_DISTANCE && along <= last + LANE_SNAP_DISTANCE;
+}
+
+uint32_t RoadGraph::findLane(Vector2 position, Vector2 heading) const {
+  if (Vector2Length(heading) < 1e-4f)
+    return NO_LANE;
+  heading = Vector2Normalize(heading);
+  // isOnLane() wants the heading within ~45 degrees of the lane, so only lanes along its main axis can match
+  bool horizontal = std::fabs(heading.x) >= std::fabs(heading.y);
+  const std::vector<std::pair<float, uint32_t>> &byOffset = horizontal ? rowLanes : columnLanes;
+  float coordinate = horizontal ? position.y : position.x;
+  auto it = std::lower_bound(byOffset.begin(), byOffset.end(), coordinate - LANE_SNAP_DISTANCE,
+                             [](const std::pair<float, uint32_t> &entry, float value) { return entry.first < value; });
+  for (; it != byOffset.end() && it->first <= coordinate + LANE_SNAP_DISTANCE; ++it) {
+    if (isOnLane(it->second, position, heading))
+      return it->second;
+  }
+  return NO_LANE;
+}
+
+uint32_t RoadGraph::getNodeLane(uint32_t node) const {
+  if (node >= positions.size())
+    return NO_LANE;
+  // Lanes own consecutive node ranges, in lane order
+  auto it = std::upper_bound(lanes.begin(), lanes.end(), node,
+                             [](uint32_t n, const LaneRun &lane) { return n < lane.firstNode; });
+  return it == lanes.begin() ? NO_LANE : (uint32_t)(it - lanes.begin()) - 1;
+}
+
+std::pair<uint32_t, uint32_t> RoadGraph::getEntranceNodes(const Module *road) const {
+  auto it = entranceNodes.find(road);
+  if (it == entranceNodes.end())
+    return {NO_NODE, NO_NODE};
+  return it->second;
+}
+
+uint64_t RoadGraph::getFingerprint() const {
+  // FNV-1a over the raw arrays; positions are bit-exact because generation is deterministic per seed
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  auto mix = [&hash](const void *data, size_t bytes) {
+    const auto *p = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < bytes; ++i)
+      hash = (hash ^ p[i]) * 0x100000001B3ULL;
+  };
+  mix(positions.data(), positions.size() * sizeof(Vector2));
+  mix(firstEdge.data(), firstEdge.size() * sizeof(uint32_t));
+  mix(edgeTargets.data(), edgeTargets.size() * sizeof(uint32_t));
+  return hash;
+}
+
+float RoadGraph::getRouteLength(std::span<const uint32_t> route) const {
+  float length = 0.0f;
+  for (size_t i = 1; i < route.size(); ++i)
+    length += Vector2Distance(positions[route[i - 1]], positions[route[i]]);
+  return length;
+}
+
+bool RoadGraph::findRoute(uint32_t start, std::span<const uint32_t> goals, SearchScratch &scratch,
+                          std::vector<uint32_t> &route) const {
+  if (hierarchy)
+    return hierarchy->findRoute(start, goals, scratch, route);
+  return findRouteAStar(start, goals, scratch, route);
+}
+
+bool RoadGraph::findRouteAStar(uint32_t start, std::span<const uint32_t> goals, SearchScratch &scratch,
+                               std::vector<uint32_t> &route) const {
+  return findRouteWeighted(start, goals, edgeLengths, 1.0f, scratch, route);
+}
+
+uint32_t RoadGraph::findEdge(uint32_t from, uint32_t to) const {
+  for (uint32_t e = firstEdge[from]; e < firstEdge[from + 1]; ++e) {
+    if (edgeTargets[e] == to)
+      return e;
+  }
+  return NO_EDGE;
+}
+
+bool RoadGraph::findRouteWeighted(uint32_t start, std::span<const uint32_t> goals, std::span<const float> edgeCosts,
+                                  float minCostPerMeter, SearchScratch &scratch, std::vector<uint32_t> &route) const {
+  route.clear();
+  scratch.lastSettled = 0;
+  const size_t nodeCount = positions.size();
+  if (start >= nodeCount || goals.empty() || edgeCosts.size() != edgeTargets.size())
+    return false;
+  const uint32_t gen = BeginSearch(scratch, nodeCount);
+
+  for (uint32_t g : goals) {
+    if (g < nodeCount)
+      scratch.goal[g] = gen;
+  }
+  const bool useHeuristic = goals.size() <= MAX_HEURISTIC_GOALS;
+  auto heuristic = [&](uint32_t node) {
+    if (!useHeuristic)
+      return 0.0f;
+    float h = std::numeric_limits<float>::max();
+    for (uint32_t g : goals)
+      h = std::min(h, Vector2Distance(positions[node], positions[g]));
+    return h * minCostPerMeter;
+  };
+
+  auto &heap = scratch.heap;
+  heap.clear();
+
+  scratch.cost[start] = 0.0f;
+  scratch.parent[start] = NO_NODE;
+  scratch.visited[start] = gen;
+  heap.push_back({heuristic(start), start});
+
+  uint32_t reached = NO_NODE;
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), Later);
+    uint32_t node = heap.back().second;
+    heap.pop_back();
+    if (scratch.closed[node] == gen)
+      continue; // Stale duplicate
+    scratch.closed[node] = gen;
+    scratch.lastSettled++;
+
+    if (scratch.goal[node] == gen) {
+      reached = node;
+      break;
+    }
+
+    const float base = scratch.cost[node];
+    for (uint32_t e = firstEdge[node]; e < firstEdge[node + 1]; ++e) {
+      uint32_t next = edgeTargets[e];
+      float cost = base + edgeCosts[e];
+      if (scratch.visited[next] == gen && cost >= scratch.cost[next])
+        continue;
+      scratch.visited[next] = gen;
+      scratch.cost[next] = cost;
+      scratch.parent[next] = node;
+      heap.push_back({cost + heuristic(next), next});
+      std::push_heap(heap.begin(), heap.end(), Later);
+    }
+  }
+
+  if (reached == NO_NODE)
+    return false;
+  for (uint32_t n = reached; n != NO_NODE; n = scratch.parent[n])
+    route.push_back(n);
+  std::reverse(route.begin(), route.end());
+  return true;
+}
+
+void RoadGraph::findDistances(uint32_t start, std::span<const uint32_t> targets, SearchScratch &scratch,
+                              std::span<float> distances) const {
+  const size_t nodeCount = positions.size();
+  std::fill(distances.begin(), distances.end(), std::numeric_limits<float>::infinity());
+  if (start >= nodeCount || targets.empty())
+    return;
+  const uint32_t gen = BeginSearch(scratch, nodeCount);
+
+  // Stop as soon as every (distinct) target is settled instead of exploring the whole graph
+  size_t remaining = 0;
+  for (uint32_t t : targets) {
+    if (t < nodeCount && scratch.goal[t] != gen) {
+      scratch.goal[t] = gen;
+      remaining++;
+    }
+  }
+
+  auto &heap = scratch.heap;
+  heap.clear();
+  scratch.cost[start] = 0.0f;
+  scratch.visited[start] = gen;
+  heap.push_back({0.0f, start});
+  while (!heap.empty() && remaining > 0) {
+    std::pop_heap(heap.begin(), heap.end(), Later);
+    uint32_t node = heap.back().second;
+    heap.pop_back();
+    if (scratch.closed[node] == gen)
+      continue; // Stale duplicate
+    scratch.closed[node] = gen;
+    scratch.lastSettled++;
+    if (scratch.goal[node] == gen)
+      remaining--;
+
+    const float base = scratch.cost[node];
+    for (uint32_t e = firstEdge[node]; e < firstEdge[node + 1]; ++e) {
+      uint32_t next = edgeTargets[e];
+      float cost = base + edgeLengths[e];
+      if (scratch.visited[next] == gen && cost >= scratch.cost[next])
+        continue;
+      scratch.visited[next] = gen;
+      scratch.cost[next] = cost;
+      heap.push_back({cost, next});
+      std::push_heap(heap.begin(), heap.end(), Later);
+    }
+  }
+
+  for (size_t i = 0; i < targets.size() && i < distances.size(); ++i) {
+    uint32_t t = targets[i];
+    if (t < nodeCount && scratch.closed[t] == gen)
+      distances[i] = scratch.cost[t];
+  }
+}
@@ -0,0 +1,120 @@
+#include "entities/map/SpotRegistry.hpp"
+
+/**
+ * @file SpotRegistry.cpp
+ * @brief Implementation of the city-wide spot table.
+ */
+
+namespace {
+bool IsCharging(const Module *mod) {
+  return mod->getType() == ModuleType::SMALL_CHARGING || mod->getType() == ModuleType::LARGE_CHARGING;
+}
+} // namespace
+
+SpotRegistry::~SpotRegistry() { clear(); }
+
+void SpotRegistry::rebuild(const std::vector<std::unique_ptr<Module>> &modules) {
+  clear();
+
+  // Parking facilities first, then charging, so each kind is one contiguous range
+  for (bool charging : {false, true}) {
+    if (charging)
+      chargingBegin = (uint32_t)facility.size();
+    for (const auto &mod : modules) {
+      if (mod->getSpotCount() == 0 || IsCharging(mod.get()) != charging)
+        continue;
+      firstSpot.push_back((uint32_t)facility.size());
+      for (int i = 0; i < (int)mod->getSpotCount(); ++i) {
+        Spot spot = mod->getSpot(i);
+        Vector2 world = {mod->worldPosition.x + spot.localPosition.x, mod->worldPosition.y + spot.localPosition.y};
+        facility.push_back((uint32_t)facilities.size());
+        positionX.push_back(world.x);
+        positionY.push_back(world.y);
+        orientation.push_back(spot.orientation);
+        price.push_back(spot.price);
+        basePrice.push_back(spot.price);
+      }
+      facilities.push_back(mod.get());
+    }
+  }
+  firstSpot.push_back((uint32_t)facility.size());
+
+  ++priceVersion;
+  states = std::make_unique<std::atomic<uint8_t>[]>(facility.size());
+  for (size_t f = 0; f < facilities.size(); ++f) {
+    Module *mod = facilities[f];
+    for (uint32_t i = 0; i < firstSpot[f + 1] - firstSpot[f]; ++i)
+      states[firstSpot[f] + i].store((uint8_t)mod->getSpot((int)i).state, std::memory_order_relaxed);
+    mod->bindSpots(this, firstSpot[f]);
+  }
+}
+
+void SpotRegistry::clear() {
+  for (Module *mod : facilities)
+    mod->unbindSpots();
+  facilities.clear();
+  firstSpot.clear();
+  chargingBegin = 0;
+  facility.clear();
+  positionX.clear();
+  positionY.clear();
+  orientation.clear();
+  price.clear();
+  basePrice.clear();
+  states.reset();
+  ++priceVersion;
+}
+
+bool SpotRegistry::tryReserve(uint32_t spot) {
+  uint8_t expected = (uint8_t)SpotState::FREE;
+  if (!states[spot].compare_exchange_strong(expected, (uint8_t)SpotState::RESERVED, std::memory_order_acq_rel))
+    return false;
+  getFacility(spot)->countStateChange(SpotState::FREE, SpotState::RESERVED);
+  return true;
+}
+
+SpotState SpotRegistry::exchange(uint32_t spot, SpotState state) {
+  SpotState previous = (SpotState)states[spot].exchange((uint8_t)state, std::memory_order_acq_rel);
+  if (previous != state)
+    getFacility(spot)->countStateChange(previous, state);
+  return previous;
+}
+
+void SpotRegistry::applyPriceFactor(uint32_t index, float factor) {
+  // Plain loop over two dense arrays; compilers vectorize it
+  const float *base = basePrice.data();
+  float *current = price.data();
+  for (uint32_t spot = firstSpot[index]; spot < firstSpot[index + 1]; ++spot)
+    current[spot] = base[spot] * factor;
+  ++priceVersion;
+}
+
+uint32_t SpotRegistry::getFacilityIndex(const Module *module) const {
+  if (module->getSpotRegistry() != this || module->getSpotCount() == 0)
+    return NO_FACILITY;
+  return facility[module->getRegistrySpot(0)];
+}
+
+std::pair<uint32_t, uint32_t> SpotRegistry::getRange(bool charging) const {
+  return charging ? std::pair{chargingBegin, size()} : std::pair{0u, chargingBegin};
+}
+
+std::pair<uint32_t, uint32_t> SpotRegistry::getRange(const Module *module) const {
+  if (module->getSpotRegistry() != this)
+    return {0, 0};
+  uint32_t first = module->getRegistrySpot(0);
+  return {first, first + (uint32_t)module->getSpotCount()};
+}
+
+uint32_t SpotRegistry::findCheapestFree(uint32_t first, uint32_t last) const {
+  uint32_t best = NO_SPOT;
+  float bestPrice = std::numeric_limits<float>::infinity();
+  for (uint32_t spot = first; spot < last; ++spot) {
+    bool free = states[spot].load(std::memory_order_relaxed) == (uint8_t)SpotState::FREE;
+    if (free && price[spot] < bestPrice) {
+      bestPrice = price[spot];
+      best = spot;
+    }
+  }
+  return best;
+}
@@ -3,6 +3,7 @@
 #include "core/AssetManager.hpp"
 #include "core/Logger.hpp"
 #include "raylib.h"
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -13,7 +14,9 @@
  */
 
 World::World(float width, float height) : width(width), height(height), showGrid(false) {
-  tileTextures = {"grass1", "grass2", "grass3", "grass4"};
+  auto &AM = AssetManager::Get();
+  tileTextures = {AM.GetTextureHandle("grass1"), AM.GetTextureHandle("grass2"), AM.GetTextureHandle("grass3"),
+                  AM.GetTextureHandle("grass4")};
 
   // Calculate Tile Size in Meters
   // BACKGROUND_TILE_SIZE art pixels per tile
@@ -41,20 +44,32 @@ void World::update(double /*dt*/) {
   // World update logic (if any)
 }
 
-void World::draw() {
+void World::draw() { drawTiles({0, 0, width, height}); }
+
+void World::drawTiles(Rectangle region) const {
+  if (backgroundTiles.empty())
+    return;
+
+  // Tile range covering the region (tiles are on a regular grid, so no search is needed)
+  int rows = (int)backgroundTiles.size();
+  int cols = (int)backgroundTiles[0].size();
+  int x0 = std::max(0, (int)std::floor(region.x / tileWidthMeter));
+  int y0 = std::max(0, (int)std::floor(region.y / tileHeightMeter));
+  int x1 = std::min(cols - 1, (int)std::floor((region.x + region.width) / tileWidthMeter));
+  int y1 = std::min(rows - 1, (int)std::floor((region.y + region.height) / tileHeightMeter));
+
   // Draw Background Tiles
   auto &AM = AssetManager::Get();
 
-  for (size_t y = 0; y < backgroundTiles.size(); ++y) {
-    for (size_t x = 0; x < backgroundTiles[y].size(); ++x) {
+  for (int y = y0; y <= y1; ++y) {
+    for (int x = x0; x <= x1; ++x) {
       int tileIndex = backgroundTiles[y][x];
-      Texture2D tex = AM.GetTexture(tileTextures[tileIndex]);
+      SpriteRegion sprite = AM.GetSpriteRegion(tileTextures[tileIndex]);
 
-      Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
       Rectangle dest = {x * tileWidthMeter, y * tileHeightMeter, tileWidthMeter, tileHeightMeter};
       Vector2 origin = {0, 0};
 
-      DrawTexturePro(tex, source, dest, origin, 0.0f, WHITE);
+      DrawTexturePro(sprite.texture, sprite.source, dest, origin, 0.0f, WHITE);
     }
   }
 }
@@ -64,18 +79,7 @@ void World::drawOverlay() {
   // User wanted this over everything
   DrawRectangleLinesEx({0, 0, width, height}, 0.1f, BLACK);
 
-  // Draw Grid
-  if (showGrid) {
-    // Grid lines every 1 meter
-    float spacing = 1.0f;
-
-    for (float x = 0; x <= width; x += spacing) {
-      DrawLineV({x, 0}, {x, height}, Fade(LIGHTGRAY, 0.3f));
-    }
-    for (float y = 0; y <= height; y += spacing) {
-      DrawLineV({0, y}, {width, y}, Fade(LIGHTGRAY, 0.3f));
-    }
-  }
+  // The optional grid is drawn by GridOverlay (RenderSystem) when showGrid is set
 }
 
 void World::drawMask() {
@@ -1,10 +1,14 @@
 #include "entities/map/WorldGenerator.hpp"
 #include "config.hpp"
+#include "core/JobPool.hpp"
 #include "core/Logger.hpp"
 #include "entities/map/Modules.hpp"
 #include "raymath.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <random>
+#include <thread>
 #include <vector>
 
 /**
@@ -18,7 +22,117 @@ struct PlannedUnit {
   std::unique_ptr<Module> bottomFacility;
 };
 
+namespace {
+/**
+ * @brief Creates a facility by kind: 0 small parking, 1 large parking, 2 small charging, 3 large charging.
+ */
+std::unique_ptr<Module> CreateFacility(int kind, bool isTop) {
+  switch (kind) {
+  case 0:
+    return std::make_unique<SmallParking>(isTop);
+  case 1:
+    return std::make_unique<LargeParking>(isTop);
+  case 2:
+    return std::make_unique<SmallChargingStation>(isTop);
+  default:
+    return std::make_unique<LargeChargingStation>(isTop);
+  }
+}
+
+/**
+ * @brief Road skeleton shared by every row of a city grid, in meters.
+ *
+ * A row is: start padding, then entrance units at a fixed pitch, with a junction road (where the
+ * cross streets meet the row) after every @ref blockUnits units, then tail padding up to the world
+ * edge. The pitches are derived once from the widest facility footprint, so a unit's position is a
+ * function of its index alone and no collision checks are needed.
+ */
+struct GridLayout {
+  float roadStep = 0.0f;      ///< Left-to-right attachment distance of a NormalRoad.
+  float entranceStep = 0.0f;  ///< Same for an entrance road.
+  float unitPitch = 0.0f;     ///< Entrance road plus the fillers that keep neighbouring facilities apart.
+  float junctionPitch = 0.0f; ///< Extra width of a junction (padding, junction road, padding).
+  float firstUnitX = 0.0f;    ///< X of the first entrance road.
+  float rowEnd = 0.0f;        ///< Every row's road reaches at least this X (the world width).
+  int startPads = 1;          ///< NormalRoads before the first unit.
+  int unitFillers = 0;        ///< NormalRoads after each entrance road.
+  int padsBeforeJunction = 0;
+  int padsAfterJunction = 0;
+  int unitsPerRow = 0;
+  int blockUnits = 1;
+  int junctions = 0; ///< Junctions per row (= cross streets between two neighbouring rows).
+
+  float unitX(int i) const { return firstUnitX + (float)i * unitPitch + (float)(i / blockUnits) * junctionPitch; }
+
+  float junctionX(int j) const {
+    return firstUnitX + (float)((j + 1) * blockUnits) * unitPitch + (float)j * junctionPitch +
+           (float)padsBeforeJunction * roadStep;
+  }
+
+  /**
+   * @brief Enumerates the row's entrance units and NormalRoads (left to right, external roads last).
+   *
+   * Used once serially to count the roads a row needs and once per row in parallel to place them,
+   * so both passes always agree.
+   *
+   * @param units Entrance units that actually carry facilities in this row (the rest is padding).
+   * @param onUnit Called as onUnit(index, x) with the left edge of each entrance road.
+   * @param onPad Called as onPad(x) with the left edge of each NormalRoad.
+   */
+  template <typename UnitFn, typename PadFn> void walkRow(int units, UnitFn &&onUnit, PadFn &&onPad) const {
+    for (int m = 0; m < startPads; ++m)
+      onPad((float)m * roadStep);
+
+    for (int i = 0; i < units; ++i) {
+      float x = unitX(i);
+      onUnit(i, x);
+      for (int m = 0; m < unitFillers; ++m)
+        onPad(x + entranceStep + (float)m * roadStep);
+
+      if ((i + 1) % blockUnits == 0 && i < unitsPerRow - 1) {
+        float junction = junctionX(i / blockUnits);
+        for (int m = 0; m < padsBeforeJunction; ++m)
+          onPad(junction - (float)(padsBeforeJunction - m) * roadStep);
+        onPad(junction);
+        for (int m = 0; m < padsAfterJunction; ++m)
+          onPad(junction + (float)(m + 1) * roadStep);
+      }
+    }
+
+    // Rows with fewer units are padded to the common length; their missing junction roads are
+    // laid on top of that padding so the cross streets still connect.
+    float tailX = units == 0 ? firstUnitX : (units < unitsPerRow ? unitX(units) : unitX(units - 1) + unitPitch);
+    int tailPads = std::max(0, (int)std::ceil((rowEnd - tailX) / roadStep - 1e-4f));
+    for (int m = 0; m < tailPads; ++m)
+      onPad(tailX + (float)m * roadStep);
+    for (int j = std::min(units / blockUnits, junctions); j < junctions; ++j)
+      onPad(junctionX(j));
+
+    // External roads, truly outside the world on both ends
+    onPad(-roadStep);
+    onPad(rowEnd);
+  }
+};
+
+/**
+ * @brief One row of a city grid, fully constructed before placement so workers never allocate.
+ */
+struct GridRow {
+  std::vector<PlannedUnit> units;                    ///< Units that carry at least one facility.
+  std::vector<std::unique_ptr<Module>> pads;         ///< NormalRoads in GridLayout::walkRow order.
+  std::vector<std::unique_ptr<Module>> crossStreets; ///< Streets down to the next row, one per junction.
+};
+
+/**
+ * @brief Number of whole road steps needed to cover @p distance (0 if it is already covered).
+ */
+int StepsToCover(float distance, float step) { return std::max(0, (int)std::ceil(distance / step - 1e-4f)); }
+} // namespace
+
 GeneratedMap WorldGenerator::generate(const MapConfig &config) {
+  if (config.rows > 1)
+    return generateGrid(config);
+
   Logger::Info("Generating World...");
 
   std::vector<std::unique_ptr<Module>> modules;
@@ -31,20 +145,6 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
   int smallChargingLeft = config.smallChargingCount;
   int largeChargingLeft = config.largeChargingCount;
 
-  auto createFacility = [&](int type, int size, bool isTop) -> std::unique_ptr<Module> {
-    if (type == 0) {
-      if (size == 0)
-        return std::make_unique<SmallParking>(isTop);
-      else
-        return std::make_unique<LargeParking>(isTop);
-    } else {
-      if (size == 0)
-        return std::make_unique<SmallChargingStation>(isTop);
-      else
-        return std::make_unique<LargeChargingStation>(isTop);
-    }
-  };
-
   auto getNextFacility = [&](bool isTop) -> std::unique_ptr<Module> {
     std::vector<int> available;
     if (smallParkingLeft > 0)
@@ -59,23 +159,15 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
       return nullptr;
     std::uniform_int_distribution<> dist(0, (int)available.size() - 1);
     int choice = available[dist(gen)];
-    if (choice == 0) {
+    if (choice == 0)
       smallParkingLeft--;
-      return createFacility(0, 0, isTop);
-    }
-    if (choice == 1) {
+    else if (choice == 1)
       largeParkingLeft--;
-      return createFacility(0, 1, isTop);
-    }
-    if (choice == 2) {
+    else if (choice == 2)
       smallChargingLeft--;
-      return createFacility(1, 0, isTop);
-    }
-    if (choice == 3) {
+    else
       largeChargingLeft--;
-      return createFacility(1, 1, isTop);
-    }
-    return nullptr;
+    return CreateFacility(choice, isTop);
   };
 
   // 1. PLAN
@@ -235,3 +327,177 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
   auto world = std::make_unique<World>(worldWidth, worldHeight);
   return {std::move(world), std::move(modules)};
 }
+
+GeneratedMap WorldGenerator::generateGrid(const MapConfig &config) {
+  const int rows = config.rows;
+
+  // 1. PLAN: every requested facility exactly once, in random order, two per entrance unit.
+  // Seeded from raylib so that --seed reproduces the layout.
+  std::vector<int> kinds;
+  kinds.insert(kinds.end(), std::max(0, config.smallParkingCount), 0);
+  kinds.insert(kinds.end(), std::max(0, config.largeParkingCount), 1);
+  kinds.insert(kinds.end(), std::max(0, config.smallChargingCount), 2);
+  kinds.insert(kinds.end(), std::max(0, config.largeChargingCount), 3);
+  std::mt19937 gen((unsigned)GetRandomValue(0, std::numeric_limits<int>::max()));
+  std::shuffle(kinds.begin(), kinds.end(), gen);
+
+  const int totalUnits = (int)(kinds.size() + 1) / 2;
+
+  GridLayout layout;
+  layout.blockUnits = std::max(1, Config::GRID_BLOCK_UNITS);
+  layout.unitsPerRow = std::max(1, (totalUnits + rows - 1) / rows);
+  layout.junctions = (layout.unitsPerRow - 1) / layout.blockUnits;
+
+  // Reference geometry, read from the modules themselves
+  NormalRoad roadProbe;
+  DoubleEntranceRoad entranceProbe;
+  const auto *roadLeft = roadProbe.getAttachmentPointByNormal({-1, 0});
+  const auto *roadRight = roadProbe.getAttachmentPointByNormal({1, 0});
+  const auto *entranceLeft = entranceProbe.getAttachmentPointByNormal({-1, 0});
+  const auto *entranceRight = entranceProbe.getAttachmentPointByNormal({1, 0});
+  const float entranceJoinX = entranceProbe.getAttachmentPointByNormal({0, -1})->position.x;
+  const float roadHeight = roadProbe.getHeight();
+  layout.roadStep = roadRight->position.x - roadLeft->position.x;
+  layout.entranceStep = entranceRight->position.x - entranceLeft->position.x;
+
+  // Construct all modules serially: module constructors draw spot prices from raylib's global RNG,
+  // and a fixed construction order keeps seeded runs reproducible.
+  std::vector<GridRow> grid(rows);
+  size_t nextKind = 0;
+  float minLeft = 0.0f; // Facility footprint relative to its entrance road's left edge
+  float maxRight = layout.entranceStep;
+  float maxTop = 0.0f;
+  float maxBottom = 0.0f;
+
+  auto nextFacility = [&](bool isTop) -> std::unique_ptr<Module> {
+    if (nextKind >= kinds.size())
+      return nullptr;
+    auto fac = CreateFacility(kinds[nextKind++], isTop);
+    const auto *fAtt = fac->getAttachmentPointByNormal({0, isTop ? 1.0f : -1.0f});
+    float left = entranceJoinX - fAtt->position.x;
+    minLeft = std::min(minLeft, left);
+    maxRight = std::max(maxRight, left + fac->getWidth());
+    float &extent = isTop ? maxTop : maxBottom;
+    extent = std::max(extent, fac->getHeight());
+    return fac;
+  };
+
+  for (auto &row : grid) {
+    for (int i = 0; i < layout.unitsPerRow && nextKind < kinds.size(); ++i) {
+      PlannedUnit unit;
+      unit.topFacility = nextFacility(true);
+      unit.bottomFacility = nextFacility(false);
+      if (unit.bottomFacility)
+        unit.road = std::make_unique<DoubleEntranceRoad>();
+      else
+        unit.road = std::make_unique<UpEntranceRoad>();
+      unit.topFacility->setParent(unit.road.get());
+      if (unit.bottomFacility)
+        unit.bottomFacility->setParent(unit.road.get());
+      row.units.push_back(std::move(unit));
+    }
+  }
+
+  // 2. LAYOUT: pitches that keep the widest facilities and the cross streets apart
+  CrossStreet crossProbe(roadHeight);
+  const float crossWidth = crossProbe.getWidth();
+  const float crossLeft = layout.roadStep / 2.0f - crossProbe.getAttachmentPointByNormal({0, -1})->position.x;
+  const float footprint = maxRight - minLeft;
+
+  layout.startPads = 1 + StepsToCover(-minLeft - layout.roadStep, layout.roadStep);
+  layout.firstUnitX = (float)layout.startPads * layout.roadStep;
+  layout.unitFillers = StepsToCover(footprint - layout.entranceStep, layout.roadStep);
+  layout.unitPitch = layout.entranceStep + (float)layout.unitFillers * layout.roadStep;
+  layout.padsBeforeJunction = StepsToCover(maxRight - layout.unitPitch - crossLeft, layout.roadStep);
+  layout.padsAfterJunction = StepsToCover(crossLeft + crossWidth - layout.roadStep - minLeft, layout.roadStep);
+  layout.junctionPitch = (float)(layout.padsBeforeJunction + 1 + layout.padsAfterJunction) * layout.roadStep;
+
+  const float lastUnitX = layout.unitX(layout.unitsPerRow - 1);
+  const float contentEnd = lastUnitX + layout.unitPitch +
+                           (float)StepsToCover(maxRight - layout.unitPitch, layout.roadStep) * layout.roadStep +
+                           layout.roadStep; // One extra road inside on the right, as in the strip layout
+
+  const float tileM = (float)Config::BACKGROUND_TILE_SIZE / (float)Config::ART_PIXELS_PER_METER;
+  const float worldWidth = std::ceil(contentEnd / tileM) * tileM;
+  layout.rowEnd = worldWidth;
+
+  // Rows are stacked so that a bottom facility of one row and a top facility of the next share the gap
+  const float crossLength = std::max(maxTop + maxBottom, roadHeight);
+  const float rowPitch = roadHeight + crossLength;
+  const float yPad = tileM * 2.0f;
+  const float firstRowY = yPad + maxTop;
+  const float contentHeight = maxTop + (float)(rows - 1) * rowPitch + roadHeight + maxBottom;
+  const float worldHeight = std::ceil((contentHeight + 2 * yPad) / tileM) * tileM;
+
+  // Remaining modules; counts come from the same walk that places them
+  for (int r = 0; r < rows; ++r) {
+    GridRow &row = grid[r];
+    size_t pads = 0;
+    layout.walkRow((int)row.units.size(), [](int, float) {}, [&pads](float) { ++pads; });
+    row.pads.reserve(pads);
+    for (size_t p = 0; p < pads; ++p)
+      row.pads.push_back(std::make_unique<NormalRoad>());
+    if (r < rows - 1) {
+      for (int j = 0; j < layout.junctions; ++j)
+        row.crossStreets.push_back(std::make_unique<CrossStreet>(crossLength));
+    }
+  }
+
+  // 3. PLACEMENT: closed form, one row per task
+  JobPool pool(std::clamp(std::thread::hardware_concurrency(), 1u, (unsigned)rows));
+  pool.dispatch((size_t)rows, [&](size_t r, unsigned) {
+    GridRow &row = grid[r];
+    const float y = firstRowY + (float)r * rowPitch;
+    size_t pad = 0;
+
+    auto placeFac = [](PlannedUnit &unit, std::unique_ptr<Module> &fac, Vector2 normal) {
+      if (!fac)
+        return;
+      const auto *rAtt = unit.road->getAttachmentPointByNormal(normal);
+      const auto *fAtt = fac->getAttachmentPointByNormal(Vector2Scale(normal, -1.0f));
+      fac->worldPosition = Vector2Subtract(Vector2Add(unit.road->worldPosition, rAtt->position), fAtt->position);
+    };
+
+    layout.walkRow(
+        (int)row.units.size(),
+        [&](int i, float x) {
+          PlannedUnit &unit = row.units[i];
+          unit.road->worldPosition = {x, y};
+          placeFac(unit, unit.topFacility, {0, -1});
+          placeFac(unit, unit.bottomFacility, {0, 1});
+        },
+        [&](float x) { row.pads[pad++]->worldPosition = {x, y}; });
+
+    for (int j = 0; j < (int)row.crossStreets.size(); ++j) {
+      float x = layout.junctionX(j) + crossLeft;
+      row.crossStreets[j]->worldPosition = {x, y + roadHeight};
+    }
+  });
+  pool.wait();
+
+  // 4. COLLECT
+  size_t moduleCount = kinds.size() + (size_t)totalUnits;
+  for (const auto &row : grid)
+    moduleCount += row.pads.size() + row.crossStreets.size();
+  std::vector<std::unique_ptr<Module>> modules;
+  modules.reserve(moduleCount);
+  for (auto &row : grid) {
+    for (auto &pad : row.pads)
+      modules.push_back(std::move(pad));
+    for (auto &unit : row.units) {
+      if (unit.topFacility)
+        modules.push_back(std::move(unit.topFacility));
+      if (unit.bottomFacility)
+        modules.push_back(std::move(unit.bottomFacility));
+      modules.push_back(std::move(unit.road));
+    }
+    for (auto &street : row.crossStreets)
+      modules.push_back(std::move(street));
+  }
+
+  Logger::Info("Generated {}-row city grid: {} facilities, {} modules, {:.0f} x {:.0f} m", rows, kinds.size(),
+               modules.size(), worldWidth, worldHeight);
+
+  auto world = std::make_unique<World>(worldWidth, worldHeight);
+  return {std::move(world), std::move(modules)};
+}
@@ -1,17 +1,23 @@
 #include "core/Application.hpp"
+#include "core/HeadlessRunner.hpp"
 #include "core/Logger.hpp"
 #include <exception>
 
 /**
  * @brief Main entry point of the application.
  *
- * Initializes the Application instance and runs the game loop.
+ * Initializes the Application instance and runs the game loop, or runs the
+ * simulation without a window when started with `--headless`.
  * Catches and logs any unhandled exceptions.
  *
  * @return 0 on success, -1 on error.
  */
-int main() {
+int main(int argc, char **argv) {
   try {
+    if (auto headless = HeadlessRunner::ParseArgs(argc, argv)) {
+      return HeadlessRunner::Run(*headless);
+    }
+
     Application app;
     app.run();
   } catch (const std::exception &e) {
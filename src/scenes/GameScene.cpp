@@ -3,11 +3,12 @@
 #include "config.hpp"
 #include "core/EntityManager.hpp"
 #include "core/Logger.hpp"
+#include "core/SimulationThread.hpp"
 #include "events/GameEvents.hpp"
 #include "events/InputEvents.hpp"
 #include "raymath.h"
 #include "systems/CameraSystem.hpp"
-#include "systems/TrafficSystem.hpp"
+#include "systems/RenderSystem.hpp"
 #include "ui/GameHUD.hpp"
 #include <format>
 
@@ -15,8 +16,8 @@
  * @file GameScene.cpp
  * @brief Implementation of the specific Game Scene.
  *
- * Manages the gameplay state, including entity management, systems initialization,
- * and the main game update/draw logic.
+ * Manages the gameplay state, including systems initialization and the main game update/draw logic.
+ * The simulation runs on a SimulationThread; this file owns the render-thread side of the handoff.
  */
 
 GameScene::GameScene(std::shared_ptr<EventBus> bus, MapConfig config, AdaptiveSignalsConfig adaptiveConfig) 
@@ -27,21 +28,41 @@ GameScene::~GameScene() { Logger::Info("GameScene Destroyed"); }
 void GameScene::load() {
   Logger::Info("Loading GameScene (Generated World)...");
 
+  // Create the simulation first; its constructor generates the world synchronously
+  simulation = std::make_unique<SimulationThread>(config);
+  const EntityManager &entities = simulation->getEntityManager();
+
   trackingSystem = std::make_unique<TrackingSystem>(eventBus);
 
-  // Initialize Managers
+  // Initialize render-thread systems
   cameraSystem = std::make_unique<CameraSystem>(eventBus);
-  entityManager = std::make_unique<EntityManager>(eventBus);
-  trafficSystem = std::make_unique<TrafficSystem>(eventBus, *entityManager);
-  gameHUD = std::make_unique<GameHUD>(eventBus, entityManager.get(), adaptiveConfig);
-
-  // Generate World via Event
-  eventBus->publish(GenerateWorldEvent{config});
+  renderSystem = std::make_unique<RenderSystem>(eventBus, entities);
+  gameHUD = std::make_unique<GameHUD>(eventBus, adaptiveConfig);
 
   // Setup Camera
   cameraSystem->setZoom(1.0f);
 
-  // Camera setup is now handled via WorldBoundsEvent in CameraSystem
+  // World generation happened on the simulation bus, so announce the bounds here
+  if (const World *world = entities.getWorld()) {
+    eventBus->publish(WorldBoundsEvent{world->getWidth(), world->getHeight()});
+  }
+
+  // Adopt the initial snapshot so picking and the HUD have data before the first tick
+  pollSnapshot();
+
+  // Forward simulation-bound requests into the command queue
+  eventTokens.push_back(eventBus->subscribe<SpawnCarRequestEvent>(
+      [this](const SpawnCarRequestEvent &e) { simulation->post(e); }));
+  eventTokens.push_back(eventBus->subscribe<CycleAutoSpawnLevelEvent>(
+      [this](const CycleAutoSpawnLevelEvent &e) { simulation->post(e); }));
+  eventTokens.push_back(
+      eventBus->subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent &e) { simulation->post(e); }));
+  eventTokens.push_back(
+      eventBus->subscribe<ExportMetricsEvent>([this](const ExportMetricsEvent &e) { simulation->post(e); }));
+  eventTokens.push_back(
+      eventBus->subscribe<ResetHeatmapEvent>([this](const ResetHeatmapEvent &e) { simulation->post(e); }));
+  eventTokens.push_back(eventBus->subscribe<CycleHeatmapDecayEvent>(
+      [this](const CycleHeatmapDecayEvent &e) { simulation->post(e); }));
 
   // Subscribe to Events
   eventTokens.push_back(eventBus->subscribe<KeyPressedEvent>([this](const KeyPressedEvent &e) {
@@ -57,6 +78,24 @@ void GameScene::load() {
         eventBus->publish(GamePausedEvent{});
       }
     }
+    if (e.key == KEY_M) {
+      eventBus->publish(ExportMetricsEvent{});
+    }
+    if (e.key == KEY_H) {
+      eventBus->publish(ToggleHeatmapEvent{});
+    }
+    if (e.key == KEY_J) {
+      eventBus->publish(ResetHeatmapEvent{});
+    }
+    if (e.key == KEY_K) {
+      eventBus->publish(CycleHeatmapDecayEvent{});
+    }
+    if (e.key == KEY_G) {
+      // The grid flag is render-only state, so toggling it from this thread is safe
+      if (World *world = simulation->getEntityManager().getWorld()) {
+        world->toggleGrid();
+      }
+    }
   }));
 
   eventTokens.push_back(
@@ -80,29 +119,27 @@ void GameScene::load() {
 
       bool found = false;
 
-      // 1. Check Cars
-      if (entityManager) {
-        for (const auto &car : entityManager->getCars()) {
-          Vector2 pos = car->getPosition();
-          // Check distance in World Space (Meters)
-          // Car radius ~0.5m - 1.0m?
+      // 1. Check Cars (picked against the latest snapshot, not live simulation state)
+      if (snapshot) {
+        for (const auto &car : snapshot->cars) {
           // Using 0.8m as clickable radius
-          if (CheckCollisionPointCircle(worldPos, pos, 0.8f)) {
+          if (CheckCollisionPointCircle(worldPos, car.position, 0.8f)) {
             selectionEvent.type = SelectionType::CAR;
-            selectionEvent.car = car.get();
+            selectionEvent.carId = car.id;
             found = true;
             break;
           }
         }
 
         // 2. Check Facilities
-        if (!found) {
-          for (const auto &mod : entityManager->getModules()) {
-            Rectangle rec = {mod->worldPosition.x, mod->worldPosition.y, mod->getWidth(), mod->getHeight()};
+        if (!found && snapshot->layout) {
+          const SnapshotLayout &layout = *snapshot->layout;
+          for (size_t f = 0; f < layout.facilities.size(); f++) {
+            const FacilityLayout &facility = layout.facilities[f];
 
-            if (CheckCollisionPointRec(worldPos, rec)) {
+            if (CheckCollisionPointRec(worldPos, facility.bounds)) {
               selectionEvent.type = SelectionType::FACILITY;
-              selectionEvent.module = mod.get();
+              selectionEvent.facilityIndex = (int)f;
               found = true;
 
               // 3. Check Spots logic
@@ -112,12 +149,8 @@ void GameScene::load() {
               float threshold = 4.0f;
               float thresholdSq = threshold * threshold;
 
-              for (size_t i = 0; i < mod->getSpotCount(); i++) {
-                Spot s = mod->getSpot(i);
-                Vector2 spotWorldPos = {mod->worldPosition.x + s.localPosition.x,
-                                        mod->worldPosition.y + s.localPosition.y};
-
-                float dSq = Vector2DistanceSqr(worldPos, spotWorldPos);
+              for (uint32_t i = 0; i < facility.spotCount; i++) {
+                float dSq = Vector2DistanceSqr(worldPos, layout.spotPositions[facility.firstSpot + i]);
                 if (dSq < thresholdSq && dSq < minDistSq) {
                   minDistSq = dSq;
                   bestSpotIndex = (int)i;
@@ -126,7 +159,6 @@ void GameScene::load() {
 
               if (bestSpotIndex != -1) {
                 selectionEvent.type = SelectionType::SPOT;
-                selectionEvent.module = mod.get();
                 selectionEvent.spotIndex = bestSpotIndex;
               }
 
@@ -141,13 +173,35 @@ void GameScene::load() {
   }));
 
   // Camera Zoom is now handled by CameraSystem
+
+  simulation->start();
 }
 
 void GameScene::unload() {
-  entityManager->clear();
+  if (simulation) {
+    simulation->stop();
+  }
   eventTokens.clear();
 }
 
+/**
+ * @brief Adopts the newest simulation snapshot, if any, and republishes it on the render bus.
+ */
+void GameScene::pollSnapshot() {
+  auto latest = simulation->pollSnapshot();
+  if (!latest)
+    return;
+
+  int previousLevel = snapshot ? snapshot->spawnLevel : latest->spawnLevel;
+  snapshot = std::move(latest);
+  eventBus->publish(SnapshotUpdatedEvent{snapshot});
+
+  // AutoSpawnLevelChangedEvent is raised on the simulation bus; mirror it for the HUD
+  if (snapshot->spawnLevel != previousLevel) {
+    eventBus->publish(AutoSpawnLevelChangedEvent{snapshot->spawnLevel});
+  }
+}
+
 void GameScene::handleInput() {
   // Camera movement is now handled by CameraSystem
 
@@ -161,11 +215,14 @@ void GameScene::update(double dt) {
   gameHUD->update(dt);
 
   if (!isPaused) {
+    simulation->post(SimulationTickCommand{dt});
+    // Render-thread systems (camera, tracking) still advance on the main bus
     eventBus->publish(GameUpdateEvent{dt});
   }
 }
 
 void GameScene::draw() {
+  pollSnapshot();
   handleInput();
 
   // Create a render camera that applies the PPM scaling
@@ -73,6 +73,9 @@ CameraSystem::CameraSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
     Camera2D renderCamera = camera;
     renderCamera.zoom *= Config::PPM;
     BeginMode2D(renderCamera);
+
+    // Let renderers cull against what is actually on screen
+    eventBus->publish(CameraViewEvent{getVisibleWorldRect(), renderCamera.zoom});
   }));
 
   eventTokens.push_back(eventBus->subscribe<EndCameraEvent>([](const EndCameraEvent &) { EndMode2D(); }));
@@ -103,6 +106,14 @@ void CameraSystem::setWorldBounds(float width, float height) {
   boundsSet = true;
 }
 
+Rectangle CameraSystem::getVisibleWorldRect() const {
+  float scale = camera.zoom * Config::PPM; // Logical pixels per meter
+  float viewWidth = Config::LOGICAL_WIDTH / scale;
+  float viewHeight = Config::LOGICAL_HEIGHT / scale;
+  return {camera.target.x - camera.offset.x / scale, camera.target.y - camera.offset.y / scale, viewWidth,
+          viewHeight};
+}
+
 void CameraSystem::update(double dt) {
 
   if (isTracking) return;
@@ -0,0 +1,130 @@
+#include "systems/GridOverlay.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include "rlgl.h"
+#include <cmath>
+
+/**
+ * @file GridOverlay.cpp
+ * @brief Implementation of the shader-based grid overlay.
+ */
+
+namespace {
+// Texture coordinates carry world meters; lines are anti-aliased to ~1 screen pixel.
+constexpr const char *GRID_FRAGMENT_SHADER = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform float spacing;        // Fine line spacing in meters
+uniform float pixelsPerMeter; // Screen scale
+uniform vec4 lineColor;
+uniform float minCellPixels;
+
+out vec4 finalColor;
+
+float lineMask(vec2 worldPos, float cell) {
+  // Distance (in screen pixels) to the nearest grid line of this level
+  vec2 d = abs(fract(worldPos / cell - 0.5) - 0.5) * cell * pixelsPerMeter;
+  return 1.0 - smoothstep(0.0, 1.0, min(d.x, d.y));
+}
+
+void main() {
+  float cellPixels = spacing * pixelsPerMeter;
+  // 0 when fine cells are at the minimum size, 1 once they are ten times larger
+  float fineFade = clamp((cellPixels - minCellPixels) / (9.0 * minCellPixels), 0.0, 1.0);
+
+  float fine = lineMask(fragTexCoord, spacing) * fineFade;
+  float coarse = lineMask(fragTexCoord, spacing * 10.0);
+  finalColor = vec4(lineColor.rgb, lineColor.a * max(fine, coarse));
+}
+)";
+
+constexpr Color GRID_COLOR = {200, 200, 200, 76}; // LIGHTGRAY at 30%
+} // namespace
+
+GridOverlay::~GridOverlay() {
+  if (shaderReady) {
+    UnloadShader(shader);
+  }
+}
+
+float GridOverlay::selectSpacing(float pixelsPerMeter) {
+  float spacing = 1.0f;
+  if (pixelsPerMeter <= 0.0f)
+    return spacing;
+  while (spacing * pixelsPerMeter < Config::GRID_MIN_CELL_PIXELS) {
+    spacing *= 10.0f;
+  }
+  return spacing;
+}
+
+bool GridOverlay::ensureShader() {
+  if (loadAttempted)
+    return shaderReady;
+  loadAttempted = true;
+
+  // Default vertex shader, custom fragment shader
+  shader = LoadShaderFromMemory(nullptr, GRID_FRAGMENT_SHADER);
+  if (shader.id == 0 || shader.id == rlGetShaderIdDefault()) {
+    Logger::Warn("GridOverlay: Shader unavailable, using line fallback.");
+    return false;
+  }
+
+  spacingLoc = GetShaderLocation(shader, "spacing");
+  pixelsPerMeterLoc = GetShaderLocation(shader, "pixelsPerMeter");
+  lineColorLoc = GetShaderLocation(shader, "lineColor");
+  float minCell = Config::GRID_MIN_CELL_PIXELS;
+  SetShaderValue(shader, GetShaderLocation(shader, "minCellPixels"), &minCell, SHADER_UNIFORM_FLOAT);
+
+  shaderReady = true;
+  return true;
+}
+
+void GridOverlay::draw(Rectangle area, float pixelsPerMeter) {
+  if (area.width <= 0 || area.height <= 0)
+    return;
+
+  float spacing = selectSpacing(pixelsPerMeter);
+
+  if (!ensureShader()) {
+    drawLines(area, spacing, GRID_COLOR);
+    return;
+  }
+
+  Vector4 color = ColorNormalize(GRID_COLOR);
+  SetShaderValue(shader, spacingLoc, &spacing, SHADER_UNIFORM_FLOAT);
+  SetShaderValue(shader, pixelsPerMeterLoc, &pixelsPerMeter, SHADER_UNIFORM_FLOAT);
+  SetShaderValue(shader, lineColorLoc, &color, SHADER_UNIFORM_VEC4);
+
+  BeginShaderMode(shader);
+  // One quad whose texture coordinates are its own world position
+  float x0 = area.x, y0 = area.y, x1 = area.x + area.width, y1 = area.y + area.height;
+  rlSetTexture(rlGetTextureIdDefault());
+  rlBegin(RL_QUADS);
+  rlColor4ub(255, 255, 255, 255);
+  rlTexCoord2f(x0, y0);
+  rlVertex2f(x0, y0);
+  rlTexCoord2f(x0, y1);
+  rlVertex2f(x0, y1);
+  rlTexCoord2f(x1, y1);
+  rlVertex2f(x1, y1);
+  rlTexCoord2f(x1, y0);
+  rlVertex2f(x1, y0);
+  rlEnd();
+  rlSetTexture(0);
+  EndShaderMode();
+}
+
+void GridOverlay::drawLines(Rectangle area, float spacing, Color color) const {
+  float x0 = std::ceil(area.x / spacing) * spacing;
+  float y0 = std::ceil(area.y / spacing) * spacing;
+  float x1 = area.x + area.width;
+  float y1 = area.y + area.height;
+
+  for (float x = x0; x <= x1; x += spacing) {
+    DrawLineV({x, area.y}, {x, y1}, color);
+  }
+  for (float y = y0; y <= y1; y += spacing) {
+    DrawLineV({area.x, y}, {x1, y}, color);
+  }
+}
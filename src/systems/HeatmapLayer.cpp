@@ -0,0 +1,67 @@
+#include "systems/HeatmapLayer.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file HeatmapLayer.cpp
+ * @brief Implementation of the congestion heatmap texture layer.
+ */
+
+namespace {
+constexpr float MAX_ALPHA = 170.0f; // Keep roads readable under the hottest cells
+} // namespace
+
+HeatmapLayer::~HeatmapLayer() { unload(); }
+
+void HeatmapLayer::unload() {
+  if (texture.id != 0) {
+    UnloadTexture(texture);
+    texture = {0, 0, 0, 0, 0};
+  }
+  uploadedVersion = 0;
+}
+
+Color HeatmapLayer::ColorFor(float value, float scale) {
+  // Empty cells keep the ramp's color so bilinear filtering does not fade hot cells towards black
+  if (value <= 0.0f || scale <= 0.0f)
+    return {255, 220, 0, 0};
+  // Square root so short queues are still visible next to the worst hotspot
+  float t = std::sqrt(std::min(value / scale, 1.0f));
+  // Yellow -> red as the queue time grows
+  return {255, (unsigned char)(220.0f * (1.0f - t)), 0, (unsigned char)(MAX_ALPHA * (0.25f + 0.75f * t))};
+}
+
+void HeatmapLayer::upload(const HeatmapGrid &grid) {
+  if (texture.id != 0 && (texture.width != grid.width || texture.height != grid.height))
+    unload();
+
+  float scale = std::max(grid.maxValue, Config::HEATMAP_MIN_SCALE);
+  pixels.resize(grid.values.size());
+  for (size_t i = 0; i < grid.values.size(); ++i)
+    pixels[i] = ColorFor(grid.values[i], scale);
+
+  if (texture.id == 0) {
+    Image image = {pixels.data(), grid.width, grid.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    texture = LoadTextureFromImage(image);
+    if (texture.id == 0)
+      return;
+    SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+  } else {
+    UpdateTexture(texture, pixels.data());
+  }
+  uploadedVersion = grid.version;
+}
+
+void HeatmapLayer::draw(const HeatmapGrid &grid) {
+  if (grid.width <= 0 || grid.height <= 0 || grid.values.size() != (size_t)grid.width * grid.height)
+    return;
+  if (grid.version != uploadedVersion)
+    upload(grid);
+  if (texture.id == 0)
+    return;
+
+  Rectangle source = {0, 0, (float)grid.width, (float)grid.height};
+  Rectangle dest = {0, 0, grid.width * grid.cellSize, grid.height * grid.cellSize};
+  DrawTexturePro(texture, source, dest, {0, 0}, 0.0f, WHITE);
+}
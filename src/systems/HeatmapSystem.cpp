@@ -0,0 +1,152 @@
+#include "systems/HeatmapSystem.hpp"
+#include "core/Logger.hpp"
+#include "events/GameEvents.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+
+/**
+ * @file HeatmapSystem.cpp
+ * @brief Implementation of the incremental congestion heatmap.
+ */
+
+namespace {
+// Renormalize before the stored values lose float precision relative to new additions
+constexpr double MAX_GAIN = 1024.0;
+// Half-lives offered by CycleHeatmapDecayEvent (simulated seconds, 0 = off)
+constexpr std::array<double, 4> DECAY_STEPS = {0.0, 60.0, 300.0, 900.0};
+} // namespace
+
+HeatmapSystem::HeatmapSystem(std::shared_ptr<EventBus> bus, float cellSize) : eventBus(bus), cellSize(cellSize) {
+  eventTokens.push_back(eventBus->subscribe<WorldBoundsEvent>(
+      [this](const WorldBoundsEvent &e) { this->resize(e.width, e.height); }));
+
+  eventTokens.push_back(eventBus->subscribe<ResetHeatmapEvent>([this](const ResetHeatmapEvent &) {
+    this->reset();
+    Logger::Info("HeatmapSystem: Reset");
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CycleHeatmapDecayEvent>([this](const CycleHeatmapDecayEvent &) {
+    auto it = std::find(DECAY_STEPS.begin(), DECAY_STEPS.end(), halfLife);
+    size_t next = it == DECAY_STEPS.end() ? 0 : (size_t)(it - DECAY_STEPS.begin() + 1) % DECAY_STEPS.size();
+    this->setHalfLife(DECAY_STEPS[next]);
+    Logger::Info("HeatmapSystem: Decay half-life {}", halfLife > 0.0 ? std::format("{:.0f} s", halfLife) : "off");
+  }));
+}
+
+HeatmapSystem::~HeatmapSystem() { eventTokens.clear(); }
+
+void HeatmapSystem::resize(float worldWidth, float worldHeight) {
+  width = std::max(1, (int)std::ceil(worldWidth / cellSize));
+  height = std::max(1, (int)std::ceil(worldHeight / cellSize));
+  reset();
+}
+
+void HeatmapSystem::reset() {
+  cells.assign((size_t)width * height, 0.0f);
+  epoch = now;
+  gain = 1.0;
+  dirty = true;
+  lastPublish = -1.0; // Show the cleared grid immediately
+}
+
+void HeatmapSystem::setHalfLife(double seconds) {
+  renormalize(); // Bake the decay so far into the stored values
+  halfLife = std::max(0.0, seconds);
+  dirty = true;
+}
+
+void HeatmapSystem::setTime(double simTime) {
+  now = simTime;
+  if (halfLife <= 0.0)
+    return;
+  gain = std::exp2((now - epoch) / halfLife);
+  if (gain > MAX_GAIN)
+    renormalize();
+}
+
+void HeatmapSystem::renormalize() {
+  if (gain != 1.0) {
+    float scale = (float)(1.0 / gain);
+    for (float &value : cells)
+      value *= scale;
+  }
+  epoch = now;
+  gain = 1.0;
+}
+
+void HeatmapSystem::update(double simTime, double dt, const std::vector<std::unique_ptr<Car>> &cars) {
+  setTime(simTime);
+  const float slowSquared = Config::HEATMAP_SLOW_SPEED * Config::HEATMAP_SLOW_SPEED;
+  for (const auto &car : cars) {
+    if (car->getState() == Car::CarState::PARKED)
+      continue;
+    Vector2 v = car->getVelocity();
+    if (v.x * v.x + v.y * v.y < slowSquared)
+      addDwell(car->getPosition(), dt);
+  }
+}
+
+void HeatmapSystem::addDwell(Vector2 position, double seconds) {
+  int x = (int)std::floor(position.x / cellSize);
+  int y = (int)std::floor(position.y / cellSize);
+  if (x < 0 || y < 0 || x >= width || y >= height)
+    return;
+  cells[(size_t)y * width + x] += (float)(seconds * gain);
+  dirty = true;
+}
+
+float HeatmapSystem::valueAt(int cellX, int cellY) const {
+  if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height)
+    return 0.0f;
+  return (float)(cells[(size_t)cellY * width + cellX] / gain);
+}
+
+std::shared_ptr<const HeatmapGrid> HeatmapSystem::getGrid() {
+  // Decay changes every value, so a decaying grid is republished even without new samples
+  bool changed = dirty || halfLife > 0.0;
+  bool due = lastPublish < 0.0 || now - lastPublish >= Config::HEATMAP_PUBLISH_INTERVAL;
+  if (published && !(changed && due))
+    return published;
+
+  auto grid = std::make_shared<HeatmapGrid>();
+  grid->width = width;
+  grid->height = height;
+  grid->cellSize = cellSize;
+  grid->version = ++version;
+  grid->values.resize(cells.size());
+  float scale = (float)(1.0 / gain);
+  for (size_t i = 0; i < cells.size(); ++i) {
+    grid->values[i] = cells[i] * scale;
+    grid->maxValue = std::max(grid->maxValue, grid->values[i]);
+  }
+
+  published = std::move(grid);
+  lastPublish = now;
+  dirty = false;
+  return published;
+}
+
+void HeatmapSystem::writeCsv(std::ostream &out) const {
+  out << "x,y,slow_seconds\n";
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      float value = valueAt(x, y);
+      if (value > 0.0f)
+        out << x * cellSize << ',' << y * cellSize << ',' << value << '\n';
+    }
+  }
+}
+
+bool HeatmapSystem::exportCsv(const std::string &prefix) const {
+  std::string path = prefix + "_heatmap_grid.csv";
+  std::ofstream out(path);
+  if (!out) {
+    Logger::Error("HeatmapSystem: Cannot write {}", path);
+    return false;
+  }
+  writeCsv(out);
+  Logger::Info("HeatmapSystem: Exported {}", path);
+  return true;
+}
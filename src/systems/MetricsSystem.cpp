@@ -0,0 +1,59 @@
+#include "systems/MetricsSystem.hpp"
+#include "systems/StatsSystem.hpp"
+
+/**
+ * @file MetricsSystem.cpp
+ * @brief Implementation of the metrics sampler.
+ */
+
+MetricsSystem::MetricsSystem(const EntityManager &em, const StatsSystem &stats, const MetricsConfig &config)
+    : entityManager(em), statsSystem(stats), store(config), nextSampleTime(store.getConfig().sampleInterval) {}
+
+void MetricsSystem::update(double simTime) {
+  if (simTime + 1e-9 < nextSampleTime)
+    return;
+  sample(simTime);
+  // Stay on the cadence grid instead of drifting by the tick remainder
+  double interval = store.getConfig().sampleInterval;
+  while (nextSampleTime <= simTime + 1e-9)
+    nextSampleTime += interval;
+}
+
+void MetricsSystem::sample(double simTime) {
+  const SimulationStats &stats = statsSystem.getStats();
+  MetricsSample s;
+  s.simTime = simTime;
+
+  s[Metric::OCCUPANCY_SMALL_PARKING] = stats.of(ModuleType::SMALL_PARKING).occupancy();
+  s[Metric::OCCUPANCY_LARGE_PARKING] = stats.of(ModuleType::LARGE_PARKING).occupancy();
+  s[Metric::OCCUPANCY_SMALL_CHARGING] = stats.of(ModuleType::SMALL_CHARGING).occupancy();
+  s[Metric::OCCUPANCY_LARGE_CHARGING] = stats.of(ModuleType::LARGE_CHARGING).occupancy();
+
+  s[Metric::CARS_DRIVING] = (float)stats.cars(Car::CarState::DRIVING);
+  s[Metric::CARS_ALIGNING] = (float)stats.cars(Car::CarState::ALIGNING);
+  s[Metric::CARS_PARKED] = (float)stats.cars(Car::CarState::PARKED);
+  s[Metric::CARS_EXITING] = (float)stats.cars(Car::CarState::EXITING);
+
+  double elapsedMinutes = (simTime - lastSampleTime) / 60.0;
+  if (elapsedMinutes > 0.0) {
+    s[Metric::SPAWN_RATE] = (float)((stats.totalSpawned - lastSpawned) / elapsedMinutes);
+    s[Metric::EXIT_RATE] = (float)((stats.totalExited - lastExited) / elapsedMinutes);
+    s[Metric::PASS_THROUGH_RATE] = (float)((stats.totalPassedThrough - lastPassedThrough) / elapsedMinutes);
+  }
+  lastSampleTime = simTime;
+  lastSpawned = stats.totalSpawned;
+  lastExited = stats.totalExited;
+  lastPassedThrough = stats.totalPassedThrough;
+
+  float batterySum = 0.0f;
+  int electricCars = 0;
+  for (const auto &car : entityManager.getCars()) {
+    if (car->getType() == Car::CarType::ELECTRIC) {
+      batterySum += car->getBatteryLevel();
+      electricCars++;
+    }
+  }
+  s[Metric::AVG_BATTERY] = electricCars > 0 ? batterySum / (float)electricCars : 0.0f;
+
+  store.record(s);
+}
@@ -0,0 +1,79 @@
+#include "systems/PathBatcher.hpp"
+#include "systems/PathPlanner.hpp"
+#include <algorithm>
+
+/**
+ * @file PathBatcher.cpp
+ * @brief Implementation of the batched path planner.
+ */
+
+PathBatcher::PathBatcher(unsigned threads) : pool(threads) { scratches.resize(pool.getThreadCount()); }
+
+void PathBatcher::enqueue(const PathRequest &request) {
+  if (!pendingCars.insert(request.carId).second)
+    return;
+  queued.push_back(request);
+}
+
+void PathBatcher::dispatch(const RoadGraph &graph) {
+  if (running || queued.empty())
+    return;
+
+  inFlight.resize(queued.size());
+  for (size_t i = 0; i < queued.size(); ++i)
+    inFlight[i].request = queued[i];
+  queued.clear();
+  running = true;
+  batchCount++;
+
+  pool.dispatch(inFlight.size(), [this, &graph](size_t index, unsigned worker) {
+    PlannedPath &planned = inFlight[index];
+    const PathRequest &r = planned.request;
+    RoadGraph::SearchScratch &scratch = scratches[worker];
+    if (r.kind == PathRequest::Kind::PARK)
+      planned.path =
+          PathPlanner::GeneratePath(r.position, r.velocity, r.facility, r.spot, &graph, &scratch, &planned.route);
+    else
+      planned.path =
+          PathPlanner::GenerateExitPath(r.position, r.facility, r.spot, r.exitRight, r.finalX, &graph, &scratch);
+  });
+}
+
+std::vector<PlannedPath> &PathBatcher::collect() {
+  ready.clear();
+  if (!running)
+    return ready;
+  pool.wait();
+  running = false;
+
+  for (PlannedPath &planned : inFlight) {
+    uint32_t carId = planned.request.carId;
+    if (cancelled.erase(carId) > 0)
+      continue; // pendingCars was already updated by cancel()
+    pendingCars.erase(carId);
+    ready.push_back(std::move(planned));
+  }
+  inFlight.clear();
+  cancelled.clear();
+  return ready;
+}
+
+void PathBatcher::cancel(uint32_t carId) {
+  if (pendingCars.erase(carId) == 0)
+    return;
+  auto it = std::find_if(queued.begin(), queued.end(), [carId](const PathRequest &r) { return r.carId == carId; });
+  if (it != queued.end())
+    queued.erase(it);
+  else
+    cancelled.insert(carId); // In flight; the workers may be reading it right now
+}
+
+void PathBatcher::clear() {
+  pool.wait();
+  running = false;
+  queued.clear();
+  inFlight.clear();
+  ready.clear();
+  pendingCars.clear();
+  cancelled.clear();
+}
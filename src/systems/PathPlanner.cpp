@@ -24,64 +24,75 @@ static constexpr float ENTRANCE_LANE_OFFSET_X = 18.0f;
 // Helper to convert art pixels to meters
 static float P2M(float artPixels) { return artPixels / static_cast<float>(Config::ART_PIXELS_PER_METER); }
 
-std::vector<Waypoint> PathPlanner::GeneratePath(const Car *car, const Module *targetFac, const Spot &targetSpot) {
+std::vector<Waypoint> PathPlanner::GeneratePath(const Car *car, const Module *targetFac, const Spot &targetSpot,
+                                                const RoadGraph *graph, RoadGraph::SearchScratch *scratch,
+                                                std::vector<uint32_t> *route) {
+  return GeneratePath(car->getPosition(), car->getVelocity(), targetFac, targetSpot, graph, scratch, route);
+}
+
+std::vector<Waypoint> PathPlanner::GeneratePath(Vector2 position, Vector2 velocity, const Module *targetFac,
+                                                const Spot &targetSpot, const RoadGraph *graph,
+                                                RoadGraph::SearchScratch *scratch, std::vector<uint32_t> *route) {
+  if (route)
+    route->clear();
+
+  // Route through the road network to the facility's road
+  Module *parentRoad = targetFac->getParent();
+  if (graph && scratch && parentRoad) {
+    auto [east, west] = graph->getEntranceNodes(parentRoad);
+    uint32_t start = graph->findNodeAhead(position, velocity);
+    const uint32_t goals[] = {east, west};
+    std::vector<uint32_t> found;
+    if (east != RoadGraph::NO_NODE && start != RoadGraph::NO_NODE && graph->findRoute(start, goals, *scratch, found)) {
+      std::vector<Waypoint> path = GeneratePathAlong(position, targetFac, targetSpot, *graph, found);
+      if (route)
+        *route = std::move(found);
+      return path;
+    }
+  }
+
+  // Without a route the car is assumed to already drive on the facility's road
   std::vector<Waypoint> path;
+  Lane mainRoadLane = (velocity.x > 0) ? Lane::DOWN : Lane::UP;
+  AddFacilityApproach(path, position, targetFac, targetSpot, mainRoadLane);
+  return path;
+}
 
-  // 1. Determine Horizontal Lane on the Main Road
-  Lane mainRoadLane = (car->getVelocity().x > 0) ? Lane::DOWN : Lane::UP;
+std::vector<Waypoint> PathPlanner::GeneratePathAlong(Vector2 startPos, const Module *targetFac, const Spot &targetSpot,
+                                                     const RoadGraph &graph, const std::vector<uint32_t> &route) {
+  std::vector<Waypoint> path;
+  Vector2 currentPos = startPos;
+  for (const Waypoint &corner : RouteCorners(graph, route, currentPos)) {
+    AddDrive(path, currentPos, corner);
+    currentPos = corner.position;
+  }
 
-  // 2. Determine Facility Orientation and Entry Side
+  // The car arrives on whichever lane the route ends on
+  auto [east, west] = graph.getEntranceNodes(targetFac->getParent());
+  Lane mainRoadLane = (!route.empty() && route.back() == east) ? Lane::DOWN : Lane::UP;
+  AddFacilityApproach(path, currentPos, targetFac, targetSpot, mainRoadLane);
+  return path;
+}
+
+void PathPlanner::AddFacilityApproach(std::vector<Waypoint> &path, Vector2 currentPos, const Module *targetFac,
+                                      const Spot &targetSpot, Lane mainRoadLane) {
+  // Determine Facility Orientation and Entry Side
   bool isUpFacility = targetFac->isUp();
   bool useRightSideEntry = isUpFacility; // Up -> Right, Down -> Left
-
-  // Track current position for segment generation
-  Vector2 currentPos = car->getPosition();
-
-  // 3. Waypoint 1: Road Entry Point
-  // Phase: APPROACH
   Module *parentRoad = targetFac->getParent();
+
+  // 1. Waypoint 1: Road Entry Point
+  // Phase: APPROACH (HIGHWAY until the last stretch)
   Waypoint wpEntry = parentRoad ? CalculateRoadEntry(parentRoad, mainRoadLane, useRightSideEntry)
                                 : CalculateFacilityEntry(targetFac, useRightSideEntry);
 
   // Set Angle
   wpEntry.entryAngle = isUpFacility ? -PI / 2.0f : PI / 2.0f;
 
-  // Split the Approach:
-  // If the distance to the entry is long (> 40m), drive in HIGHWAY mode first.
-  // Then switch to APPROACH mode for the last 30m (where braking might occur).
-  float distToEntry = Vector2Distance(currentPos, wpEntry.position);
-  float approachDist = Config::CarAI::TURN_SLOWDOWN_DIST + 5.0f; // e.g. 35m
-
-  if (distToEntry > approachDist + 10.0f) {
-    // Create an intermediate "Pre-Approach" point
-    // Distance from Entry = approachDist
-    // Lerp factor = 1.0 - (approachDist / distToEntry)
-    // Actually, we want the point at (dist - approachDist)
-
-    float t = 1.0f - (approachDist / distToEntry);
-    Vector2 prePos = Vector2Lerp(currentPos, wpEntry.position, t);
-
-    // Target: Pre-Approach Point
-    // Phase: HIGHWAY
-    // Angle: 0 (Straight driving logic usually, or just point to next)
-    // Actually, entryAngle matters for the *next* turn.
-    // For this point, we are just driving straight on road.
-    // Let's set it to 0 or derive from direction.
-    // But simpler: just inherit 0.
-
-    Waypoint wpPre = wpEntry;
-    wpPre.position = prePos;
-    wpPre.entryAngle = 0.0f; // No sharp turn expected here
-    wpPre.stopAtEnd = false;
-
-    AddSegment(path, currentPos, wpPre, Config::CarAI::Phases::HIGHWAY);
-    currentPos = prePos;
-  }
-
-  AddSegment(path, currentPos, wpEntry, Config::CarAI::Phases::APPROACH);
+  AddDrive(path, currentPos, wpEntry);
   currentPos = wpEntry.position; // Update head
 
-  // 4. Waypoint 2: Facility Entry Point (Gate)
+  // 2. Waypoint 2: Facility Entry Point (Gate)
   // Phase: ACCESS
   Waypoint wpGate = CalculateFacilityEntry(targetFac, useRightSideEntry);
   wpGate.entryAngle = wpEntry.entryAngle; // Vertical
@@ -89,7 +100,7 @@ std::vector<Waypoint> PathPlanner::GeneratePath(const Car *car, const Module *ta
   AddSegment(path, currentPos, wpGate, Config::CarAI::Phases::ACCESS);
   currentPos = wpGate.position;
 
-  // 5. Waypoint 3: Alignment Point
+  // 3. Waypoint 3: Alignment Point
   // Phase: MANEUVER
   Waypoint wpAlign = CalculateAlignmentPoint(targetFac, targetSpot);
   wpAlign.entryAngle = targetSpot.orientation;
@@ -97,13 +108,11 @@ std::vector<Waypoint> PathPlanner::GeneratePath(const Car *car, const Module *ta
   AddSegment(path, currentPos, wpAlign, Config::CarAI::Phases::MANEUVER);
   currentPos = wpAlign.position;
 
-  // 6. Waypoint 4: Final Parking Spot
+  // 4. Waypoint 4: Final Parking Spot
   // Phase: PARKING
   Waypoint wpSpot = CalculateSpotPoint(targetFac, targetSpot);
 
   AddSegment(path, currentPos, wpSpot, Config::CarAI::Phases::PARKING);
-
-  return path;
 }
 
 Waypoint PathPlanner::CalculateRoadEntry(const Module *road, Lane roadLane, bool useRightSideEntry) {
@@ -184,9 +193,16 @@ Waypoint PathPlanner::CalculateSpotPoint(const Module *facility, const Spot &spo
 }
 
 std::vector<Waypoint> PathPlanner::GenerateExitPath(const Car *car, const Module *currentFac, const Spot &currentSpot,
-                                                    bool exitRight, float finalX) {
+                                                    bool exitRight, float finalX, const RoadGraph *graph,
+                                                    RoadGraph::SearchScratch *scratch) {
+  return GenerateExitPath(car->getPosition(), currentFac, currentSpot, exitRight, finalX, graph, scratch);
+}
+
+std::vector<Waypoint> PathPlanner::GenerateExitPath(Vector2 position, const Module *currentFac,
+                                                    const Spot &currentSpot, bool exitRight, float finalX,
+                                                    const RoadGraph *graph, RoadGraph::SearchScratch *scratch) {
   std::vector<Waypoint> path;
-  Vector2 currentPos = car->getPosition();
+  Vector2 currentPos = position;
 
   // 1. Waypoint 1: Alignment Point (Reverse)
   // Phase: MANEUVER
@@ -222,12 +238,34 @@ std::vector<Waypoint> PathPlanner::GenerateExitPath(const Car *car, const Module
 
   // 4. Waypoint 4: Map Edge Exit
   // Phase: HIGHWAY (Crucial change: High density correction over long distance)
+  // With a road network: the nearest map exit in the chosen direction, possibly on another road.
+  if (graph && scratch && parentRoad) {
+    Vector2 heading = exitRight ? Vector2{1, 0} : Vector2{-1, 0};
+    std::vector<uint32_t> goals;
+    for (const auto &exit : graph->getExits()) {
+      if (Vector2DotProduct(exit.direction, heading) > 0.5f)
+        goals.push_back(exit.node);
+    }
+    uint32_t start = graph->findNodeAhead(currentPos, heading);
+    std::vector<uint32_t> route;
+    if (start != RoadGraph::NO_NODE && graph->findRoute(start, goals, *scratch, route)) {
+      for (const Waypoint &corner : RouteCorners(*graph, route, currentPos)) {
+        AddDrive(path, currentPos, corner);
+        currentPos = corner.position;
+      }
+      Vector2 exitPos = Vector2Add(graph->getNodePosition(route.back()), Vector2Scale(heading, 2.0f));
+      Waypoint wpEdge(exitPos, 1.0f, -1, exitRight ? 0.0f : PI, true);
+      AddSegment(path, currentPos, wpEdge, Config::CarAI::Phases::HIGHWAY);
+      return path;
+    }
+  }
+
   float yPos = 0.0f;
   if (parentRoad) {
     float laneOffset = (exitRight) ? P2M(Config::LANE_OFFSET_DOWN) : P2M(Config::LANE_OFFSET_UP);
     yPos = parentRoad->worldPosition.y + laneOffset;
   } else {
-    yPos = car->getPosition().y;
+    yPos = position.y;
   }
 
   Waypoint wpEdge({finalX, yPos}, 1.0f, -1, 0.0f, true);
@@ -237,6 +275,51 @@ std::vector<Waypoint> PathPlanner::GenerateExitPath(const Car *car, const Module
   return path;
 }
 
+std::vector<Waypoint> PathPlanner::RouteCorners(const RoadGraph &graph, const std::vector<uint32_t> &route,
+                                                Vector2 from) {
+  std::vector<Vector2> points;
+  points.reserve(route.size() + 1);
+  points.push_back(from);
+  for (uint32_t node : route) {
+    Vector2 p = graph.getNodePosition(node);
+    if (Vector2Distance(points.back(), p) > 0.01f)
+      points.push_back(p);
+  }
+
+  std::vector<Waypoint> corners;
+  for (size_t i = 1; i + 1 < points.size(); ++i) {
+    Vector2 in = Vector2Normalize(Vector2Subtract(points[i], points[i - 1]));
+    Vector2 out = Vector2Normalize(Vector2Subtract(points[i + 1], points[i]));
+    if (Vector2DotProduct(in, out) > 0.999f)
+      continue; // Straight on
+    corners.emplace_back(points[i], 1.0f, -1, atan2f(out.y, out.x));
+  }
+  return corners;
+}
+
+void PathPlanner::AddDrive(std::vector<Waypoint> &path, Vector2 startPos, Waypoint target) {
+  // Split the Approach:
+  // If the distance to the target is long (> 40m), drive in HIGHWAY mode first.
+  // Then switch to APPROACH mode for the last 30m (where braking might occur).
+  float dist = Vector2Distance(startPos, target.position);
+  float approachDist = Config::CarAI::TURN_SLOWDOWN_DIST + 5.0f; // e.g. 35m
+
+  if (dist > approachDist + 10.0f) {
+    // Intermediate "Pre-Approach" point, approachDist before the target
+    float t = 1.0f - (approachDist / dist);
+    Waypoint wpPre = target;
+    wpPre.position = Vector2Lerp(startPos, target.position, t);
+    // Straight driving up to here: keep the current heading so no turn slowdown kicks in
+    wpPre.entryAngle = atan2f(target.position.y - startPos.y, target.position.x - startPos.x);
+    wpPre.stopAtEnd = false;
+
+    AddSegment(path, startPos, wpPre, Config::CarAI::Phases::HIGHWAY);
+    startPos = wpPre.position;
+  }
+
+  AddSegment(path, startPos, target, Config::CarAI::Phases::APPROACH);
+}
+
 void PathPlanner::AddSegment(std::vector<Waypoint> &path, Vector2 startPos, Waypoint target,
                              const Config::CarAI::AIPhase &phase) {
   // 1. Calculate Segment distance
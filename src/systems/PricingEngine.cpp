@@ -0,0 +1,99 @@
+#include "systems/PricingEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file PricingEngine.cpp
+ * @brief Implementation of demand-based pricing.
+ */
+
+namespace {
+// TUNING: A factor this close to its target snaps to it, and the facility stops being visited...
+constexpr float FACTOR_SETTLED = 0.005f;
+// TUNING: ...once its smoothed arrival rate (per minute) has also decayed below this
+constexpr float ARRIVALS_SETTLED = 0.01f;
+
+bool IsCharging(const Module *mod) {
+  return mod->getType() == ModuleType::SMALL_CHARGING || mod->getType() == ModuleType::LARGE_CHARGING;
+}
+} // namespace
+
+void PricingEngine::reset(SpotRegistry &r) {
+  registry = &r;
+  demand.assign(registry->getFacilities().size(), {});
+  active.clear();
+  changed.clear();
+  lastRun = 0.0;
+  // Every facility starts at its base prices, which need not fit its (empty) occupancy
+  for (uint32_t index = 0; index < demand.size(); ++index)
+    activate(index);
+}
+
+void PricingEngine::activate(uint32_t index) {
+  FacilityDemand &d = demand[index];
+  if (d.active)
+    return;
+  // Settled until now, so smoothing starts from the last update
+  d.active = true;
+  d.lastUpdate = std::max(d.lastUpdate, lastRun);
+  active.push_back(index);
+}
+
+void PricingEngine::onSpotStateChanged(const Module *facility, SpotState previous, SpotState current) {
+  uint32_t index = registry && facility ? registry->getFacilityIndex(facility) : SpotRegistry::NO_FACILITY;
+  if (index == SpotRegistry::NO_FACILITY)
+    return;
+  if (previous == SpotState::FREE && current == SpotState::RESERVED)
+    demand[index].arrivals++;
+  activate(index);
+}
+
+const std::vector<Module *> &PricingEngine::update(double simTime) {
+  changed.clear();
+  if (!registry || simTime - lastRun < rules.interval)
+    return changed;
+  lastRun = simTime;
+
+  size_t kept = 0;
+  for (uint32_t index : active) {
+    FacilityDemand &d = demand[index];
+    Module *facility = registry->getFacilities()[index];
+    double elapsed = simTime - d.lastUpdate;
+    float alpha = elapsed > 0.0 ? (float)(1.0 - std::exp(-elapsed / rules.timeConstant)) : 0.0f;
+    float measured = elapsed > 0.0 ? (float)(d.arrivals * 60.0 / elapsed) : 0.0f;
+    d.arrivalRate += alpha * (measured - d.arrivalRate);
+    d.arrivals = 0;
+    d.lastUpdate = simTime;
+
+    auto counts = facility->getSpotCounts();
+    float spots = (float)facility->getSpotCount();
+    float occupancy = (float)(counts.reserved + counts.occupied) / spots;
+    float target = 1.0f + rules.occupancyGain * (occupancy - rules.targetOccupancy) +
+                   rules.arrivalGain * d.arrivalRate / spots;
+    if (IsCharging(facility))
+      target += rules.chargingGain * (float)counts.occupied / spots;
+    target = std::clamp(target, rules.minFactor, rules.maxFactor);
+
+    const bool settled = std::fabs(target - d.factor) <= FACTOR_SETTLED;
+    float next = settled ? target : d.factor + alpha * (target - d.factor);
+    if (next != d.factor) {
+      d.factor = next;
+      registry->applyPriceFactor(index, d.factor);
+      changed.push_back(facility);
+    }
+
+    if (!settled || d.arrivalRate > ARRIVALS_SETTLED) {
+      active[kept++] = index;
+    } else {
+      d.active = false;
+      d.arrivalRate = 0.0f;
+    }
+  }
+  active.resize(kept);
+  return changed;
+}
+
+float PricingEngine::getFactor(const Module *facility) const {
+  uint32_t index = registry && facility ? registry->getFacilityIndex(facility) : SpotRegistry::NO_FACILITY;
+  return index == SpotRegistry::NO_FACILITY ? 1.0f : demand[index].factor;
+}
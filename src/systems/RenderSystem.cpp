@@ -0,0 +1,175 @@
+#include "systems/RenderSystem.hpp"
+#include "events/GameEvents.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// TUNING: Half the longest car sprite (meters); keeps cars straddling the screen edge visible
+constexpr float CAR_CULL_MARGIN = 3.0f;
+// TUNING: Module index cell size (meters), roughly one road segment
+constexpr float MODULE_GRID_CELL = 40.0f;
+} // namespace
+
+/**
+ * @file RenderSystem.cpp
+ * @brief Implementation of the snapshot-driven world renderer.
+ */
+
+RenderSystem::RenderSystem(std::shared_ptr<EventBus> bus, const EntityManager &em) : eventBus(bus), entityManager(em) {
+  eventTokens.push_back(eventBus->subscribe<DrawWorldEvent>([this](const DrawWorldEvent &) { this->draw(); }));
+
+  // Re-bake the static layer whenever a world is (re)generated
+  eventTokens.push_back(eventBus->subscribe<WorldBoundsEvent>([this](const WorldBoundsEvent &e) {
+    this->staticLayerDirty = true;
+    this->rebuildModuleIndex(e.width, e.height);
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CameraViewEvent>(
+      [this](const CameraViewEvent &e) {
+        this->visibleArea = e.visibleArea;
+        this->pixelsPerMeter = e.pixelsPerMeter;
+      }));
+
+  // Baking needs its own texture mode, which is only possible before the frame's target is bound
+  eventTokens.push_back(eventBus->subscribe<PreRenderEvent>([this](const PreRenderEvent &) {
+    World *world = entityManager.getWorld();
+    if (!staticLayerDirty || !world)
+      return;
+    staticLayerDirty = false;
+    staticLayer.bake(*world, entityManager.getModules());
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<SnapshotUpdatedEvent>(
+      [this](const SnapshotUpdatedEvent &e) { this->snapshot = e.snapshot; }));
+
+  eventTokens.push_back(eventBus->subscribe<ToggleHeatmapEvent>(
+      [this](const ToggleHeatmapEvent &) { this->heatmapVisible = !this->heatmapVisible; }));
+
+  // Track Dashboard State
+  eventTokens.push_back(eventBus->subscribe<ToggleDashboardEvent>(
+      [this](const ToggleDashboardEvent &) { this->dashboardVisible = !this->dashboardVisible; }));
+
+  // Track Selection
+  eventTokens.push_back(eventBus->subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent &e) {
+    // Logic matching DashboardOverlay: specific selection forces visibility
+    if (e.type != SelectionType::GENERAL) {
+      this->dashboardVisible = true;
+    }
+    this->selectedCarId = e.carId;
+  }));
+}
+
+RenderSystem::~RenderSystem() { eventTokens.clear(); }
+
+void RenderSystem::rebuildModuleIndex(float worldWidth, float worldHeight) {
+  moduleIndex = std::make_unique<SpatialGrid>(worldWidth, worldHeight, MODULE_GRID_CELL);
+  const auto &modules = entityManager.getModules();
+  for (size_t i = 0; i < modules.size(); ++i) {
+    const auto &mod = modules[i];
+    moduleIndex->insert((int)i, {mod->worldPosition.x, mod->worldPosition.y, mod->getWidth(), mod->getHeight()});
+  }
+}
+
+void RenderSystem::draw() {
+  World *world = entityManager.getWorld();
+
+  if (staticLayer.isBaked()) {
+    staticLayer.draw(visibleArea);
+  } else {
+    // Not baked yet (first frame) or baking failed: draw the static world directly
+    if (world) {
+      world->drawTiles(visibleArea);
+    }
+
+    const auto &modules = entityManager.getModules();
+    if (moduleIndex) {
+      moduleIndex->query(visibleArea, visibleModules);
+      for (int i : visibleModules) {
+        modules[i]->draw();
+      }
+    } else {
+      for (const auto &mod : modules) {
+        mod->draw();
+      }
+    }
+  }
+
+  // Queuing hotspots go under the cars so the cars causing them stay visible
+  if (heatmapVisible && snapshot && snapshot->heatmap) {
+    heatmapLayer.draw(*snapshot->heatmap);
+  }
+
+  if (snapshot) {
+    Rectangle carArea = {visibleArea.x - CAR_CULL_MARGIN, visibleArea.y - CAR_CULL_MARGIN,
+                         visibleArea.width + 2 * CAR_CULL_MARGIN, visibleArea.height + 2 * CAR_CULL_MARGIN};
+    CarLod lod = selectCarLod(pixelsPerMeter);
+    for (const auto &car : snapshot->cars) {
+      bool showPath = car.id == selectedCarId && this->dashboardVisible;
+      // The selected path may cross the screen even when its car is off-screen
+      if (!showPath && !CheckCollisionPointRec(car.position, carArea))
+        continue;
+      drawCar(car, showPath, lod);
+    }
+    // All car sprites share the atlas (and markers the default texture), so this is usually a single draw call
+    spriteBatch.flush();
+  }
+
+  // Draw Mask last (Foreground)
+  if (world) {
+    if (world->isGridEnabled()) {
+      Rectangle gridArea = GetCollisionRec(visibleArea, {0, 0, world->getWidth(), world->getHeight()});
+      gridOverlay.draw(gridArea, pixelsPerMeter);
+    }
+    world->drawOverlay();
+    world->drawMask();
+  }
+}
+
+RenderSystem::CarLod RenderSystem::selectCarLod(float pixelsPerMeter) {
+  float carPixels = Car::getSpriteSize().y * pixelsPerMeter;
+  if (carPixels < Config::LOD_MARKER_MAX_PIXELS)
+    return CarLod::MARKER;
+  if (carPixels < Config::LOD_DETAIL_MIN_PIXELS)
+    return CarLod::SPRITE;
+  return CarLod::DETAILED;
+}
+
+void RenderSystem::drawPath(const CarSnapshot &car, CarLod lod) const {
+  for (size_t i = 0; i < car.path.size(); ++i) {
+    Vector2 wpPos = car.path[i];
+    // Waypoint markers are only readable close up
+    if (lod == CarLod::DETAILED) {
+      DrawCircleV(wpPos, 0.25f, Fade(BLUE, 0.5f));
+    }
+    DrawLineV(i > 0 ? car.path[i - 1] : car.position, wpPos, Fade(BLUE, 0.3f));
+  }
+}
+
+void RenderSystem::drawCar(const CarSnapshot &car, bool showPath, CarLod lod) {
+  if (showPath && !car.path.empty()) {
+    drawPath(car, lod);
+  }
+
+  Vector2 size = Car::getSpriteSize();
+  switch (lod) {
+  case CarLod::MARKER: {
+    // Keep markers visible when zoomed far out
+    float side = std::max(size.x, Config::LOD_MARKER_MIN_PIXELS / pixelsPerMeter);
+    Color color = (car.type == Car::CarType::ELECTRIC) ? SKYBLUE : ORANGE;
+    if (car.id == selectedCarId)
+      color = GOLD;
+    spriteBatch.submitRect({car.position.x - side / 2.0f, car.position.y - side / 2.0f, side, side}, color);
+    break;
+  }
+  case CarLod::SPRITE: {
+    float snapped = std::round(car.rotation / 90.0f) * 90.0f;
+    spriteBatch.submit(car.texture, {car.position.x, car.position.y, size.x, size.y}, {size.x / 2.0f, size.y / 2.0f},
+                       snapped);
+    break;
+  }
+  case CarLod::DETAILED:
+    spriteBatch.submit(car.texture, {car.position.x, car.position.y, size.x, size.y}, {size.x / 2.0f, size.y / 2.0f},
+                       car.rotation);
+    break;
+  }
+}
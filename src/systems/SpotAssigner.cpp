@@ -0,0 +1,292 @@
+#include "systems/SpotAssigner.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+/**
+ * @file SpotAssigner.cpp
+ * @brief Implementation of the per-tick spot matching.
+ */
+
+namespace {
+// TUNING: Facilities each car considers; more widens the choice but grows the matching
+constexpr size_t CANDIDATE_FACILITIES = 4;
+// TUNING: Free spots per candidate facility (the cheapest ones); bounds the problem on big facilities
+constexpr size_t MAX_SPOTS_PER_FACILITY = 8;
+// TUNING: Dollars a distance-priority driver would pay to park 1 m closer
+constexpr float DISTANCE_COST_PER_METER = 0.01f;
+// TUNING: Cost of passing through; any reachable spot is preferable
+constexpr float PASS_THROUGH_COST = 1000.0f;
+
+constexpr double UNREACHED = std::numeric_limits<double>::infinity();
+
+uint64_t SpotKey(const Module *facility, int spotIndex) {
+  return (uint64_t)(uintptr_t)facility * 131071u + (uint64_t)(uint32_t)spotIndex;
+}
+
+bool IsCharger(const Module *mod) {
+  return dynamic_cast<const SmallChargingStation *>(mod) || dynamic_cast<const LargeChargingStation *>(mod);
+}
+
+bool IsParking(const Module *mod) {
+  return dynamic_cast<const SmallParking *>(mod) || dynamic_cast<const LargeParking *>(mod);
+}
+} // namespace
+
+void SpotAssigner::reset(const std::vector<std::unique_ptr<Module>> &modules) {
+  parkings.clear();
+  chargers.clear();
+  queued.clear();
+  for (auto &index : priceIndex)
+    index.clear();
+  indexEntries.clear();
+  for (const auto &mod : modules) {
+    if (IsParking(mod.get())) {
+      indexEntries[mod.get()] = {false, (uint32_t)parkings.size()};
+      parkings.push_back(mod.get());
+    } else if (IsCharger(mod.get())) {
+      indexEntries[mod.get()] = {true, (uint32_t)chargers.size()};
+      chargers.push_back(mod.get());
+    }
+  }
+  for (const auto &mod : modules)
+    refresh(mod.get());
+}
+
+void SpotAssigner::refresh(const Module *facility) {
+  auto it = indexEntries.find(facility);
+  if (it == indexEntries.end())
+    return;
+  IndexEntry &entry = it->second;
+  std::set<PriceKey> &index = priceIndex[entry.charging];
+  if (entry.listed)
+    index.erase({entry.price, entry.position});
+
+  int cheapest = facility->getCheapestFreeSpotIndex();
+  entry.listed = cheapest >= 0;
+  if (entry.listed) {
+    entry.price = facility->getSpot(cheapest).price;
+    index.insert({entry.price, entry.position});
+  }
+}
+
+void SpotAssigner::enqueue(const SpotRequest &request) { queued.push_back(request); }
+
+void SpotAssigner::cancel(uint32_t carId) {
+  std::erase_if(queued, [carId](const SpotRequest &r) { return r.carId == carId; });
+}
+
+const std::vector<int> &SpotAssigner::freeSpotsByPrice(Module *facility) {
+  auto [it, added] = freeSpots.try_emplace(facility);
+  std::vector<int> &spots = it->second;
+  if (added) {
+    for (int i = 0; i < (int)facility->getSpotCount(); ++i) {
+      if (facility->getSpot(i).state == SpotState::FREE)
+        spots.push_back(i);
+    }
+    std::stable_sort(spots.begin(), spots.end(),
+                     [facility](int a, int b) { return facility->getSpot(a).price < facility->getSpot(b).price; });
+  }
+  return spots;
+}
+
+void SpotAssigner::buildCandidates(const RoadGraph &graph, DistanceMatrix &distances) {
+  candidates.clear();
+  candidateIndex.clear();
+  freeSpots.clear();
+  firstArc.clear();
+  arcs.clear();
+  const size_t spotsPerFacility = std::min(MAX_SPOTS_PER_FACILITY, queued.size());
+
+  for (const SpotRequest &request : queued) {
+    firstArc.push_back((uint32_t)arcs.size());
+    const bool byDistance = request.priority == Car::Priority::PRIORITY_DISTANCE;
+    std::span<const float> row;
+    if (byDistance) {
+      uint32_t source = graph.findNodeAhead(request.position, request.velocity);
+      if (source != RoadGraph::NO_NODE)
+        row = distances.getRow(source);
+    }
+
+    // 1. Rank facilities by what this car pays at best there
+    facilityCosts.clear();
+    const std::vector<Module *> &facilities = request.charging ? chargers : parkings;
+    if (byDistance) {
+      for (Module *fac : facilities) {
+        if (fac->getSpotCounts().free == 0)
+          continue;
+        // Straight-line distance only off the road network (e.g. maps without a graph)
+        int column = row.empty() ? -1 : distances.getColumn(fac);
+        float meters = column >= 0 ? row[column] : Vector2Distance(request.position, fac->worldPosition);
+        if (meters != DistanceMatrix::UNREACHABLE)
+          facilityCosts.push_back({meters * DISTANCE_COST_PER_METER, fac});
+      }
+    } else {
+      // Already ranked by the price index
+      for (auto [price, position] : priceIndex[request.charging]) {
+        if (facilityCosts.size() == CANDIDATE_FACILITIES)
+          break;
+        if (facilities[position]->getSpotCounts().free > 0)
+          facilityCosts.push_back({price, facilities[position]});
+      }
+    }
+    size_t keep = std::min(CANDIDATE_FACILITIES, facilityCosts.size());
+    std::partial_sort(facilityCosts.begin(), facilityCosts.begin() + keep, facilityCosts.end(),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    // 2. Offer the cheapest free spots of those facilities
+    for (size_t f = 0; f < keep; ++f) {
+      Module *fac = facilityCosts[f].second;
+      const std::vector<int> &spots = freeSpotsByPrice(fac);
+      for (size_t s = 0; s < spots.size() && s < spotsPerFacility; ++s) {
+        auto [it, added] = candidateIndex.try_emplace(SpotKey(fac, spots[s]), (uint32_t)candidates.size());
+        if (added)
+          candidates.push_back({fac, spots[s]});
+        arcs.push_back({it->second, byDistance ? facilityCosts[f].first : fac->getSpot(spots[s]).price});
+      }
+    }
+  }
+  firstArc.push_back((uint32_t)arcs.size());
+
+  // Pass-through columns follow the spots, one per car, so they can only be numbered now
+  for (uint32_t car = 0; car < queued.size(); ++car)
+    arcs.push_back({(uint32_t)(candidates.size() + car), PASS_THROUGH_COST});
+}
+
+bool SpotAssigner::augment(uint32_t car) {
+  const uint32_t carCount = (uint32_t)queued.size();
+  // A car's spot arcs, then its pass-through arc (stored after all spot arcs)
+  auto forEachArc = [&](uint32_t c, auto &&visit) {
+    for (uint32_t a = firstArc[c]; a < firstArc[c + 1]; ++a)
+      visit(arcs[a]);
+    visit(arcs[firstArc[carCount] + c]);
+  };
+
+  // The new car's potential makes its cheapest reduced cost zero; all reduced costs stay non-negative
+  double potential = UNREACHED;
+  forEachArc(car, [&](const Arc &arc) { potential = std::min(potential, arc.cost - columnPotential[arc.column]); });
+  carPotential[car] = potential;
+
+  // Dijkstra over columns: a matched column leads on to its car's arcs, a free one ends the path
+  searchHeap.clear();
+  auto relax = [&](uint32_t from, double base, const Arc &arc) {
+    lastStats.relaxations++;
+    double cost = base + arc.cost - carPotential[from] - columnPotential[arc.column];
+    if (columnSettled[arc.column] || cost >= pathCost[arc.column])
+      return;
+    if (pathCost[arc.column] == UNREACHED)
+      reached.push_back(arc.column);
+    pathCost[arc.column] = cost;
+    reachedFrom[arc.column] = from;
+    searchHeap.push_back({cost, arc.column});
+    std::push_heap(searchHeap.begin(), searchHeap.end(), std::greater<>());
+  };
+  forEachArc(car, [&](const Arc &arc) { relax(car, 0.0, arc); });
+
+  int end = -1;
+  double endCost = 0.0;
+  while (!searchHeap.empty() && lastStats.relaxations <= maxRelaxations) {
+    std::pop_heap(searchHeap.begin(), searchHeap.end(), std::greater<>());
+    auto [cost, column] = searchHeap.back();
+    searchHeap.pop_back();
+    if (columnSettled[column])
+      continue; // Stale entry
+    columnSettled[column] = 1;
+    settled.push_back(column);
+    if (columnCar[column] < 0) {
+      end = (int)column;
+      endCost = cost;
+      break;
+    }
+    uint32_t holder = (uint32_t)columnCar[column];
+    forEachArc(holder, [&](const Arc &arc) { relax(holder, cost, arc); });
+  }
+
+  if (end >= 0) {
+    // Shift the potentials so every matched arc, and the path just found, has reduced cost zero
+    carPotential[car] += endCost;
+    for (uint32_t column : settled) {
+      if ((int)column == end)
+        continue;
+      double slack = endCost - pathCost[column];
+      columnPotential[column] -= slack;
+      carPotential[columnCar[column]] += slack;
+    }
+
+    // Flip the path: every car on it moves to the column it was reached through
+    for (uint32_t column = (uint32_t)end;;) {
+      uint32_t mover = reachedFrom[column];
+      int previous = carColumn[mover];
+      carColumn[mover] = (int)column;
+      columnCar[column] = (int)mover;
+      if (mover == car)
+        break;
+      column = (uint32_t)previous;
+    }
+  }
+
+  for (uint32_t column : reached) {
+    pathCost[column] = UNREACHED;
+    columnSettled[column] = 0;
+  }
+  reached.clear();
+  settled.clear();
+  return end >= 0;
+}
+
+void SpotAssigner::greedy() {
+  const uint32_t carCount = (uint32_t)queued.size();
+  std::fill(columnCar.begin(), columnCar.end(), -1);
+  for (uint32_t car = 0; car < carCount; ++car) {
+    const Arc *best = &arcs[firstArc[carCount] + car]; // Passing through
+    for (uint32_t a = firstArc[car]; a < firstArc[car + 1]; ++a) {
+      if (columnCar[arcs[a].column] < 0 && arcs[a].cost < best->cost)
+        best = &arcs[a];
+    }
+    carColumn[car] = (int)best->column;
+    columnCar[best->column] = (int)car;
+  }
+}
+
+const std::vector<SpotAssignment> &SpotAssigner::solve(const RoadGraph &graph, DistanceMatrix &distances) {
+  results.clear();
+  lastStats = {};
+  if (queued.empty())
+    return results;
+
+  buildCandidates(graph, distances);
+  const uint32_t carCount = (uint32_t)queued.size();
+  const size_t columnCount = candidates.size() + carCount;
+  carColumn.assign(carCount, -1);
+  columnCar.assign(columnCount, -1);
+  carPotential.assign(carCount, 0.0);
+  columnPotential.assign(columnCount, 0.0);
+  pathCost.assign(columnCount, UNREACHED);
+  columnSettled.assign(columnCount, 0);
+  reachedFrom.assign(columnCount, 0);
+  lastStats.cars = carCount;
+  lastStats.spots = candidates.size();
+
+  // Adding the cars in request order makes ties go to the earlier request
+  for (uint32_t car = 0; car < carCount; ++car) {
+    if (!augment(car)) {
+      greedy();
+      lastStats.greedy = true;
+      greedyFallbacks++;
+      break;
+    }
+  }
+
+  for (uint32_t car = 0; car < carCount; ++car) {
+    SpotAssignment result{queued[car]};
+    if (carColumn[car] < (int)candidates.size()) {
+      result.facility = candidates[carColumn[car]].facility;
+      result.spotIndex = candidates[carColumn[car]].spotIndex;
+      lastStats.assigned++;
+    }
+    results.push_back(result);
+  }
+  queued.clear();
+  return results;
+}
@@ -0,0 +1,104 @@
+#include "systems/SpriteBatch.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file SpriteBatch.cpp
+ * @brief Implementation of the sorted rlgl sprite batch.
+ */
+
+void SpriteBatch::submit(TextureHandle sprite, Rectangle dest, Vector2 origin, float rotation, Color tint,
+                         int layer) {
+  SpriteRegion region = AssetManager::Get().GetSpriteRegion(sprite);
+  if (region.texture.id == 0)
+    return;
+
+  uint64_t key = ((uint64_t)(uint32_t)layer << 32) | region.texture.id;
+  submissions.push_back({key, region.texture.id, region.texture.width, region.texture.height, region.source, dest,
+                         origin, rotation, tint});
+}
+
+void SpriteBatch::submitRect(Rectangle dest, Color color, int layer) {
+  unsigned int whiteId = rlGetTextureIdDefault();
+  uint64_t key = ((uint64_t)(uint32_t)layer << 32) | whiteId;
+  submissions.push_back({key, whiteId, 1, 1, {0, 0, 1, 1}, dest, {0, 0}, 0.0f, color});
+}
+
+void SpriteBatch::flush() {
+  if (submissions.empty())
+    return;
+
+  std::stable_sort(submissions.begin(), submissions.end(),
+                   [](const Submission &a, const Submission &b) { return a.sortKey < b.sortKey; });
+
+  unsigned int boundTexture = 0;
+  for (const auto &s : submissions) {
+    if (s.textureId != boundTexture) {
+      rlSetTexture(s.textureId);
+      boundTexture = s.textureId;
+    }
+
+    // Corner positions, same math as DrawTexturePro
+    Vector2 topLeft, topRight, bottomLeft, bottomRight;
+    if (s.rotation == 0.0f) {
+      float x = s.dest.x - s.origin.x;
+      float y = s.dest.y - s.origin.y;
+      topLeft = {x, y};
+      topRight = {x + s.dest.width, y};
+      bottomLeft = {x, y + s.dest.height};
+      bottomRight = {x + s.dest.width, y + s.dest.height};
+    } else {
+      float sinRotation, cosRotation;
+      float quarterTurns = s.rotation / 90.0f;
+      if (quarterTurns == std::floor(quarterTurns)) {
+        // Exact quarter turns (LOD sprites) skip the trig calls
+        static constexpr float sinTable[4] = {0.0f, 1.0f, 0.0f, -1.0f};
+        static constexpr float cosTable[4] = {1.0f, 0.0f, -1.0f, 0.0f};
+        int q = (((int)quarterTurns % 4) + 4) % 4;
+        sinRotation = sinTable[q];
+        cosRotation = cosTable[q];
+      } else {
+        sinRotation = sinf(s.rotation * DEG2RAD);
+        cosRotation = cosf(s.rotation * DEG2RAD);
+      }
+      float dx = -s.origin.x;
+      float dy = -s.origin.y;
+      float w = s.dest.width;
+      float h = s.dest.height;
+
+      topLeft = {s.dest.x + dx * cosRotation - dy * sinRotation, s.dest.y + dx * sinRotation + dy * cosRotation};
+      topRight = {s.dest.x + (dx + w) * cosRotation - dy * sinRotation,
+                  s.dest.y + (dx + w) * sinRotation + dy * cosRotation};
+      bottomLeft = {s.dest.x + dx * cosRotation - (dy + h) * sinRotation,
+                    s.dest.y + dx * sinRotation + (dy + h) * cosRotation};
+      bottomRight = {s.dest.x + (dx + w) * cosRotation - (dy + h) * sinRotation,
+                     s.dest.y + (dx + w) * sinRotation + (dy + h) * cosRotation};
+    }
+
+    float u0 = s.source.x / s.textureWidth;
+    float v0 = s.source.y / s.textureHeight;
+    float u1 = (s.source.x + s.source.width) / s.textureWidth;
+    float v1 = (s.source.y + s.source.height) / s.textureHeight;
+
+    // Flushes raylib's buffer if these 4 vertices would overflow it; the texture stays bound
+    rlCheckRenderBatchLimit(4);
+
+    rlBegin(RL_QUADS);
+    rlColor4ub(s.tint.r, s.tint.g, s.tint.b, s.tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(topLeft.x, topLeft.y);
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(bottomLeft.x, bottomLeft.y);
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(bottomRight.x, bottomRight.y);
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(topRight.x, topRight.y);
+    rlEnd();
+  }
+  rlSetTexture(0);
+
+  submissions.clear();
+}
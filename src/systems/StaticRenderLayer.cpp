@@ -0,0 +1,89 @@
+#include "systems/StaticRenderLayer.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file StaticRenderLayer.cpp
+ * @brief Implementation of the baked background/module layer.
+ */
+
+StaticRenderLayer::~StaticRenderLayer() { unload(); }
+
+bool StaticRenderLayer::bake(const World &world, const std::vector<std::unique_ptr<Module>> &modules) {
+  unload();
+
+  // Art textures are authored at ART_PIXELS_PER_METER, so baking at that density is lossless
+  const float ppm = static_cast<float>(Config::ART_PIXELS_PER_METER);
+  const float chunkMeters = static_cast<float>(Config::STATIC_LAYER_CHUNK_SIZE) / ppm;
+
+  int cols = (int)std::ceil(world.getWidth() / chunkMeters);
+  int rows = (int)std::ceil(world.getHeight() / chunkMeters);
+
+  for (int cy = 0; cy < rows; ++cy) {
+    for (int cx = 0; cx < cols; ++cx) {
+      Rectangle bounds = {cx * chunkMeters, cy * chunkMeters, 0, 0};
+      bounds.width = std::min(chunkMeters, world.getWidth() - bounds.x);
+      bounds.height = std::min(chunkMeters, world.getHeight() - bounds.y);
+
+      int texWidth = (int)std::ceil(bounds.width * ppm);
+      int texHeight = (int)std::ceil(bounds.height * ppm);
+
+      RenderTexture2D target = LoadRenderTexture(texWidth, texHeight);
+      if (target.id == 0) {
+        Logger::Error("StaticRenderLayer: Failed to create {}x{} chunk, falling back to direct drawing.", texWidth,
+                      texHeight);
+        unload();
+        return false;
+      }
+      SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);
+
+      // Camera maps the chunk's top-left corner (meters) to texture pixel (0, 0)
+      Camera2D camera = {};
+      camera.target = {bounds.x, bounds.y};
+      camera.zoom = ppm;
+
+      BeginTextureMode(target);
+      ClearBackground(BLANK);
+      BeginMode2D(camera);
+
+      world.drawTiles(bounds);
+      for (const auto &mod : modules) {
+        Rectangle rec = {mod->worldPosition.x, mod->worldPosition.y, mod->getWidth(), mod->getHeight()};
+        if (CheckCollisionRecs(rec, bounds)) {
+          mod->draw();
+        }
+      }
+
+      EndMode2D();
+      EndTextureMode();
+
+      chunks.push_back({target, bounds});
+    }
+  }
+
+  Logger::Info("StaticRenderLayer: Baked {} chunk(s) for {} modules.", chunks.size(), modules.size());
+  return true;
+}
+
+void StaticRenderLayer::draw(Rectangle visibleArea) const {
+  for (const auto &chunk : chunks) {
+    if (!CheckCollisionRecs(chunk.bounds, visibleArea))
+      continue;
+
+    const Texture2D &tex = chunk.target.texture;
+    // Render textures are stored bottom-up, hence the negative source height
+    Rectangle source = {0, 0, (float)tex.width, -(float)tex.height};
+    Rectangle dest = {chunk.bounds.x, chunk.bounds.y, tex.width / (float)Config::ART_PIXELS_PER_METER,
+                      tex.height / (float)Config::ART_PIXELS_PER_METER};
+    DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
+  }
+}
+
+void StaticRenderLayer::unload() {
+  for (auto &chunk : chunks) {
+    UnloadRenderTexture(chunk.target);
+  }
+  chunks.clear();
+}
@@ -0,0 +1,92 @@
+#include "systems/StatsSystem.hpp"
+#include "events/GameEvents.hpp"
+
+/**
+ * @file StatsSystem.cpp
+ * @brief Implementation of the incremental statistics aggregator.
+ */
+
+namespace {
+int &spotCounter(FacilityStats &s, SpotState state) {
+  switch (state) {
+  case SpotState::RESERVED:
+    return s.reserved;
+  case SpotState::OCCUPIED:
+    return s.occupied;
+  case SpotState::FREE:
+  default:
+    return s.free;
+  }
+}
+} // namespace
+
+StatsSystem::StatsSystem(std::shared_ptr<EventBus> bus, const EntityManager &em) : eventBus(bus), entityManager(em) {
+  // A new world was generated: take the one full scan
+  eventTokens.push_back(
+      eventBus->subscribe<WorldBoundsEvent>([this](const WorldBoundsEvent &) { this->rebuildFacilities(); }));
+
+  eventTokens.push_back(eventBus->subscribe<SpotStateChangedEvent>([this](const SpotStateChangedEvent &e) {
+    if (!e.facility)
+      return;
+    FacilityStats &s = stats.byType[(size_t)e.facility->getType()];
+    spotCounter(s, e.previous)--;
+    spotCounter(s, e.current)++;
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
+    if (!e.car || trackedCars.contains(e.car))
+      return;
+    Car::CarState state = e.car->getState();
+    trackedCars[e.car] = {state};
+    stats.carsByState[(size_t)state]++;
+    stats.activeCars++;
+    stats.totalSpawned++;
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CarStateChangedEvent>([this](const CarStateChangedEvent &e) {
+    if (e.car)
+      this->moveCar(e.car, e.car->getState());
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
+    auto it = trackedCars.find(e.car);
+    if (it == trackedCars.end())
+      return;
+    stats.carsByState[(size_t)it->second.state]--;
+    stats.activeCars--;
+    stats.totalRemoved++;
+    if (it->second.visitedFacility)
+      stats.totalExited++;
+    else
+      stats.totalPassedThrough++;
+    trackedCars.erase(it);
+  }));
+}
+
+StatsSystem::~StatsSystem() { eventTokens.clear(); }
+
+void StatsSystem::rebuildFacilities() {
+  stats.byType = {};
+  for (const auto &mod : entityManager.getModules()) {
+    if (mod->getSpotCount() == 0)
+      continue;
+    FacilityStats &s = stats.byType[(size_t)mod->getType()];
+    auto counts = mod->getSpotCounts();
+    s.facilities++;
+    s.totalSpots += (int)mod->getSpotCount();
+    s.free += counts.free;
+    s.reserved += counts.reserved;
+    s.occupied += counts.occupied;
+  }
+}
+
+void StatsSystem::moveCar(const Car *car, Car::CarState newState) {
+  auto it = trackedCars.find(car);
+  if (it == trackedCars.end() || it->second.state == newState)
+    return;
+  stats.carsByState[(size_t)it->second.state]--;
+  stats.carsByState[(size_t)newState]++;
+  it->second.state = newState;
+  if (newState == Car::CarState::ALIGNING || newState == Car::CarState::PARKED)
+    it->second.visitedFacility = true;
+}
@@ -11,31 +11,18 @@ TrackingSystem::TrackingSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
   eventTokens.push_back(
       eventBus->subscribe<StopTrackingEvent>([this](const StopTrackingEvent &) { this->stopTracking(); }));
 
-  // Monitor for target car spawn
-  eventTokens.push_back(eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
-    if (this->waitingForSpawn) {
-      this->targetCar = e.car;
+  // Keep the latest simulation state
+  eventTokens.push_back(eventBus->subscribe<SnapshotUpdatedEvent>([this](const SnapshotUpdatedEvent &e) {
+    this->snapshot = e.snapshot;
+
+    // Monitor for target car spawn
+    if (this->waitingForSpawn && snapshot && snapshot->lastSpawnedCarId > this->spawnBaselineId) {
+      this->targetCarId = snapshot->lastSpawnedCarId;
       this->waitingForSpawn = false;
       Logger::Info("TrackingSystem: Target car found, beginning tracking.");
     }
   }));
 
-  // Handle target car deletion (safety)
-  eventTokens.push_back(eventBus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
-    if (this->targetCar == e.car) {
-      Logger::Info("TrackingSystem: Target car deleted. Stopping tracking.");
-      this->stopTracking();
-    }
-  }));
-
-  // Stop tracking on world reset
-  eventTokens.push_back(eventBus->subscribe<GenerateWorldEvent>([this](const GenerateWorldEvent &) {
-    if (this->isTrackingActive) {
-      Logger::Info("TrackingSystem: World reset detected via GenerateWorldEvent. Stopping tracking.");
-      this->stopTracking();
-    }
-  }));
-
   // Update tracking position
   eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) { this->update(e.dt); }));
 }
@@ -45,7 +32,8 @@ TrackingSystem::~TrackingSystem() = default;
 void TrackingSystem::startTracking() {
   isTrackingActive = true;
   waitingForSpawn = true;
-  targetCar = nullptr;
+  targetCarId = 0;
+  spawnBaselineId = snapshot ? snapshot->lastSpawnedCarId : 0;
 
   // Request a new car spawn to track
   eventBus->publish(SpawnCarRequestEvent{});
@@ -55,29 +43,24 @@ void TrackingSystem::startTracking() {
 
 void TrackingSystem::stopTracking() {
   isTrackingActive = false;
-  targetCar = nullptr;
+  targetCarId = 0;
   waitingForSpawn = false;
   eventBus->publish(TrackingStatusEvent{false});
   Logger::Info("TrackingSystem: Stopped.");
 }
 
 void TrackingSystem::update(double) {
-  if (!isTrackingActive || !targetCar) {
-    if (isTrackingActive && !targetCar && !waitingForSpawn) {
-        // This shouldn't happen normally, maybe the car was deleted but we missed the event
-        Logger::Warn("TrackingSystem: Active but no target car. Stopping.");
-        stopTracking();
-    }
+  if (!isTrackingActive || waitingForSpawn || !snapshot)
     return;
-  }
-
-  // Forward car position to camera
-  Vector2 carPos = targetCar->getPosition();
-  eventBus->publish(CameraMoveEvent{carPos});
 
-  // End tracking if target car makes it to the exit
-  if (targetCar->getState() == Car::CarState::EXITING && targetCar->hasArrived()) {
-    Logger::Info("TrackingSystem: Target car exited. Stopping tracking.");
+  // The simulation removes cars as soon as they finish exiting
+  const CarSnapshot *target = snapshot->findCar(targetCarId);
+  if (!target) {
+    Logger::Info("TrackingSystem: Target car left the simulation. Stopping tracking.");
     stopTracking();
+    return;
   }
-}
\ No newline at end of file
+
+  // Forward car position to camera
+  eventBus->publish(CameraMoveEvent{target->position});
+}
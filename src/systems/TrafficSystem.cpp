@@ -7,12 +7,31 @@
 
 #include "entities/Car.hpp"
 #include "raymath.h"
+#include <algorithm>
+#include <chrono>
 
 /**
  * @file TrafficSystem.cpp
  * @brief Implementation of the Traffic System.
  */
 
+namespace {
+// TUNING: Length of the straight provisional path (meters); the planned path replaces it a tick later
+constexpr float PROVISIONAL_PATH_LENGTH = 30.0f;
+
+/**
+ * @brief Keeps a car cruising down its lane while its real path is being planned.
+ */
+std::vector<Waypoint> ProvisionalPath(const Car *car) {
+  Vector2 velocity = car->getVelocity();
+  if (Vector2Length(velocity) < 0.1f)
+    return {};
+  Vector2 heading = Vector2Normalize(velocity);
+  Vector2 ahead = Vector2Add(car->getPosition(), Vector2Scale(heading, PROVISIONAL_PATH_LENGTH));
+  return {Waypoint(ahead, 1.0f, -1, atan2f(heading.y, heading.x))};
+}
+} // namespace
+
 TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager &em)
     : eventBus(bus), entityManager(em) {
 
@@ -26,104 +45,40 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
     eventBus->publish(AutoSpawnLevelChangedEvent{currentSpawnLevel});
   }));
 
-  // 1. Handle Spawn Request -> Find Position -> Publish CreateCarEvent
-  eventTokens.push_back(eventBus->subscribe<SpawnCarRequestEvent>([this](const SpawnCarRequestEvent &) {
-    Logger::Info("TrafficSystem: Processing Spawn Request...");
-
-    const auto &modules = entityManager.getModules();
-    if (modules.empty())
-      return;
-
-    // Find Leftmost and Rightmost Roads
-    const Module *leftRoad = nullptr;
-    const Module *rightRoad = nullptr;
-    float minX = std::numeric_limits<float>::max();
-    float maxRightX = std::numeric_limits<float>::lowest();
-
-    for (const auto &mod : modules) {
-      // We assume external roads are NormalRoads
-      if (auto *r = dynamic_cast<NormalRoad *>(mod.get())) {
-        float x = r->worldPosition.x;
-        float w = r->getWidth();
-
-        if (x < minX) {
-          minX = x;
-          leftRoad = r;
-        }
+  // The road graph is built by now; size the live edge weights for it
+  eventTokens.push_back(eventBus->subscribe<WorldBoundsEvent>([this](const WorldBoundsEvent &) {
+    pathBatcher.clear();
+    congestion.reset(entityManager.getRoadGraph());
+    buildDistanceMatrix();
+    spotAssigner.reset(entityManager.getModules());
+    pricing.reset(const_cast<EntityManager &>(entityManager).getSpotRegistry());
+    trips.clear();
+    rerouteQueue = {};
+  }));
 
-        if (x + w > maxRightX) {
-          maxRightX = x + w;
-          rightRoad = r;
-        }
-      }
-    }
+  // Demand and the price index follow every spot change, whoever made it
+  eventTokens.push_back(eventBus->subscribe<SpotStateChangedEvent>([this](const SpotStateChangedEvent &e) {
+    pricing.onSpotStateChanged(e.facility, e.previous, e.current);
+    spotAssigner.refresh(e.facility);
+  }));
 
-    if (!leftRoad && !rightRoad) {
-      Logger::Error("TrafficSystem: No roads found to spawn cars.");
+  eventTokens.push_back(eventBus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
+    if (!e.car)
       return;
-    }
-
-    // Randomly choose side
-    bool spawnLeft = (GetRandomValue(0, 1) == 0);
-
-    // If one side is missing, force the other
-    if (!leftRoad)
-      spawnLeft = false;
-    if (!rightRoad)
-      spawnLeft = true;
-
-    Vector2 spawnPos = {0, 0};
-    Vector2 spawnVel = {0, 0};
-    float speed = 15.0f; // Initial speed (matches max speed roughly)
-
-    float pixelsPerMeter = static_cast<float>(Config::ART_PIXELS_PER_METER);
-
-    if (spawnLeft) {
-      // Spawn Left -> Drive Right
-      float laneOffset = (float)Config::LANE_OFFSET_DOWN / pixelsPerMeter;
-
-      // Note: road->worldPosition is Top-Left of the module in World Coordinates.
-      // Lane offset is usually relative to the top of the road asset.
-
-      spawnPos.x = leftRoad->worldPosition.x;
-      spawnPos.y = leftRoad->worldPosition.y + laneOffset;
-
-      spawnVel = {speed, 0};
-      Logger::Info("Spawning Car LEFT at ({}, {})", spawnPos.x, spawnPos.y);
-
-    } else {
-      // Spawn Right -> Drive Left
-      float laneOffset = (float)Config::LANE_OFFSET_UP / pixelsPerMeter;
-
-      spawnPos.x = rightRoad->worldPosition.x + rightRoad->getWidth();
-      spawnPos.y = rightRoad->worldPosition.y + laneOffset;
-
-      spawnVel = {-speed, 0};
-    }
-    // Random Car Type
-    // 50% Combustion, 50% Electric
-    int carType = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-
-    // Random Priority
-    // 50% Price, 50% Distance
-    int priority = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-
-    // Entry Side is determined by spawnLeft
-    // spawnLeft means coming FROM Left (driving Right?)
-    // Logic: if spawnLeft is true, spawnPos is on leftRoad. Velocity is positive X (Right).
-    // So it entered from LEFT.
-    bool enteredFromLeft = spawnLeft;
+    spotAssigner.cancel(e.car->getId());
+    pathBatcher.cancel(e.car->getId());
+    trips.erase(e.car->getId());
+    congestion.removeCar(e.car->getId());
+  }));
 
-    eventBus->publish(CreateCarEvent{spawnPos, spawnVel, carType, priority, enteredFromLeft});
+  // 1. Handle Spawn Request -> Find Position -> Publish CreateCarEvent
+  eventTokens.push_back(eventBus->subscribe<SpawnCarRequestEvent>([this](const SpawnCarRequestEvent &) {
+    Logger::Info("TrafficSystem: Processing Spawn Request...");
+    spawnCar();
   }));
 
-  // 2. Handle Car Spawned -> Calculate Path -> Publish AssignPathEvent
+  // 2. Handle Car Spawned -> Request a spot; this tick's requests are assigned together at the end of the tick
   eventTokens.push_back(eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
-    // Logger::Info("TrafficSystem: Calculating path for new car...");
-
-    std::vector<Module *> facilities;
-    const auto &modules = entityManager.getModules();
-
     Car::CarType type = e.car->getType();
     float battery = e.car->getBatteryLevel();
 
@@ -148,139 +103,36 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
       }
     }
 
-    // Filter Facilities
-    for (const auto &mod : modules) {
-      if (type == Car::CarType::COMBUSTION) {
-        // Combustion: Parking Only
-        if (dynamic_cast<SmallParking *>(mod.get()) || dynamic_cast<LargeParking *>(mod.get())) {
-          facilities.push_back(mod.get());
-        }
-      } else {
-        // Electric
-        if (seekCharging) {
-          if (dynamic_cast<SmallChargingStation *>(mod.get()) || dynamic_cast<LargeChargingStation *>(mod.get())) {
-            facilities.push_back(mod.get());
-          }
-        } else {
-          if (dynamic_cast<SmallParking *>(mod.get()) || dynamic_cast<LargeParking *>(mod.get())) {
-            facilities.push_back(mod.get());
-          }
-        }
-      }
-    }
-
-      if (facilities.empty()) {
-        Logger::Info("TrafficSystem: No suitable facilities found. Car passing through.");
-        assignThroughTrafficPath(e.car);
-        return;
-      }
-
-    if (facilities.empty()) {
-      assignThroughTrafficPath(e.car);
-      return;
-    }
-
-    Module *targetFac = nullptr;
-    int bestSpotIndex = -1;
-    float bestMetric = std::numeric_limits<float>::max(); // Price or Distance
-
-    Car::Priority priority = e.car->getPriority();
-    Vector2 carPos = e.car->getPosition();
-
-    Logger::Info("TrafficSystem: Selecting facility for Car (Pri: {})", (int)priority);
-
-    if (priority == Car::Priority::PRIORITY_DISTANCE) {
-      // Closest Facility with Available Spots
-      for (auto *fac : facilities) {
-        // Check if full
-        if (fac->getSpotCounts().free == 0)
-          continue;
-
-        // Metric: Distance (Manhattan or Euclidean? Euclidean is fine)
-        // Use WorldPosition X primarily? User said: "closest facility to the entrace... that's also available"
-        // e.car->getPosition() is the spawn point right now.
-        float dist = Vector2Distance(carPos, fac->worldPosition);
-
-        if (dist < bestMetric) {
-          // Check if actually has valid spot index
-          int idx = fac->getRandomSpotIndex(); // Random valid spot in this facility
-          if (idx != -1) {
-            bestMetric = dist;
-            targetFac = fac;
-            bestSpotIndex = idx;
-          }
-        }
-      }
-    } else {
-      // Revised Approach for Price:
-      // 1. Iterate all facilities.
-      // 2. For each facility, try to find a free spot.
-      // 3. Since we can't iterate all spots easily, let's trust `getRandomSpotIndex`.
-      //    It returns a random FREE spot.
-      //    We compare the price of these candidates.
-      //    This minimizes facilities interaction but might miss a slightly cheaper spot IN the same facility.
-      //    But variance is small ($0.5). Facility diff is Large ($10 vs $2).
-      //    So finding cheapest FACILITY is 90% of the battle.
-
-      for (auto *fac : facilities) {
-        int idx = fac->getRandomSpotIndex();
-        if (idx == -1)
-          continue; // Full
-
-        Spot s = fac->getSpot(idx);
-        if (s.price < bestMetric) {
-          bestMetric = s.price;
-          targetFac = fac;
-          bestSpotIndex = idx;
-        }
-      }
-    }
-
-    if (!targetFac || bestSpotIndex == -1) {
-      // Fallback: Random
-      if (!facilities.empty()) {
-        targetFac = facilities[GetRandomValue(0, (int)facilities.size() - 1)];
-        bestSpotIndex = targetFac->getRandomSpotIndex();
-      }
-    }
-
-    // --- New Spot-Based Pathfinding (via PathPlanner) ---
-
-    // 1. Determine Spot
-    int spotIndex = bestSpotIndex;
-    // If still -1, try one more time
-    if (targetFac && spotIndex == -1)
-      spotIndex = targetFac->getRandomSpotIndex();
-
-    // Handle "Through Traffic" (No spots available)
-    if (spotIndex == -1 || !targetFac) {
-      Logger::Info("TrafficSystem: Facility full (Free: 0). Car passing through.");
+    // Combustion cars only park; electric cars charge or park
+    if (!spotAssigner.hasFacilities(seekCharging)) {
+      Logger::Info("TrafficSystem: No suitable facilities found. Car passing through.");
       assignThroughTrafficPath(e.car);
       return;
     }
 
-    // Reserve the spot immediately
-    targetFac->setSpotState(spotIndex, SpotState::RESERVED);
-
-    // Log Reservation
-    auto counts = targetFac->getSpotCounts();
-    Logger::Info("TrafficSystem: Spot Reserved. Facility Status: [Free: {}, Reserved: {}, Occupied: {}]", counts.free,
-                 counts.reserved, counts.occupied);
-
-    Spot spot = targetFac->getSpot(spotIndex);
-
-    // 2. Generate Path
-    std::vector<Waypoint> path = PathPlanner::GeneratePath(e.car, targetFac, spot);
-
-    // Store context in Car so it knows where it is when it wants to leave
-    e.car->setParkingContext(targetFac, spot, spotIndex);
-
-    // Publish Path Assignment
-    eventBus->publish(AssignPathEvent{e.car, path});
+    SpotRequest request;
+    request.car = e.car;
+    request.carId = e.car->getId();
+    request.charging = seekCharging;
+    request.priority = e.car->getPriority();
+    request.position = e.car->getPosition();
+    request.velocity = e.car->getVelocity();
+    spotAssigner.enqueue(request);
+
+    // The car follows its lane until its spot is assigned and its path planned
+    eventBus->publish(AssignPathEvent{e.car, ProvisionalPath(e.car)});
   }));
 
   // 3. Handle Game Update
   eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) {
+    // Paths requested last tick take effect now, whenever their batch finished
+    applyPlannedPaths();
+
+    // Cars have moved for this tick: measure the lanes, then re-check the trips that are due
+    simTime += e.dt;
+    congestion.update(e.dt, entityManager.getCars());
+    rerouteCars();
+
     // Auto-Spawn Logic
     if (currentSpawnLevel > 0) {
       spawnTimer += (float)e.dt;
@@ -334,7 +186,7 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
         if (fac && idx != -1) {
           Spot s = fac->getSpot(idx);
           if (s.state == SpotState::RESERVED) {
-            fac->setSpotState(idx, SpotState::OCCUPIED);
+            setSpotState(fac, idx, SpotState::OCCUPIED);
             // auto counts = fac->getSpotCounts();
             // Logger::Info("TrafficSystem: Spot Occupied.");
           }
@@ -373,8 +225,8 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
         }
       }
 
-      // Check if ready to leave parking
-      if (shouldExit) {
+      // Check if ready to leave parking (unless its exit path is already being planned)
+      if (shouldExit && !pathBatcher.isPending(car->getId())) {
         // ... (Existing Exit Logic) ...
         Logger::Info("TrafficSystem: Car exiting.");
 
@@ -387,10 +239,6 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
           continue;
         }
 
-        if (idx != -1) {
-          currentFac->setSpotState(idx, SpotState::FREE);
-        }
-
         bool exitRight = false;
         if (car->getPriority() == Car::Priority::PRIORITY_DISTANCE) {
           exitRight = !car->getEnteredFromLeft();
@@ -398,11 +246,19 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
           exitRight = (GetRandomValue(0, 1) == 1);
         }
 
-        float finalX = exitRight ? (maxRoadX + 2.0f) : (minRoadX - 2.0f);
-        std::vector<Waypoint> path = PathPlanner::GenerateExitPath(car, currentFac, currentSpot, exitRight, finalX);
-
-        car->setPath(path);
-        car->setState(Car::CarState::EXITING);
+        // The car stays parked (and its spot taken) until the planned exit path is applied
+        PathRequest request;
+        request.kind = PathRequest::Kind::EXIT;
+        request.car = car;
+        request.carId = car->getId();
+        request.position = car->getPosition();
+        request.velocity = car->getVelocity();
+        request.facility = currentFac;
+        request.spot = currentSpot;
+        request.spotIndex = idx;
+        request.exitRight = exitRight;
+        request.finalX = exitRight ? (maxRoadX + 2.0f) : (minRoadX - 2.0f);
+        pathBatcher.enqueue(request);
       }
 
       // Check if finished exiting
@@ -414,72 +270,193 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
     for (Car *c : carsToRemove) {
       const_cast<EntityManager &>(entityManager).removeCar(c);
     }
+
+    // End of the tick: re-price, assign this tick's spot requests, then plan the paths while the rest of the frame runs
+    for (Module *facility : pricing.update(simTime))
+      spotAssigner.refresh(facility);
+    assignSpots();
+    pathBatcher.dispatch(entityManager.getRoadGraph());
   }));
 }
 
 TrafficSystem::~TrafficSystem() { eventTokens.clear(); }
 
 void TrafficSystem::spawnCar() {
-  Logger::Info("TrafficSystem: Processing Spawn Logic...");
-
-  const auto &modules = entityManager.getModules();
-  if (modules.empty())
+  // Cars enter at the open ends of the road network (both ends of every road)
+  const auto &entries = entityManager.getRoadGraph().getEntries();
+  if (entries.empty()) {
+    Logger::Error("TrafficSystem: No roads found to spawn cars.");
     return;
+  }
 
-  // Find Leftmost and Rightmost Roads
-  const Module *leftRoad = nullptr;
-  const Module *rightRoad = nullptr;
-  float minX = std::numeric_limits<float>::max();
-  float maxRightX = std::numeric_limits<float>::lowest();
+  const RoadGraph::Endpoint &entry = entries[GetRandomValue(0, (int)entries.size() - 1)];
+  float speed = 15.0f; // Initial speed (matches max speed roughly)
+  Vector2 spawnPos = entityManager.getRoadGraph().getNodePosition(entry.node);
+  Vector2 spawnVel = Vector2Scale(entry.direction, speed);
 
-  for (const auto &mod : modules) {
-    if (auto *r = dynamic_cast<NormalRoad *>(mod.get())) {
-      float x = r->worldPosition.x;
-      float w = r->getWidth();
+  // Random Car Type: 50% Combustion, 50% Electric
+  int carType = (GetRandomValue(0, 1) == 0) ? 0 : 1;
+  // Random Priority: 50% Price, 50% Distance
+  int priority = (GetRandomValue(0, 1) == 0) ? 0 : 1;
+  // Driving right means it came in from the left
+  bool enteredFromLeft = entry.direction.x > 0;
 
-      if (x < minX) {
-        minX = x;
-        leftRoad = r;
-      }
+  eventBus->publish(CreateCarEvent{spawnPos, spawnVel, carType, priority, enteredFromLeft});
+}
 
-      if (x + w > maxRightX) {
-        maxRightX = x + w;
-        rightRoad = r;
-      }
+void TrafficSystem::buildDistanceMatrix() {
+  const RoadGraph &graph = entityManager.getRoadGraph();
+  distanceMatrix.reset(graph, entityManager.getModules());
+
+  // Every spawn starts at a map entry, so those rows are needed anyway; facility exits fill in on demand
+  auto started = std::chrono::steady_clock::now();
+  std::vector<uint32_t> sources;
+  for (const auto &entry : graph.getEntries())
+    sources.push_back(entry.node);
+  distanceMatrix.addRows(sources);
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+  Logger::Info("TrafficSystem: Distance matrix {} x {} built in {:.1f} ms", distanceMatrix.getRowCount(),
+               distanceMatrix.getColumnCount(), ms);
+}
+
+void TrafficSystem::assignSpots() {
+  for (const SpotAssignment &assignment : spotAssigner.solve(entityManager.getRoadGraph(), distanceMatrix)) {
+    Car *car = assignment.request.car;
+    Module *targetFac = assignment.facility;
+    if (!targetFac) {
+      Logger::Info("TrafficSystem: Facility full (Free: 0). Car passing through.");
+      assignThroughTrafficPath(car);
+      continue;
+    }
+
+    // Reserve the spot before the path is planned; the compare-and-swap fails if it was taken since the solve
+    if (!targetFac->tryReserveSpot(assignment.spotIndex)) {
+      Logger::Warn("TrafficSystem: Assigned spot was taken meanwhile. Car passing through.");
+      assignThroughTrafficPath(car);
+      continue;
     }
+    eventBus->publish(SpotStateChangedEvent{targetFac, assignment.spotIndex, SpotState::FREE, SpotState::RESERVED});
+
+    auto counts = targetFac->getSpotCounts();
+    Logger::Info("TrafficSystem: Spot Reserved. Facility Status: [Free: {}, Reserved: {}, Occupied: {}]", counts.free,
+                 counts.reserved, counts.occupied);
+
+    Spot spot = targetFac->getSpot(assignment.spotIndex);
+
+    // Store context in Car so it knows where it is when it wants to leave
+    car->setParkingContext(targetFac, spot, assignment.spotIndex);
+
+    PathRequest request;
+    request.kind = PathRequest::Kind::PARK;
+    request.car = car;
+    request.carId = assignment.request.carId;
+    request.position = car->getPosition();
+    request.velocity = car->getVelocity();
+    request.facility = targetFac;
+    request.spot = spot;
+    request.spotIndex = assignment.spotIndex;
+    pathBatcher.enqueue(request);
   }
 
-  if (!leftRoad && !rightRoad)
-    return;
+  const SpotAssigner::SolveStats &stats = spotAssigner.getLastStats();
+  if (stats.greedy)
+    Logger::Warn("TrafficSystem: Spot matching for {} cars exceeded its budget; assigned greedily", stats.cars);
+}
+
+void TrafficSystem::applyPlannedPaths() {
+  for (PlannedPath &planned : pathBatcher.collect()) {
+    const PathRequest &request = planned.request;
+    Car *car = request.car;
+    if (request.kind == PathRequest::Kind::EXIT) {
+      if (request.spotIndex != -1)
+        setSpotState(const_cast<Module *>(request.facility), request.spotIndex, SpotState::FREE);
+      car->setPath(planned.path);
+      car->setState(Car::CarState::EXITING);
+      continue;
+    }
 
-  bool spawnLeft = (GetRandomValue(0, 1) == 0);
-  if (!leftRoad)
-    spawnLeft = false;
-  if (!rightRoad)
-    spawnLeft = true;
-
-  Vector2 spawnPos = {0, 0};
-  Vector2 spawnVel = {0, 0};
-  float speed = 15.0f;
-  float pixelsPerMeter = static_cast<float>(Config::ART_PIXELS_PER_METER);
-
-  if (spawnLeft) {
-    float laneOffset = (float)Config::LANE_OFFSET_DOWN / pixelsPerMeter;
-    spawnPos.x = leftRoad->worldPosition.x;
-    spawnPos.y = leftRoad->worldPosition.y + laneOffset;
-    spawnVel = {speed, 0};
-  } else {
-    float laneOffset = (float)Config::LANE_OFFSET_UP / pixelsPerMeter;
-    spawnPos.x = rightRoad->worldPosition.x + rightRoad->getWidth();
-    spawnPos.y = rightRoad->worldPosition.y + laneOffset;
-    spawnVel = {-speed, 0};
+    // The route was planned without congestion; check it against live travel times soon
+    if (!planned.route.empty()) {
+      trips[request.carId] = PlannedTrip{car, request.facility, request.spot, std::move(planned.route)};
+      rerouteQueue.push({simTime + Config::REROUTE_FIRST_CHECK, request.carId});
+    }
+    eventBus->publish(AssignPathEvent{car, planned.path});
   }
+}
 
-  int carType = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-  int priority = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-  bool enteredFromLeft = spawnLeft;
+void TrafficSystem::rerouteCars() {
+  int searches = 0;
+  while (!rerouteQueue.empty() && rerouteQueue.top().first <= simTime &&
+         searches < Config::REROUTE_SEARCHES_PER_TICK) {
+    uint32_t carId = rerouteQueue.top().second;
+    rerouteQueue.pop();
+    auto it = trips.find(carId);
+    if (it == trips.end())
+      continue;
+    if (it->second.car->getState() != Car::CarState::DRIVING) {
+      trips.erase(it);
+      continue;
+    }
 
-  eventBus->publish(CreateCarEvent{spawnPos, spawnVel, carType, priority, enteredFromLeft});
+    ++searches;
+    if (reroute(carId, it->second))
+      rerouteQueue.push({simTime + Config::REROUTE_INTERVAL, carId});
+    else
+      trips.erase(it);
+  }
+}
+
+bool TrafficSystem::reroute(uint32_t carId, PlannedTrip &trip) {
+  const RoadGraph &graph = entityManager.getRoadGraph();
+  Car *car = trip.car;
+  uint32_t ahead = graph.findNodeAhead(car->getPosition(), car->getVelocity());
+  if (ahead == RoadGraph::NO_NODE)
+    return true; // Mid-turn; try again later
+
+  auto onRoute = std::find(trip.route.begin(), trip.route.end(), ahead);
+  if (onRoute == trip.route.end())
+    return false; // Turned off towards the facility (or off the plan)
+  if (onRoute + 1 == trip.route.end())
+    return false; // Already on the last stretch
+
+  // Predicted time of the rest of the current route under live weights
+  float current = 0.0f;
+  for (auto node = onRoute; node + 1 != trip.route.end(); ++node) {
+    uint32_t edge = graph.findEdge(*node, *(node + 1));
+    if (edge == RoadGraph::NO_EDGE)
+      return false;
+    current += congestion.getCost(edge);
+  }
+
+  auto [east, west] = graph.getEntranceNodes(trip.facility->getParent());
+  const uint32_t goals[] = {east, west};
+  if (!graph.findRouteWeighted(ahead, goals, congestion.getCosts(), CongestionWeights::GetMinCostPerMeter(),
+                               routeScratch, candidateRoute))
+    return true;
+
+  float candidate = 0.0f;
+  for (size_t i = 0; i + 1 < candidateRoute.size(); ++i)
+    candidate += congestion.getCost(graph.findEdge(candidateRoute[i], candidateRoute[i + 1]));
+
+  // Only switch for a clear gain, so cars do not flap between two similar routes
+  float saving = current - candidate;
+  if (saving < std::max(Config::REROUTE_MIN_SAVING, current * Config::REROUTE_MIN_SAVING_FRACTION))
+    return true;
+
+  std::vector<Waypoint> path =
+      PathPlanner::GeneratePathAlong(car->getPosition(), trip.facility, trip.spot, graph, candidateRoute);
+  trip.route = candidateRoute;
+  rerouteCount++;
+  Logger::Info("TrafficSystem: Rerouting car {} (predicted {:.0f} s -> {:.0f} s)", carId, current, candidate);
+  eventBus->publish(AssignPathEvent{car, path});
+  return true;
+}
+
+void TrafficSystem::setSpotState(Module *facility, int spotIndex, SpotState state) {
+  SpotState previous = facility->setSpotState(spotIndex, state);
+  if (previous != state) {
+    eventBus->publish(SpotStateChangedEvent{facility, spotIndex, previous, state});
+  }
 }
 
 void TrafficSystem::assignThroughTrafficPath(Car *car) {
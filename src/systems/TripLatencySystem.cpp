@@ -0,0 +1,100 @@
+#include "systems/TripLatencySystem.hpp"
+#include "config.hpp"
+#include "entities/map/Modules.hpp"
+#include "events/GameEvents.hpp"
+
+/**
+ * @file TripLatencySystem.cpp
+ * @brief Implementation of the per-trip latency recorder.
+ */
+
+TripLatencySystem::TripLatencySystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
+  eventTokens.push_back(eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
+    if (!e.car || trips.contains(e.car))
+      return;
+    Trip trip{e.car->getState()};
+    trip.spawned = now;
+    trips[e.car] = trip;
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CarStateChangedEvent>([this](const CarStateChangedEvent &e) {
+    if (e.car)
+      this->onStateChanged(*e.car);
+  }));
+
+  eventTokens.push_back(eventBus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
+    auto it = trips.find(e.car);
+    if (it == trips.end())
+      return;
+    const Trip &trip = it->second;
+    // Pass-through cars never park; their traversal is not an exit time
+    if (trip.exiting >= 0.0 && trip.parked >= 0.0) {
+      latencies.record(TripMetric::EXIT, e.car->getType(), e.car->getPriority(), now - trip.exiting);
+      summaryDirty = true;
+    }
+    trips.erase(it);
+  }));
+}
+
+TripLatencySystem::~TripLatencySystem() { eventTokens.clear(); }
+
+void TripLatencySystem::onStateChanged(const Car &car) {
+  auto it = trips.find(&car);
+  if (it == trips.end())
+    return;
+  Trip &trip = it->second;
+  Car::CarState state = car.getState();
+  if (state == trip.state)
+    return;
+  trip.state = state;
+
+  Car::CarType type = car.getType();
+  Car::Priority priority = car.getPriority();
+
+  switch (state) {
+  case Car::CarState::ALIGNING:
+    if (trip.aligning < 0.0) {
+      trip.aligning = now;
+      latencies.record(TripMetric::SEARCH, type, priority, now - trip.spawned);
+    }
+    break;
+  case Car::CarState::PARKED:
+    if (trip.parked < 0.0) {
+      trip.parked = now;
+      latencies.record(TripMetric::TIME_TO_PARK, type, priority, now - trip.spawned);
+      if (trip.aligning >= 0.0)
+        latencies.record(TripMetric::ALIGNING, type, priority, now - trip.aligning);
+
+      const Module *facility = car.getParkedFacility();
+      trip.atCharger = facility && (facility->getType() == ModuleType::SMALL_CHARGING ||
+                                    facility->getType() == ModuleType::LARGE_CHARGING);
+      trip.batteryAtPark = car.getBatteryLevel();
+    }
+    break;
+  case Car::CarState::EXITING:
+    if (trip.exiting < 0.0) {
+      trip.exiting = now;
+      if (trip.parked >= 0.0) {
+        double dwell = now - trip.parked;
+        latencies.record(TripMetric::DWELL, type, priority, dwell);
+
+        float chargedKwh = (car.getBatteryLevel() - trip.batteryAtPark) / 100.0f * Config::BATTERY_CAPACITY_KWH;
+        if (trip.atCharger && type == Car::CarType::ELECTRIC && chargedKwh > 0.0f)
+          latencies.record(TripMetric::CHARGE_PER_KWH, type, priority, dwell / chargedKwh);
+      }
+    }
+    break;
+  case Car::CarState::DRIVING:
+    break;
+  }
+  summaryDirty = true;
+}
+
+const TripLatencySummary &TripLatencySystem::getSummary() {
+  if (summaryDirty && (summaryTime < 0.0 || now - summaryTime >= 1.0)) {
+    summary = latencies.summarize();
+    summaryTime = now;
+    summaryDirty = false;
+  }
+  return summary;
+}
@@ -2,11 +2,15 @@
 #include "config.hpp"
 #include "events/InputEvents.hpp"
 #include "raymath.h"
+#include <array>
 #include <format>
 #include <string>
 
-DashboardOverlay::DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager *em)
-    : UIElement({0, 0}, {0, 0}, bus), entityManager(em) {
+DashboardOverlay::DashboardOverlay(std::shared_ptr<EventBus> bus) : UIElement({0, 0}, {0, 0}, bus) {
+
+  // Keep the latest simulation state
+  eventTokens.push_back(
+      bus->subscribe<SnapshotUpdatedEvent>([this](const SnapshotUpdatedEvent &e) { snapshot = e.snapshot; }));
 
   // Subscribe to selection events
   eventTokens.push_back(bus->subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent &e) {
@@ -59,9 +63,11 @@ void DashboardOverlay::draw() {
   // Rough estimation per type
   if (currentSelection.type == SelectionType::GENERAL) {
     estimatedHeight = headerHeight + 10 + 25 + (3 * 25) + 10 + 25 + 25 + (3 * 25); // ~350
+    estimatedHeight += 10 + 25 + (TRIP_METRIC_COUNT * 25);                         // Trip times
   } else if (currentSelection.type == SelectionType::CAR) {
     estimatedHeight = headerHeight + (5 * 25); // ~155
-    if (currentSelection.car && currentSelection.car->getType() == Car::CarType::ELECTRIC)
+    const CarSnapshot *car = snapshot ? snapshot->findCar(currentSelection.carId) : nullptr;
+    if (car && car->type == Car::CarType::ELECTRIC)
       estimatedHeight += 25;
   } else if (currentSelection.type == SelectionType::FACILITY) {
     estimatedHeight = headerHeight + (8 * 25); // ~230
@@ -101,48 +107,11 @@ void DashboardOverlay::drawGeneralInfo(int x, int y, int width) {
   DrawText("GENERAL INFO", x, y, 20, GOLD);
   y += 30;
 
-  int totalFacilities = 0;
-  int totalSpots = 0;
-  int occupiedSpots = 0;
-
-  int chargingStations = 0;
-  int parkingLots = 0;
-
-  int chargingSpots = 0;
-  int occupiedCharging = 0;
-
-  int parkingSpots = 0;
-  int occupiedParking = 0;
-
-  if (entityManager) {
-    auto &modules = entityManager->getModules();
-    // totalFacilities = modules.size(); // Incorrect, includes roads
-
-    for (const auto &m : modules) {
-      auto type = m->getType();
-      bool isCharging = (type == ModuleType::SMALL_CHARGING || type == ModuleType::LARGE_CHARGING);
-      bool isParking = (type == ModuleType::SMALL_PARKING || type == ModuleType::LARGE_PARKING);
-
-      if (!isCharging && !isParking)
-        continue; // Skip roads/etc
-
-      totalFacilities++;
-
-      auto counts = m->getSpotCounts();
-      totalSpots += (counts.free + counts.reserved + counts.occupied);
-      occupiedSpots += counts.occupied;
-
-      if (isCharging) {
-        chargingStations++;
-        chargingSpots += (counts.free + counts.reserved + counts.occupied);
-        occupiedCharging += counts.occupied;
-      } else if (isParking) {
-        parkingLots++;
-        parkingSpots += (counts.free + counts.reserved + counts.occupied);
-        occupiedParking += counts.occupied;
-      }
-    }
-  }
+  // Aggregates are maintained incrementally by StatsSystem on the simulation thread
+  SimulationStats stats = snapshot ? snapshot->stats : SimulationStats{};
+  FacilityStats parking = stats.parking();
+  FacilityStats charging = stats.charging();
+  FacilityStats all = stats.allFacilities();
 
   auto drawStat = [&](const char *label, const std::string &val) {
     DrawText(label, x, y, 20, WHITE);
@@ -150,27 +119,36 @@ void DashboardOverlay::drawGeneralInfo(int x, int y, int width) {
     y += 25;
   };
 
-  drawStat("Facilities:", std::format("{}", totalFacilities));
-  drawStat("Pk Lots:", std::format("{}", parkingLots));
-  drawStat("Chrg Stns:", std::format("{}", chargingStations));
+  drawStat("Facilities:", std::format("{}", all.facilities));
+  drawStat("Pk Lots:", std::format("{}", parking.facilities));
+  drawStat("Chrg Stns:", std::format("{}", charging.facilities));
 
   y += 10;
   DrawText("OCCUPANCY", x, y, 20, YELLOW);
   y += 25;
 
-  float overallOcc = totalSpots > 0 ? (float)occupiedSpots / totalSpots * 100.0f : 0.0f;
-  float parkingOcc = parkingSpots > 0 ? (float)occupiedParking / parkingSpots * 100.0f : 0.0f;
-  float chargingOcc = chargingSpots > 0 ? (float)occupiedCharging / chargingSpots * 100.0f : 0.0f;
+  drawStat("Overall:", std::format("{:.1f}%", all.occupancy() * 100.0f));
+  drawStat("Parking:", std::format("{:.1f}%", parking.occupancy() * 100.0f));
+  drawStat("Charging:", std::format("{:.1f}%", charging.occupancy() * 100.0f));
 
-  drawStat("Overall:", std::format("{:.1f}%", overallOcc));
-  drawStat("Parking:", std::format("{:.1f}%", parkingOcc));
-  drawStat("Charging:", std::format("{:.1f}%", chargingOcc));
+  y += 10;
+  DrawText("TRIP TIMES p50/95/99", x, y, 20, YELLOW);
+  y += 25;
+
+  static constexpr std::array<const char *, TRIP_METRIC_COUNT> tripLabels = {
+      "To Park:", "Search:", "Aligning:", "Dwell:", "s / kWh:", "Exit:",
+  };
+  TripLatencySummary trips = snapshot ? snapshot->trips : TripLatencySummary{};
+  for (size_t m = 0; m < TRIP_METRIC_COUNT; ++m) {
+    const auto &q = trips.metrics[m];
+    drawStat(tripLabels[m], q.count > 0 ? std::format("{:.0f}/{:.0f}/{:.0f}", q.p50, q.p95, q.p99) : "-");
+  }
 }
 
 void DashboardOverlay::drawCarInfo(int x, int y, int width) {
-  if (!currentSelection.car)
+  const CarSnapshot *car = snapshot ? snapshot->findCar(currentSelection.carId) : nullptr;
+  if (!car)
     return;
-  auto *car = currentSelection.car;
 
   DrawText("CAR INFO", x, y, 20, GOLD);
   y += 30;
@@ -181,11 +159,11 @@ void DashboardOverlay::drawCarInfo(int x, int y, int width) {
     y += 25;
   };
 
-  std::string typeStr = (car->getType() == Car::CarType::ELECTRIC) ? "Electric" : "Gas";
+  std::string typeStr = (car->type == Car::CarType::ELECTRIC) ? "Electric" : "Gas";
   drawStat("Type:", typeStr);
 
   std::string stateStr;
-  switch (car->getState()) {
+  switch (car->state) {
   case Car::CarState::DRIVING:
     stateStr = "Driving";
     break;
@@ -201,20 +179,21 @@ void DashboardOverlay::drawCarInfo(int x, int y, int width) {
   }
   drawStat("State:", stateStr);
 
-  float speed = Vector2Length(car->getVelocity());
+  float speed = Vector2Length(car->velocity);
   drawStat("Speed:", std::format("{:.1f}", speed));
 
-  if (car->getType() == Car::CarType::ELECTRIC) {
-    drawStat("Battery:", std::format("{:.1f}%", car->getBatteryLevel()));
+  if (car->type == Car::CarType::ELECTRIC) {
+    drawStat("Battery:", std::format("{:.1f}%", car->batteryLevel));
   }
 
-  drawStat("Priority:", (car->getPriority() == Car::Priority::PRIORITY_PRICE) ? "Price" : "Distance");
+  drawStat("Priority:", (car->priority == Car::Priority::PRIORITY_PRICE) ? "Price" : "Distance");
 }
 
 void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
-  if (!currentSelection.module)
+  if (!snapshot || !snapshot->layout || currentSelection.facilityIndex < 0 ||
+      currentSelection.facilityIndex >= (int)snapshot->layout->facilities.size())
     return;
-  auto *m = currentSelection.module;
+  const FacilityLayout *m = &snapshot->layout->facilities[currentSelection.facilityIndex];
 
   DrawText("FACILITY INFO", x, y, 20, GOLD);
   y += 30;
@@ -226,7 +205,7 @@ void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
   };
 
   std::string typeStr = "Unknown";
-  switch (m->getType()) {
+  switch (m->type) {
   case ModuleType::SMALL_PARKING:
     typeStr = "Sml Parking";
     break;
@@ -244,7 +223,7 @@ void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
   }
   drawStat("Type:", typeStr);
 
-  auto counts = m->getSpotCounts();
+  auto counts = snapshot->facilityCounts[currentSelection.facilityIndex];
   int total = counts.free + counts.reserved + counts.occupied;
 
   drawStat("Total Spots:", std::format("{}", total));
@@ -255,14 +234,17 @@ void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
   float occ = total > 0 ? (float)counts.occupied / total * 100.0f : 0.0f;
   drawStat("Occ. Rate:", std::format("{:.1f}%", occ));
 
-  drawStat("Price Mult:", std::format("{:.2f}x", m->getPriceMultiplier()));
+  drawStat("Price Mult:", std::format("{:.2f}x", m->priceMultiplier));
 }
 
 void DashboardOverlay::drawSpotInfo(int x, int y, int width) {
-  if (!currentSelection.module || currentSelection.spotIndex == -1)
+  if (!snapshot || !snapshot->layout || currentSelection.facilityIndex < 0 ||
+      currentSelection.facilityIndex >= (int)snapshot->layout->facilities.size())
+    return;
+  const FacilityLayout &facility = snapshot->layout->facilities[currentSelection.facilityIndex];
+  if (currentSelection.spotIndex < 0 || currentSelection.spotIndex >= (int)facility.spotCount)
     return;
-  auto *m = currentSelection.module;
-  Spot spot = m->getSpot(currentSelection.spotIndex);
+  const uint32_t spot = facility.firstSpot + (uint32_t)currentSelection.spotIndex;
 
   DrawText("SPOT INFO", x, y, 20, GOLD);
   y += 30;
@@ -276,11 +258,11 @@ void DashboardOverlay::drawSpotInfo(int x, int y, int width) {
   drawStat("Index:", std::format("{}", currentSelection.spotIndex));
 
   std::string stateStr = "Free";
-  if (spot.state == SpotState::RESERVED)
+  if (snapshot->spotStates[spot] == SpotState::RESERVED)
     stateStr = "Reserved";
-  if (spot.state == SpotState::OCCUPIED)
+  if (snapshot->spotStates[spot] == SpotState::OCCUPIED)
     stateStr = "Occupied";
   drawStat("State:", stateStr);
 
-  drawStat("Price:", std::format("${:.2f}", spot.price));
+  drawStat("Price:", std::format("${:.2f}", (*snapshot->spotPrices)[spot]));
 }
@@ -12,10 +12,10 @@
  * @brief Implementation of GameHUD.
  */
 
-GameHUD::GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager, const AdaptiveSignalsConfig& config) 
+GameHUD::GameHUD(std::shared_ptr<EventBus> bus, const AdaptiveSignalsConfig& config) 
     : eventBus(bus), adaptiveConfig(config) {
   // Setup UI Elements
-  uiManager.add(std::make_shared<DashboardOverlay>(eventBus, entityManager));
+  uiManager.add(std::make_shared<DashboardOverlay>(eventBus));
 
   auto spawnBtn = std::make_shared<UIButton>(Vector2{10, 10}, Vector2{150, 40}, "Spawn Car", eventBus);
   spawnBtn->setOnClick([this]() { eventBus->publish(SpawnCarRequestEvent{}); });
@@ -64,6 +64,10 @@ GameHUD::GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager, co
   trafficBtn->setOnClick([this]() { eventBus->publish(SceneChangeEvent{SceneType::AdaptiveSignals, {}, adaptiveConfig}); });
   uiManager.add(trafficBtn);
 
+  auto exportBtn = std::make_shared<UIButton>(Vector2{10, 260}, Vector2{150, 40}, "Export CSV", eventBus);
+  exportBtn->setOnClick([this]() { eventBus->publish(ExportMetricsEvent{}); });
+  uiManager.add(exportBtn);
+
   // Update button text automatically when the tracking state changes in the system
   eventTokens.push_back(eventBus->subscribe<TrackingStatusEvent>([weakTrackBtn](const TrackingStatusEvent& e) {
     if (auto btn = weakTrackBtn.lock()) {
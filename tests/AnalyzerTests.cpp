@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "Analyzer.hpp"
+#include "core/EventJournal.hpp"
+#include "core/TrajectoryWriter.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+namespace {
+std::string TempPath(const char *name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+JournalRecord CarRecord(uint64_t tick, uint32_t carId, JournalEventKind kind, uint8_t state) {
+    JournalRecord record{};
+    record.tick = tick;
+    record.carId = carId;
+    record.facility = JournalRecord::NO_FACILITY;
+    record.kind = kind;
+    record.state = state;
+    return record;
+}
+
+JournalRecord SpotRecord(uint64_t tick, uint32_t facility, uint8_t previous, uint8_t state) {
+    JournalRecord record{};
+    record.tick = tick;
+    record.facility = facility;
+    record.kind = JournalEventKind::SPOT_STATE;
+    record.previous = previous;
+    record.state = state;
+    return record;
+}
+
+/**
+ * @brief Writes @p trips identical trips 60 ticks apart: spawn, aligning after 10 s, parked after 12 s,
+ * exiting after 112 s, removed after 120 s. Each occupies spot 0 of facility 0 while parked.
+ */
+void WriteJournal(const std::string &path, int trips) {
+    auto writer = EventJournalWriter::Open(path, 60.0, {{2, 10}, {4, 5}});
+    ASSERT_NE(writer, nullptr);
+    std::vector<JournalRecord> records;
+    for (int i = 0; i < trips; ++i) {
+        uint64_t t0 = (uint64_t)i * 60;
+        uint32_t id = (uint32_t)i + 1;
+        records.push_back(CarRecord(t0, id, JournalEventKind::CAR_SPAWNED, 0));
+        records.push_back(CarRecord(t0 + 600, id, JournalEventKind::CAR_STATE, 1));
+        records.push_back(SpotRecord(t0 + 720, 0, 0, 2));
+        records.push_back(CarRecord(t0 + 720, id, JournalEventKind::CAR_STATE, 2));
+        records.push_back(SpotRecord(t0 + 6720, 0, 2, 0));
+        records.push_back(CarRecord(t0 + 6720, id, JournalEventKind::CAR_STATE, 3));
+        records.push_back(CarRecord(t0 + 7200, id, JournalEventKind::CAR_REMOVED, 3));
+    }
+    std::stable_sort(records.begin(), records.end(),
+                     [](const JournalRecord &a, const JournalRecord &b) { return a.tick < b.tick; });
+    for (const auto &record : records)
+        writer->append(record);
+}
+} // namespace
+
+TEST(AnalyzerTests, StitchesTripsAcrossThreadRanges) {
+    std::string path = TempPath("parklogic_analyzer_test.plevj");
+    WriteJournal(path, 50);
+    auto reader = EventJournalReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->getRecords().size(), 350u);
+    ASSERT_EQ(reader->getFacilities().size(), 2u);
+
+    for (unsigned threads : {1u, 7u}) {
+        AnalyzerOptions options;
+        options.threads = threads;
+        options.bucketSeconds = 60.0;
+        Analyzer analyzer(options);
+        analyzer.analyzeJournal(*reader);
+
+        const LatencyHistogram &dwell = analyzer.trip(AnalyzerTrip::DWELL, 0);
+        EXPECT_EQ(dwell.count(), 50u) << threads << " threads";
+        EXPECT_NEAR(dwell.quantile(0.5), 100.0, 3.0);
+        EXPECT_EQ(analyzer.trip(AnalyzerTrip::TIME_ON_MAP, 0).count(), 50u);
+        EXPECT_NEAR(analyzer.trip(AnalyzerTrip::EXIT, 0).quantile(0.5), 8.0, 0.3);
+
+        // Arrivals at 12-61 s, departures at 112-161 s
+        ASSERT_EQ(analyzer.bucketCount(), 3u);
+        EXPECT_EQ(analyzer.bucket(0, 0).occupied, 48);
+        EXPECT_EQ(analyzer.bucket(1, 0).occupied, 42);
+        EXPECT_EQ(analyzer.bucket(1, 0).arrivals, 2u);
+        EXPECT_EQ(analyzer.bucket(1, 0).departures, 8u);
+        EXPECT_EQ(analyzer.bucket(analyzer.bucketCount() - 1, 0).occupied, 0);
+        EXPECT_EQ(analyzer.bucket(0, 1).occupied, 0);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(AnalyzerTests, FacilityIndicesAbove16BitsRoundTrip) {
+    std::string path = TempPath("parklogic_analyzer_wide.plevj");
+    const uint32_t wide = 40000; // Past int16_t, as on large generated grids
+    {
+        auto writer = EventJournalWriter::Open(path, 60.0, std::vector<JournalFacility>(wide + 1, {2, 4}));
+        ASSERT_NE(writer, nullptr);
+        writer->append(SpotRecord(10, wide, 0, 2));
+    }
+    auto reader = EventJournalReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(reader->getRecords().size(), 1u);
+    EXPECT_EQ(reader->getRecords()[0].facility, wide);
+
+    AnalyzerOptions options;
+    options.bucketSeconds = 60.0;
+    Analyzer analyzer(options);
+    analyzer.analyzeJournal(*reader);
+    ASSERT_EQ(analyzer.bucketCount(), 1u);
+    EXPECT_EQ(analyzer.bucket(0, wide).occupied, 1);
+    int occupied = 0;
+    for (uint32_t facility = 0; facility <= wide; ++facility)
+        occupied += analyzer.bucket(0, facility).occupied;
+    EXPECT_EQ(occupied, 1); // Counted once, against no other facility
+
+    reader.reset();
+    std::remove(path.c_str());
+}
+
+TEST(AnalyzerTests, HeatmapCountsSlowSamplesPerCell) {
+    std::string path = TempPath("parklogic_analyzer_test.pltraj");
+    {
+        auto writer = TrajectoryWriter::Open(path, 60.0, 6, 32);
+        ASSERT_NE(writer, nullptr);
+        for (uint64_t tick = 0; tick < 100; ++tick) {
+            writer->append({tick, 1, 2.0f, 2.0f, 0.1f, 0.0f, 0, 0, 0.0f});   // Queued in cell (0, 0)
+            writer->append({tick, 2, 12.0f, 7.0f, 10.0f, 0.0f, 0, 0, 0.0f}); // Moving in cell (2, 1)
+        }
+    }
+    auto reader = TrajectoryReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+
+    AnalyzerOptions options;
+    options.threads = 3;
+    Analyzer analyzer(options);
+    analyzer.analyzeTrajectories(*reader);
+
+    EXPECT_EQ(analyzer.heatCellCount(), 2u);
+    const Analyzer::HeatCell *queued = analyzer.heatCell(0, 0);
+    ASSERT_NE(queued, nullptr);
+    EXPECT_EQ(queued->samples, 100u);
+    EXPECT_EQ(queued->slowSamples, 100u);
+    const Analyzer::HeatCell *moving = analyzer.heatCell(2, 1);
+    ASSERT_NE(moving, nullptr);
+    EXPECT_EQ(moving->slowSamples, 0u);
+
+    std::ostringstream csv;
+    analyzer.writeHeatmapCsv(csv);
+    EXPECT_NE(csv.str().find("0,0,100,100,10\n"), std::string::npos); // 100 samples x 0.1 s
+
+    reader.reset();
+    std::remove(path.c_str());
+}
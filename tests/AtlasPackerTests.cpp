@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "core/AtlasPacker.hpp"
+#include <vector>
+
+namespace {
+bool overlaps(const AtlasPlacement &a, std::pair<int, int> sa, const AtlasPlacement &b, std::pair<int, int> sb) {
+    if (a.page != b.page)
+        return false;
+    return a.x < b.x + sb.first && b.x < a.x + sa.first && a.y < b.y + sb.second && b.y < a.y + sa.second;
+}
+} // namespace
+
+TEST(AtlasPackerTests, PlacementsAreDisjointAndInsidePage) {
+    std::vector<std::pair<int, int>> sizes = {{17, 31}, {32, 32}, {284, 155}, {436, 363}, {17, 31}, {274, 330}};
+    AtlasPacker packer(1024, 2);
+    auto placements = packer.pack(sizes);
+
+    ASSERT_EQ(placements.size(), sizes.size());
+    EXPECT_EQ(packer.getPageCount(), 1);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        EXPECT_EQ(placements[i].page, 0);
+        EXPECT_GE(placements[i].x, 2);
+        EXPECT_GE(placements[i].y, 2);
+        EXPECT_LE(placements[i].x + sizes[i].first, packer.getPageExtent(0).first);
+        EXPECT_LE(placements[i].y + sizes[i].second, packer.getPageExtent(0).second);
+        for (size_t j = i + 1; j < sizes.size(); ++j) {
+            EXPECT_FALSE(overlaps(placements[i], sizes[i], placements[j], sizes[j])) << i << " vs " << j;
+        }
+    }
+}
+
+TEST(AtlasPackerTests, SpillsToNewPageAndRejectsOversized) {
+    // A 128px page holds four 60px squares (two shelves of two)
+    std::vector<std::pair<int, int>> sizes = {{60, 60}, {60, 60}, {60, 60}, {60, 60}, {60, 60}, {200, 10}};
+    AtlasPacker packer(128, 0);
+    auto placements = packer.pack(sizes);
+
+    EXPECT_EQ(placements[5].page, -1);
+    EXPECT_EQ(packer.getPageCount(), 2);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(placements[i].page, 0);
+    }
+    EXPECT_EQ(placements[4].page, 1);
+    EXPECT_FALSE(overlaps(placements[0], sizes[0], placements[2], sizes[2]));
+}
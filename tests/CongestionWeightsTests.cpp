@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "config.hpp"
+#include "core/CongestionWeights.hpp"
+#include "entities/Car.hpp"
+#include "raymath.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+std::unique_ptr<Car> CarOnEdge(const RoadGraph &graph, uint32_t from, uint32_t edge, float speed) {
+    Vector2 a = graph.getNodePosition(from);
+    Vector2 b = graph.getNodePosition(graph.getEdgeTarget(edge));
+    Vector2 heading = Vector2Normalize(Vector2Subtract(b, a));
+    return std::make_unique<Car>(Vector2Lerp(a, b, 0.5f), nullptr, Vector2Scale(heading, speed),
+                                 Car::CarType::COMBUSTION);
+}
+} // namespace
+
+TEST(CongestionWeightsTests, SlowCarsRaiseEdgeCostUntilTheyLeave) {
+    GeneratedMap map = GridMap(2, 10);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    CongestionWeights weights;
+    weights.reset(graph);
+
+    uint32_t from = 0;
+    uint32_t edge = LongestEdge(graph, from);
+    ASSERT_NE(edge, RoadGraph::NO_EDGE);
+    const float freeFlow = graph.getEdgeLength(edge) / Config::ROUTE_FREE_FLOW_SPEED;
+    EXPECT_FLOAT_EQ(weights.getCost(edge), freeFlow);
+
+    std::vector<std::unique_ptr<Car>> cars;
+    cars.push_back(CarOnEdge(graph, from, edge, 2.0f));
+    for (int i = 0; i < 600; ++i)
+        weights.update(1.0 / 60.0, cars);
+    EXPECT_EQ(weights.getCarEdge(cars[0]->getId()), edge);
+    EXPECT_GT(weights.getCost(edge), 2.0f * freeFlow);
+    EXPECT_EQ(weights.getActiveEdgeCount(), 1u);
+
+    // A stopped car is still matched by position and pins the edge at the minimum speed
+    cars[0]->setVelocity({0.0f, 0.0f});
+    for (int i = 0; i < 3600; ++i)
+        weights.update(1.0 / 60.0, cars);
+    EXPECT_FLOAT_EQ(weights.getCost(edge), graph.getEdgeLength(edge) / Config::ROUTE_MIN_SPEED);
+
+    // Once the queue is gone the edge recovers to free flow and drops out of the update
+    weights.removeCar(cars[0]->getId());
+    cars.clear();
+    for (int i = 0; i < 60 * 120; ++i)
+        weights.update(1.0 / 60.0, cars);
+    EXPECT_FLOAT_EQ(weights.getCost(edge), freeFlow);
+    EXPECT_EQ(weights.getActiveEdgeCount(), 0u);
+}
+
+TEST(CongestionWeightsTests, WeightedRouteAvoidsCongestedEdge) {
+    GeneratedMap map = GridMap(3, 60); // Wide enough for several cross streets per row
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    CongestionWeights weights;
+    weights.reset(graph);
+
+    // Free flow costs are proportional to length, so the weighted search agrees with plain A*
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> shortest;
+    std::vector<uint32_t> weighted;
+    const uint32_t start = graph.getEntries()[0].node;
+    const uint32_t goals[] = {graph.getExits().back().node};
+    ASSERT_TRUE(graph.findRouteAStar(start, goals, scratch, shortest));
+    ASSERT_TRUE(graph.findRouteWeighted(start, goals, weights.getCosts(), CongestionWeights::GetMinCostPerMeter(),
+                                        scratch, weighted));
+    EXPECT_EQ(weighted, shortest);
+
+    // Jam the cross street the route changes rows on; a neighbouring cross street is the detour
+    uint32_t jammed = RoadGraph::NO_EDGE;
+    uint32_t jammedFrom = 0;
+    float longestDrop = 0.0f;
+    for (size_t i = 1; i < shortest.size(); ++i) {
+        uint32_t e = graph.findEdge(shortest[i - 1], shortest[i]);
+        ASSERT_NE(e, RoadGraph::NO_EDGE);
+        float drop = std::fabs(graph.getNodePosition(shortest[i]).y - graph.getNodePosition(shortest[i - 1]).y);
+        if (drop > longestDrop) {
+            longestDrop = drop;
+            jammed = e;
+            jammedFrom = shortest[i - 1];
+        }
+    }
+    ASSERT_NE(jammed, RoadGraph::NO_EDGE);
+    std::vector<std::unique_ptr<Car>> cars;
+    cars.push_back(CarOnEdge(graph, jammedFrom, jammed, 0.0f));
+    for (int i = 0; i < 60 * 60; ++i)
+        weights.update(1.0 / 60.0, cars);
+
+    ASSERT_TRUE(graph.findRouteWeighted(start, goals, weights.getCosts(), CongestionWeights::GetMinCostPerMeter(),
+                                        scratch, weighted));
+    float jammedCost = 0.0f;
+    float detourCost = 0.0f;
+    bool usesJam = false;
+    for (size_t i = 1; i < shortest.size(); ++i)
+        jammedCost += weights.getCost(graph.findEdge(shortest[i - 1], shortest[i]));
+    for (size_t i = 1; i < weighted.size(); ++i) {
+        uint32_t e = graph.findEdge(weighted[i - 1], weighted[i]);
+        usesJam = usesJam || e == jammed;
+        detourCost += weights.getCost(e);
+    }
+    EXPECT_LE(detourCost, jammedCost);
+    EXPECT_FALSE(usesJam);
+
+    // Costs of the wrong size are rejected rather than read out of bounds
+    std::vector<float> wrongSize(graph.getEdgeCount() + 1, 1.0f);
+    EXPECT_FALSE(graph.findRouteWeighted(start, goals, wrongSize, 1.0f, scratch, weighted));
+}
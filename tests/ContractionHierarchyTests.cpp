@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "entities/map/ContractionHierarchy.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+bool IsConnected(const RoadGraph &graph, const std::vector<uint32_t> &route) {
+    for (size_t i = 1; i < route.size(); ++i) {
+        auto [begin, end] = graph.getEdgeRange(route[i - 1]);
+        bool found = false;
+        for (uint32_t e = begin; e < end && !found; ++e)
+            found = graph.getEdgeTarget(e) == route[i];
+        if (!found)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+TEST(ContractionHierarchyTests, MatchesAStarOnEveryEntryAndEntrance) {
+    GeneratedMap map = GridMap(4, 15);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    auto hierarchy = ContractionHierarchy::Build(graph);
+    ASSERT_EQ(hierarchy->getNodeCount(), graph.getNodeCount());
+
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> actual;
+    int routes = 0;
+    for (const auto &entry : graph.getEntries()) {
+        for (const auto &mod : map.modules) {
+            auto [east, west] = graph.getEntranceNodes(mod.get());
+            if (east == RoadGraph::NO_NODE)
+                continue;
+            const uint32_t goals[] = {east, west};
+            bool a = graph.findRouteAStar(entry.node, goals, scratch, expected);
+            bool h = hierarchy->findRoute(entry.node, goals, scratch, actual);
+            ASSERT_EQ(a, h);
+            if (!a)
+                continue;
+            ++routes;
+            EXPECT_EQ(actual.front(), entry.node);
+            EXPECT_TRUE(actual.back() == east || actual.back() == west);
+            EXPECT_TRUE(IsConnected(graph, actual)) << "Shortcut expanded into a non-existent edge";
+            EXPECT_NEAR(graph.getRouteLength(actual), graph.getRouteLength(expected), 1e-2f);
+        }
+    }
+    EXPECT_GT(routes, 0);
+
+    // Exits are reachable the same way; a route from a node to itself is just that node
+    const uint32_t self[] = {graph.getEntries()[0].node};
+    ASSERT_TRUE(hierarchy->findRoute(self[0], self, scratch, actual));
+    EXPECT_EQ(actual.size(), 1u);
+}
+
+TEST(ContractionHierarchyTests, AttachedHierarchyAnswersFindRoute) {
+    GeneratedMap map = GridMap(3, 10);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    graph.setHierarchy(ContractionHierarchy::Build(graph));
+
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> viaHierarchy;
+    std::vector<uint32_t> viaAStar;
+    const uint32_t start = graph.getEntries()[0].node;
+    const uint32_t goals[] = {graph.getExits().back().node};
+    bool a = graph.findRouteAStar(start, goals, scratch, viaAStar);
+    size_t aStarSettled = scratch.lastSettled;
+    ASSERT_EQ(graph.findRoute(start, goals, scratch, viaHierarchy), a);
+    if (a) {
+        EXPECT_NEAR(graph.getRouteLength(viaHierarchy), graph.getRouteLength(viaAStar), 1e-2f);
+        EXPECT_LE(scratch.lastSettled, aStarSettled);
+    }
+}
+
+TEST(ContractionHierarchyTests, SavedHierarchyOnlyLoadsForItsOwnMap) {
+    GeneratedMap map = GridMap(2, 8);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    auto built = ContractionHierarchy::Build(graph);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "parklogic_ch_test.plch").string();
+    ASSERT_TRUE(built->save(path));
+    auto loaded = ContractionHierarchy::Load(path, graph);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getArcCount(), built->getArcCount());
+    EXPECT_EQ(loaded->getFingerprint(), graph.getFingerprint());
+
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> a;
+    std::vector<uint32_t> b;
+    for (const auto &entry : graph.getEntries()) {
+        const uint32_t goals[] = {graph.getExits()[0].node};
+        ASSERT_EQ(built->findRoute(entry.node, goals, scratch, a), loaded->findRoute(entry.node, goals, scratch, b));
+        EXPECT_EQ(a, b);
+    }
+
+    GeneratedMap other = GridMap(3, 8);
+    RoadGraph otherGraph = RoadGraph::Build(other.modules);
+    EXPECT_EQ(ContractionHierarchy::Load(path, otherGraph), nullptr);
+
+    // A damaged arc count must be rejected before it sizes an allocation
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t arcCount = 0xFFFFFFFFu;
+        file.seekp(28); // FileHeader::arcCount
+        file.write(reinterpret_cast<const char *>(&arcCount), sizeof(arcCount));
+    }
+    EXPECT_EQ(ContractionHierarchy::Load(path, graph), nullptr);
+    std::remove(path.c_str());
+    EXPECT_EQ(ContractionHierarchy::Load(path, graph), nullptr);
+}
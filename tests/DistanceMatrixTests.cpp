@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "entities/map/DistanceMatrix.hpp"
+#include <vector>
+
+TEST(DistanceMatrixTests, EntryRowsMatchRouteLengths) {
+    GeneratedMap map = GridMap(3);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    DistanceMatrix matrix;
+    matrix.reset(graph, map.modules);
+    ASSERT_EQ(matrix.getColumnCount(), 40u);
+
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> route;
+    for (const auto &entry : graph.getEntries()) {
+        std::span<const float> row = matrix.getRow(entry.node);
+        ASSERT_EQ(row.size(), matrix.getColumnCount());
+        for (size_t c = 0; c < row.size(); ++c) {
+            auto [east, west] = graph.getEntranceNodes(matrix.getFacilities()[c]->getParent());
+            const uint32_t goals[] = {east, west};
+            if (graph.findRouteAStar(entry.node, goals, scratch, route))
+                EXPECT_NEAR(row[c], graph.getRouteLength(route), 1e-2f) << "entry " << entry.node << " column " << c;
+            else
+                EXPECT_EQ(row[c], DistanceMatrix::UNREACHABLE);
+        }
+    }
+    EXPECT_EQ(matrix.getRowCount(), graph.getEntries().size());
+
+    // Rows are computed once; asking again does not add one
+    matrix.getRow(graph.getEntries()[0].node);
+    EXPECT_EQ(matrix.getRowCount(), graph.getEntries().size());
+    EXPECT_TRUE(matrix.getRow(RoadGraph::NO_NODE).empty());
+}
+
+TEST(DistanceMatrixTests, FacilityExitRowsAreAddedOnDemand) {
+    GeneratedMap map = GridMap(2);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    DistanceMatrix matrix;
+    matrix.reset(graph, map.modules);
+
+    // Roads have no column; facilities do
+    int roads = 0;
+    for (const auto &mod : map.modules) {
+        if (mod->getSpotCount() == 0) {
+            EXPECT_EQ(matrix.getColumn(mod.get()), -1);
+            roads++;
+        }
+    }
+    EXPECT_GT(roads, 0);
+
+    // From a facility's own gate, that facility (and its road neighbours) are at distance zero
+    const Module *facility = matrix.getFacilities().front();
+    auto [east, west] = graph.getEntranceNodes(facility->getParent());
+    std::span<const float> fromExit = matrix.getRow(east);
+    EXPECT_EQ(matrix.getRowCount(), 1u);
+    EXPECT_FLOAT_EQ(fromExit[matrix.getColumn(facility)], 0.0f);
+    for (float d : fromExit)
+        EXPECT_GE(d, 0.0f);
+
+    // The other lane's gate is a separate row
+    matrix.addRows(std::vector<uint32_t>{east, west});
+    EXPECT_EQ(matrix.getRowCount(), 2u);
+}
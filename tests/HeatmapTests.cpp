@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "core/EventBus.hpp"
+#include "events/GameEvents.hpp"
+#include "systems/HeatmapSystem.hpp"
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace {
+const std::vector<std::unique_ptr<Car>> NO_CARS;
+}
+
+TEST(HeatmapTests, AccumulatesDwellIntoCells) {
+    auto bus = std::make_shared<EventBus>();
+    HeatmapSystem heatmap(bus, 2.0f);
+    heatmap.setHalfLife(0.0);
+    bus->publish(WorldBoundsEvent{10.0f, 5.0f});
+
+    auto grid = heatmap.getGrid();
+    EXPECT_EQ(grid->width, 5);
+    EXPECT_EQ(grid->height, 3);
+
+    heatmap.addDwell({3.0f, 1.0f}, 0.5);
+    heatmap.addDwell({3.9f, 1.9f}, 0.25);
+    heatmap.addDwell({50.0f, 1.0f}, 1.0); // Off the map
+    EXPECT_FLOAT_EQ(heatmap.valueAt(1, 0), 0.75f);
+    EXPECT_FLOAT_EQ(heatmap.valueAt(0, 0), 0.0f);
+
+    std::ostringstream csv;
+    heatmap.writeCsv(csv);
+    EXPECT_EQ(csv.str(), "x,y,slow_seconds\n2,0,0.75\n");
+}
+
+TEST(HeatmapTests, DecaysLazilyByHalfLife) {
+    auto bus = std::make_shared<EventBus>();
+    HeatmapSystem heatmap(bus, 1.0f);
+    heatmap.setHalfLife(10.0);
+    bus->publish(WorldBoundsEvent{4.0f, 4.0f});
+
+    heatmap.addDwell({0.5f, 0.5f}, 8.0);
+    heatmap.update(10.0, 0.0, NO_CARS);
+    EXPECT_NEAR(heatmap.valueAt(0, 0), 4.0f, 1e-4);
+
+    // Time added now counts fully; the weight grows past the renormalization threshold on the way
+    heatmap.addDwell({0.5f, 0.5f}, 4.0);
+    heatmap.update(200.0, 0.0, NO_CARS);
+    EXPECT_NEAR(heatmap.valueAt(0, 0), 8.0f * std::exp2(-19.0f), 1e-6);
+}
+
+TEST(HeatmapTests, RepublishesOnlyWhenChangedAndReset) {
+    auto bus = std::make_shared<EventBus>();
+    HeatmapSystem heatmap(bus, 1.0f);
+    heatmap.setHalfLife(0.0);
+    bus->publish(WorldBoundsEvent{4.0f, 4.0f});
+
+    auto first = heatmap.getGrid();
+    heatmap.addDwell({1.5f, 2.5f}, 1.0);
+    heatmap.update(0.2, 0.0, NO_CARS);
+    EXPECT_EQ(heatmap.getGrid(), first); // Changed, but published too recently
+
+    heatmap.update(1.0, 0.0, NO_CARS);
+    auto second = heatmap.getGrid();
+    ASSERT_NE(second, first);
+    EXPECT_GT(second->version, first->version);
+    EXPECT_FLOAT_EQ(second->at(1, 2), 1.0f);
+    EXPECT_FLOAT_EQ(second->maxValue, 1.0f);
+
+    heatmap.update(5.0, 0.0, NO_CARS);
+    EXPECT_EQ(heatmap.getGrid(), second); // Nothing changed
+
+    bus->publish(ResetHeatmapEvent{});
+    auto cleared = heatmap.getGrid();
+    EXPECT_FLOAT_EQ(cleared->maxValue, 0.0f);
+
+    bus->publish(CycleHeatmapDecayEvent{});
+    EXPECT_DOUBLE_EQ(heatmap.getHalfLife(), 60.0);
+}
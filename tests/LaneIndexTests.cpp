@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "core/LaneIndex.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+/**
+ * @brief Cars placed along one lane edge.
+ */
+struct LaneCars {
+    Vector2 a;
+    Vector2 b;
+    std::vector<std::unique_ptr<Car>> cars{};
+
+    Car *add(uint32_t id, float t, float speed) {
+        Vector2 heading = Vector2Normalize(Vector2Subtract(b, a));
+        cars.push_back(std::make_unique<Car>(Vector2Lerp(a, b, t), nullptr, Vector2Scale(heading, speed),
+                                             Car::CarType::COMBUSTION));
+        cars.back()->setId(id);
+        return cars.back().get();
+    }
+};
+
+/**
+ * @brief One tick of car updates, with the neighbor lists EntityManager hands out.
+ */
+void Step(LaneIndex &index, const std::vector<std::unique_ptr<Car>> &cars, double dt) {
+    index.update(cars);
+    for (const auto &car : cars) {
+        std::vector<const Car *> neighbors;
+        index.appendNeighbors(*car, neighbors);
+        car->updateWithNeighbors(dt, neighbors);
+    }
+}
+} // namespace
+
+TEST(LaneIndexTests, LeadersFollowTheDrivingOrder) {
+    GeneratedMap map = GridMap(2, 6);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    uint32_t from = 0;
+    uint32_t edge = LongestEdge(graph, from);
+    ASSERT_NE(edge, RoadGraph::NO_EDGE);
+    LaneCars lane{graph.getNodePosition(from), graph.getNodePosition(graph.getEdgeTarget(edge))};
+
+    // Listed out of driving order
+    Car *middle = lane.add(1, 0.5f, 1.0f);
+    Car *front = lane.add(2, 0.6f, 1.0f);
+    Car *rear = lane.add(3, 0.1f, 14.0f);
+
+    LaneIndex index;
+    index.reset(graph);
+    index.update(lane.cars);
+    uint32_t laneId = index.getLane(*rear);
+    ASSERT_NE(laneId, RoadGraph::NO_LANE);
+    EXPECT_EQ(index.getLane(*middle), laneId);
+    EXPECT_EQ(index.getLaneCars(laneId), (std::vector<const Car *>{rear, middle, front}));
+    EXPECT_EQ(index.getLeader(*rear), middle);
+    EXPECT_EQ(index.getLeader(*middle), front);
+    EXPECT_EQ(index.getLeader(*front), nullptr);
+    EXPECT_EQ(index.getFollower(*front), middle);
+    EXPECT_EQ(index.getFollower(*rear), nullptr);
+    EXPECT_TRUE(index.getOffLaneCars().empty());
+
+    // The fast rear car overtakes the others; the lane list is re-sorted
+    rear->addWaypoint(Waypoint(lane.b));
+    for (int tick = 0; tick < 600 && Vector2Distance(rear->getPosition(), lane.a) <
+                                          Vector2Distance(front->getPosition(), lane.a) + 1.0f;
+         ++tick) {
+        for (auto &car : lane.cars)
+            car->update(1.0 / 60.0);
+    }
+    index.update(lane.cars);
+    EXPECT_EQ(index.getLaneCars(laneId), (std::vector<const Car *>{middle, front, rear}));
+    EXPECT_EQ(index.getLeader(*front), rear);
+
+    // A removed car drops out of the list
+    std::erase_if(lane.cars, [front](const auto &car) { return car.get() == front; });
+    index.update(lane.cars);
+    EXPECT_EQ(index.getLeader(*middle), rear);
+    EXPECT_EQ(index.getFollower(*rear), middle);
+}
+
+TEST(LaneIndexTests, CarsOffTheRoadsAreListedSeparately) {
+    GeneratedMap map = GridMap(2, 6);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    uint32_t from = 0;
+    uint32_t edge = LongestEdge(graph, from);
+    ASSERT_NE(edge, RoadGraph::NO_EDGE);
+    LaneCars lane{graph.getNodePosition(from), graph.getNodePosition(graph.getEdgeTarget(edge))};
+
+    Car *onRoad = lane.add(1, 0.5f, 5.0f);
+    Car *parked = lane.add(2, 0.7f, 5.0f);
+    parked->setState(Car::CarState::PARKED);
+    // Sideways across the lane, as when turning into a facility
+    Vector2 across = {-(lane.b.y - lane.a.y), lane.b.x - lane.a.x};
+    lane.cars.push_back(std::make_unique<Car>(Vector2Lerp(lane.a, lane.b, 0.6f), nullptr,
+                                              Vector2Scale(Vector2Normalize(across), 5.0f), Car::CarType::COMBUSTION));
+    Car *turning = lane.cars.back().get();
+    turning->setId(3);
+
+    LaneIndex index;
+    index.reset(graph);
+    index.update(lane.cars);
+    EXPECT_NE(index.getLane(*onRoad), RoadGraph::NO_LANE);
+    EXPECT_EQ(index.getLane(*parked), RoadGraph::NO_LANE);
+    EXPECT_EQ(index.getLane(*turning), RoadGraph::NO_LANE);
+    EXPECT_EQ(index.getLeader(*onRoad), nullptr);
+    EXPECT_EQ(index.getOffLaneCars(), (std::vector<const Car *>{turning}));
+}
+
+TEST(LaneIndexTests, NeighborsComeFromTheCarsSurroundings) {
+    GeneratedMap map = GridMap(2, 6);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    uint32_t from = 0;
+    uint32_t edge = LongestEdge(graph, from);
+    ASSERT_NE(edge, RoadGraph::NO_EDGE);
+    LaneCars lane{graph.getNodePosition(from), graph.getNodePosition(graph.getEdgeTarget(edge))};
+    Vector2 heading = Vector2Normalize(Vector2Subtract(lane.b, lane.a));
+    Vector2 across = {-heading.y, heading.x};
+
+    Car *driving = lane.add(1, 0.2f, 5.0f);
+    Car *leader = lane.add(2, 0.8f, 5.0f);
+    // Off-lane cars crossing the lane: one just ahead of the driving car, one far down the road
+    auto addCrossing = [&](uint32_t id, Vector2 position) {
+        lane.cars.push_back(std::make_unique<Car>(position, nullptr, Vector2Scale(across, 3.0f),
+                                                  Car::CarType::COMBUSTION));
+        lane.cars.back()->setId(id);
+        return lane.cars.back().get();
+    };
+    Vector2 start = driving->getPosition();
+    Car *ahead = addCrossing(3, Vector2Add(start, Vector2Scale(heading, 6.0f)));
+    Car *beside = addCrossing(4, Vector2Subtract(start, Vector2Scale(heading, 4.0f)));
+    Car *far = addCrossing(5, Vector2Lerp(lane.a, lane.b, 0.95f));
+    ASSERT_GT(Vector2Distance(start, far->getPosition()), 60.0f);
+
+    LaneIndex index;
+    index.reset(graph);
+    index.update(lane.cars);
+    ASSERT_NE(index.getLane(*driving), RoadGraph::NO_LANE);
+    ASSERT_EQ(index.getOffLaneCars().size(), 3u);
+    auto contains = [](const std::vector<const Car *> &cars, const Car *car) {
+        return std::find(cars.begin(), cars.end(), car) != cars.end();
+    };
+
+    // On the lane: the leader and the off-lane cars around the corridor ahead, nothing far away
+    std::vector<const Car *> neighbors;
+    index.appendNeighbors(*driving, neighbors);
+    EXPECT_EQ(neighbors.front(), leader);
+    EXPECT_TRUE(contains(neighbors, ahead));
+    EXPECT_FALSE(contains(neighbors, far));
+
+    // Off the lane: the cars around it, on a lane or not
+    neighbors.clear();
+    index.appendNeighbors(*ahead, neighbors);
+    EXPECT_TRUE(contains(neighbors, driving));
+    EXPECT_TRUE(contains(neighbors, beside));
+    EXPECT_FALSE(contains(neighbors, far));
+}
+
+TEST(LaneIndexTests, CrossStreetCarsYieldAtJunctions) {
+    GeneratedMap map = GridMap(3, 60); // Wide enough for cross streets between the rows
+    RoadGraph graph = RoadGraph::Build(map.modules);
+
+    // A northbound cross street and the eastbound lane it turns onto
+    uint32_t crossLane = RoadGraph::NO_LANE;
+    uint32_t rowNode = RoadGraph::NO_NODE;
+    for (uint32_t lane = 0; lane < (uint32_t)graph.getLaneCount() && rowNode == RoadGraph::NO_NODE; ++lane) {
+        if (graph.getLaneDirection(lane).y != -1.0f)
+            continue;
+        auto [begin, end] = graph.getEdgeRange(graph.getLaneNodes(lane).second - 1);
+        for (uint32_t e = begin; e < end; ++e) {
+            uint32_t target = graph.getEdgeTarget(e);
+            if (graph.getLaneDirection(graph.getNodeLane(target)).x == 1.0f) {
+                crossLane = lane;
+                rowNode = target;
+            }
+        }
+    }
+    ASSERT_NE(rowNode, RoadGraph::NO_NODE);
+    Vector2 junction = graph.getNodePosition(graph.getLaneNodes(crossLane).second - 1);
+    Vector2 row = graph.getNodePosition(rowNode);
+
+    // Both reach the junction at about the same time
+    std::vector<std::unique_ptr<Car>> cars;
+    cars.push_back(std::make_unique<Car>(Vector2{junction.x, junction.y + 15.0f}, nullptr, Vector2{0, -8.0f},
+                                         Car::CarType::COMBUSTION));
+    Car *crossing = cars.back().get();
+    crossing->setId(1);
+    crossing->addWaypoint(Waypoint(junction));
+    crossing->addWaypoint(Waypoint(row));
+    crossing->addWaypoint(Waypoint({row.x + 40.0f, row.y}));
+    cars.push_back(std::make_unique<Car>(Vector2{row.x - 40.0f, row.y}, nullptr, Vector2{8.0f, 0},
+                                         Car::CarType::COMBUSTION));
+    Car *through = cars.back().get();
+    through->setId(2);
+    through->addWaypoint(Waypoint({row.x + 60.0f, row.y}));
+
+    LaneIndex index;
+    index.reset(graph);
+    bool watched = false;
+    float closest = INFINITY;
+    float slowest = INFINITY;
+    for (int tick = 0; tick < 400; ++tick) {
+        Step(index, cars, 1.0 / 60.0);
+        // Still on its own lane, the cross-street car already watches the row car coming up to the junction
+        std::vector<const Car *> neighbors;
+        index.appendNeighbors(*crossing, neighbors);
+        if (index.getLane(*crossing) == crossLane && index.getLane(*through) != RoadGraph::NO_LANE)
+            watched = watched || std::find(neighbors.begin(), neighbors.end(), through) != neighbors.end();
+        closest = std::min(closest, Vector2Distance(crossing->getPosition(), through->getPosition()));
+        if (through->getPosition().x < crossing->getPosition().x) // Until the row car is past
+            slowest = std::min(slowest, Vector2Length(crossing->getVelocity()));
+    }
+    EXPECT_TRUE(watched);
+    // The cross-street car waits for the row car instead of driving into it
+    EXPECT_LT(slowest, 1.0f);
+    EXPECT_GT(closest, 2.5f);
+    EXPECT_GT(crossing->getPosition().x, row.x + 10.0f);
+}
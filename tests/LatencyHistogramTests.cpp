@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "core/LatencyHistogram.hpp"
+#include "core/TripLatencies.hpp"
+#include <sstream>
+
+TEST(LatencyHistogramTests, QuantilesWithinBucketError) {
+    LatencyHistogram h;
+    for (int i = 1; i <= 1000; ++i) {
+        h.record(i * 0.1); // 0.1 s .. 100 s
+    }
+
+    EXPECT_EQ(h.count(), 1000u);
+    EXPECT_NEAR(h.quantile(0.50), 50.0, 50.0 * 0.04);
+    EXPECT_NEAR(h.quantile(0.99), 99.0, 99.0 * 0.04);
+    EXPECT_DOUBLE_EQ(h.max(), 100.0);
+    EXPECT_NEAR(h.mean(), 50.05, 1e-9);
+}
+
+TEST(LatencyHistogramTests, BucketBoundsAreConsistent) {
+    for (double v : {0.001, 0.0123, 1.0, 1.5, 37.0, 3599.0, 86400.0}) {
+        size_t b = LatencyHistogram::BucketIndex(v);
+        EXPECT_LE(LatencyHistogram::BucketLowerBound(b), v);
+        EXPECT_GT(LatencyHistogram::BucketLowerBound(b + 1), v);
+    }
+    EXPECT_EQ(LatencyHistogram::BucketIndex(0.0), 0u);
+    EXPECT_EQ(LatencyHistogram::BucketIndex(1e12), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTests, MergeEqualsRecordingEverything) {
+    LatencyHistogram a, b, all;
+    for (int i = 1; i <= 100; ++i) {
+        (i % 2 ? a : b).record(i);
+        all.record(i);
+    }
+    a.merge(b);
+
+    EXPECT_EQ(a.count(), all.count());
+    EXPECT_DOUBLE_EQ(a.quantile(0.95), all.quantile(0.95));
+    EXPECT_DOUBLE_EQ(a.min(), 1.0);
+    EXPECT_DOUBLE_EQ(a.max(), 100.0);
+}
+
+TEST(TripLatenciesTests, BucketCsvRoundTripMerges) {
+    TripLatencies run1, run2;
+    for (int i = 1; i <= 50; ++i) {
+        run1.record(TripMetric::DWELL, Car::CarType::ELECTRIC, Car::Priority::PRIORITY_PRICE, i * 2.0);
+        run2.record(TripMetric::DWELL, Car::CarType::COMBUSTION, Car::Priority::PRIORITY_DISTANCE, i * 4.0);
+    }
+
+    std::stringstream exported;
+    run2.writeBucketsCsv(exported);
+    TripLatencies merged = run1;
+    ASSERT_TRUE(merged.readBucketsCsv(exported));
+
+    EXPECT_EQ(merged.combined(TripMetric::DWELL).count(), 100u);
+    EXPECT_EQ(merged.at(TripMetric::DWELL, Car::CarType::COMBUSTION, Car::Priority::PRIORITY_DISTANCE).count(), 50u);
+    EXPECT_NEAR(merged.at(TripMetric::DWELL, Car::CarType::COMBUSTION, Car::Priority::PRIORITY_DISTANCE).quantile(0.5),
+                run2.at(TripMetric::DWELL, Car::CarType::COMBUSTION, Car::Priority::PRIORITY_DISTANCE).quantile(0.5),
+                1e-9);
+    EXPECT_EQ(merged.summarize()[TripMetric::SEARCH].count, 0u);
+}
@@ -5,6 +5,7 @@
 #include "entities/map/Waypoint.hpp"
 #include "entities/map/Modules.hpp"   // Necessary to work with Modules
 #include "systems/PathPlanner.hpp"    // Necessary to work with PathPlanner
+#include "systems/StatsSystem.hpp"
 #include "systems/TrafficSystem.hpp"
 #include "events/GameEvents.hpp"
 #include "core/EventBus.hpp"
@@ -166,6 +167,57 @@ TEST(TrafficSystemTest, PassThroughFallback) {
     // Waypoints are private in Car, but we can check hasArrived()
 }
 
+// --- Test Suite 5: StatsSystem Logic ---
+
+TEST(StatsSystemTest, TracksSpotsIncrementally) {
+    auto bus = std::make_shared<EventBus>();
+    EntityManager em(bus);
+    auto parking = std::make_unique<SmallParking>(true);
+    Module* lot = parking.get();
+    em.addModule(std::move(parking));
+
+    StatsSystem stats(bus, em);
+    bus->publish(WorldBoundsEvent{100.0f, 100.0f}); // Initial full scan
+
+    int spots = (int)lot->getSpotCount();
+    ASSERT_GT(spots, 0);
+    EXPECT_EQ(stats.getStats().parking().facilities, 1);
+    EXPECT_EQ(stats.getStats().parking().free, spots);
+
+    SpotState prev = lot->setSpotState(0, SpotState::OCCUPIED);
+    bus->publish(SpotStateChangedEvent{lot, 0, prev, SpotState::OCCUPIED});
+
+    const FacilityStats p = stats.getStats().parking();
+    EXPECT_EQ(p.occupied, 1);
+    EXPECT_EQ(p.free, spots - 1);
+    EXPECT_EQ(p.occupied, lot->getSpotCounts().occupied);
+    EXPECT_EQ(stats.getStats().charging().totalSpots, 0);
+}
+
+TEST(StatsSystemTest, TracksCarStates) {
+    auto bus = std::make_shared<EventBus>();
+    EntityManager em(bus);
+    StatsSystem stats(bus, em);
+
+    auto car = std::make_unique<Car>(Vector2{0, 0}, nullptr, Vector2{15, 0}, Car::CarType::COMBUSTION);
+    Car* carPtr = car.get();
+    em.addCar(std::move(car));
+    bus->publish(CarSpawnedEvent{carPtr});
+
+    EXPECT_EQ(stats.getStats().activeCars, 1);
+    EXPECT_EQ(stats.getStats().cars(Car::CarState::DRIVING), 1);
+
+    carPtr->setState(Car::CarState::PARKED);
+    bus->publish(CarStateChangedEvent{carPtr});
+    EXPECT_EQ(stats.getStats().cars(Car::CarState::DRIVING), 0);
+    EXPECT_EQ(stats.getStats().cars(Car::CarState::PARKED), 1);
+
+    bus->publish(CarDeletedEvent{carPtr});
+    EXPECT_EQ(stats.getStats().activeCars, 0);
+    EXPECT_EQ(stats.getStats().cars(Car::CarState::PARKED), 0);
+    EXPECT_EQ(stats.getStats().totalRemoved, 1u);
+}
+
 #include "core/AssetManager.hpp"
 
 // --- Main ---
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "core/MetricsStore.hpp"
+#include "core/RingBuffer.hpp"
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+TEST(RingBufferTests, OverwritesOldestWhenFull) {
+    RingBuffer<int> ring(3);
+    for (int i = 1; i <= 5; ++i) {
+        ring.push(i);
+    }
+
+    ASSERT_EQ(ring.size(), 3u);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring[0], 3);
+    EXPECT_EQ(ring[1], 4);
+    EXPECT_EQ(ring.newest(), 5);
+}
+
+TEST(MetricsStoreTests, DownsamplesIntoMinuteBuckets) {
+    MetricsConfig config;
+    config.sampleInterval = 1.0;
+    MetricsStore store(config);
+
+    // Two full minutes of samples: cars_parked is 0 in the first minute, 10 in the second
+    for (int t = 1; t <= 120; ++t) {
+        MetricsSample s;
+        s.simTime = t;
+        s[Metric::CARS_PARKED] = t <= 60 ? 0.0f : 10.0f;
+        store.record(s);
+    }
+
+    const auto &tiers = store.getTiers();
+    ASSERT_EQ(tiers.size(), 3u);
+    EXPECT_EQ(tiers[0].rows.size(), 119u); // The last second is still the open bucket
+    ASSERT_EQ(tiers[1].rows.size(), 1u);
+    EXPECT_FLOAT_EQ(tiers[1].rows[0][Metric::CARS_PARKED], 0.0f);
+    EXPECT_DOUBLE_EQ(tiers[1].rows[0].simTime, 60.0);
+    EXPECT_EQ(tiers[1].pendingCount, 60);
+}
+
+TEST(MetricsStoreTests, MemoryStaysBounded) {
+    MetricsConfig config;
+    config.secondCapacity = 10;
+    config.downsample = false;
+    MetricsStore store(config);
+
+    for (int t = 1; t <= 1000; ++t) {
+        MetricsSample s;
+        s.simTime = t;
+        store.record(s);
+    }
+
+    ASSERT_EQ(store.getTiers().size(), 1u);
+    EXPECT_EQ(store.getTiers()[0].rows.size(), 10u);
+    EXPECT_DOUBLE_EQ(store.getTiers()[0].rows[0].simTime, 990.0);
+}
+
+TEST(MetricsStoreTests, CsvHasHeaderAndOneRowPerBucket) {
+    MetricsConfig config;
+    config.downsample = false;
+    MetricsStore store(config);
+    for (int t = 1; t <= 3; ++t) {
+        MetricsSample s;
+        s.simTime = t;
+        store.record(s);
+    }
+
+    std::ostringstream out;
+    store.writeCsv(out, 0);
+    std::string csv = out.str();
+
+    EXPECT_EQ(csv.rfind("sim_time,occupancy_small_parking", 0), 0u);
+    EXPECT_EQ(std::count(csv.begin(), csv.end(), '\n'), 4); // Header + 2 closed + 1 open bucket
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "core/OpenMetricsExporter.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(OpenMetricsExporterTests, FormatIsValidExposition) {
+    TelemetrySample sample;
+    sample.ticks = 600;
+    sample.stats.carsByState[0] = 3;
+    sample.stats.byType[(size_t)ModuleType::SMALL_PARKING] = {1, 10, 7, 1, 2};
+
+    std::ostringstream out;
+    OpenMetricsExporter::Format(out, sample, {});
+    std::string text = out.str();
+
+    EXPECT_NE(text.find("parklogic_ticks_total 600\n"), std::string::npos);
+    EXPECT_NE(text.find("parklogic_cars{state=\"driving\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("parklogic_spots{type=\"small_parking\",state=\"occupied\"} 2\n"), std::string::npos);
+    EXPECT_EQ(text.find("large_charging"), std::string::npos); // Types without spots are omitted
+    ASSERT_GE(text.size(), 6u);
+    EXPECT_EQ(text.substr(text.size() - 6), "# EOF\n");
+}
+
+TEST(OpenMetricsExporterTests, WritesFileOnShutdown) {
+    auto path = std::filesystem::temp_directory_path() / "parklogic_openmetrics_test.prom";
+    std::filesystem::remove(path);
+    {
+        OpenMetricsExporter exporter(path.string(), 60.0);
+        TelemetrySample sample;
+        sample.ticks = 42;
+        exporter.submit(sample);
+    } // Destructor performs the final write
+
+    std::ifstream in(path);
+    ASSERT_TRUE(in.good());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_NE(contents.str().find("parklogic_ticks_total 42"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "core/JobPool.hpp"
+#include "systems/PathBatcher.hpp"
+#include "systems/PathPlanner.hpp"
+#include <atomic>
+#include <vector>
+
+namespace {
+bool SamePath(const std::vector<Waypoint> &a, const std::vector<Waypoint> &b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].position.x != b[i].position.x || a[i].position.y != b[i].position.y)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+TEST(JobPoolTests, RunsEveryIndexOncePerBatch) {
+    JobPool pool(3);
+    ASSERT_EQ(pool.getThreadCount(), 3u);
+
+    for (size_t count : {1u, 7u, 1000u, 0u, 64u}) {
+        std::vector<std::atomic<int>> runs(count);
+        std::atomic<bool> badWorker = false;
+        pool.dispatch(count, [&](size_t index, unsigned worker) {
+            runs[index]++;
+            if (worker >= 3)
+                badWorker = true;
+        });
+        pool.wait();
+        for (size_t i = 0; i < count; ++i)
+            EXPECT_EQ(runs[i].load(), 1) << "index " << i << " of " << count;
+        EXPECT_FALSE(badWorker);
+    }
+
+    // Dispatching again waits for the running batch instead of overlapping it
+    std::atomic<int> total = 0;
+    for (int batch = 0; batch < 50; ++batch)
+        pool.dispatch(16, [&](size_t, unsigned) { total++; });
+    pool.wait();
+    EXPECT_EQ(total.load(), 50 * 16);
+}
+
+TEST(PathBatcherTests, BatchMatchesSynchronousPlanningInRequestOrder) {
+    GeneratedMap map = GridMap(3);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+    RoadGraph::SearchScratch scratch;
+
+    // One PARK request per facility, starting at alternating map entries
+    std::vector<PathRequest> requests;
+    for (const auto &mod : map.modules) {
+        if (!mod->getParent() || mod->getSpotCount() == 0)
+            continue;
+        const auto &entry = graph.getEntries()[requests.size() % graph.getEntries().size()];
+        PathRequest request;
+        request.carId = (uint32_t)requests.size() + 1;
+        request.position = graph.getNodePosition(entry.node);
+        request.velocity = {entry.direction.x * 15.0f, entry.direction.y * 15.0f};
+        request.facility = mod.get();
+        request.spot = mod->getSpot(0);
+        request.spotIndex = 0;
+        requests.push_back(request);
+    }
+    ASSERT_GT(requests.size(), 4u);
+
+    PathBatcher batcher(4);
+    for (const PathRequest &request : requests)
+        batcher.enqueue(request);
+    batcher.enqueue(requests[0]); // A car has one request at a time
+    EXPECT_EQ(batcher.getQueuedCount(), requests.size());
+    EXPECT_TRUE(batcher.isPending(requests[0].carId));
+
+    EXPECT_TRUE(batcher.collect().empty()); // Nothing dispatched yet
+    batcher.dispatch(graph);
+    batcher.cancel(requests[1].carId); // Already in flight: dropped on collect
+    std::vector<PlannedPath> &planned = batcher.collect();
+    ASSERT_EQ(planned.size(), requests.size() - 1);
+    EXPECT_FALSE(batcher.isPending(requests[0].carId));
+    EXPECT_EQ(batcher.getBatchCount(), 1u);
+
+    size_t next = 0;
+    for (const PlannedPath &result : planned) {
+        if (next == 1)
+            next++;
+        const PathRequest &request = requests[next++];
+        ASSERT_EQ(result.request.carId, request.carId);
+        std::vector<uint32_t> route;
+        std::vector<Waypoint> expected = PathPlanner::GeneratePath(request.position, request.velocity, request.facility,
+                                                                   request.spot, &graph, &scratch, &route);
+        EXPECT_TRUE(SamePath(result.path, expected)) << "car " << request.carId;
+        EXPECT_EQ(result.route, route);
+        EXPECT_FALSE(result.path.empty());
+    }
+
+    // Cancelling a queued request removes it before it is ever solved
+    batcher.enqueue(requests[2]);
+    batcher.cancel(requests[2].carId);
+    EXPECT_EQ(batcher.getQueuedCount(), 0u);
+    batcher.dispatch(graph);
+    EXPECT_TRUE(batcher.collect().empty());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "systems/PricingEngine.hpp"
+#include "systems/SpotAssigner.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+/**
+ * @brief Parking lots bound to a registry, with a pricing engine over them.
+ */
+struct Lots {
+    std::vector<std::unique_ptr<Module>> modules;
+    SpotRegistry registry;
+    PricingEngine pricing;
+
+    Module *add(Vector2 position, float spotPrice) {
+        auto lot = std::make_unique<SmallParking>(true);
+        lot->worldPosition = position;
+        lot->setPriceMultiplier(1.0f); // Otherwise random per lot
+        lot->assignRandomPricesToSpots(spotPrice, 0.0f);
+        modules.push_back(std::move(lot));
+        return modules.back().get();
+    }
+
+    void bind() {
+        registry.rebuild(modules);
+        pricing.reset(registry);
+    }
+
+    /**
+     * @brief Runs pricing updates until @p until; returns every facility any of them re-priced.
+     */
+    std::vector<Module *> run(double &simTime, double until) {
+        std::vector<Module *> touched;
+        for (; simTime <= until; simTime += pricing.getRules().interval) {
+            for (Module *fac : pricing.update(simTime)) {
+                if (std::find(touched.begin(), touched.end(), fac) == touched.end())
+                    touched.push_back(fac);
+            }
+        }
+        return touched;
+    }
+};
+} // namespace
+
+TEST(PricingEngineTests, FullLotsGetDearerAndIdleLotsCheaper) {
+    Lots lots;
+    Module *empty = lots.add({0, 0}, 2.0f);
+    Module *full = lots.add({100, 0}, 2.0f);
+    for (int i = 0; i < (int)full->getSpotCount(); ++i)
+        full->setSpotState(i, SpotState::OCCUPIED);
+    const float listPrice = full->getSpot(0).price;
+    lots.bind();
+    EXPECT_EQ(lots.pricing.getActiveCount(), 2u);
+
+    double simTime = 0.0;
+    lots.run(simTime, 1200.0);
+    const PricingRules &rules = lots.pricing.getRules();
+    EXPECT_FLOAT_EQ(lots.pricing.getFactor(empty), rules.minFactor);
+    EXPECT_FLOAT_EQ(lots.pricing.getFactor(full), 1.0f + rules.occupancyGain * (1.0f - rules.targetOccupancy));
+    uint32_t emptyFirst = lots.registry.getRange(empty).first;
+    EXPECT_FLOAT_EQ(empty->getSpot(0).price, lots.registry.getBasePrice(emptyFirst) * rules.minFactor);
+    auto [begin, end] = lots.registry.getRange(full);
+    for (uint32_t spot = begin; spot < end; ++spot) {
+        EXPECT_FLOAT_EQ(lots.registry.getBasePrice(spot), listPrice);
+        EXPECT_FLOAT_EQ(lots.registry.getPrice(spot), listPrice * lots.pricing.getFactor(full));
+    }
+
+    // Both settled: nothing is visited until demand changes
+    EXPECT_EQ(lots.pricing.getActiveCount(), 0u);
+    EXPECT_TRUE(lots.run(simTime, simTime + 60.0).empty());
+
+    // A car leaves the full lot; only that lot is re-priced, downward
+    float before = lots.pricing.getFactor(full);
+    float idle = lots.pricing.getFactor(empty);
+    full->setSpotState(0, SpotState::FREE);
+    lots.pricing.onSpotStateChanged(full, SpotState::OCCUPIED, SpotState::FREE);
+    EXPECT_EQ(lots.pricing.getActiveCount(), 1u);
+    std::vector<Module *> touched = lots.run(simTime, simTime + 60.0);
+    ASSERT_EQ(touched.size(), 1u);
+    EXPECT_EQ(touched[0], full);
+    EXPECT_LT(lots.pricing.getFactor(full), before);
+    EXPECT_FLOAT_EQ(lots.pricing.getFactor(empty), idle);
+}
+
+TEST(PricingEngineTests, PriceChangesReorderFacilitySelection) {
+    Lots lots;
+    Module *busy = lots.add({0, 0}, 2.0f); // Cheapest list price, but one free spot
+    Module *idle = lots.add({100, 0}, 3.0f);
+    for (int i = 1; i < (int)busy->getSpotCount(); ++i)
+        busy->setSpotState(i, SpotState::OCCUPIED);
+    lots.bind();
+
+    SpotAssigner assigner;
+    assigner.reset(lots.modules);
+    RoadGraph graph;
+    DistanceMatrix distances;
+    SpotRequest request;
+    request.carId = 1;
+    request.priority = Car::Priority::PRIORITY_PRICE;
+
+    assigner.enqueue(request);
+    EXPECT_EQ(assigner.solve(graph, distances)[0].facility, busy);
+
+    // Busy gets dearer, idle cheaper, until idle's spots undercut busy's
+    double simTime = 0.0;
+    for (; simTime <= 600.0; simTime += lots.pricing.getRules().interval) {
+        for (Module *fac : lots.pricing.update(simTime))
+            assigner.refresh(fac);
+    }
+    ASSERT_LT(idle->getSpot(0).price, busy->getSpot(0).price);
+
+    assigner.enqueue(request);
+    EXPECT_EQ(assigner.solve(graph, distances)[0].facility, idle);
+}
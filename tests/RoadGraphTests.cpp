@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include "raymath.h"
+#include "systems/PathPlanner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST(RoadGraphTests, StripHasOneRoadWithTwoLanes) {
+    MapConfig config; // Single road strip
+    GeneratedMap map = WorldGenerator::generate(config);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+
+    ASSERT_EQ(graph.getEntries().size(), 2u);
+    ASSERT_EQ(graph.getExits().size(), 2u);
+    const auto &east = graph.getEntries()[0];
+    EXPECT_GT(east.direction.x, 0.0f);
+
+    // Driving east from the left end reaches the eastbound exit in a straight line
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> route;
+    const uint32_t goal[] = {graph.getExits()[0].node};
+    ASSERT_TRUE(graph.findRoute(east.node, goal, scratch, route));
+    for (uint32_t node : route)
+        EXPECT_FLOAT_EQ(graph.getNodePosition(node).y, graph.getNodePosition(east.node).y);
+
+    // No U-turns on a single road: the westbound exit is unreachable
+    const uint32_t behind[] = {graph.getExits()[1].node};
+    EXPECT_FALSE(graph.findRoute(east.node, behind, scratch, route));
+}
+
+TEST(RoadGraphTests, GridRoutesAcrossRowsThroughCrossStreets) {
+    GeneratedMap map = GridMap(3);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+
+    // Both ends of three roads
+    EXPECT_EQ(graph.getEntries().size(), 6u);
+
+    // Every entrance road is reachable from the top-left entry
+    const RoadGraph::Endpoint *topLeft = &graph.getEntries()[0];
+    for (const auto &entry : graph.getEntries()) {
+        Vector2 p = graph.getNodePosition(entry.node);
+        Vector2 best = graph.getNodePosition(topLeft->node);
+        if (entry.direction.x > 0 && p.y < best.y)
+            topLeft = &entry;
+    }
+
+    RoadGraph::SearchScratch scratch;
+    std::vector<uint32_t> route;
+    int entrances = 0;
+    float maxY = 0.0f;
+    for (const auto &mod : map.modules) {
+        auto [east, west] = graph.getEntranceNodes(mod.get());
+        if (east == RoadGraph::NO_NODE)
+            continue;
+        ++entrances;
+        const uint32_t goals[] = {east, west};
+        ASSERT_TRUE(graph.findRoute(topLeft->node, goals, scratch, route));
+        EXPECT_EQ(route.front(), topLeft->node);
+        EXPECT_TRUE(route.back() == east || route.back() == west);
+        maxY = std::max(maxY, graph.getNodePosition(route.back()).y);
+
+        // A* with a heuristic agrees with plain Dijkstra (many goals disable the heuristic)
+        float aStar = graph.getRouteLength(route);
+        std::vector<uint32_t> dijkstraGoals = {east, west, east, west, east};
+        std::vector<uint32_t> dijkstraRoute;
+        ASSERT_TRUE(graph.findRoute(topLeft->node, dijkstraGoals, scratch, dijkstraRoute));
+        EXPECT_NEAR(aStar, graph.getRouteLength(dijkstraRoute), 1e-2f);
+    }
+    EXPECT_EQ(entrances, 20);
+    EXPECT_GT(maxY, graph.getNodePosition(topLeft->node).y + 50.0f) << "Never left the first road";
+}
+
+TEST(RoadGraphTests, PlannerFollowsTheGraphToAnotherRow) {
+    GeneratedMap map = GridMap(2);
+    RoadGraph graph = RoadGraph::Build(map.modules);
+
+    const RoadGraph::Endpoint &entry = graph.getEntries()[0];
+    Vector2 start = graph.getNodePosition(entry.node);
+
+    // A facility on the other road
+    const Module *target = nullptr;
+    for (const auto &mod : map.modules) {
+        const Module *road = mod->getParent();
+        if (mod->getSpotCount() > 0 && road && std::fabs(road->worldPosition.y - start.y) > 50.0f)
+            target = mod.get();
+    }
+    ASSERT_NE(target, nullptr);
+
+    Car car(start, nullptr, Vector2Scale(entry.direction, 15.0f), Car::CarType::COMBUSTION);
+    Spot spot = target->getSpot(0);
+    RoadGraph::SearchScratch scratch;
+    std::vector<Waypoint> path = PathPlanner::GeneratePath(&car, target, spot, &graph, &scratch);
+    ASSERT_FALSE(path.empty());
+
+    Vector2 spotPos = Vector2Add(target->worldPosition, spot.localPosition);
+    EXPECT_LT(Vector2Distance(path.back().position, spotPos), 0.01f);
+
+    // No leg may cut across blocks: consecutive waypoints are axis-aligned or short (turns, parking)
+    Vector2 prev = start;
+    for (const Waypoint &wp : path) {
+        Vector2 d = Vector2Subtract(wp.position, prev);
+        EXPECT_TRUE(std::fabs(d.x) < 0.01f || std::fabs(d.y) < 0.01f || Vector2Length(d) < 25.0f)
+            << "Diagonal leg to (" << wp.position.x << ", " << wp.position.y << ")";
+        prev = wp.position;
+    }
+}
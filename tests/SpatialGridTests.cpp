@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "core/SpatialGrid.hpp"
+#include <vector>
+
+TEST(SpatialGridTests, QueryReturnsOnlyNearbyItems) {
+    SpatialGrid grid(100.0f, 100.0f, 10.0f);
+    grid.insert(0, {1, 1, 5, 5});
+    grid.insert(1, {80, 80, 5, 5});
+
+    std::vector<int> out;
+    grid.query({0, 0, 20, 20}, out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], 0);
+
+    grid.query({70, 70, 30, 30}, out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], 1);
+}
+
+TEST(SpatialGridTests, SpanningItemIsReportedOnceInIdOrder) {
+    SpatialGrid grid(100.0f, 100.0f, 10.0f);
+    grid.insert(2, {0, 0, 100, 5}); // Spans a full row of cells
+    grid.insert(1, {15, 1, 2, 2});
+
+    std::vector<int> out;
+    grid.query({0, 0, 100, 100}, out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+
+    // Repeated queries must not be affected by earlier de-duplication
+    grid.query({0, 0, 100, 100}, out);
+    EXPECT_EQ(out.size(), 2u);
+}
+
+TEST(SpatialGridTests, AreaOutsideGridIsEmpty) {
+    SpatialGrid grid(50.0f, 50.0f, 10.0f);
+    grid.insert(0, {45, 45, 5, 5});
+
+    std::vector<int> out;
+    grid.query({200, 200, 10, 10}, out);
+    EXPECT_TRUE(out.empty());
+
+    grid.clear();
+    grid.query({0, 0, 50, 50}, out);
+    EXPECT_TRUE(out.empty());
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "systems/SpotAssigner.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+/**
+ * @brief Parking lots off the road network, so distance-priority cars measure straight lines.
+ */
+struct Lots {
+    std::vector<std::unique_ptr<Module>> modules;
+    RoadGraph graph;
+    DistanceMatrix distances;
+
+    Module *add(Vector2 position, float spotPrice, int freeSpots) {
+        auto lot = std::make_unique<SmallParking>(true);
+        lot->worldPosition = position;
+        lot->assignRandomPricesToSpots(spotPrice, 0.0f);
+        for (int i = freeSpots; i < (int)lot->getSpotCount(); ++i)
+            lot->setSpotState(i, SpotState::OCCUPIED);
+        modules.push_back(std::move(lot));
+        return modules.back().get();
+    }
+};
+
+SpotRequest Request(uint32_t id, Car::Priority priority, Vector2 position) {
+    SpotRequest request;
+    request.carId = id;
+    request.priority = priority;
+    request.position = position;
+    request.velocity = {15, 0};
+    return request;
+}
+} // namespace
+
+TEST(SpotAssignerTests, ContestedSpotGoesToTheCarThatLosesMostWithoutIt) {
+    Lots lots;
+    Module *near = lots.add({0, 0}, 2.0f, 1);     // One cheap spot, right at the cars
+    Module *far = lots.add({100, 0}, 10.0f, 20); // Plenty of expensive spots 100 m away
+    lots.distances.reset(lots.graph, lots.modules);
+
+    SpotAssigner assigner;
+    assigner.reset(lots.modules);
+    EXPECT_FALSE(assigner.hasFacilities(true));
+    ASSERT_TRUE(assigner.hasFacilities(false));
+
+    // First come, first served would give the near spot to car 1 ($1 of walking saved) and make
+    // car 2 pay $8 more; the matching sends car 1 on to the far lot instead
+    assigner.enqueue(Request(1, Car::Priority::PRIORITY_DISTANCE, {0, 0}));
+    assigner.enqueue(Request(2, Car::Priority::PRIORITY_PRICE, {0, 0}));
+    const std::vector<SpotAssignment> &result = assigner.solve(lots.graph, lots.distances);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].request.carId, 1u);
+    EXPECT_EQ(result[0].facility, far);
+    EXPECT_EQ(result[1].facility, near);
+    EXPECT_EQ(near->getSpot(result[1].spotIndex).state, SpotState::FREE); // Reserving is the caller's job
+    EXPECT_FALSE(assigner.getLastStats().greedy);
+    EXPECT_EQ(assigner.getLastStats().assigned, 2u);
+    EXPECT_EQ(assigner.getQueuedCount(), 0u);
+
+    // Out of budget: greedy in request order
+    assigner.setMaxRelaxations(1);
+    assigner.enqueue(Request(1, Car::Priority::PRIORITY_DISTANCE, {0, 0}));
+    assigner.enqueue(Request(2, Car::Priority::PRIORITY_PRICE, {0, 0}));
+    const std::vector<SpotAssignment> &greedy = assigner.solve(lots.graph, lots.distances);
+    EXPECT_TRUE(assigner.getLastStats().greedy);
+    EXPECT_EQ(assigner.getGreedyFallbackCount(), 1u);
+    EXPECT_EQ(greedy[0].facility, near);
+    EXPECT_EQ(greedy[1].facility, far);
+}
+
+TEST(SpotAssignerTests, CarsBeyondFreeSpotsPassThrough) {
+    Lots lots;
+    Module *lot = lots.add({0, 0}, 2.0f, 3);
+    lots.distances.reset(lots.graph, lots.modules);
+
+    SpotAssigner assigner;
+    assigner.reset(lots.modules);
+    for (uint32_t id = 1; id <= 8; ++id) {
+        Car::Priority priority = id % 2 ? Car::Priority::PRIORITY_PRICE : Car::Priority::PRIORITY_DISTANCE;
+        assigner.enqueue(Request(id, priority, {0, 0}));
+    }
+    assigner.cancel(8);
+    ASSERT_EQ(assigner.getQueuedCount(), 7u);
+
+    // Each free spot goes to exactly one car; the rest pass through
+    const std::vector<SpotAssignment> &result = assigner.solve(lots.graph, lots.distances);
+    ASSERT_EQ(result.size(), 7u);
+    std::vector<int> taken;
+    for (const SpotAssignment &assignment : result) {
+        if (!assignment.facility)
+            continue;
+        EXPECT_EQ(assignment.facility, lot);
+        EXPECT_EQ(lot->getSpot(assignment.spotIndex).state, SpotState::FREE);
+        taken.push_back(assignment.spotIndex);
+    }
+    std::sort(taken.begin(), taken.end());
+    EXPECT_EQ(taken.size(), 3u);
+    EXPECT_EQ(std::unique(taken.begin(), taken.end()), taken.end());
+    EXPECT_FALSE(assigner.getLastStats().greedy);
+
+    // A full lot is not a candidate at all
+    for (int spot : taken)
+        lot->setSpotState(spot, SpotState::RESERVED);
+    assigner.refresh(lot);
+    assigner.enqueue(Request(9, Car::Priority::PRIORITY_PRICE, {0, 0}));
+    EXPECT_EQ(assigner.solve(lots.graph, lots.distances)[0].facility, nullptr);
+    EXPECT_EQ(assigner.getLastStats().spots, 0u);
+}
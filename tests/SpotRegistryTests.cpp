@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "TestMaps.hpp"
+#include "entities/map/SpotRegistry.hpp"
+#include <thread>
+#include <vector>
+
+namespace {
+bool IsCharging(const Module &mod) {
+    return mod.getType() == ModuleType::SMALL_CHARGING || mod.getType() == ModuleType::LARGE_CHARGING;
+}
+} // namespace
+
+TEST(SpotRegistryTests, BindsFacilitiesInKindRanges) {
+    GeneratedMap map = GridMap(2, 6);
+    Module *first = nullptr;
+    size_t total = 0;
+    for (const auto &mod : map.modules) {
+        total += mod->getSpotCount();
+        if (!first && mod->getSpotCount() > 0)
+            first = mod.get();
+    }
+    ASSERT_NE(first, nullptr);
+    first->setSpotState(1, SpotState::OCCUPIED); // Taken over by rebuild()
+
+    SpotRegistry registry;
+    registry.rebuild(map.modules);
+    ASSERT_EQ(registry.size(), total);
+
+    for (const auto &mod : map.modules) {
+        if (mod->getSpotCount() == 0)
+            continue;
+        auto [begin, end] = registry.getRange(mod.get());
+        ASSERT_EQ(end - begin, mod->getSpotCount());
+        auto [kindBegin, kindEnd] = registry.getRange(IsCharging(*mod));
+        EXPECT_GE(begin, kindBegin);
+        EXPECT_LE(end, kindEnd);
+        for (uint32_t spot = begin; spot < end; ++spot) {
+            Spot local = mod->getSpot((int)(spot - begin));
+            EXPECT_EQ(registry.getFacility(spot), mod.get());
+            EXPECT_FLOAT_EQ(registry.getPosition(spot).x, mod->worldPosition.x + local.localPosition.x);
+            EXPECT_FLOAT_EQ(registry.getPosition(spot).y, mod->worldPosition.y + local.localPosition.y);
+            EXPECT_FLOAT_EQ(registry.getPrice(spot), local.price);
+        }
+    }
+    EXPECT_EQ(registry.getRange(false).first, 0u);
+    EXPECT_EQ(registry.getRange(true).second, registry.size());
+
+    // Module and registry now share one state
+    uint32_t taken = registry.getRange(first).first + 1;
+    EXPECT_EQ(registry.getState(taken), SpotState::OCCUPIED);
+    EXPECT_FALSE(first->tryReserveSpot(1));
+    EXPECT_TRUE(first->tryReserveSpot(2));
+    EXPECT_EQ(registry.getState(taken + 1), SpotState::RESERVED);
+    EXPECT_EQ(first->getSpotCounts().reserved, 1);
+
+    // Unbinding writes the state back
+    registry.clear();
+    EXPECT_EQ(registry.size(), 0u);
+    EXPECT_EQ(first->getSpotRegistry(), nullptr);
+    EXPECT_EQ(first->getSpot(2).state, SpotState::RESERVED);
+    EXPECT_EQ(first->getSpot(1).state, SpotState::OCCUPIED);
+}
+
+TEST(SpotRegistryTests, ConcurrentReservationsNeverShareASpot) {
+    GeneratedMap map = GridMap(2, 6);
+    SpotRegistry registry;
+    registry.rebuild(map.modules);
+    auto [begin, end] = registry.getRange(false);
+    ASSERT_GT(end, begin);
+
+    // Every thread grabs the cheapest free parking spot until none is left
+    constexpr int THREADS = 4;
+    std::vector<std::vector<uint32_t>> won(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (;;) {
+                uint32_t spot = registry.findCheapestFree(begin, end);
+                if (spot == SpotRegistry::NO_SPOT)
+                    return;
+                if (registry.tryReserve(spot)) // Another thread may have been faster
+                    won[t].push_back(spot);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    std::vector<int> owners(registry.size(), 0);
+    size_t reserved = 0;
+    for (const auto &spots : won) {
+        for (uint32_t spot : spots)
+            owners[spot]++;
+        reserved += spots.size();
+    }
+    EXPECT_EQ(reserved, end - begin);
+    for (uint32_t spot = begin; spot < end; ++spot)
+        EXPECT_EQ(owners[spot], 1) << "spot " << spot;
+
+    // The per-facility counters saw every reservation exactly once
+    int counted = 0;
+    for (const auto &mod : map.modules) {
+        if (mod->getSpotCount() > 0 && !IsCharging(*mod)) {
+            EXPECT_EQ(mod->getSpotCounts().free, 0);
+            counted += mod->getSpotCounts().reserved;
+        }
+    }
+    EXPECT_EQ(counted, (int)(end - begin));
+    EXPECT_EQ(registry.findCheapestFree(begin, end), SpotRegistry::NO_SPOT);
+}
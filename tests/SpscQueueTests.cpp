@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "core/SpscQueue.hpp"
+#include <memory>
+#include <thread>
+
+TEST(SpscQueueTests, PreservesFifoOrder) {
+    SpscQueue<int, 8> queue;
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(SpscQueueTests, RejectsPushWhenFull) {
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(99));
+    EXPECT_EQ(queue.sizeApprox(), 4u);
+
+    int value = -1;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.push(4));
+}
+
+TEST(SpscQueueTests, PopReleasesSlot) {
+    SpscQueue<std::shared_ptr<int>, 2> queue;
+    auto item = std::make_shared<int>(7);
+    queue.push(item);
+    EXPECT_EQ(item.use_count(), 2);
+
+    std::shared_ptr<int> out;
+    ASSERT_TRUE(queue.pop(out));
+    out.reset();
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(SpscQueueTests, TwoThreadsTransferEverythingInOrder) {
+    constexpr int count = 100000;
+    SpscQueue<int, 64> queue;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value = 0;
+    while (expected < count) {
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_EQ(expected, count);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "core/TelemetryRing.hpp"
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+
+namespace {
+std::string UniqueName() { return "/parklogic_test_" + std::to_string(getpid()); }
+
+TelemetryFrame MakeFrame(uint64_t tick, size_t cars) {
+    TelemetryFrame frame;
+    frame.tick = tick;
+    frame.simTime = tick / 60.0;
+    for (size_t i = 0; i < cars; ++i) {
+        frame.cars.push_back({(uint32_t)i + 1, (float)i, 2.0f, 90.0f, 50.0f, 0, 1, 0});
+    }
+    frame.spots = {0, 1, 2};
+    return frame;
+}
+} // namespace
+
+TEST(TelemetryRingTests, ReaderSeesFramesWrittenByWriter) {
+    auto writer = TelemetryRingWriter::Create(UniqueName(), 4, 8, 3);
+    ASSERT_NE(writer, nullptr);
+    auto reader = TelemetryRingReader::Open(UniqueName());
+    ASSERT_NE(reader, nullptr);
+
+    TelemetryFrame out;
+    EXPECT_FALSE(reader->readLatest(out));
+
+    writer->write(MakeFrame(10, 2));
+    writer->write(MakeFrame(11, 3));
+
+    ASSERT_TRUE(reader->readLatest(out));
+    EXPECT_EQ(out.frame, 2u);
+    EXPECT_EQ(out.tick, 11u);
+    ASSERT_EQ(out.cars.size(), 3u);
+    EXPECT_EQ(out.cars[2].id, 3u);
+    EXPECT_FLOAT_EQ(out.cars[2].x, 2.0f);
+    ASSERT_EQ(out.spots.size(), 3u);
+    EXPECT_EQ(out.spots[2], 2);
+
+    ASSERT_TRUE(reader->read(1, out));
+    EXPECT_EQ(out.tick, 10u);
+}
+
+TEST(TelemetryRingTests, OverwrittenFramesAndOverflowAreReported) {
+    auto writer = TelemetryRingWriter::Create(UniqueName(), 2, 4, 3);
+    ASSERT_NE(writer, nullptr);
+    auto reader = TelemetryRingReader::Open(UniqueName());
+    ASSERT_NE(reader, nullptr);
+
+    for (uint64_t t = 1; t <= 3; ++t) {
+        writer->write(MakeFrame(t, 6)); // More cars than the segment holds
+    }
+
+    TelemetryFrame out;
+    EXPECT_FALSE(reader->read(1, out)); // Lapped by frame 3
+    ASSERT_TRUE(reader->read(3, out));
+    EXPECT_EQ(out.cars.size(), 4u);
+    EXPECT_TRUE(out.truncated);
+}
+
+TEST(TelemetryRingTests, OpenFailsWithoutSegment) {
+    EXPECT_EQ(TelemetryRingReader::Open("/parklogic_test_missing_segment"), nullptr);
+}
+#endif
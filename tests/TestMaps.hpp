@@ -0,0 +1,40 @@
+#pragma once
+#include "entities/map/RoadGraph.hpp"
+#include "entities/map/WorldGenerator.hpp"
+#include <cstdint>
+
+/**
+ * @file TestMaps.hpp
+ * @brief Generated maps shared by the routing and traffic tests.
+ */
+
+/**
+ * @brief Grid city with @p rows rows and @p facilitiesPerKind facilities of each module type.
+ */
+inline GeneratedMap GridMap(int rows, int facilitiesPerKind = 10) {
+    MapConfig config;
+    config.rows = rows;
+    config.smallParkingCount = facilitiesPerKind;
+    config.largeParkingCount = facilitiesPerKind;
+    config.smallChargingCount = facilitiesPerKind;
+    config.largeChargingCount = facilitiesPerKind;
+    return WorldGenerator::generate(config);
+}
+
+/**
+ * @brief Longest edge of @p graph, where a test car is unambiguously in the middle of one lane.
+ * @param from Receives the edge's source node.
+ */
+inline uint32_t LongestEdge(const RoadGraph &graph, uint32_t &from) {
+    uint32_t best = RoadGraph::NO_EDGE;
+    for (uint32_t n = 0; n < (uint32_t)graph.getNodeCount(); ++n) {
+        auto [begin, end] = graph.getEdgeRange(n);
+        for (uint32_t e = begin; e < end; ++e) {
+            if (best == RoadGraph::NO_EDGE || graph.getEdgeLength(e) > graph.getEdgeLength(best)) {
+                best = e;
+                from = n;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include "core/TrajectoryReader.hpp"
+#include "core/TrajectoryWriter.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace TrajectoryFormat;
+
+namespace {
+std::string TempPath(const char *name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+std::vector<int64_t> RoundTrip(const std::vector<int64_t> &values, ColumnHeader &header) {
+    std::vector<uint64_t> packed;
+    EncodeColumn(values, header, packed);
+    EXPECT_EQ(header.byteSize, packed.size() * sizeof(uint64_t));
+    std::vector<int64_t> decoded;
+    DecodeColumn(header, packed.data(), (uint32_t)values.size(), decoded);
+    return decoded;
+}
+
+TrajectoryRow MakeRow(uint64_t tick, uint32_t carId) {
+    return {tick, carId, 10.0f + tick * 0.5f, 20.0f - carId, 1.25f, -0.5f, 1, (uint32_t)tick / 10, 87.5f};
+}
+} // namespace
+
+TEST(TrajectoryTests, CodecRoundTripsArbitraryValues) {
+    std::vector<int64_t> values = {5, 7, 7, -3, 1000000, 0, std::numeric_limits<int64_t>::min(),
+                                   std::numeric_limits<int64_t>::max(), 42};
+    ColumnHeader header{};
+    EXPECT_EQ(RoundTrip(values, header), values);
+    EXPECT_LT(header.bitWidth, 64); // The few huge deltas are escaped instead of widening the rest
+}
+
+TEST(TrajectoryTests, CodecPacksSmallDeltasNarrowly) {
+    std::vector<int64_t> ticks;
+    for (int64_t t = 600; t < 1600; ++t)
+        ticks.push_back(t);
+    ColumnHeader header{};
+    EXPECT_EQ(RoundTrip(ticks, header), ticks);
+    EXPECT_EQ(header.bitWidth, 2); // Delta +1 zig-zags to 2
+    EXPECT_EQ(header.first, 600);
+
+    std::vector<int64_t> constant(100, 3);
+    EXPECT_EQ(RoundTrip(constant, header), constant);
+    EXPECT_EQ(header.bitWidth, 0);
+    EXPECT_EQ(header.byteSize, 0u);
+
+    // A jump to the next car's ticks escapes once; an all-ones delta must escape too
+    std::vector<int64_t> jumps = ticks;
+    jumps.push_back(-5000000);
+    jumps.push_back(-4999999);
+    jumps.push_back(-4999998);
+    jumps.push_back(-5000000); // Delta -2 zig-zags to 3, the escape code at width 2
+    EXPECT_EQ(RoundTrip(jumps, header), jumps);
+    EXPECT_EQ(header.bitWidth, 2);
+    EXPECT_LE(header.byteSize, (jumps.size() * 2 + 2 * 64 + 63) / 64 * 8);
+}
+
+TEST(TrajectoryTests, DecoderStopsAtTheEndOfTheColumn) {
+    std::vector<int64_t> values = {0, 1, 100000000, 100000001, 100000002};
+    ColumnHeader header{};
+    std::vector<uint64_t> packed;
+    EncodeColumn(values, header, packed);
+    header.byteSize = 8; // Cuts the escaped delta short
+
+    std::vector<int64_t> decoded;
+    DecodeColumn(header, packed.data(), (uint32_t)values.size(), decoded);
+    EXPECT_EQ(decoded, (std::vector<int64_t>{0, 1, 1, 1, 1}));
+}
+
+TEST(TrajectoryTests, ReaderQueriesColumnsByTickRange) {
+    std::string path = TempPath("parklogic_trajectory_test.pltraj");
+    {
+        auto writer = TrajectoryWriter::Open(path, 60.0, 6, 16);
+        ASSERT_NE(writer, nullptr);
+        for (uint64_t tick = 0; tick < 100; ++tick) {
+            writer->append(MakeRow(tick, 1));
+            writer->append(MakeRow(tick, 2));
+        }
+        EXPECT_EQ(writer->getRowsWritten(), 200u);
+    }
+
+    auto reader = TrajectoryReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_FALSE(reader->wasRecovered());
+    EXPECT_EQ(reader->getHeader().sampleEvery, 6u);
+    EXPECT_EQ(reader->getChunks().size(), 13u); // 200 rows / 16 per chunk
+
+    std::vector<int64_t> xs;
+    std::vector<int64_t> ticks;
+    reader->readColumn(TrajectoryColumn::X, 40, 49, xs, &ticks);
+    ASSERT_EQ(xs.size(), 20u);
+    EXPECT_EQ(ticks.front(), 40);
+    EXPECT_EQ(ticks.back(), 49);
+    EXPECT_NEAR(xs.front() * SCALE[(size_t)TrajectoryColumn::X], 30.0, 1e-3);
+
+    std::vector<int64_t> battery;
+    reader->readColumn(TrajectoryColumn::BATTERY, 0, 1000, battery);
+    ASSERT_EQ(battery.size(), 200u);
+    EXPECT_EQ(battery[123], 8750);
+
+    std::vector<int64_t> vy;
+    reader->readColumn(TrajectoryColumn::VY, 99, 99, vy);
+    ASSERT_EQ(vy.size(), 2u);
+    EXPECT_EQ(vy[0], -500);
+
+    reader.reset();
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryTests, WriterDeltaEncodesEachCarsTrajectory) {
+    std::string path = TempPath("parklogic_trajectory_cars.pltraj");
+    constexpr uint32_t CARS = 8;
+    constexpr uint64_t TICKS = 32;
+    {
+        auto writer = TrajectoryWriter::Open(path, 60.0, 1, CARS * TICKS);
+        ASSERT_NE(writer, nullptr);
+        // Cars 100 m apart, each moving 0.5 m per tick, appended car after car within each tick
+        for (uint64_t tick = 0; tick < TICKS; ++tick) {
+            for (uint32_t car = 0; car < CARS; ++car) {
+                TrajectoryRow row = MakeRow(tick, car);
+                row.x = 100.0f * car + 0.5f * tick;
+                writer->append(row);
+            }
+        }
+    }
+
+    auto reader = TrajectoryReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(reader->getChunks().size(), 1u);
+    const ChunkIndexEntry &entry = reader->getChunks()[0];
+    EXPECT_EQ(entry.firstTick, 0u);
+    EXPECT_EQ(entry.lastTick, TICKS - 1);
+
+    // Within a car X steps 500 mm, which zig-zags to 10 bits; only the 7 car switches escape
+    ChunkHeader chunk{};
+    std::memcpy(&chunk, reader->getFile().data() + entry.offset, sizeof(chunk));
+    const ColumnHeader &x = chunk.columns[(size_t)TrajectoryColumn::X];
+    EXPECT_LE(x.bitWidth, 10);
+    EXPECT_LE(x.byteSize, ((CARS * TICKS - 1) * 10 + (CARS - 1) * 64 + 63) / 64 * 8);
+
+    std::vector<int64_t> xs;
+    std::vector<int64_t> ids;
+    std::vector<int64_t> ticks;
+    reader->readColumn(TrajectoryColumn::X, 0, TICKS, xs, &ticks);
+    reader->readColumn(TrajectoryColumn::CAR_ID, 0, TICKS, ids);
+    ASSERT_EQ(xs.size(), CARS * TICKS);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_EQ(ids[i], (int64_t)(i / TICKS));
+        EXPECT_EQ(ticks[i], (int64_t)(i % TICKS));
+        EXPECT_NEAR(xs[i] * SCALE[(size_t)TrajectoryColumn::X], 100.0 * ids[i] + 0.5 * ticks[i], 1e-3);
+    }
+
+    reader.reset();
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryTests, ReaderRecoversChunksWithoutTrailer) {
+    std::string path = TempPath("parklogic_trajectory_recover.pltraj");
+    {
+        auto writer = TrajectoryWriter::Open(path, 60.0, 1, 8);
+        ASSERT_NE(writer, nullptr);
+        for (uint64_t tick = 0; tick < 20; ++tick)
+            writer->append(MakeRow(tick, 7));
+    }
+    // Simulate a crash before the index was written
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - sizeof(Trailer));
+
+    auto reader = TrajectoryReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_TRUE(reader->wasRecovered());
+    EXPECT_EQ(reader->getChunks().size(), 3u);
+
+    std::vector<int64_t> ids;
+    reader->readColumn(TrajectoryColumn::CAR_ID, 0, 100, ids);
+    EXPECT_EQ(ids, std::vector<int64_t>(20, 7));
+
+    reader.reset();
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryTests, ReaderDropsChunksWithColumnsOutsideTheFile) {
+    std::string path = TempPath("parklogic_trajectory_damaged.pltraj");
+    {
+        auto writer = TrajectoryWriter::Open(path, 60.0, 1, 8);
+        ASSERT_NE(writer, nullptr);
+        for (uint64_t tick = 0; tick < 20; ++tick)
+            writer->append(MakeRow(tick, 7));
+    }
+    uint64_t second = TrajectoryReader::Open(path)->getChunks().at(1).offset;
+
+    // Overwrites one field of a column header of the second chunk
+    auto patch = [&](TrajectoryColumn column, size_t field, const auto &value) {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp((std::streamoff)(second + offsetof(ChunkHeader, columns) +
+                                    (size_t)column * sizeof(ColumnHeader) + field));
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    // The index still lists the chunk, but its X deltas point past the end of the file
+    patch(TrajectoryColumn::X, offsetof(ColumnHeader, offset), uint64_t{1} << 40);
+    auto reader = TrajectoryReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_TRUE(reader->wasRecovered());
+    ASSERT_EQ(reader->getChunks().size(), 1u);
+    std::vector<int64_t> xs;
+    reader->readColumn(TrajectoryColumn::X, 0, 100, xs);
+    EXPECT_EQ(xs.size(), 8u);
+    reader.reset();
+
+    // X back inside the file, but the tick deltas have too few bytes for the rows at their bit width
+    patch(TrajectoryColumn::X, offsetof(ColumnHeader, offset), second + sizeof(ChunkHeader));
+    patch(TrajectoryColumn::TICK, offsetof(ColumnHeader, byteSize), uint32_t{0});
+    patch(TrajectoryColumn::TICK, offsetof(ColumnHeader, bitWidth), uint8_t{64});
+    reader = TrajectoryReader::Open(path);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->getChunks().size(), 1u);
+
+    reader.reset();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "entities/map/WorldGenerator.hpp"
+#include "raymath.h"
+#include <vector>
+
+namespace {
+MapConfig GridConfig(int rows, int facilitiesPerKind) {
+    MapConfig config;
+    config.rows = rows;
+    config.smallParkingCount = facilitiesPerKind;
+    config.largeParkingCount = facilitiesPerKind;
+    config.smallChargingCount = facilitiesPerKind;
+    config.largeChargingCount = facilitiesPerKind;
+    return config;
+}
+
+Rectangle Bounds(const Module &m) { return {m.worldPosition.x, m.worldPosition.y, m.getWidth(), m.getHeight()}; }
+
+bool Overlaps(Rectangle a, Rectangle b) {
+    const float eps = 1e-3f;
+    return a.x + eps < b.x + b.width && b.x + eps < a.x + a.width && a.y + eps < b.y + b.height &&
+           b.y + eps < a.y + a.height;
+}
+} // namespace
+
+TEST(WorldGeneratorTests, GridPlacesEveryFacilityOnItsRoad) {
+    GeneratedMap map = WorldGenerator::generate(GridConfig(4, 25));
+
+    std::vector<const Module *> facilities;
+    int crossStreets = 0;
+    for (const auto &mod : map.modules) {
+        if (dynamic_cast<const CrossStreet *>(mod.get()))
+            ++crossStreets;
+        if (mod->getSpotCount() > 0)
+            facilities.push_back(mod.get());
+    }
+    ASSERT_EQ(facilities.size(), 100u);
+
+    // 50 units over 4 rows -> 13 per row -> 2 junctions per row, 3 gaps between rows
+    EXPECT_EQ(crossStreets, 2 * 3);
+
+    for (const Module *fac : facilities) {
+        const Module *road = fac->getParent();
+        ASSERT_NE(road, nullptr);
+        Vector2 normal = fac->isUp() ? Vector2{0, 1} : Vector2{0, -1};
+        Vector2 facJoint = Vector2Add(fac->worldPosition, fac->getAttachmentPointByNormal(normal)->position);
+        Vector2 roadJoint =
+            Vector2Add(road->worldPosition, road->getAttachmentPointByNormal(Vector2Scale(normal, -1))->position);
+        EXPECT_LT(Vector2Distance(facJoint, roadJoint), 1e-3f);
+
+        Rectangle b = Bounds(*fac);
+        EXPECT_GE(b.x, 0.0f);
+        EXPECT_GE(b.y, 0.0f);
+        EXPECT_LE(b.x + b.width, map.world->getWidth());
+        EXPECT_LE(b.y + b.height, map.world->getHeight());
+    }
+}
+
+TEST(WorldGeneratorTests, GridKeepsFacilitiesAndCrossStreetsApart) {
+    GeneratedMap map = WorldGenerator::generate(GridConfig(3, 20));
+
+    std::vector<Rectangle> occupied;
+    for (const auto &mod : map.modules) {
+        if (mod->getSpotCount() > 0 || dynamic_cast<const CrossStreet *>(mod.get()))
+            occupied.push_back(Bounds(*mod));
+    }
+    for (size_t i = 0; i < occupied.size(); ++i) {
+        for (size_t j = i + 1; j < occupied.size(); ++j)
+            EXPECT_FALSE(Overlaps(occupied[i], occupied[j])) << i << " overlaps " << j;
+    }
+}
@@ -0,0 +1,449 @@
+#include "Analyzer.hpp"
+#include "core/JobPool.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+/**
+ * @file Analyzer.cpp
+ * @brief Implementation of the parallel trajectory / journal analyzer.
+ */
+
+namespace {
+// Mirrors of the simulation enums stored in the files (the tool does not link the simulation)
+constexpr uint8_t CAR_ALIGNING = 1;  ///< Car::CarState::ALIGNING
+constexpr uint8_t CAR_PARKED = 2;    ///< Car::CarState::PARKED
+constexpr uint8_t CAR_EXITING = 3;   ///< Car::CarState::EXITING
+constexpr uint8_t SPOT_RESERVED = 1; ///< SpotState::RESERVED
+constexpr uint8_t SPOT_OCCUPIED = 2; ///< SpotState::OCCUPIED
+
+constexpr std::array<const char *, ANALYZER_TRIP_COUNT> TRIP_NAMES = {"search", "time_to_park", "dwell", "exit",
+                                                                       "time_on_map"};
+constexpr std::array<const char *, Analyzer::CAR_TYPE_COUNT> TYPE_NAMES = {"combustion", "electric"};
+
+const char *FacilityTypeName(uint32_t type) {
+  switch (type) {
+  case 2:
+    return "small_parking";
+  case 3:
+    return "large_parking";
+  case 4:
+    return "small_charging";
+  case 5:
+    return "large_charging";
+  default:
+    return "other";
+  }
+}
+
+uint64_t CellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+/**
+ * @brief Timestamps of one car's trip (negative = not reached yet).
+ */
+struct OpenTrip {
+  double spawned = 0.0;
+  double aligning = -1.0;
+  double parked = -1.0;
+  double exiting = -1.0;
+};
+
+/**
+ * @brief Applies one car event to an open trip.
+ * @return False once the car has left the map and the trip is complete.
+ */
+bool Advance(OpenTrip &trip, const JournalRecord &record, double tickRate, Analyzer::TripHistograms &trips) {
+  double now = (double)record.tick / tickRate;
+  auto byType = [&](AnalyzerTrip metric) -> LatencyHistogram & {
+    return trips[static_cast<size_t>(metric)][std::min<size_t>(record.carType, Analyzer::CAR_TYPE_COUNT - 1)];
+  };
+
+  if (record.kind == JournalEventKind::CAR_REMOVED) {
+    if (trip.parked >= 0.0 && trip.exiting >= 0.0)
+      byType(AnalyzerTrip::EXIT).record(now - trip.exiting);
+    byType(AnalyzerTrip::TIME_ON_MAP).record(now - trip.spawned);
+    return false;
+  }
+  if (record.kind != JournalEventKind::CAR_STATE)
+    return true;
+
+  if (record.state == CAR_ALIGNING && trip.aligning < 0.0) {
+    trip.aligning = now;
+    byType(AnalyzerTrip::SEARCH).record(now - trip.spawned);
+  } else if (record.state == CAR_PARKED && trip.parked < 0.0) {
+    trip.parked = now;
+    byType(AnalyzerTrip::TIME_TO_PARK).record(now - trip.spawned);
+  } else if (record.state == CAR_EXITING && trip.exiting < 0.0) {
+    trip.exiting = now;
+    if (trip.parked >= 0.0)
+      byType(AnalyzerTrip::DWELL).record(now - trip.parked);
+  }
+  return true;
+}
+
+/**
+ * @brief What one worker learned from its contiguous range of journal records.
+ *
+ * Trips that started in an earlier range show up here as orphans: their events are kept in order
+ * and replayed once the trips that were still open at the end of the previous ranges are known.
+ */
+struct JournalPartial {
+  uint64_t firstBucket = 0;
+  std::vector<Analyzer::FacilityBucket> buckets; ///< Deltas for occupied/reserved, counts for the rest.
+  std::unordered_map<uint32_t, OpenTrip> open;
+  std::unordered_map<uint32_t, std::vector<JournalRecord>> orphans;
+  Analyzer::TripHistograms trips{};
+};
+} // namespace
+
+Analyzer::Analyzer(const AnalyzerOptions &options) : options(options) {}
+
+const char *Analyzer::Usage() {
+  return "Usage: parklogic_analyze [options]\n"
+         "  --trajectory <path>     Trajectory file written with --trajectory (.pltraj)\n"
+         "  --journal <path>        Event journal written with --journal (.plevj)\n"
+         "  --out <prefix>          CSV prefix (default parklogic_analysis)\n"
+         "  --threads <n>           Worker threads (default: all hardware threads)\n"
+         "  --bucket <s>            Simulated seconds per occupancy/throughput bucket (default 60)\n"
+         "  --cell <m>              Heatmap cell size in meters (default 5)\n"
+         "  --slow-speed <m/s>      Speed below which a car counts as congested (default 1)\n";
+}
+
+std::optional<AnalyzerOptions> Analyzer::ParseArgs(int argc, char **argv) {
+  auto number = [](std::string_view option, const char *value) {
+    try {
+      size_t used = 0;
+      double result = std::stod(value, &used);
+      if (used == std::string_view(value).size() && result >= 0.0)
+        return result;
+    } catch (const std::exception &) {
+    }
+    throw std::invalid_argument(std::format("Invalid value '{}' for {}", value, option));
+  };
+
+  AnalyzerOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--help") {
+      std::cout << Usage();
+      return std::nullopt;
+    }
+    if (i + 1 >= argc)
+      throw std::invalid_argument(std::format("Missing value for {}", arg));
+    const char *value = argv[++i];
+
+    if (arg == "--trajectory")
+      options.trajectoryPath = value;
+    else if (arg == "--journal")
+      options.journalPath = value;
+    else if (arg == "--out")
+      options.outputPrefix = value;
+    else if (arg == "--threads")
+      options.threads = (unsigned)number(arg, value);
+    else if (arg == "--bucket")
+      options.bucketSeconds = number(arg, value);
+    else if (arg == "--cell")
+      options.cellSize = number(arg, value);
+    else if (arg == "--slow-speed")
+      options.slowSpeed = number(arg, value);
+    else
+      throw std::invalid_argument(std::format("Unknown option {}", arg));
+  }
+
+  if (options.trajectoryPath.empty() && options.journalPath.empty())
+    throw std::invalid_argument("Nothing to analyze: pass --trajectory and/or --journal");
+  if (options.bucketSeconds <= 0.0 || options.cellSize <= 0.0)
+    throw std::invalid_argument("--bucket and --cell must be positive");
+  return options;
+}
+
+unsigned Analyzer::workerCount() const {
+  if (options.threads > 0)
+    return options.threads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::pair<int32_t, int32_t> Analyzer::cellOf(double x, double y) const {
+  return {(int32_t)std::floor(x / options.cellSize), (int32_t)std::floor(y / options.cellSize)};
+}
+
+const Analyzer::HeatCell *Analyzer::heatCell(int32_t cellX, int32_t cellY) const {
+  auto it = heatmap.find(CellKey(cellX, cellY));
+  return it != heatmap.end() ? &it->second : nullptr;
+}
+
+void Analyzer::analyzeTrajectories(const TrajectoryReader &reader) {
+  using TrajectoryFormat::SCALE;
+  const size_t chunkCount = reader.getChunks().size();
+  const unsigned threads = (unsigned)std::min<size_t>(workerCount(), std::max<size_t>(chunkCount, 1));
+  const double positionScale = SCALE[(size_t)TrajectoryColumn::X];
+  const double speedScale = SCALE[(size_t)TrajectoryColumn::VX];
+  const double slowSquared = options.slowSpeed * options.slowSpeed;
+
+  std::vector<std::unordered_map<uint64_t, HeatCell>> partials(threads);
+
+  JobPool pool(threads);
+  pool.dispatch(chunkCount, [&](size_t c, unsigned worker) {
+    auto &cells = partials[worker];
+    std::vector<int64_t> xs, ys, vxs, vys;
+    reader.decodeColumn(c, TrajectoryColumn::X, xs);
+    reader.decodeColumn(c, TrajectoryColumn::Y, ys);
+    reader.decodeColumn(c, TrajectoryColumn::VX, vxs);
+    reader.decodeColumn(c, TrajectoryColumn::VY, vys);
+
+    for (size_t r = 0; r < xs.size(); ++r) {
+      auto [cellX, cellY] = cellOf(xs[r] * positionScale, ys[r] * positionScale);
+      HeatCell &cell = cells[CellKey(cellX, cellY)];
+      cell.samples++;
+      double vx = vxs[r] * speedScale;
+      double vy = vys[r] * speedScale;
+      if (vx * vx + vy * vy < slowSquared)
+        cell.slowSamples++;
+    }
+  });
+  pool.wait();
+
+  for (const auto &cells : partials) {
+    for (const auto &[key, cell] : cells) {
+      HeatCell &total = heatmap[key];
+      total.samples += cell.samples;
+      total.slowSamples += cell.slowSamples;
+    }
+  }
+
+  const auto &header = reader.getHeader();
+  heatSampleSeconds = header.tickRate > 0.0 ? header.sampleEvery / header.tickRate : 0.0;
+  hasTrajectories = true;
+}
+
+void Analyzer::analyzeJournal(const EventJournalReader &reader) {
+  auto facilityTable = reader.getFacilities();
+  auto records = reader.getRecords();
+  facilities.assign(facilityTable.begin(), facilityTable.end());
+  const size_t facilityCount = facilities.size();
+  const double tickRate = reader.getTickRate() > 0.0 ? reader.getTickRate() : 60.0;
+  const uint64_t bucketTicks = std::max<uint64_t>(1, (uint64_t)std::llround(options.bucketSeconds * tickRate));
+  bucketSeconds = (double)bucketTicks / tickRate;
+  hasJournal = true;
+  if (records.empty())
+    return;
+
+  const unsigned threads = (unsigned)std::min<size_t>(workerCount(), records.size());
+  std::vector<JournalPartial> partials(threads);
+
+  // One contiguous slice of the records per job, so each partial covers a run of buckets
+  JobPool pool(threads);
+  pool.dispatch(threads, [&](size_t slice, unsigned) {
+    JournalPartial &partial = partials[slice];
+    size_t begin = records.size() * slice / threads;
+    size_t end = records.size() * (slice + 1) / threads;
+    reader.getFile().adviseSequential((size_t)((const unsigned char *)&records[begin] - reader.getFile().data()),
+                                      (end - begin) * sizeof(JournalRecord));
+
+    // Records are in tick order, so this range touches a contiguous run of buckets
+    partial.firstBucket = records[begin].tick / bucketTicks;
+    size_t rangeBuckets = records[end - 1].tick / bucketTicks - partial.firstBucket + 1;
+    partial.buckets.resize(rangeBuckets * facilityCount);
+
+    for (size_t i = begin; i < end; ++i) {
+      const JournalRecord &record = records[i];
+      if (record.kind == JournalEventKind::SPOT_STATE) {
+        if (record.facility >= facilityCount) // Includes NO_FACILITY
+          continue;
+        size_t index = (record.tick / bucketTicks - partial.firstBucket) * facilityCount + record.facility;
+        FacilityBucket &bucket = partial.buckets[index];
+        bool wasOccupied = record.previous == SPOT_OCCUPIED;
+        bool isOccupied = record.state == SPOT_OCCUPIED;
+        if (isOccupied && !wasOccupied) {
+          bucket.occupied++;
+          bucket.arrivals++;
+        } else if (wasOccupied && !isOccupied) {
+          bucket.occupied--;
+          bucket.departures++;
+        }
+        bucket.reserved += (record.state == SPOT_RESERVED) - (record.previous == SPOT_RESERVED);
+        continue;
+      }
+
+      if (record.kind == JournalEventKind::CAR_SPAWNED) {
+        partial.open[record.carId] = OpenTrip{(double)record.tick / tickRate};
+        continue;
+      }
+      if (auto orphan = partial.orphans.find(record.carId); orphan != partial.orphans.end()) {
+        orphan->second.push_back(record);
+        continue;
+      }
+      auto trip = partial.open.find(record.carId);
+      if (trip == partial.open.end()) {
+        partial.orphans[record.carId].push_back(record);
+        continue;
+      }
+      if (!Advance(trip->second, record, tickRate, partial.trips))
+        partial.open.erase(trip);
+    }
+  });
+  pool.wait();
+
+  // Stitch the ranges together in order
+  size_t totalBuckets = records.back().tick / bucketTicks + 1;
+  timeline.assign(totalBuckets * facilityCount, {});
+  std::unordered_map<uint32_t, OpenTrip> carried;
+  for (JournalPartial &partial : partials) {
+    for (size_t i = 0; i < partial.buckets.size(); ++i) {
+      FacilityBucket &total = timeline[partial.firstBucket * facilityCount + i];
+      const FacilityBucket &part = partial.buckets[i];
+      total.occupied += part.occupied;
+      total.reserved += part.reserved;
+      total.arrivals += part.arrivals;
+      total.departures += part.departures;
+    }
+
+    for (const auto &[carId, events] : partial.orphans) {
+      auto trip = carried.find(carId);
+      if (trip == carried.end())
+        continue; // Spawned before the journal started
+      for (const JournalRecord &record : events) {
+        if (!Advance(trip->second, record, tickRate, partial.trips)) {
+          carried.erase(trip);
+          break;
+        }
+      }
+    }
+    carried.insert(partial.open.begin(), partial.open.end());
+
+    for (size_t m = 0; m < ANALYZER_TRIP_COUNT; ++m) {
+      for (size_t t = 0; t < CAR_TYPE_COUNT; ++t)
+        trips[m][t].merge(partial.trips[m][t]);
+    }
+  }
+
+  // Occupancy deltas -> occupancy at the end of each bucket
+  for (size_t b = 1; b < totalBuckets; ++b) {
+    for (size_t f = 0; f < facilityCount; ++f) {
+      timeline[b * facilityCount + f].occupied += timeline[(b - 1) * facilityCount + f].occupied;
+      timeline[b * facilityCount + f].reserved += timeline[(b - 1) * facilityCount + f].reserved;
+    }
+  }
+}
+
+void Analyzer::writeHeatmapCsv(std::ostream &out) const {
+  std::vector<uint64_t> keys;
+  keys.reserve(heatmap.size());
+  for (const auto &entry : heatmap)
+    keys.push_back(entry.first);
+  auto cellY = [](uint64_t key) { return (int32_t)(uint32_t)key; };
+  auto cellX = [](uint64_t key) { return (int32_t)(uint32_t)(key >> 32); };
+  std::sort(keys.begin(), keys.end(), [&](uint64_t a, uint64_t b) {
+    return std::pair(cellY(a), cellX(a)) < std::pair(cellY(b), cellX(b));
+  });
+
+  out << "x,y,samples,slow_samples,slow_seconds\n";
+  for (uint64_t key : keys) {
+    const HeatCell &cell = heatmap.at(key);
+    out << cellX(key) * options.cellSize << ',' << cellY(key) * options.cellSize << ',' << cell.samples << ','
+        << cell.slowSamples << ',' << cell.slowSamples * heatSampleSeconds << '\n';
+  }
+}
+
+void Analyzer::writeOccupancyCsv(std::ostream &out) const {
+  out << "time_s,facility,type,spots,occupied,reserved,occupancy,arrivals,departures\n";
+  for (size_t b = 0; b < bucketCount(); ++b) {
+    for (size_t f = 0; f < facilities.size(); ++f) {
+      const FacilityBucket &cell = bucket(b, f);
+      uint32_t spots = facilities[f].spotCount;
+      out << (b + 1) * bucketSeconds << ',' << f << ',' << FacilityTypeName(facilities[f].type) << ',' << spots << ','
+          << cell.occupied << ',' << cell.reserved << ',' << (spots > 0 ? (double)cell.occupied / spots : 0.0) << ','
+          << cell.arrivals << ',' << cell.departures << '\n';
+    }
+  }
+}
+
+void Analyzer::writeThroughputCsv(std::ostream &out) const {
+  double hours = bucketCount() * bucketSeconds / 3600.0;
+  out << "facility,type,spots,arrivals,departures,arrivals_per_hour,turnover_per_spot\n";
+  for (size_t f = 0; f < facilities.size(); ++f) {
+    uint64_t arrivals = 0;
+    uint64_t departures = 0;
+    for (size_t b = 0; b < bucketCount(); ++b) {
+      arrivals += bucket(b, f).arrivals;
+      departures += bucket(b, f).departures;
+    }
+    uint32_t spots = facilities[f].spotCount;
+    out << f << ',' << FacilityTypeName(facilities[f].type) << ',' << spots << ',' << arrivals << ',' << departures
+        << ',' << (hours > 0.0 ? arrivals / hours : 0.0) << ',' << (spots > 0 ? (double)arrivals / spots : 0.0)
+        << '\n';
+  }
+}
+
+void Analyzer::writeTripsCsv(std::ostream &out) const {
+  out << "metric,car_type,count,mean,p50,p90,p95,p99,max\n";
+  for (size_t m = 0; m < ANALYZER_TRIP_COUNT; ++m) {
+    for (size_t t = 0; t < CAR_TYPE_COUNT; ++t) {
+      const LatencyHistogram &h = trips[m][t];
+      out << TRIP_NAMES[m] << ',' << TYPE_NAMES[t] << ',' << h.count() << ',' << h.mean() << ',' << h.quantile(0.50)
+          << ',' << h.quantile(0.90) << ',' << h.quantile(0.95) << ',' << h.quantile(0.99) << ',' << h.max() << '\n';
+    }
+  }
+}
+
+bool Analyzer::exportCsv(const std::string &prefix) const {
+  auto write = [&](const char *suffix, void (Analyzer::*writer)(std::ostream &) const) {
+    std::string path = prefix + suffix;
+    std::ofstream out(path);
+    if (!out) {
+      Logger::Error("Analyzer: Cannot write {}", path);
+      return false;
+    }
+    (this->*writer)(out);
+    Logger::Info("Analyzer: Exported {}", path);
+    return true;
+  };
+
+  bool ok = true;
+  if (hasTrajectories)
+    ok = write("_heatmap.csv", &Analyzer::writeHeatmapCsv) && ok;
+  if (hasJournal) {
+    ok = write("_occupancy.csv", &Analyzer::writeOccupancyCsv) && ok;
+    ok = write("_throughput.csv", &Analyzer::writeThroughputCsv) && ok;
+    ok = write("_trips.csv", &Analyzer::writeTripsCsv) && ok;
+  }
+  return ok;
+}
+
+int Analyzer::run() {
+  auto start = std::chrono::steady_clock::now();
+
+  if (!options.trajectoryPath.empty()) {
+    auto reader = TrajectoryReader::Open(options.trajectoryPath);
+    if (!reader) {
+      Logger::Error("Analyzer: {} is not a readable trajectory file", options.trajectoryPath);
+      return 1;
+    }
+    if (reader->wasRecovered())
+      Logger::Warn("Analyzer: {} has no chunk index (interrupted run?); recovered {} chunks",
+                   options.trajectoryPath, reader->getChunks().size());
+    analyzeTrajectories(*reader);
+    Logger::Info("Analyzer: {} chunks, {} heatmap cells", reader->getChunks().size(), heatmap.size());
+  }
+
+  if (!options.journalPath.empty()) {
+    auto reader = EventJournalReader::Open(options.journalPath);
+    if (!reader) {
+      Logger::Error("Analyzer: {} is not a readable event journal", options.journalPath);
+      return 1;
+    }
+    analyzeJournal(*reader);
+    Logger::Info("Analyzer: {} journal records, {} facilities, {} buckets", reader->getRecords().size(),
+                 facilities.size(), bucketCount());
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  Logger::Info("Analyzer: Done in {:.2f} s with {} threads", seconds, workerCount());
+  return exportCsv(options.outputPrefix) ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "core/EventJournal.hpp"
+#include "core/LatencyHistogram.hpp"
+#include "core/TrajectoryReader.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file Analyzer.hpp
+ * @brief Offline, multi-threaded aggregation of trajectory files and event journals.
+ */
+
+/**
+ * @struct AnalyzerOptions
+ * @brief Command line of `parklogic_analyze`.
+ */
+struct AnalyzerOptions {
+  std::string trajectoryPath; ///< .pltraj input; empty = skip the heatmap.
+  std::string journalPath;    ///< .plevj input; empty = skip occupancy, throughput and trips.
+  std::string outputPrefix = "parklogic_analysis";
+  unsigned threads = 0;        ///< Worker threads; 0 = one per hardware thread.
+  double bucketSeconds = 60.0; ///< Simulated seconds per occupancy/throughput bucket.
+  double cellSize = 5.0;       ///< Heatmap cell edge in meters.
+  double slowSpeed = 1.0;      ///< Samples below this speed (m/s) count as congested.
+};
+
+/**
+ * @enum AnalyzerTrip
+ * @brief Trip durations reconstructed from an event journal.
+ */
+enum class AnalyzerTrip : size_t {
+  SEARCH,       ///< Spawn until ALIGNING.
+  TIME_TO_PARK, ///< Spawn until PARKED.
+  DWELL,        ///< PARKED until EXITING.
+  EXIT,         ///< EXITING until removal (cars that parked only).
+  TIME_ON_MAP,  ///< Spawn until removal, all cars.
+  COUNT
+};
+
+constexpr size_t ANALYZER_TRIP_COUNT = static_cast<size_t>(AnalyzerTrip::COUNT);
+
+/**
+ * @class Analyzer
+ * @brief Computes occupancy curves, per-facility throughput, a congestion heatmap and trip time
+ * distributions, and writes them as CSV.
+ *
+ * Inputs are memory-mapped and split across worker threads: trajectory chunks are handed out
+ * through an atomic counter, the journal's fixed-size records are cut into one contiguous range
+ * per thread. Each worker aggregates into private state that is merged at the end, so memory
+ * depends on the world size, the simulated duration and the number of cars alive at once, never
+ * on the size of the input files.
+ */
+class Analyzer {
+public:
+  /**
+   * @struct HeatCell
+   * @brief Trajectory samples that fell into one heatmap cell.
+   */
+  struct HeatCell {
+    uint64_t samples = 0;
+    uint64_t slowSamples = 0; ///< Samples slower than AnalyzerOptions::slowSpeed.
+  };
+
+  /**
+   * @struct FacilityBucket
+   * @brief One facility in one time bucket. Occupancy is the state at the end of the bucket.
+   */
+  struct FacilityBucket {
+    int64_t occupied = 0;
+    int64_t reserved = 0;
+    uint64_t arrivals = 0;   ///< Spots that became OCCUPIED.
+    uint64_t departures = 0; ///< Spots that stopped being OCCUPIED.
+  };
+
+  explicit Analyzer(const AnalyzerOptions &options);
+
+  /**
+   * @brief Parses the command line.
+   * @return std::nullopt if only `--help` was requested.
+   * @throws std::invalid_argument On an unknown option, a malformed value or no input file.
+   */
+  static std::optional<AnalyzerOptions> ParseArgs(int argc, char **argv);
+  static const char *Usage();
+
+  void analyzeTrajectories(const TrajectoryReader &reader);
+  void analyzeJournal(const EventJournalReader &reader);
+
+  /**
+   * @brief Opens the inputs named in the options, analyzes them and writes the CSV files.
+   * @return Process exit code.
+   */
+  int run();
+
+  /**
+   * @brief Writes `<prefix>_heatmap.csv`, `_occupancy.csv`, `_throughput.csv` and `_trips.csv`
+   * for the inputs that were analyzed.
+   */
+  bool exportCsv(const std::string &prefix) const;
+
+  void writeHeatmapCsv(std::ostream &out) const;
+  void writeOccupancyCsv(std::ostream &out) const;
+  void writeThroughputCsv(std::ostream &out) const;
+  void writeTripsCsv(std::ostream &out) const;
+
+  /**
+   * @brief Heatmap cell of a world position.
+   */
+  std::pair<int32_t, int32_t> cellOf(double x, double y) const;
+  const HeatCell *heatCell(int32_t cellX, int32_t cellY) const;
+  size_t heatCellCount() const { return heatmap.size(); }
+
+  const std::vector<JournalFacility> &getFacilities() const { return facilities; }
+  size_t bucketCount() const { return facilities.empty() ? 0 : timeline.size() / facilities.size(); }
+  const FacilityBucket &bucket(size_t index, size_t facility) const {
+    return timeline[index * facilities.size() + facility];
+  }
+  const LatencyHistogram &trip(AnalyzerTrip metric, size_t carType) const {
+    return trips[static_cast<size_t>(metric)][carType];
+  }
+
+  static constexpr size_t CAR_TYPE_COUNT = 2; ///< Number of Car::CarType values.
+  using TripHistograms = std::array<std::array<LatencyHistogram, CAR_TYPE_COUNT>, ANALYZER_TRIP_COUNT>;
+
+private:
+  unsigned workerCount() const;
+
+  AnalyzerOptions options;
+
+  bool hasTrajectories = false;
+  double heatSampleSeconds = 0.0; ///< Simulated time represented by one trajectory sample.
+  std::unordered_map<uint64_t, HeatCell> heatmap;
+
+  bool hasJournal = false;
+  double bucketSeconds = 0.0; ///< Actual bucket length after rounding to whole ticks.
+  std::vector<JournalFacility> facilities;
+  std::vector<FacilityBucket> timeline; ///< bucketCount() x facilities, row-major.
+  TripHistograms trips{};
+};
@@ -0,0 +1,25 @@
+#include "Analyzer.hpp"
+#include "core/Logger.hpp"
+#include <exception>
+
+/**
+ * @brief Entry point of `parklogic_analyze`.
+ *
+ * Aggregates trajectory files and event journals written by `parklogic --headless`
+ * into CSV files. See Analyzer::Usage() for the options.
+ *
+ * @return 0 on success, 1 if an input could not be read or an output written, -1 on bad arguments.
+ */
+int main(int argc, char **argv) {
+  try {
+    auto options = Analyzer::ParseArgs(argc, argv);
+    if (!options)
+      return 0;
+    Analyzer analyzer(*options);
+    return analyzer.run();
+  } catch (const std::exception &e) {
+    Logger::Error("{}", e.what());
+    Logger::Info("\n{}", Analyzer::Usage());
+    return -1;
+  }
+}
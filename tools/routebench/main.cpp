@@ -0,0 +1,192 @@
+#include "core/Logger.hpp"
+#include "entities/map/ContractionHierarchy.hpp"
+#include "entities/map/RoadGraph.hpp"
+#include "entities/map/WorldGenerator.hpp"
+#include "raylib.h"
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file main.cpp
+ * @brief `parklogic_routebench`: plain A* against the contraction hierarchy on generated cities.
+ */
+
+namespace {
+struct BenchOptions {
+  int rows = 20;
+  int facilitiesPerKind = 2500;
+  int queries = 2000;
+  unsigned int seed = 1;
+  std::string cachePath; ///< Also time a save/load round trip through this file.
+};
+
+const char *Usage() {
+  return "Usage: parklogic_routebench [options]\n"
+         "  --rows <n>          Road rows of the generated city (default 20)\n"
+         "  --facilities <n>    Facilities of each of the four kinds (default 2500)\n"
+         "  --queries <n>       Random spawn-to-facility routes (default 2000)\n"
+         "  --seed <n>          Random seed (default 1)\n"
+         "  --cache <path>      Also save the hierarchy to <path> and time loading it back\n";
+}
+
+int ParseCount(std::string_view option, const char *value) {
+  try {
+    size_t used = 0;
+    int result = std::stoi(value, &used);
+    if (used == std::string_view(value).size() && result >= 0)
+      return result;
+  } catch (const std::exception &) {
+  }
+  throw std::invalid_argument(std::format("{} expects a non-negative integer, got '{}'", option, value));
+}
+
+BenchOptions ParseArgs(int argc, char **argv) {
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (i + 1 >= argc)
+      throw std::invalid_argument(std::format("Missing value for {}", arg));
+    const char *value = argv[++i];
+    if (arg == "--rows")
+      options.rows = ParseCount(arg, value);
+    else if (arg == "--facilities")
+      options.facilitiesPerKind = ParseCount(arg, value);
+    else if (arg == "--queries")
+      options.queries = ParseCount(arg, value);
+    else if (arg == "--seed")
+      options.seed = (unsigned int)ParseCount(arg, value);
+    else if (arg == "--cache")
+      options.cachePath = value;
+    else
+      throw std::invalid_argument(std::format("Unknown option {}", arg));
+  }
+  return options;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Query {
+  uint32_t start;
+  uint32_t goals[2];
+};
+
+/**
+ * @brief Times @p queries with one search method and sums what they settled and returned.
+ */
+template <typename Search> void Measure(const char *name, const std::vector<Query> &queries, Search search) {
+  RoadGraph::SearchScratch scratch;
+  std::vector<uint32_t> route;
+  size_t settled = 0;
+  size_t found = 0;
+  double totalLength = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (const Query &q : queries) {
+    if (search(q, scratch, route)) {
+      found++;
+      totalLength += route.size();
+    }
+    settled += scratch.lastSettled;
+  }
+  double ms = MillisecondsSince(start);
+  Logger::Info("{:<22} {:>9.2f} us/query  {:>9.1f} nodes settled/query  {} of {} routed ({:.1f} nodes/route)", name,
+               1000.0 * ms / (double)queries.size(), (double)settled / (double)queries.size(), found, queries.size(),
+               found ? totalLength / (double)found : 0.0);
+}
+} // namespace
+
+/**
+ * @brief Entry point of `parklogic_routebench`.
+ * @return 0 on success, 1 if the two methods disagree on a route length, -1 on bad arguments.
+ */
+int main(int argc, char **argv) {
+  BenchOptions options;
+  try {
+    options = ParseArgs(argc, argv);
+  } catch (const std::exception &e) {
+    Logger::Error("{}", e.what());
+    Logger::Info("\n{}", Usage());
+    return -1;
+  }
+
+  SetRandomSeed(options.seed);
+  MapConfig config;
+  config.rows = options.rows;
+  config.smallParkingCount = options.facilitiesPerKind;
+  config.largeParkingCount = options.facilitiesPerKind;
+  config.smallChargingCount = options.facilitiesPerKind;
+  config.largeChargingCount = options.facilitiesPerKind;
+
+  Logger::SetMinLevel(Logger::Level::Error); // Thousands of missing-texture warnings without a window
+  GeneratedMap map = WorldGenerator::generate(config);
+  Logger::SetMinLevel(Logger::Level::Info);
+
+  auto started = std::chrono::steady_clock::now();
+  RoadGraph graph = RoadGraph::Build(map.modules);
+  Logger::Info("Graph built in {:.1f} ms", MillisecondsSince(started));
+
+  started = std::chrono::steady_clock::now();
+  auto hierarchy = ContractionHierarchy::Build(graph);
+  Logger::Info("Hierarchy built in {:.1f} ms", MillisecondsSince(started));
+
+  if (!options.cachePath.empty() && hierarchy->save(options.cachePath)) {
+    started = std::chrono::steady_clock::now();
+    auto loaded = ContractionHierarchy::Load(options.cachePath, graph);
+    Logger::Info("Hierarchy {} in {:.1f} ms", loaded ? "loaded" : "FAILED to load", MillisecondsSince(started));
+  }
+
+  // The same work TrafficSystem does: a random map entry to the entrance of a random facility
+  std::vector<std::pair<uint32_t, uint32_t>> entrances;
+  for (const auto &mod : map.modules) {
+    auto nodes = graph.getEntranceNodes(mod.get());
+    if (nodes.first != RoadGraph::NO_NODE)
+      entrances.push_back(nodes);
+  }
+  if (entrances.empty() || graph.getEntries().empty()) {
+    Logger::Error("The generated map has no facilities to route to");
+    return 1;
+  }
+  std::vector<Query> queries(options.queries);
+  for (Query &q : queries) {
+    q.start = graph.getEntries()[GetRandomValue(0, (int)graph.getEntries().size() - 1)].node;
+    auto [east, west] = entrances[GetRandomValue(0, (int)entrances.size() - 1)];
+    q.goals[0] = east;
+    q.goals[1] = west;
+  }
+
+  Measure("A*", queries, [&](const Query &q, RoadGraph::SearchScratch &scratch, std::vector<uint32_t> &route) {
+    return graph.findRouteAStar(q.start, q.goals, scratch, route);
+  });
+  Measure("Contraction hierarchy", queries,
+          [&](const Query &q, RoadGraph::SearchScratch &scratch, std::vector<uint32_t> &route) {
+            return hierarchy->findRoute(q.start, q.goals, scratch, route);
+          });
+
+  // Both must find equally short routes
+  RoadGraph::SearchScratch scratch;
+  std::vector<uint32_t> aStarRoute;
+  std::vector<uint32_t> hierarchyRoute;
+  int mismatches = 0;
+  for (const Query &q : queries) {
+    bool a = graph.findRouteAStar(q.start, q.goals, scratch, aStarRoute);
+    bool h = hierarchy->findRoute(q.start, q.goals, scratch, hierarchyRoute);
+    if (a != h)
+      mismatches++;
+    // Lengths are re-summed from float positions; tied routes of a long trip differ in the last digits
+    float expected = a ? graph.getRouteLength(aStarRoute) : 0.0f;
+    if (a && std::fabs(expected - graph.getRouteLength(hierarchyRoute)) > 0.01f + expected * 1e-5f)
+      mismatches++;
+  }
+  if (mismatches > 0) {
+    Logger::Error("{} of {} routes differ between A* and the hierarchy", mismatches, queries.size());
+    return 1;
+  }
+  Logger::Info("All {} routes agree", queries.size());
+  return 0;
+}